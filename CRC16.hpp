@@ -3,6 +3,8 @@
 #ifndef CRC16_HPP
 #define CRC16_HPP
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 
 namespace unify_link
@@ -267,8 +269,45 @@ namespace unify_link
         0x4040,
     };
 
-    // 查表法计算crc
-    inline uint16_t crc16_calculation(const uint8_t *ptr, uint16_t len, uint16_t crc = 0xFFFF)
+    // 多字节 CRC 引擎：
+    //   UNIFY_LINK_CRC16_ENGINE = 1 : 单表逐字节查表（512B 表，适合 Flash 紧张的 MCU）
+    //   UNIFY_LINK_CRC16_ENGINE = 4 : slicing-by-4（2KB 表）
+    //   UNIFY_LINK_CRC16_ENGINE = 8 : slicing-by-8（4KB 表，默认）
+    // 定义 UNIFY_LINK_CRC16_HW 后 crc16_calculation() 转发到用户实现的 unify_link_crc16_hw()，
+    // 用于接入 MCU 的 CRC 外设（需配置为 CRC-16/MODBUS：多项式 0x8005，输入/输出反转）。
+    // 所有引擎结果与 crc16_table 逐字节算法逐位一致。
+#ifndef UNIFY_LINK_CRC16_ENGINE
+#define UNIFY_LINK_CRC16_ENGINE 8
+#endif
+
+    static_assert(UNIFY_LINK_CRC16_ENGINE == 1 || UNIFY_LINK_CRC16_ENGINE == 4 || UNIFY_LINK_CRC16_ENGINE == 8,
+                  "UNIFY_LINK_CRC16_ENGINE must be 1, 4 or 8");
+
+    // 编译期生成 slicing 表：table[0] 即 crc16_table，table[k] 为前一张表再推进一个零字节
+    template <size_t Slices>
+    constexpr std::array<std::array<uint16_t, 256>, Slices> make_crc16_slice_tables()
+    {
+        std::array<std::array<uint16_t, 256>, Slices> tables{};
+        for (size_t i = 0; i < 256; ++i)
+            tables[0][i] = crc16_table[i];
+
+        for (size_t k = 1; k < Slices; ++k)
+        {
+            for (size_t i = 0; i < 256; ++i)
+            {
+                const uint16_t prev = tables[k - 1][i];
+                tables[k][i] = static_cast<uint16_t>((prev >> 8) ^ crc16_table[prev & 0xff]);
+            }
+        }
+        return tables;
+    }
+
+    // 两套表分开定义：只有被调用的引擎引用的表才会链接进固件（slicing-by-4 只占 2KB）
+    inline constexpr auto crc16_slice4_table = make_crc16_slice_tables<4>();
+    inline constexpr auto crc16_slice8_table = make_crc16_slice_tables<8>();
+
+    // 查表法计算crc（逐字节）
+    inline uint16_t crc16_calculation_bytewise(const uint8_t *ptr, uint16_t len, uint16_t crc = 0xFFFF)
     {
         while (len--)
         {
@@ -276,6 +315,82 @@ namespace unify_link
         }
         return crc;
     }
-}
+
+    // slicing-by-4：每次迭代处理 4 字节
+    inline uint16_t crc16_calculation_slice4(const uint8_t *ptr, uint16_t len, uint16_t crc = 0xFFFF)
+    {
+        const auto &t = crc16_slice4_table;
+        while (len >= 4)
+        {
+            crc = static_cast<uint16_t>(t[3][(ptr[0] ^ crc) & 0xff] ^ t[2][(ptr[1] ^ (crc >> 8)) & 0xff] ^
+                                        t[1][ptr[2]] ^ t[0][ptr[3]]);
+            ptr += 4;
+            len -= 4;
+        }
+        return crc16_calculation_bytewise(ptr, len, crc);
+    }
+
+    // slicing-by-8：每次迭代处理 8 字节
+    inline uint16_t crc16_calculation_slice8(const uint8_t *ptr, uint16_t len, uint16_t crc = 0xFFFF)
+    {
+        const auto &t = crc16_slice8_table;
+        while (len >= 8)
+        {
+            crc = static_cast<uint16_t>(t[7][(ptr[0] ^ crc) & 0xff] ^ t[6][(ptr[1] ^ (crc >> 8)) & 0xff] ^
+                                        t[5][ptr[2]] ^ t[4][ptr[3]] ^ t[3][ptr[4]] ^ t[2][ptr[5]] ^ t[1][ptr[6]] ^
+                                        t[0][ptr[7]]);
+            ptr += 8;
+            len -= 8;
+        }
+        return crc16_calculation_bytewise(ptr, len, crc);
+    }
+
+#ifdef UNIFY_LINK_CRC16_HW
+} // namespace unify_link
+
+// 由用户在 MCU 工程中实现：从 crc 初值继续计算 ptr[0..len) 的 CRC-16/MODBUS
+extern uint16_t unify_link_crc16_hw(const uint8_t *ptr, uint16_t len, uint16_t crc);
+
+namespace unify_link
+{
+#endif
+
+    inline uint16_t crc16_calculation(const uint8_t *ptr, uint16_t len, uint16_t crc = 0xFFFF)
+    {
+#if defined(UNIFY_LINK_CRC16_HW)
+        return ::unify_link_crc16_hw(ptr, len, crc);
+#elif UNIFY_LINK_CRC16_ENGINE == 8
+        return crc16_calculation_slice8(ptr, len, crc);
+#elif UNIFY_LINK_CRC16_ENGINE == 4
+        return crc16_calculation_slice4(ptr, len, crc);
+#else
+        return crc16_calculation_bytewise(ptr, len, crc);
+#endif
+    }
+
+    // 将 crc 推进 len 个零字节（CRC 寄存器对状态是 GF(2) 线性的）
+    inline uint16_t crc16_shift(uint16_t crc, uint32_t len)
+    {
+#if UNIFY_LINK_CRC16_ENGINE == 8
+        const auto &t = crc16_slice8_table;
+        for (; len >= 8; len -= 8)
+            crc = static_cast<uint16_t>(t[7][crc & 0xff] ^ t[6][crc >> 8]);
+#elif UNIFY_LINK_CRC16_ENGINE == 4
+        const auto &t = crc16_slice4_table;
+        for (; len >= 4; len -= 4)
+            crc = static_cast<uint16_t>(t[3][crc & 0xff] ^ t[2][crc >> 8]);
+#endif
+        for (; len > 0; --len)
+            crc = static_cast<uint16_t>((crc >> 8) ^ crc16_table[crc & 0xff]);
+        return crc;
+    }
+
+    // 拼接 CRC：crc_a 为前段的 CRC（任意初值），crc_b0 为后段以初值 0 计算的 CRC，len_b 为后段长度
+    // 结果等于把后段接在前段之后连续计算的 CRC，可让乱序到达的分块各自计算 CRC 后按顺序合并
+    inline uint16_t crc16_combine(uint16_t crc_a, uint16_t crc_b0, uint32_t len_b)
+    {
+        return static_cast<uint16_t>(crc16_shift(crc_a, len_b) ^ crc_b0);
+    }
+} // namespace unify_link
 
 #endif // CRC16_HPP
@@ -0,0 +1,477 @@
+/**
+ * @file unify_link_benchmark.cpp
+ * @brief Google Benchmark suite: CRC, ring buffer, component round trips, parsing of damaged streams and resync
+ *
+ * JSON 输出：unify_link_benchmarks --benchmark_out=result.json --benchmark_out_format=json
+ * （或构建目标 benchmark_json，结果写入构建目录下的 unify_link_benchmarks.json）
+ */
+
+#include "encoder_link.hpp"
+#include "motor_link.hpp"
+#include "unify_link.hpp"
+
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace unify_link;
+
+namespace
+{
+    // 按接收环空闲空间分段推送并解析，与串口传输层的读取方式相同
+    void feed(Unify_link_base &link, const uint8_t *data, size_t len)
+    {
+        while (len != 0)
+        {
+            uint32_t space = link.rec_buff.remain();
+            if (space == 0)
+            {
+                link.parse_data_task();
+                space = link.rec_buff.remain();
+                if (space == 0)
+                    return;
+            }
+            const uint32_t n = link.rev_data_push(data, static_cast<uint32_t>(std::min<size_t>(len, space)));
+            data += n;
+            len -= n;
+            link.parse_data_task();
+        }
+    }
+
+    void pipe_all(Unify_link_base &tx, Unify_link_base &rx)
+    {
+        uint8_t bytes[2 * MAX_SEND_BUFF_LENGTH];
+        uint32_t len = 0;
+        tx.send_buff_pop(bytes, &len);
+        rx.rev_data_push(bytes, len);
+        rx.parse_data_task();
+    }
+} // namespace
+
+// ============================================================================
+// CRC16
+// ============================================================================
+
+static void BM_crc16(benchmark::State &state)
+{
+    std::vector<uint8_t> data(static_cast<size_t>(state.range(0)));
+    std::mt19937 rng(1);
+    for (uint8_t &b : data)
+        b = static_cast<uint8_t>(rng());
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(crc16_calculation(data.data(), static_cast<uint16_t>(data.size())));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_crc16)->Arg(8)->Arg(16)->Arg(64)->Arg(256)->Arg(MAX_FRAME_DATA_LENGTH)->Arg(4096);
+
+// 各引擎对比（与 UNIFY_LINK_CRC16_ENGINE 无关）：帧头 6 字节、短消息、典型电机帧、固件分片、最大载荷
+static void BM_crc16_engine(benchmark::State &state, uint16_t (*crc)(const uint8_t *, uint16_t, uint16_t))
+{
+    std::vector<uint8_t> data(static_cast<size_t>(state.range(0)));
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = static_cast<uint8_t>(i * 31 + 7);
+    if (crc(data.data(), static_cast<uint16_t>(data.size()), 0xFFFF) !=
+        crc16_calculation_bytewise(data.data(), static_cast<uint16_t>(data.size())))
+        state.SkipWithError("engine disagrees with the bytewise reference");
+
+    uint16_t value = 0xFFFF;
+    for (auto _ : state)
+    {
+        value = crc(data.data(), static_cast<uint16_t>(data.size()), value);
+        benchmark::DoNotOptimize(value);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK_CAPTURE(BM_crc16_engine, bytewise, &crc16_calculation_bytewise)->Arg(6)->Arg(24)->Arg(72)->Arg(256)->Arg(512);
+BENCHMARK_CAPTURE(BM_crc16_engine, slice4, &crc16_calculation_slice4)->Arg(6)->Arg(24)->Arg(72)->Arg(256)->Arg(512);
+BENCHMARK_CAPTURE(BM_crc16_engine, slice8, &crc16_calculation_slice8)->Arg(6)->Arg(24)->Arg(72)->Arg(256)->Arg(512);
+
+// ============================================================================
+// Circular_buffer
+// ============================================================================
+
+static void BM_ring_push_pop(benchmark::State &state)
+{
+    Circular_buffer<uint8_t, MAX_RECV_BUFF_LENGTH> ring;
+    std::vector<uint8_t> chunk(static_cast<size_t>(state.range(0)), 0x5A);
+    std::vector<uint8_t> out(chunk.size());
+
+    for (auto _ : state)
+    {
+        ring.push_data(chunk.data(), static_cast<uint32_t>(chunk.size()));
+        ring.read_data(out.data(), static_cast<uint32_t>(out.size()));
+        ring.pop_data(static_cast<uint32_t>(out.size()));
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_ring_push_pop)->Arg(1)->Arg(16)->Arg(64)->Arg(512);
+
+// 生产者（计时线程）与消费者线程同时访问，测量 SPSC 约定下的跨线程吞吐（Circular_buffer 与 Spsc_ring_buffer 对比）
+template <typename Ring>
+static void BM_ring_cross_thread(benchmark::State &state)
+{
+    static Ring ring;
+    ring.pop_data(ring.used());
+    std::vector<uint8_t> chunk(static_cast<size_t>(state.range(0)), 0x5A);
+
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> consumed{0};
+    std::thread consumer(
+        [&]
+        {
+            uint8_t out[MAX_RECV_BUFF_LENGTH];
+            while (!stop.load(std::memory_order_acquire) || ring.used() != 0)
+            {
+                const uint32_t n = ring.used();
+                if (n == 0)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+                ring.read_data(out, n);
+                ring.pop_data(n);
+                consumed.fetch_add(n, std::memory_order_relaxed);
+            }
+        });
+
+    uint64_t stalls = 0;
+    for (auto _ : state)
+    {
+        while (ring.push_data(chunk.data(), static_cast<uint32_t>(chunk.size())) == 0)
+        {
+            stalls++;
+            std::this_thread::yield();
+        }
+    }
+    stop.store(true, std::memory_order_release);
+    consumer.join();
+
+    state.SetBytesProcessed(static_cast<int64_t>(consumed.load()));
+    state.counters["full_stalls"] = benchmark::Counter(static_cast<double>(stalls), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK_TEMPLATE(BM_ring_cross_thread, Circular_buffer<uint8_t, MAX_RECV_BUFF_LENGTH>)
+    ->Arg(16)
+    ->Arg(64)
+    ->Arg(512)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ring_cross_thread, Spsc_ring_buffer<uint8_t, MAX_RECV_BUFF_LENGTH>)
+    ->Arg(16)
+    ->Arg(64)
+    ->Arg(512)
+    ->UseRealTime();
+
+// ============================================================================
+// Component round trips: build_send_data -> send_buff_pop -> rev_data_push -> parse_data_task
+// ============================================================================
+
+namespace
+{
+    struct Round_trip_t
+    {
+        Unify_link_base device;
+        Unify_link_base host;
+        Motor_link_t device_motor{device};
+        Motor_link_t host_motor{host};
+        Encoder_link_t device_encoder{device};
+        Encoder_link_t host_encoder{host};
+        uint32_t tick = 0;
+
+        Round_trip_t()
+        {
+            // 信息 / 设置载荷以 motor_id 定位接收端条目；控制量与 PID 未初始化，先清零
+            device_motor.motor_pid = {};
+            for (uint8_t i = 0; i < Motor_link_t::MAX_MOTORS; ++i)
+            {
+                device_motor.motor_set[i] = {};
+                device_motor.motor_info[i] = {};
+                device_motor.motor_info[i].motor_id = i;
+                device_motor.motor_settings[i] = {};
+                device_motor.motor_settings[i].motor_id = i;
+            }
+        }
+    };
+
+    template <typename Send>
+    void BM_round_trip(benchmark::State &state, Send send)
+    {
+        Round_trip_t rt;
+        uint64_t bytes = 0;
+        for (auto _ : state)
+        {
+            send(rt);
+            bytes += rt.device.send_buff_used();
+            pipe_all(rt.device, rt.host);
+            rt.tick++;
+        }
+        if (rt.host.success_count() == 0)
+            state.SkipWithError("no frame decoded");
+        state.SetBytesProcessed(static_cast<int64_t>(bytes));
+        state.counters["frames"] = benchmark::Counter(static_cast<double>(rt.host.success_count()),
+                                                      benchmark::Counter::kIsRate);
+    }
+} // namespace
+
+BENCHMARK_CAPTURE(BM_round_trip, motor_basic, [](Round_trip_t &rt) { rt.device_motor.send_motor_basic_data(); });
+BENCHMARK_CAPTURE(BM_round_trip, motor_info, [](Round_trip_t &rt) { rt.device_motor.send_motor_info_data(0); });
+BENCHMARK_CAPTURE(BM_round_trip, motor_setting, [](Round_trip_t &rt) { rt.device_motor.send_motor_setting_data(0); });
+BENCHMARK_CAPTURE(BM_round_trip, motor_set, [](Round_trip_t &rt) { rt.device_motor.send_motor_set_data(); });
+BENCHMARK_CAPTURE(BM_round_trip, motor_basic_delta,
+                  [](Round_trip_t &rt)
+                  {
+                      rt.device_motor.motor_basic[rt.tick % Motor_link_t::MAX_MOTORS].position++;
+                      rt.device_motor.send_motor_basic_delta();
+                  });
+BENCHMARK_CAPTURE(BM_round_trip, motor_pid,
+                  [](Round_trip_t &rt)
+                  {
+                      rt.device_motor.motor_pid.motor_id = static_cast<uint8_t>(rt.tick % Motor_link_t::MAX_MOTORS);
+                      rt.device.send_packet<COMPONENT_ID_MOTORS>(Motor_link_t::MOTOR_PID_ID, rt.device_motor.motor_pid);
+                  });
+BENCHMARK_CAPTURE(BM_round_trip, motor_set_delta,
+                  [](Round_trip_t &rt)
+                  {
+                      rt.device_motor.motor_set[rt.tick % Motor_link_t::MAX_MOTORS].set++;
+                      rt.device_motor.send_motor_set_delta();
+                  });
+BENCHMARK_CAPTURE(BM_round_trip, encoder_basic, [](Round_trip_t &rt) { rt.device_encoder.send_encoder_basic_data(); });
+BENCHMARK_CAPTURE(BM_round_trip, encoder_info, [](Round_trip_t &rt) { rt.device_encoder.send_encoder_info_data(); });
+BENCHMARK_CAPTURE(BM_round_trip, encoder_setting,
+                  [](Round_trip_t &rt) { rt.device_encoder.send_encoder_setting_data(); });
+
+// ============================================================================
+// Parsing damaged streams: bit errors (ppm of bits) and lost byte spans (per mille of frames)
+// ============================================================================
+
+namespace
+{
+    std::vector<uint8_t> damaged_stream(uint32_t frames, uint32_t ber_ppm, uint32_t loss_permille)
+    {
+        Unify_link_base device;
+        Motor_link_t motor{device};
+        std::vector<uint8_t> clean;
+        for (uint32_t i = 0; i < frames; ++i)
+        {
+            motor.motor_basic[i % Motor_link_t::MAX_MOTORS].position = static_cast<uint16_t>(i);
+            motor.send_motor_basic_data();
+            uint8_t bytes[2 * MAX_SEND_BUFF_LENGTH];
+            uint32_t len = 0;
+            device.send_buff_pop(bytes, &len);
+            clean.insert(clean.end(), bytes, bytes + len);
+        }
+
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<uint32_t> ppm(0, 999999);
+        std::vector<uint8_t> out;
+        out.reserve(clean.size());
+        const size_t frame_len = clean.size() / frames;
+        for (size_t i = 0; i < clean.size(); ++i)
+        {
+            // 每帧起点按概率丢掉一段（1 ~ frame_len 字节）
+            if (loss_permille != 0 && i % frame_len == 0 && ppm(rng) < loss_permille * 1000)
+            {
+                i += 1 + rng() % frame_len;
+                if (i >= clean.size())
+                    break;
+            }
+            uint8_t b = clean[i];
+            if (ber_ppm != 0)
+                for (int bit = 0; bit < 8; ++bit)
+                    if (ppm(rng) < ber_ppm)
+                        b ^= static_cast<uint8_t>(1u << bit);
+            out.push_back(b);
+        }
+        return out;
+    }
+} // namespace
+
+static void BM_parse_damaged(benchmark::State &state)
+{
+    constexpr uint32_t kFrames = 4096;
+    const auto stream = damaged_stream(kFrames, static_cast<uint32_t>(state.range(0)),
+                                       static_cast<uint32_t>(state.range(1)));
+
+    uint64_t decoded = 0;
+    uint64_t crc_errors = 0;
+    for (auto _ : state)
+    {
+        Unify_link_base host;
+        Motor_link_t motor{host};
+        feed(host, stream.data(), stream.size());
+        decoded += host.success_count();
+        crc_errors += host.stats_totals().crc_errors;
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * stream.size()));
+    state.counters["decoded_ratio"] =
+        static_cast<double>(decoded) / static_cast<double>(state.iterations() * kFrames);
+    state.counters["crc_errors"] = benchmark::Counter(static_cast<double>(crc_errors), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_parse_damaged)
+    ->ArgNames({"ber_ppm", "loss_permille"})
+    ->Args({0, 0})
+    ->Args({10, 0})
+    ->Args({100, 0})
+    ->Args({1000, 0})
+    ->Args({0, 10})
+    ->Args({0, 100})
+    ->Args({100, 10});
+
+// ============================================================================
+// Resynchronisation: memchr header search vs the original byte-at-a-time search
+// ============================================================================
+
+namespace
+{
+    // 原逐字节帧头搜索的参考解析器，作为速度基线与正确性参照
+    class Legacy_link : public Unify_link_base
+    {
+    public:
+        void legacy_parse_data_task()
+        {
+            while (rec_buff.used() >= sizeof(frame_head))
+            {
+                if (!legacy_find_frame_head())
+                    break;
+
+                const uint16_t payload_len = frame_head.length();
+                if (payload_len > MAX_FRAME_DATA_LENGTH)
+                {
+                    rec_buff.pop_data(1);
+                    continue;
+                }
+
+                if (rec_buff.used() < sizeof(frame_head) + payload_len)
+                    break;
+
+                rec_buff.read_data(frame_data.data(), payload_len, sizeof(frame_head));
+
+                uint16_t crc = crc16_calculation(reinterpret_cast<uint8_t *>(&frame_head),
+                                                 offsetof(unify_link_frame_head_t, crc16));
+                crc = crc16_calculation(frame_data.data(), payload_len, crc);
+                if (crc != frame_head.crc16)
+                {
+                    rec_buff.pop_data(1);
+                    continue;
+                }
+
+                rec_buff.pop_data(sizeof(frame_head) + payload_len);
+                _count_decode(frame_head.component_id, frame_head.data_id, payload_len,
+                              handle_data(frame_head.component_id, frame_head.data_id, frame_data.data(), payload_len));
+            }
+        }
+
+    private:
+        bool legacy_find_frame_head()
+        {
+            while (rec_buff.used() >= sizeof(frame_head))
+            {
+                rec_buff.read_data(reinterpret_cast<uint8_t *>(&frame_head), sizeof(frame_head));
+                if (frame_head.frame_header == FRAME_HEADER)
+                    return true;
+                rec_buff.pop_data(1);
+            }
+            return false;
+        }
+    };
+
+    constexpr uint8_t kResyncComponent = 0x04;
+    constexpr uint8_t kResyncDataId = 0x01;
+    constexpr uint16_t kResyncPayloadLen = 48;
+    constexpr uint32_t kResyncFrames = 4000;
+    constexpr uint32_t kResyncChunk = 256;
+    constexpr uint32_t kGarbageEvery = 50;
+
+    // 合法帧，可每 kGarbageEvery 帧插入一段随机垃圾，再按 ber_ppm（每百万比特）翻转
+    std::vector<uint8_t> resync_stream(uint32_t ber_ppm, uint32_t garbage_len)
+    {
+        Unify_link_base tx;
+        std::vector<uint8_t> stream;
+        std::mt19937 rng(1234);
+
+        uint8_t payload[kResyncPayloadLen];
+        uint8_t frame[MAX_FRAME_LENGTH];
+        for (uint32_t n = 0; n < kResyncFrames; ++n)
+        {
+            for (uint16_t i = 0; i < kResyncPayloadLen; ++i)
+                payload[i] = static_cast<uint8_t>(n + i);
+            tx.build_send_data(kResyncComponent, kResyncDataId, payload, kResyncPayloadLen);
+
+            uint32_t len = 0;
+            tx.send_buff_pop(frame, &len);
+            stream.insert(stream.end(), frame, frame + len);
+
+            if (garbage_len != 0 && n % kGarbageEvery == 0)
+                for (uint32_t i = 0; i < garbage_len; ++i)
+                    stream.push_back(static_cast<uint8_t>(rng()));
+        }
+
+        std::uniform_int_distribution<uint32_t> ppm(0, 999999);
+        if (ber_ppm != 0)
+            for (auto &b : stream)
+                for (int bit = 0; bit < 8; ++bit)
+                    if (ppm(rng) < ber_ppm)
+                        b ^= static_cast<uint8_t>(1u << bit);
+        return stream;
+    }
+
+    // 固定块长推送，每块后解析一次
+    template <typename Link>
+    void resync_parse(Link &link, void (Link::*parse)(), const std::vector<uint8_t> &stream, uint8_t *dst)
+    {
+        link.register_handle_data(kResyncComponent, kResyncDataId, dst, nullptr, kResyncPayloadLen);
+        for (size_t off = 0; off < stream.size(); off += kResyncChunk)
+        {
+            const uint32_t n = static_cast<uint32_t>(std::min<size_t>(kResyncChunk, stream.size() - off));
+            link.rev_data_push(stream.data() + off, n);
+            (link.*parse)();
+        }
+    }
+} // namespace
+
+template <typename Link>
+static void BM_resync(benchmark::State &state, void (Link::*parse)())
+{
+    const auto stream = resync_stream(static_cast<uint32_t>(state.range(0)), static_cast<uint32_t>(state.range(1)));
+    uint8_t dst[kResyncPayloadLen];
+
+    // 两种帧头搜索必须恢复出相同的帧
+    Legacy_link reference;
+    resync_parse(reference, &Legacy_link::legacy_parse_data_task, stream, dst);
+
+    uint64_t resyncs = 0;
+    uint64_t skipped = 0;
+    for (auto _ : state)
+    {
+        Link link;
+        resync_parse(link, parse, stream, dst);
+        if (link.success_count() != reference.success_count() ||
+            link.decode_error_count() != reference.decode_error_count())
+        {
+            state.SkipWithError("frames recovered differ from the byte-at-a-time parser");
+            break;
+        }
+        resyncs += link.resync_count();
+        skipped += link.resync_skipped_bytes();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * stream.size()));
+    state.counters["frames"] = static_cast<double>(reference.success_count());
+    state.counters["resyncs"] = benchmark::Counter(static_cast<double>(resyncs), benchmark::Counter::kAvgIterations);
+    state.counters["skipped_bytes"] =
+        benchmark::Counter(static_cast<double>(skipped), benchmark::Counter::kAvgIterations);
+}
+
+static void resync_scenarios(benchmark::internal::Benchmark *b)
+{
+    b->ArgNames({"ber_ppm", "garbage_len"})
+        ->Args({0, 0})
+        ->Args({10, 0})
+        ->Args({100, 0})
+        ->Args({1000, 0})
+        ->Args({0, 4096})
+        ->Args({100, 4096});
+}
+BENCHMARK_CAPTURE(BM_resync, memchr, &Unify_link_base::parse_data_task)->Apply(resync_scenarios);
+BENCHMARK_CAPTURE(BM_resync, bytewise, &Legacy_link::legacy_parse_data_task)->Apply(resync_scenarios);
@@ -3,13 +3,17 @@
 #ifndef __ENCODER_LINK_HPP__
 #define __ENCODER_LINK_HPP__
 
+#include "publish_scheduler.hpp"
 #include "unify_link.hpp"
+#include "unify_link_static.hpp"
+
+#include <cstring>
 
 namespace unify_link
 {
-    class Encoder_link_t
+    // 协议定义（与链路尺寸无关）：不同尺寸链路上的 Encoder_link_basic_t 共享同一组载荷类型
+    struct Encoder_link_def_t
     {
-    public:
         enum class ErrorCode : uint8_t
         {
             OK = 0,
@@ -50,45 +54,112 @@ namespace unify_link
 #pragma pack(pop)
 
         constexpr static uint16_t MAX_ENCODERS = 8;
-        encoder_basic_t encoder_basic[MAX_ENCODERS];
+        constexpr static uint8_t component_id = COMPONENT_ID_ENCODERS; // 组件ID（与 motor_link 区分）
+    };
+
+    template <typename Link>
+    class Encoder_link_basic_t : public Encoder_link_def_t
+    {
+    public:
+        using link_type = Link;
+
+        encoder_basic_t encoder_basic[MAX_ENCODERS] = {};
         encoder_info_t encoder_info;
-        encoder_setting_t encoder_setting;
+        encoder_setting_t encoder_setting = {};
+
+        // 发布死区：位置（按 16 位回绕计）与速度的变化量都不超过阈值、且错误码不变时不重发
+        struct basic_deadband_t
+        {
+            uint16_t position = 0;
+            int32_t velocity = 0;
+        };
+
+        // 最近一次经 publish_encoder_basic() 发出的值
+        encoder_basic_t encoder_basic_published[MAX_ENCODERS] = {};
+        bool encoder_basic_publish_valid = false;
 
     public:
-        Unify_link_base &link_base;
-        constexpr static uint8_t component_id = COMPONENT_ID_ENCODERS; // 组件ID（与 motor_link 区分）
+        Link &link_base;
+        // 全部 ID 已写入链路分发表；为 false 时分发表已满（见 UNIFY_LINK_MAX_HANDLERS），组件收不到未注册的帧
+        bool registered = false;
 
-        Encoder_link_t(Unify_link_base &link_base) : link_base(link_base) { build_handle_data_matrix(); }
-        ~Encoder_link_t() {};
+        Encoder_link_basic_t(Link &link_base) : link_base(link_base) { registered = build_handle_data_matrix(); }
+        // 编译期注册：由 Unify_link_static 构造，不写入运行时分发表
+        explicit Encoder_link_basic_t(static_registration_t<Link> reg) : link_base(reg.link_base), registered(true) {}
+        ~Encoder_link_basic_t() {};
 
-        void build_handle_data_matrix()
+        bool build_handle_data_matrix()
         {
-            link_base.register_handle_data(component_id, ENCODER_BASIC_ID, &encoder_basic, nullptr,
-                                           sizeof(encoder_basic));
-            link_base.register_handle_data(component_id, ENCODER_INFO_ID, &encoder_info, nullptr, sizeof(encoder_info));
-            link_base.register_handle_data(component_id, ENCODER_SETTING_ID, &encoder_setting, nullptr,
-                                           sizeof(encoder_setting));
+            bool ok = true;
+            ok &= link_base.register_handle_data(component_id, ENCODER_BASIC_ID, &encoder_basic, nullptr,
+                                                 sizeof(encoder_basic));
+            ok &= link_base.register_handle_data(component_id, ENCODER_INFO_ID, &encoder_info, nullptr,
+                                                 sizeof(encoder_info));
+            ok &= link_base.register_handle_data(component_id, ENCODER_SETTING_ID, &encoder_setting, nullptr,
+                                                 sizeof(encoder_setting));
+            return ok;
         }
 
     public:
         void send_encoder_basic_data() { send_encoder_basic_data(encoder_basic); }
         void send_encoder_basic_data(const encoder_basic_t (&send_data)[MAX_ENCODERS])
         {
-            link_base.send_packet<component_id>(ENCODER_BASIC_ID, send_data);
+            link_base.template send_packet<component_id>(ENCODER_BASIC_ID, send_data);
         }
 
         void send_encoder_info_data() { send_encoder_info_data(encoder_info); }
         void send_encoder_info_data(const encoder_info_t &send_data)
         {
-            link_base.send_packet<component_id>(ENCODER_INFO_ID, send_data);
+            link_base.template send_packet<component_id>(ENCODER_INFO_ID, send_data);
         }
 
         void send_encoder_setting_data() { send_encoder_setting_data(encoder_setting); }
         void send_encoder_setting_data(const encoder_setting_t &send_data)
         {
-            link_base.send_packet<component_id>(ENCODER_SETTING_ID, send_data);
+            link_base.template send_packet<component_id>(ENCODER_SETTING_ID, send_data);
         }
+
+        // 发布周期（ms），0 表示不发布；供 Publish_scheduler_t 使用（见 add_encoder_basic_stream()）
+        uint32_t feedback_interval() const { return encoder_setting.feedback_interval; }
+
+        // 死区发布：任一编码器越过死区（或 force）时发送整帧 encoder_basic
+        Publish_result publish_encoder_basic(const basic_deadband_t &deadband = {}, bool force = false)
+        {
+            if (!force && encoder_basic_publish_valid && !encoder_basic_moved(deadband))
+                return Publish_result::SUPPRESSED;
+
+            if (link_base.build_send_data(component_id, ENCODER_BASIC_ID, reinterpret_cast<const uint8_t *>(encoder_basic),
+                                          sizeof(encoder_basic)) == 0)
+                return Publish_result::BLOCKED;
+
+            std::memcpy(encoder_basic_published, encoder_basic, sizeof(encoder_basic));
+            encoder_basic_publish_valid = true;
+            return Publish_result::SENT;
+        }
+
+        bool encoder_basic_moved(const basic_deadband_t &deadband) const
+        {
+            for (uint16_t i = 0; i < MAX_ENCODERS; ++i)
+            {
+                const encoder_basic_t &now = encoder_basic[i];
+                const encoder_basic_t &last = encoder_basic_published[i];
+                const int32_t position = static_cast<int16_t>(static_cast<uint16_t>(now.position - last.position));
+                const int64_t velocity = static_cast<int64_t>(now.velocity) - last.velocity;
+                if (now.error_code != last.error_code || (position < 0 ? -position : position) > deadband.position ||
+                    (velocity < 0 ? -velocity : velocity) > deadband.velocity)
+                    return true;
+            }
+            return false;
+        }
+
+    public:
+        // 编译期路由表（与 build_handle_data_matrix() 等价），供 Unify_link_static 使用
+        using static_routes = std::tuple<static_data_route<ENCODER_BASIC_ID, &Encoder_link_basic_t::encoder_basic>,
+                                         static_data_route<ENCODER_INFO_ID, &Encoder_link_basic_t::encoder_info>,
+                                         static_data_route<ENCODER_SETTING_ID, &Encoder_link_basic_t::encoder_setting>>;
     };
+
+    using Encoder_link_t = Encoder_link_basic_t<Unify_link_base>;
 } // namespace unify_link
 
 #endif
\ No newline at end of file
@@ -4,7 +4,9 @@
 #ifndef __MOTOR_LINK_HPP__
 #define __MOTOR_LINK_HPP__
 
+#include "publish_scheduler.hpp"
 #include "unify_link.hpp"
+#include "unify_link_static.hpp"
 
 #include "unify_link_def.h"
 
@@ -12,9 +14,9 @@
 
 namespace unify_link
 {
-    class Motor_link_t
+    // 协议定义（与链路尺寸无关）：不同尺寸链路上的 Motor_link_basic_t 共享同一组载荷类型
+    struct Motor_link_def_t
     {
-    public:
         enum class ErrorCode : uint8_t
         {
             OK = 0,
@@ -87,16 +89,66 @@ namespace unify_link
             PIDParams_t position_pid;
         } pid_t;
 
+        // 增量帧：载荷为 [changed_mask(1) | 变化的条目（按电机序号升序）]，
+        // 未变化的条目沿用接收端的上一次重建值；全量帧（MOTOR_BASIC_ID / MOTOR_SET_ID）作为关键帧
+        constexpr static uint8_t MOTOR_BASIC_DELTA_ID = 6;
+        constexpr static uint8_t MOTOR_SET_DELTA_ID = 7;
+
 #pragma pack(pop)
 
         // Maximum number of motors
         constexpr static uint8_t MAX_MOTORS = 8;
-        feedback_t motor_basic[MAX_MOTORS];
+        static_assert(MAX_MOTORS <= 8, "delta encoding uses an 8-bit changed mask");
+        constexpr static uint8_t component_id = COMPONENT_ID_MOTORS; // 组件ID
+    };
+
+    template <typename Link>
+    class Motor_link_basic_t : public Motor_link_def_t
+    {
+    public:
+        using link_type = Link;
+
+        // 发送端影子副本：记录对端当前持有的值，用于计算增量
+        template <typename T>
+        struct delta_tx_t
+        {
+            T shadow[MAX_MOTORS] = {};
+            uint16_t since_keyframe = 0;
+            bool keyed = false; // 是否已发送过关键帧
+        };
+
+        // 接收端同步状态：序号检查发现丢帧后增量不再可信，直到收到下一个关键帧
+        struct delta_rx_t
+        {
+            bool synced = false;
+            uint64_t com_errors = 0; // 上次同步时链路的 com_error_count
+        };
+
+        feedback_t motor_basic[MAX_MOTORS] = {};
         info_t motor_info[MAX_MOTORS];
-        settings_t motor_settings[MAX_MOTORS];
+        settings_t motor_settings[MAX_MOTORS] = {};
         set_t motor_set[MAX_MOTORS];
         pid_t motor_pid;
 
+        // 增量模式：每 keyframe_interval 次发送插入一次全量关键帧
+        uint16_t keyframe_interval = 100;
+        delta_tx_t<feedback_t> basic_delta_tx;
+        delta_tx_t<set_t> set_delta_tx;
+        delta_rx_t basic_delta_rx;
+        delta_rx_t set_delta_rx;
+
+        // 发布死区：位置（按 16 位回绕计）、速度、电流的变化量都不超过阈值，且温度与错误码不变时不重发
+        struct basic_deadband_t
+        {
+            uint16_t position = 0;
+            uint16_t speed = 0;
+            uint16_t current = 0;
+        };
+
+        // 最近一次经 publish_motor_basic() 发出的值
+        feedback_t motor_basic_published[MAX_MOTORS] = {};
+        bool motor_basic_publish_valid = false;
+
     public:
         std::function<void(const feedback_t (&)[MAX_MOTORS])> on_motor_basic_updated;
         std::function<void(const info_t &)> on_motor_info_updated;
@@ -104,49 +156,49 @@ namespace unify_link
         std::function<void(const set_t (&)[MAX_MOTORS])> on_motor_set_updated;
         std::function<void(const pid_t &)> on_motor_pid_updated;
 
-        Unify_link_base &link_base;
-        constexpr static uint8_t component_id = COMPONENT_ID_MOTORS; // 组件ID
+        Link &link_base;
+        // 全部 ID 已写入链路分发表；为 false 时分发表已满（见 UNIFY_LINK_MAX_HANDLERS），组件收不到未注册的帧
+        bool registered = false;
 
-        Motor_link_t(Unify_link_base &link_base) : link_base(link_base) { build_handle_data_matrix(); }
-        ~Motor_link_t() {};
+        Motor_link_basic_t(Link &link_base) : link_base(link_base) { registered = build_handle_data_matrix(); }
+        // 编译期注册：由 Unify_link_static 构造，不写入运行时分发表
+        explicit Motor_link_basic_t(static_registration_t<Link> reg) : link_base(reg.link_base), registered(true) {}
+        ~Motor_link_basic_t() {};
 
-        void build_handle_data_matrix()
+        bool build_handle_data_matrix()
         {
             // 注册数据处理函数
-            link_base.register_handle_data(
+            bool ok = true;
+            ok &= link_base.register_handle_data(
                 component_id, MOTOR_BASIC_ID, &motor_basic,
                 [this](const uint8_t *data, uint16_t len) { return this->handle_motor_basic(data, len); },
                 sizeof(motor_basic));
 
-            link_base.register_handle_data(
+            ok &= link_base.register_handle_data(
                 component_id, MOTOR_INFO_ID, nullptr, [this](const uint8_t *data, uint16_t len)
                 { return this->handle_motor_info(data, len); }, sizeof(info_t));
 
-            link_base.register_handle_data(
+            ok &= link_base.register_handle_data(
                 component_id, MOTOR_SETTING_ID, nullptr, [this](const uint8_t *data, uint16_t len)
                 { return this->handle_motor_settings(data, len); }, sizeof(settings_t));
 
-            link_base.register_handle_data(
+            ok &= link_base.register_handle_data(
                 component_id, MOTOR_SET_ID, nullptr,
-                [this](const uint8_t *data, uint16_t len)
-                {
-                    if (len != sizeof(motor_set))
-                    {
-                        return false;
-                    }
-
-                    std::memcpy(motor_set, data, sizeof(motor_set));
-                    if (on_motor_set_updated)
-                    {
-                        on_motor_set_updated(motor_set);
-                    }
-                    return true;
-                },
+                [this](const uint8_t *data, uint16_t len) { return this->handle_motor_set(data, len); },
                 sizeof(motor_set));
 
-            link_base.register_handle_data(
+            ok &= link_base.register_handle_data(
                 component_id, MOTOR_PID_ID, &motor_pid,
                 [this](const uint8_t *data, uint16_t len) { return this->handle_motor_pid(data, len); }, sizeof(pid_t));
+
+            ok &= link_base.register_handle_data(
+                component_id, MOTOR_BASIC_DELTA_ID, nullptr,
+                [this](const uint8_t *data, uint16_t len) { return this->handle_motor_basic_delta(data, len); }, 0xFFFF);
+
+            ok &= link_base.register_handle_data(
+                component_id, MOTOR_SET_DELTA_ID, nullptr,
+                [this](const uint8_t *data, uint16_t len) { return this->handle_motor_set_delta(data, len); }, 0xFFFF);
+            return ok;
         }
 
     public:
@@ -177,6 +229,7 @@ namespace unify_link
             (void)len;
             (void)data;
 
+            mark_delta_synced(basic_delta_rx); // 全量帧即关键帧
             if (on_motor_basic_updated)
                 on_motor_basic_updated(motor_basic);
             return true;
@@ -192,6 +245,80 @@ namespace unify_link
             return handle_motor_payload(data, len, motor_settings, on_motor_settings_updated);
         }
 
+        bool handle_motor_set(const uint8_t *data, uint16_t len)
+        {
+            if (len != sizeof(motor_set))
+            {
+                return false;
+            }
+
+            std::memcpy(motor_set, data, sizeof(motor_set));
+            mark_delta_synced(set_delta_rx); // 全量帧即关键帧
+            if (on_motor_set_updated)
+            {
+                on_motor_set_updated(motor_set);
+            }
+            return true;
+        }
+
+        bool handle_motor_basic_delta(const uint8_t *data, uint16_t len)
+        {
+            if (!apply_delta(data, len, motor_basic, basic_delta_rx))
+                return false;
+
+            if (on_motor_basic_updated)
+                on_motor_basic_updated(motor_basic);
+            return true;
+        }
+
+        bool handle_motor_set_delta(const uint8_t *data, uint16_t len)
+        {
+            if (!apply_delta(data, len, motor_set, set_delta_rx))
+                return false;
+
+            if (on_motor_set_updated)
+                on_motor_set_updated(motor_set);
+            return true;
+        }
+
+        void mark_delta_synced(delta_rx_t &rx)
+        {
+            rx.synced = true;
+            rx.com_errors = link_base.com_error_count();
+        }
+
+        // 在 target 上重建增量帧；未同步或自上次同步以来检测到丢帧时拒绝，等待关键帧
+        template <typename T>
+        bool apply_delta(const uint8_t *data, uint16_t len, T (&target)[MAX_MOTORS], delta_rx_t &rx)
+        {
+            if (!rx.synced || link_base.com_error_count() != rx.com_errors)
+            {
+                rx.synced = false;
+                return false;
+            }
+
+            if (len < 1)
+                return false;
+
+            const uint8_t mask = data[0];
+            uint16_t count = 0;
+            for (uint8_t i = 0; i < MAX_MOTORS; ++i)
+                count = static_cast<uint16_t>(count + ((mask >> i) & 1u));
+            if (len != 1 + count * sizeof(T))
+                return false;
+
+            const uint8_t *entry = data + 1;
+            for (uint8_t i = 0; i < MAX_MOTORS; ++i)
+            {
+                if (mask & (1u << i))
+                {
+                    std::memcpy(&target[i], entry, sizeof(T));
+                    entry += sizeof(T);
+                }
+            }
+            return true;
+        }
+
         bool handle_motor_pid(const uint8_t *data, uint16_t len)
         {
             // already copied by unify_link_base
@@ -208,7 +335,48 @@ namespace unify_link
         void send_motor_basic_data() { send_motor_basic_data(motor_basic); }
         void send_motor_basic_data(const feedback_t (&send_data)[MAX_MOTORS])
         {
-            link_base.send_packet<component_id>(MOTOR_BASIC_ID, send_data);
+            link_base.template send_packet<component_id>(MOTOR_BASIC_ID, send_data);
+        }
+
+        // 发布周期（ms）：各电机 settings_t::feedback_interval 中最小的非 0 值，全部为 0 表示不发布
+        uint32_t feedback_interval() const
+        {
+            uint32_t interval = 0;
+            for (const settings_t &s : motor_settings)
+                if (s.feedback_interval != 0 && (interval == 0 || s.feedback_interval < interval))
+                    interval = s.feedback_interval;
+            return interval;
+        }
+
+        // 死区发布：任一电机越过死区（或 force）时发送整帧 motor_basic（见 add_motor_basic_stream()）
+        Publish_result publish_motor_basic(const basic_deadband_t &deadband = {}, bool force = false)
+        {
+            if (!force && motor_basic_publish_valid && !motor_basic_moved(deadband))
+                return Publish_result::SUPPRESSED;
+
+            if (link_base.build_send_data(component_id, MOTOR_BASIC_ID, reinterpret_cast<const uint8_t *>(motor_basic),
+                                          sizeof(motor_basic)) == 0)
+                return Publish_result::BLOCKED;
+
+            std::memcpy(motor_basic_published, motor_basic, sizeof(motor_basic));
+            motor_basic_publish_valid = true;
+            return Publish_result::SENT;
+        }
+
+        bool motor_basic_moved(const basic_deadband_t &deadband) const
+        {
+            auto exceeds = [](int32_t delta, uint16_t limit) { return (delta < 0 ? -delta : delta) > limit; };
+            for (uint8_t i = 0; i < MAX_MOTORS; ++i)
+            {
+                const feedback_t &now = motor_basic[i];
+                const feedback_t &last = motor_basic_published[i];
+                if (now.error_code != last.error_code || now.temperature != last.temperature ||
+                    exceeds(static_cast<int16_t>(static_cast<uint16_t>(now.position - last.position)), deadband.position) ||
+                    exceeds(static_cast<int32_t>(now.speed) - last.speed, deadband.speed) ||
+                    exceeds(static_cast<int32_t>(now.current) - last.current, deadband.current))
+                    return true;
+            }
+            return false;
         }
 
         void send_motor_info_data(uint8_t motor_id)
@@ -220,7 +388,7 @@ namespace unify_link
         }
         void send_motor_info_data(const info_t &send_data)
         {
-            link_base.send_packet<component_id>(MOTOR_INFO_ID, send_data);
+            link_base.template send_packet<component_id>(MOTOR_INFO_ID, send_data);
         }
 
         void send_motor_setting_data(uint8_t motor_id)
@@ -232,13 +400,95 @@ namespace unify_link
         }
         void send_motor_setting_data(const settings_t &send_data)
         {
-            link_base.send_packet<component_id>(MOTOR_SETTING_ID, send_data);
+            link_base.template send_packet<component_id>(MOTOR_SETTING_ID, send_data);
+        }
+
+        // 配置类消息（设置、PID）走链路可靠模式：对端确认前超时重传，无需在应用层循环重发
+        // 需要链路启用可靠发送（UNIFY_LINK_RELIABLE_STORE > 0），否则返回 false
+        bool set_reliable_config(bool enable = true)
+        {
+            return link_base.set_reliable(component_id, MOTOR_SETTING_ID, enable) &&
+                   link_base.set_reliable(component_id, MOTOR_PID_ID, enable);
         }
 
         void send_motor_set_data() { send_motor_set_data(motor_set); }
         void send_motor_set_data(const set_t (&send_data)[MAX_MOTORS])
         {
-            link_base.send_packet<component_id>(MOTOR_SET_ID, send_data);
+            // 逐项直接序列化进发送缓冲区
+            auto frame = link_base.begin_send_frame(component_id, MOTOR_SET_ID, sizeof(send_data));
+            if (!frame.valid())
+                return;
+
+            for (const auto &entry : send_data)
+                frame.put(entry);
+            link_base.commit_send_frame(frame);
+        }
+
+        // 增量发送：只发送与对端影子副本不同的条目；首次发送及每 keyframe_interval 次发送一个全量关键帧，
+        // 全部未变化时不发送。1kHz 控制环下通常只有少数电机的设定值在变化
+        void send_motor_basic_delta() { send_motor_basic_delta(motor_basic); }
+        void send_motor_basic_delta(const feedback_t (&send_data)[MAX_MOTORS])
+        {
+            send_delta(MOTOR_BASIC_ID, MOTOR_BASIC_DELTA_ID, send_data, basic_delta_tx);
+        }
+
+        void send_motor_set_delta() { send_motor_set_delta(motor_set); }
+        void send_motor_set_delta(const set_t (&send_data)[MAX_MOTORS])
+        {
+            send_delta(MOTOR_SET_ID, MOTOR_SET_DELTA_ID, send_data, set_delta_tx);
+        }
+
+        // 下一次增量发送强制为关键帧（例如对端重启后）
+        void request_keyframe()
+        {
+            basic_delta_tx.keyed = false;
+            set_delta_tx.keyed = false;
+        }
+
+        template <typename T>
+        void send_delta(uint8_t full_id, uint8_t delta_id, const T (&send_data)[MAX_MOTORS], delta_tx_t<T> &tx)
+        {
+            if (!tx.keyed || tx.since_keyframe >= keyframe_interval)
+            {
+                if (link_base.build_send_data(component_id, full_id, reinterpret_cast<const uint8_t *>(send_data),
+                                              sizeof(send_data)) == 0)
+                    return; // 发送缓冲区已满，下次重试
+
+                std::memcpy(tx.shadow, send_data, sizeof(send_data));
+                tx.since_keyframe = 0;
+                tx.keyed = true;
+                return;
+            }
+
+            tx.since_keyframe++;
+
+            uint8_t mask = 0;
+            uint16_t count = 0;
+            for (uint8_t i = 0; i < MAX_MOTORS; ++i)
+            {
+                if (std::memcmp(&send_data[i], &tx.shadow[i], sizeof(T)) != 0)
+                {
+                    mask = static_cast<uint8_t>(mask | (1u << i));
+                    count++;
+                }
+            }
+            if (mask == 0)
+                return; // 无变化
+
+            auto frame = link_base.begin_send_frame(component_id, delta_id, static_cast<uint16_t>(1 + count * sizeof(T)));
+            if (!frame.valid())
+                return; // 影子副本保持不变，下次重发这些条目
+
+            frame.put(mask);
+            for (uint8_t i = 0; i < MAX_MOTORS; ++i)
+            {
+                if (mask & (1u << i))
+                {
+                    frame.put(send_data[i]);
+                    tx.shadow[i] = send_data[i];
+                }
+            }
+            link_base.commit_send_frame(frame);
         }
 
         bool set_motor_mode(uint8_t motor_id, MotorMode mode)
@@ -306,7 +556,22 @@ namespace unify_link
             motor_set[motor_id].set_extra2 = current;
             return true;
         }
+
+    public:
+        // 编译期路由表（与 build_handle_data_matrix() 等价），供 Unify_link_static 使用
+        using static_routes =
+            std::tuple<static_data_route<MOTOR_BASIC_ID, &Motor_link_basic_t::motor_basic, &Motor_link_basic_t::handle_motor_basic>,
+                       static_callback_route<MOTOR_INFO_ID, info_t, &Motor_link_basic_t::handle_motor_info>,
+                       static_callback_route<MOTOR_SETTING_ID, settings_t, &Motor_link_basic_t::handle_motor_settings>,
+                       static_callback_route<MOTOR_SET_ID, set_t[MAX_MOTORS], &Motor_link_basic_t::handle_motor_set>,
+                       static_data_route<MOTOR_PID_ID, &Motor_link_basic_t::motor_pid, &Motor_link_basic_t::handle_motor_pid>,
+                       static_variable_route<MOTOR_BASIC_DELTA_ID, uint8_t[1 + sizeof(feedback_t) * MAX_MOTORS],
+                                             &Motor_link_basic_t::handle_motor_basic_delta>,
+                       static_variable_route<MOTOR_SET_DELTA_ID, uint8_t[1 + sizeof(set_t) * MAX_MOTORS],
+                                             &Motor_link_basic_t::handle_motor_set_delta>>;
     };
+
+    using Motor_link_t = Motor_link_basic_t<Unify_link_base>;
 } // namespace unify_link
 
 #endif
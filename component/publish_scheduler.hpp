@@ -0,0 +1,191 @@
+#pragma once
+
+#ifndef __PUBLISH_SCHEDULER_HPP__
+#define __PUBLISH_SCHEDULER_HPP__
+
+#include "unify_link_def.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+
+namespace unify_link
+{
+    // 一次发布尝试的结果：SUPPRESSED 表示数据未越过死区、本周期不发送；BLOCKED 表示发送缓冲区已满，下次 poll() 重试
+    enum class Publish_result : uint8_t
+    {
+        SENT,
+        SUPPRESSED,
+        BLOCKED,
+    };
+
+    // 遥测发布调度：每条流按各自的周期（例如组件设置中的 feedback_interval）在 poll() 中发布。
+    //   - 周期到期时调用流的发布函数，发布函数自行做死区判断（force 为 true 时必须发送，用于心跳）
+    //   - 新流的首次发布时刻按 stagger 错开，之后按“上次到期时刻 + 周期”推进，相位保持不变，不会对齐到同一 tick
+    //   - 周期为 0 表示暂停该流
+    // 在发送上下文（主循环或发送任务）中调用 poll()，不分配内存（发布函数的捕获应能放入 std::function 的小对象缓冲区）
+    template <uint8_t MaxStreams = 8>
+    class Publish_scheduler_t
+    {
+    public:
+        using publish_fn_t = std::function<Publish_result(bool force)>;
+        using interval_fn_t = std::function<uint32_t()>;
+
+        struct stream_stats_t
+        {
+            uint32_t sent = 0;
+            uint32_t suppressed = 0;
+            uint32_t blocked = 0;
+        };
+
+        // clock：单调时钟（HAL_GetTick() 等）；为 nullptr 时只能使用 poll(now)。
+        // stagger：相邻两条流首次发布的错开量（时钟单位）
+        explicit Publish_scheduler_t(clock_fn_t clock = nullptr, uint32_t stagger = 1) : clock(clock), stagger(stagger) {}
+
+        // 固定周期；max_silence 非 0 时，连续被死区抑制达到该时长后强制发送一次（心跳）。返回流编号，表满返回 -1
+        int add_stream(publish_fn_t publish, uint32_t interval, uint32_t max_silence = 0)
+        {
+            return _add(std::move(publish), interval, nullptr, max_silence);
+        }
+
+        // 周期在每次 poll() 时重新读取，例如绑定到对端可修改的 feedback_interval 设置
+        int add_stream(publish_fn_t publish, interval_fn_t interval, uint32_t max_silence = 0)
+        {
+            return _add(std::move(publish), 0, std::move(interval), max_silence);
+        }
+
+        bool set_interval(int id, uint32_t interval)
+        {
+            if (id < 0 || id >= count)
+                return false;
+            streams[id].interval = interval;
+            streams[id].interval_fn = nullptr;
+            return true;
+        }
+
+        void poll()
+        {
+            if (clock != nullptr)
+                poll(clock());
+        }
+
+        // 由外部 tick 驱动（例如定时器中断中计数的毫秒）
+        void poll(uint32_t now)
+        {
+            for (uint8_t i = 0; i < count; ++i)
+            {
+                stream_t &s = streams[i];
+                const uint32_t interval = s.interval_fn ? s.interval_fn() : s.interval;
+                if (interval == 0)
+                {
+                    s.started = false; // 恢复后重新按相位错开
+                    continue;
+                }
+                if (!s.started)
+                {
+                    s.next_due = now + (i * stagger) % interval;
+                    s.last_sent = now;
+                    s.started = true;
+                }
+                if (static_cast<int32_t>(now - s.next_due) < 0)
+                    continue;
+
+                const bool force = s.max_silence != 0 && now - s.last_sent >= s.max_silence;
+                const Publish_result result = s.publish(force);
+                if (result == Publish_result::BLOCKED)
+                {
+                    s.stats.blocked++;
+                    continue; // 不推进到期时刻，下次 poll() 重试
+                }
+
+                if (result == Publish_result::SENT)
+                {
+                    s.stats.sent++;
+                    s.last_sent = now;
+                }
+                else
+                {
+                    s.stats.suppressed++;
+                }
+
+                // 保持相位；落后超过一个周期（长时间未 poll 或周期变短）时从当前时刻重新对齐，不补发
+                s.next_due += interval;
+                if (static_cast<int32_t>(now - s.next_due) >= 0)
+                    s.next_due = now + interval;
+            }
+        }
+
+        // 距离最近一条流到期的时钟单位数（可用于计算休眠时长）；没有活动的流时返回 UINT32_MAX
+        uint32_t time_to_next(uint32_t now) const
+        {
+            uint32_t best = UINT32_MAX;
+            for (uint8_t i = 0; i < count; ++i)
+            {
+                const stream_t &s = streams[i];
+                if ((s.interval_fn ? s.interval_fn() : s.interval) == 0)
+                    continue;
+                if (!s.started)
+                    return 0;
+                const int32_t left = static_cast<int32_t>(s.next_due - now);
+                best = std::min<uint32_t>(best, left > 0 ? static_cast<uint32_t>(left) : 0);
+            }
+            return best;
+        }
+
+        const stream_stats_t *stats(int id) const { return id >= 0 && id < count ? &streams[id].stats : nullptr; }
+        uint8_t stream_count() const { return count; }
+        static constexpr uint8_t capacity() { return MaxStreams; }
+
+    private:
+        struct stream_t
+        {
+            publish_fn_t publish;
+            interval_fn_t interval_fn;
+            uint32_t interval = 0;
+            uint32_t max_silence = 0;
+            uint32_t next_due = 0;
+            uint32_t last_sent = 0;
+            bool started = false;
+            stream_stats_t stats;
+        };
+
+        int _add(publish_fn_t publish, uint32_t interval, interval_fn_t interval_fn, uint32_t max_silence)
+        {
+            if (count >= MaxStreams || !publish)
+                return -1;
+            stream_t &s = streams[count];
+            s.publish = std::move(publish);
+            s.interval = interval;
+            s.interval_fn = std::move(interval_fn);
+            s.max_silence = max_silence;
+            return count++;
+        }
+
+        clock_fn_t clock;
+        uint32_t stagger;
+        stream_t streams[MaxStreams];
+        uint8_t count = 0;
+    };
+
+    using Publish_scheduler = Publish_scheduler_t<>;
+
+    // 组件遥测流：以组件自身的 feedback_interval 为周期、以组件的死区判断决定是否发送
+    template <typename Scheduler, typename Encoder>
+    int add_encoder_basic_stream(Scheduler &scheduler, Encoder &encoder,
+                                 const typename Encoder::basic_deadband_t &deadband = {}, uint32_t max_silence = 0)
+    {
+        return scheduler.add_stream([&encoder, deadband](bool force)
+                                    { return encoder.publish_encoder_basic(deadband, force); },
+                                    [&encoder]() { return encoder.feedback_interval(); }, max_silence);
+    }
+
+    template <typename Scheduler, typename Motor>
+    int add_motor_basic_stream(Scheduler &scheduler, Motor &motor,
+                               const typename Motor::basic_deadband_t &deadband = {}, uint32_t max_silence = 0)
+    {
+        return scheduler.add_stream([&motor, deadband](bool force) { return motor.publish_motor_basic(deadband, force); },
+                                    [&motor]() { return motor.feedback_interval(); }, max_silence);
+    }
+} // namespace unify_link
+
+#endif
@@ -2,16 +2,37 @@
 #define __UPDATE_LINK_HPP__
 
 #include "unify_link.hpp"
+#include "unify_link_static.hpp"
+
+#include <functional>
 
 namespace unify_link
 {
-    class Update_Link_t
+    // 协议定义（与链路尺寸无关）：不同尺寸链路上的 Update_Link_basic_t 共享同一组载荷类型
+    struct Update_Link_def_t
     {
-    public:
         // 消息ID定义
         constexpr static uint8_t FIRMWARE_INFO_ID = 1;
         constexpr static uint8_t FIRMWARE_CRC_ID = 2;
 
+        // 流式传输：BEGIN 开始 → 按偏移寻址的 CHUNK 在滑动窗口内连续发送 → 接收端以 ACK 回报窗口位图
+        constexpr static uint8_t FIRMWARE_BEGIN_ID = 3;
+        constexpr static uint8_t FIRMWARE_CHUNK_ID = 4;
+        constexpr static uint8_t FIRMWARE_ACK_ID = 5;
+
+        constexpr static uint8_t FIRMWARE_WINDOW = 32; // 滑动窗口（分块数），与 32bit 位图对应
+
+        enum class FirmwareStatus : uint8_t
+        {
+            IDLE = 0,
+            BUSY = 1,        // 传输中
+            DONE = 2,        // 全部接收且整镜像 CRC 一致
+            CRC_ERROR = 3,   // 全部接收但 CRC 不一致
+            WRITE_ERROR = 4, // 接收端写入失败（on_firmware_chunk 返回 false）
+            REJECTED = 5,    // 接收端拒绝（参数非法或 on_firmware_begin 返回 false）
+            TIMEOUT = 6      // 发送端连续 fw_max_retries 次超时无进展（接收端无响应）
+        };
+
 #pragma pack(push, 1)
         typedef struct
         {
@@ -22,34 +43,443 @@ namespace unify_link
         {
             uint16_t crc16;
         } firmware_crc_t;
+
+        typedef struct
+        {
+            uint32_t total_size;  // 镜像总长度
+            uint16_t chunk_size;  // 分块长度（最后一块可以更短）
+            uint16_t image_crc16; // 整镜像 CRC-16/MODBUS
+        } firmware_begin_t;
+
+        // CHUNK 载荷：firmware_chunk_head_t + 分块数据
+        typedef struct
+        {
+            uint32_t offset; // 分块在镜像中的偏移（chunk_size 的整数倍）
+        } firmware_chunk_head_t;
+
+        typedef struct
+        {
+            uint32_t base_offset;   // 此偏移之前的数据已全部按序接收
+            uint32_t ack_bitmap;    // bit i：base 之后第 i 个分块已接收
+            uint32_t nack_bitmap;   // bit i：第 i 个分块在已接收的更后分块之前缺失（判定丢失，请求重传）
+            uint16_t running_crc;   // [0, base_offset) 的 CRC
+            FirmwareStatus status;
+        } firmware_ack_t;
 #pragma pack(pop)
 
+        constexpr static uint8_t component_id = COMPONENT_ID_UPDATE;
+    };
+
+    template <typename Link>
+    class Update_Link_basic_t : public Update_Link_def_t
+    {
+    public:
+        using link_type = Link;
+
+        // 默认分块长度：占满一帧载荷
+        constexpr static uint16_t FIRMWARE_MAX_CHUNK =
+            static_cast<uint16_t>(Link::max_payload_length - sizeof(firmware_chunk_head_t));
+
         firmware_info_t firmware_info;
         firmware_crc_t firmware_crc;
 
-        Unify_link_base &link_base;
+        // 接收端（设备）：写入 Flash 等，返回 false 时中止传输
+        std::function<bool(uint32_t total_size)> on_firmware_begin;
+        std::function<bool(uint32_t offset, const uint8_t *data, uint16_t len)> on_firmware_chunk;
+        std::function<void(FirmwareStatus)> on_firmware_received;
+        // 发送端（主机）：传输结束（成功或失败）
+        std::function<void(FirmwareStatus)> on_firmware_sent;
 
-        constexpr static uint8_t component_id = COMPONENT_ID_UPDATE;
+        uint16_t fw_ack_every = 4;            // 接收端每收到 N 个分块回一次 ACK（乱序/完成时立即回）
+        uint32_t fw_retransmit_timeout = 200; // 发送端无进展超时（链路时钟单位，见 set_clock）
+        uint8_t fw_max_retries = 10;          // 连续超时次数上限，超过后以 TIMEOUT 结束发送
+
+        // 接收端状态
+        struct fw_rx_state_t
+        {
+            FirmwareStatus status = FirmwareStatus::IDLE;
+            uint32_t total_size = 0;
+            uint16_t chunk_size = 0;
+            uint16_t image_crc = 0;
+            uint32_t base_offset = 0;
+            uint32_t ack_bits = 0;
+            uint16_t running_crc = 0xFFFF;
+            uint16_t since_ack = 0;
+            uint16_t slot_crc[FIRMWARE_WINDOW] = {}; // 乱序到达分块的 CRC（初值 0），按序并入 running_crc
+        } fw_rx;
+
+        // 发送端状态（位图均相对 base_offset 所在分块）
+        struct fw_tx_state_t
+        {
+            FirmwareStatus status = FirmwareStatus::IDLE;
+            const uint8_t *image = nullptr;
+            uint32_t total_size = 0;
+            uint16_t chunk_size = 0;
+            uint16_t image_crc = 0;
+            uint32_t base_offset = 0;
+            uint32_t next_offset = 0; // 下一个从未发送过的分块
+            uint32_t acked_bits = 0;
+            uint32_t resend_bits = 0; // 待重传
+            uint32_t resent_bits = 0; // 本轮已重传，重复的 NACK 不再触发
+            uint32_t last_progress = 0;
+            bool begin_pending = false;
+            uint8_t timeouts = 0; // 自上次进展以来的连续超时次数
+            uint32_t retransmit_count = 0;
+        } fw_tx;
+
+        Link &link_base;
+        // 全部 ID 已写入链路分发表；为 false 时分发表已满（见 UNIFY_LINK_MAX_HANDLERS），组件收不到未注册的帧
+        bool registered = false;
 
-        Update_Link_t(Unify_link_base &link_base) : link_base(link_base) { build_handle_data_matrix(); }
-        ~Update_Link_t() {}
+        Update_Link_basic_t(Link &link_base) : link_base(link_base) { registered = build_handle_data_matrix(); }
+        // 编译期注册：由 Unify_link_static 构造，不写入运行时分发表
+        explicit Update_Link_basic_t(static_registration_t<Link> reg) : link_base(reg.link_base), registered(true) {}
+        ~Update_Link_basic_t() {}
 
-        void build_handle_data_matrix()
+        bool build_handle_data_matrix()
         {
-            link_base.register_handle_data(component_id, FIRMWARE_INFO_ID, &firmware_info, nullptr,
-                                           sizeof(firmware_info));
-            link_base.register_handle_data(component_id, FIRMWARE_CRC_ID, &firmware_crc, nullptr, sizeof(firmware_crc));
+            bool ok = true;
+            ok &= link_base.register_handle_data(component_id, FIRMWARE_INFO_ID, &firmware_info, nullptr,
+                                                 sizeof(firmware_info));
+            ok &= link_base.register_handle_data(component_id, FIRMWARE_CRC_ID, &firmware_crc, nullptr, sizeof(firmware_crc));
+
+            ok &= link_base.register_handle_data(
+                component_id, FIRMWARE_BEGIN_ID, nullptr, [this](const uint8_t *data, uint16_t len)
+                { return this->handle_firmware_begin(data, len); }, sizeof(firmware_begin_t));
+            ok &= link_base.register_handle_data(
+                component_id, FIRMWARE_CHUNK_ID, nullptr, [this](const uint8_t *data, uint16_t len)
+                { return this->handle_firmware_chunk(data, len); }, 0xFFFF);
+            ok &= link_base.register_handle_data(
+                component_id, FIRMWARE_ACK_ID, nullptr,
+                [this](const uint8_t *data, uint16_t len) { return this->handle_firmware_ack(data, len); },
+                sizeof(firmware_ack_t));
+            return ok;
         }
 
         void send_firmware_info() { send_firmware_info(firmware_info); }
         void send_firmware_info(const firmware_info_t &info)
         {
-            link_base.send_packet<component_id>(FIRMWARE_INFO_ID, info);
+            link_base.template send_packet<component_id>(FIRMWARE_INFO_ID, info);
         }
 
         void send_firmware_crc() { send_firmware_crc(firmware_crc); }
-        void send_firmware_crc(const firmware_crc_t &crc) { link_base.send_packet<component_id>(FIRMWARE_CRC_ID, crc); }
+        void send_firmware_crc(const firmware_crc_t &crc)
+        {
+            link_base.template send_packet<component_id>(FIRMWARE_CRC_ID, crc);
+        }
+
+        // ================= 发送端 =================
+
+        // 开始流式发送 image[0..size)（传输结束前 image 必须保持有效）；chunk_size = 0 时占满一帧载荷
+        bool start_firmware_transfer(const uint8_t *image, uint32_t size, uint16_t chunk_size = 0)
+        {
+            if (image == nullptr || size == 0 || chunk_size > FIRMWARE_MAX_CHUNK)
+                return false;
+
+            fw_tx = fw_tx_state_t{};
+            fw_tx.status = FirmwareStatus::BUSY;
+            fw_tx.image = image;
+            fw_tx.total_size = size;
+            fw_tx.chunk_size = chunk_size != 0 ? chunk_size : FIRMWARE_MAX_CHUNK;
+            fw_tx.image_crc = image_crc16(image, size);
+            fw_tx.begin_pending = true;
+            send_firmware_begin();
+            return true;
+        }
+
+        // 周期调用：先重传 NACK 的分块，再在窗口内发送新分块，直到发送缓冲区写满；无进展超时时重传窗口首块
+        void firmware_transfer_task()
+        {
+            if (fw_tx.status != FirmwareStatus::BUSY)
+                return;
+
+            const uint32_t now = link_base.now();
+            const bool timed_out = now - fw_tx.last_progress >= fw_retransmit_timeout;
+            if (timed_out && fw_tx.timeouts++ >= fw_max_retries)
+            {
+                finish_firmware_send(FirmwareStatus::TIMEOUT);
+                return;
+            }
+
+            if (fw_tx.begin_pending)
+            {
+                if (timed_out)
+                    send_firmware_begin();
+                return;
+            }
+
+            if (timed_out)
+            {
+                fw_tx.resend_bits |= 1u; // 尾部丢失或 ACK 丢失：重传窗口首块，接收端会回 ACK
+                fw_tx.resent_bits = 0;
+                fw_tx.last_progress = now;
+            }
+
+            const uint32_t base_index = fw_tx.base_offset / fw_tx.chunk_size;
+            while (fw_tx.resend_bits != 0)
+            {
+                uint8_t i = 0;
+                while (((fw_tx.resend_bits >> i) & 1u) == 0)
+                    ++i;
+
+                if (!send_firmware_chunk(base_index + i))
+                    return;
+                fw_tx.resend_bits &= ~(1u << i);
+                fw_tx.resent_bits |= 1u << i;
+                fw_tx.retransmit_count++;
+            }
+
+            while (fw_tx.next_offset < fw_tx.total_size)
+            {
+                const uint32_t index = fw_tx.next_offset / fw_tx.chunk_size;
+                if (index - base_index >= FIRMWARE_WINDOW)
+                    break; // 窗口已满，等待 ACK
+
+                if (!send_firmware_chunk(index))
+                    return;
+                fw_tx.next_offset += chunk_length(fw_tx.total_size, fw_tx.chunk_size, index);
+            }
+        }
+
+        bool handle_firmware_ack(const uint8_t *data, uint16_t len)
+        {
+            if (len != sizeof(firmware_ack_t))
+                return false;
+
+            firmware_ack_t ack;
+            std::memcpy(&ack, data, sizeof(ack));
+            if (fw_tx.status != FirmwareStatus::BUSY)
+                return true;
+
+            if (ack.status == FirmwareStatus::IDLE)
+            {
+                // 接收端丢失了会话（例如重启）：从头开始
+                const uint8_t *image = fw_tx.image;
+                start_firmware_transfer(image, fw_tx.total_size, fw_tx.chunk_size);
+                return true;
+            }
+
+            if (ack.status != FirmwareStatus::BUSY)
+            {
+                finish_firmware_send(ack.status);
+                return true;
+            }
+
+            if (fw_tx.begin_pending)
+            {
+                fw_tx.begin_pending = false;
+                fw_tx.timeouts = 0;
+            }
+            if (ack.base_offset > fw_tx.base_offset && ack.base_offset <= fw_tx.next_offset)
+            {
+                const uint32_t shift = (ack.base_offset - fw_tx.base_offset) / fw_tx.chunk_size;
+                fw_tx.resend_bits = shift >= 32 ? 0 : fw_tx.resend_bits >> shift;
+                fw_tx.resent_bits = shift >= 32 ? 0 : fw_tx.resent_bits >> shift;
+                fw_tx.base_offset = ack.base_offset;
+                fw_tx.last_progress = link_base.now();
+                fw_tx.timeouts = 0;
+            }
+            else if (ack.base_offset != fw_tx.base_offset)
+            {
+                return true; // 过期的 ACK
+            }
+
+            fw_tx.acked_bits = ack.ack_bitmap;
+            fw_tx.resend_bits |= ack.nack_bitmap & ~fw_tx.resent_bits;
+            fw_tx.resend_bits &= ~fw_tx.acked_bits;
+            return true;
+        }
+
+        FirmwareStatus firmware_send_status() const { return fw_tx.status; }
+        uint32_t firmware_acked_bytes() const { return fw_tx.base_offset; }
+
+        // ================= 接收端 =================
+
+        bool handle_firmware_begin(const uint8_t *data, uint16_t len)
+        {
+            if (len != sizeof(firmware_begin_t))
+                return false;
+
+            firmware_begin_t begin;
+            std::memcpy(&begin, data, sizeof(begin));
+
+            fw_rx = fw_rx_state_t{};
+            fw_rx.status = FirmwareStatus::BUSY;
+            if (begin.total_size == 0 || begin.chunk_size == 0 || begin.chunk_size > FIRMWARE_MAX_CHUNK ||
+                (on_firmware_begin && !on_firmware_begin(begin.total_size)))
+            {
+                fw_rx.status = FirmwareStatus::REJECTED;
+            }
+
+            fw_rx.total_size = begin.total_size;
+            fw_rx.chunk_size = begin.chunk_size;
+            fw_rx.image_crc = begin.image_crc16;
+            send_firmware_ack();
+            return fw_rx.status == FirmwareStatus::BUSY;
+        }
+
+        bool handle_firmware_chunk(const uint8_t *data, uint16_t len)
+        {
+            if (len < sizeof(firmware_chunk_head_t))
+                return false;
+
+            if (fw_rx.status != FirmwareStatus::BUSY)
+            {
+                send_firmware_ack(); // 告知发送端当前状态（IDLE 时发送端重新开始）
+                return false;
+            }
+
+            firmware_chunk_head_t head;
+            std::memcpy(&head, data, sizeof(head));
+            const uint8_t *chunk = data + sizeof(head);
+            const uint16_t chunk_len = static_cast<uint16_t>(len - sizeof(head));
+
+            if (head.offset >= fw_rx.total_size || head.offset % fw_rx.chunk_size != 0)
+                return false;
+
+            const uint32_t index = head.offset / fw_rx.chunk_size;
+            if (chunk_len != chunk_length(fw_rx.total_size, fw_rx.chunk_size, index))
+                return false;
+
+            const uint32_t base_index = fw_rx.base_offset / fw_rx.chunk_size;
+            const uint32_t rel = index - base_index;
+            if (index >= base_index && rel >= FIRMWARE_WINDOW)
+                return false; // 超出窗口
+
+            if (index < base_index || ((fw_rx.ack_bits >> rel) & 1u) != 0)
+            {
+                send_firmware_ack(); // 重复分块：通常是 ACK 丢失后的重传，重新回报窗口
+                return true;
+            }
+
+            if (on_firmware_chunk && !on_firmware_chunk(head.offset, chunk, chunk_len))
+            {
+                fw_rx.status = FirmwareStatus::WRITE_ERROR;
+                finish_firmware_receive();
+                return false;
+            }
+
+            fw_rx.ack_bits |= 1u << rel;
+            fw_rx.slot_crc[index % FIRMWARE_WINDOW] = crc16_calculation(chunk, chunk_len, 0);
+            const bool out_of_order = rel != 0;
+
+            // 窗口首部连续到达的分块按序并入整镜像 CRC
+            while ((fw_rx.ack_bits & 1u) != 0)
+            {
+                const uint32_t i = fw_rx.base_offset / fw_rx.chunk_size;
+                const uint16_t n = chunk_length(fw_rx.total_size, fw_rx.chunk_size, i);
+                fw_rx.running_crc = crc16_combine(fw_rx.running_crc, fw_rx.slot_crc[i % FIRMWARE_WINDOW], n);
+                fw_rx.base_offset += n;
+                fw_rx.ack_bits >>= 1;
+            }
+
+            if (fw_rx.base_offset == fw_rx.total_size)
+            {
+                fw_rx.status =
+                    fw_rx.running_crc == fw_rx.image_crc ? FirmwareStatus::DONE : FirmwareStatus::CRC_ERROR;
+                finish_firmware_receive();
+                return true;
+            }
+
+            if (out_of_order || ++fw_rx.since_ack >= fw_ack_every)
+                send_firmware_ack();
+            return true;
+        }
+
+        FirmwareStatus firmware_receive_status() const { return fw_rx.status; }
+
+        void send_firmware_ack()
+        {
+            // NACK：已接收的最高分块之前仍缺失的分块（串口按序传输，缺口即丢失）
+            uint32_t below_highest = 0;
+            for (uint32_t bits = fw_rx.ack_bits; bits != 0; bits >>= 1)
+                below_highest = (below_highest << 1) | 1u;
+            below_highest >>= 1;
+
+            firmware_ack_t ack;
+            ack.base_offset = fw_rx.base_offset;
+            ack.ack_bitmap = fw_rx.ack_bits;
+            ack.nack_bitmap = ~fw_rx.ack_bits & below_highest;
+            ack.running_crc = fw_rx.running_crc;
+            ack.status = fw_rx.status;
+            fw_rx.since_ack = 0;
+            link_base.template send_packet<component_id>(FIRMWARE_ACK_ID, ack);
+        }
+
+    private:
+        static uint16_t chunk_length(uint32_t total_size, uint16_t chunk_size, uint32_t index)
+        {
+            const uint32_t offset = index * chunk_size;
+            return static_cast<uint16_t>(std::min<uint32_t>(chunk_size, total_size - offset));
+        }
+
+        static uint16_t image_crc16(const uint8_t *image, uint32_t size)
+        {
+            uint16_t crc = 0xFFFF;
+            while (size > 0)
+            {
+                const uint16_t n = static_cast<uint16_t>(std::min<uint32_t>(size, 0x8000));
+                crc = crc16_calculation(image, n, crc);
+                image += n;
+                size -= n;
+            }
+            return crc;
+        }
+
+        void send_firmware_begin()
+        {
+            firmware_begin_t begin;
+            begin.total_size = fw_tx.total_size;
+            begin.chunk_size = fw_tx.chunk_size;
+            begin.image_crc16 = fw_tx.image_crc;
+            link_base.template send_packet<component_id>(FIRMWARE_BEGIN_ID, begin);
+            fw_tx.last_progress = link_base.now();
+        }
+
+        // 分块直接从镜像序列化进发送缓冲区；空间不足时返回 false
+        bool send_firmware_chunk(uint32_t index)
+        {
+            const uint32_t offset = index * fw_tx.chunk_size;
+            const uint16_t n = chunk_length(fw_tx.total_size, fw_tx.chunk_size, index);
+
+            auto frame = link_base.begin_send_frame(component_id, FIRMWARE_CHUNK_ID,
+                                                    static_cast<uint16_t>(sizeof(firmware_chunk_head_t) + n));
+            if (!frame.valid())
+                return false;
+
+            const firmware_chunk_head_t head = {offset};
+            frame.put(head);
+            frame.write(fw_tx.image + offset, n);
+            return link_base.commit_send_frame(frame) != 0;
+        }
+
+        void finish_firmware_send(FirmwareStatus status)
+        {
+            fw_tx.status = status;
+            fw_tx.image = nullptr;
+            if (on_firmware_sent)
+                on_firmware_sent(status);
+        }
+
+        void finish_firmware_receive()
+        {
+            send_firmware_ack();
+            if (on_firmware_received)
+                on_firmware_received(fw_rx.status);
+        }
+
+    public:
+        // 编译期路由表（与 build_handle_data_matrix() 等价），供 Unify_link_static 使用
+        using static_routes = std::tuple<
+            static_data_route<FIRMWARE_INFO_ID, &Update_Link_basic_t::firmware_info>,
+            static_data_route<FIRMWARE_CRC_ID, &Update_Link_basic_t::firmware_crc>,
+            static_callback_route<FIRMWARE_BEGIN_ID, firmware_begin_t, &Update_Link_basic_t::handle_firmware_begin>,
+            static_variable_route<FIRMWARE_CHUNK_ID, uint8_t[Link::max_payload_length],
+                                  &Update_Link_basic_t::handle_firmware_chunk>,
+            static_callback_route<FIRMWARE_ACK_ID, firmware_ack_t, &Update_Link_basic_t::handle_firmware_ack>>;
     };
+
+    using Update_Link_t = Update_Link_basic_t<Unify_link_base>;
 } // namespace unify_link
 
-#endif
\ No newline at end of file
+#endif
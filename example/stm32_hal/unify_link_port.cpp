@@ -0,0 +1,97 @@
+// STM32 HAL 移植示例：循环 DMA 接收 + 空闲线中断，发送走普通 DMA
+// 不参与 CMake 构建，拷贝到 CubeMX 工程中使用（需要 HAL_UART_RegisterCallback 或库中自带的弱回调）
+//
+// CubeMX 配置：
+//   - USARTx RX DMA：Circular，Byte/Byte，Memory increment
+//   - USARTx TX DMA：Normal，Byte/Byte，Memory increment
+//   - 打开 USARTx 全局中断（空闲线事件）与两个 DMA 通道中断
+//
+// 接收路径没有 memcpy：DMA 直接写入 unify_link.rec_buff.buf，中断只推进 head。
+// Cortex-M7 带 D-Cache 时，rec_buff 必须放在非缓存区（MPU）或在 parse 前按区间 SCB_InvalidateDCache_by_Addr。
+
+#include "motor_link.hpp"
+#include "unify_link.hpp"
+
+#include "main.h" // CubeMX 生成，提供 HAL 与 huartX 声明
+
+extern UART_HandleTypeDef huart1;
+
+namespace
+{
+    UART_HandleTypeDef *const link_uart = &huart1;
+
+    unify_link::Unify_link_base unify_link_base;
+    unify_link::Motor_link_t motor_link(unify_link_base);
+
+    volatile bool tx_busy = false;
+    uint32_t tx_inflight = 0; // 当前 DMA 发送的字节数，完成中断中 consume
+
+    void start_rx_dma()
+    {
+        // 循环模式下 HAL 在半满、全满和空闲线时回调 HAL_UARTEx_RxEventCallback，Size 为 DMA 写入位置
+        HAL_UARTEx_ReceiveToIdle_DMA(link_uart, unify_link_base.rev_dma_buffer(),
+                                     static_cast<uint16_t>(unify_link::Unify_link_base::rev_dma_size));
+    }
+
+    // 发送任务只在主循环中调用（send_buff_peek 与 build_send_data 同一上下文）
+    void kick_tx()
+    {
+        if (tx_busy)
+            return;
+
+        uint32_t len = 0;
+        const uint8_t *data = unify_link_base.send_buff_peek_contiguous(&len); // 跨环尾时分两次发送
+        if (len == 0)
+            return;
+
+        tx_inflight = std::min<uint32_t>(len, 0xFFFF);
+        tx_busy = true;
+        if (HAL_UART_Transmit_DMA(link_uart, const_cast<uint8_t *>(data), static_cast<uint16_t>(tx_inflight)) !=
+            HAL_OK)
+            tx_busy = false;
+    }
+} // namespace
+
+extern "C" void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
+{
+    if (huart != link_uart)
+        return;
+
+    unify_link_base.rev_dma_update(Size); // 仅推进 head，溢出计入 rx_overflow_count / rx_overflow_bytes
+}
+
+extern "C" void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+    if (huart != link_uart)
+        return;
+
+    unify_link_base.send_buff_consume(tx_inflight);
+    tx_busy = false;
+}
+
+extern "C" void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
+{
+    if (huart != link_uart)
+        return;
+
+    // 溢出错误（ORE）会停止接收 DMA，丢失的字节已使帧流中断：对齐 head 后从缓冲区起点重新接收
+    HAL_UART_AbortReceive(huart);
+    unify_link_base.rev_dma_restart();
+    start_rx_dma();
+}
+
+extern "C" void unify_link_port_init()
+{
+    unify_link_base.set_clock([] { return HAL_GetTick(); });
+    start_rx_dma();
+}
+
+// 在主循环（或 RTOS 任务）中周期调用
+extern "C" void unify_link_port_task()
+{
+    unify_link_base.parse_data_task();
+    unify_link_base.bundle_poll();
+    unify_link_base.fragment_poll();
+    unify_link_base.reliable_poll();
+    kick_tx();
+}
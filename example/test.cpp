@@ -48,9 +48,9 @@ int main()
         unify_link_base.parse_data_task();
     }
 
-    std::cout << "Success count: " << unify_link_base.success_count << std::endl;
-    std::cout << "Communication error count: " << unify_link_base.com_error_count << std::endl;
-    std::cout << "Decode error count: " << unify_link_base.decode_error_count << std::endl;
+    std::cout << "Success count: " << unify_link_base.success_count() << std::endl;
+    std::cout << "Communication error count: " << unify_link_base.com_error_count() << std::endl;
+    std::cout << "Decode error count: " << unify_link_base.decode_error_count() << std::endl;
     std::cout << "Last sequence ID: " << static_cast<int>(unify_link_base.last_seq_id) << std::endl;
 
     return 0;
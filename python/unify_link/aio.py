@@ -0,0 +1,181 @@
+"""asyncio layer over the native multi-link hub (Linux, built with UNIFY_LINK_BUILD_SERIAL).
+
+The hub's worker threads read, parse and dispatch every link in C++. Frames of watched IDs are
+collected into one native batch, which wakes the event loop once through an eventfd; the loop then
+fans the whole batch out to awaiting requests and ``frames()`` subscribers.
+
+    async with AsyncHub() as hub:          # or: hub = AsyncHub(); ... await hub.start()
+        link = hub.add_port("/dev/ttyUSB0", baud_rate=921600)
+        motors = MotorLink(link.base)      # components bind before start()
+        link.watch(MotorLink.component_id, 2)
+        await hub.start()
+        info = await link.request(MotorLink.component_id, 2)
+"""
+
+import asyncio
+import collections
+import errno
+import os
+
+from . import unify_link as _ul
+
+__all__ = ["AsyncHub", "AsyncLink"]
+
+if not hasattr(_ul, "LinkHub"):
+    raise ImportError("unify_link.aio needs the Linux serial transport (UNIFY_LINK_BUILD_SERIAL=ON)")
+
+
+class AsyncLink:
+    """One link of an :class:`AsyncHub`; created by ``AsyncHub.add_port()`` / ``add_fd()``."""
+
+    def __init__(self, hub, index):
+        self._hub = hub
+        self.index = index
+        self._watched = set()
+        self._waiters = collections.defaultdict(collections.deque)  # (cid, did) -> futures, FIFO
+        self._subscribers = []  # (cid or None, did or None, asyncio.Queue)
+
+    @property
+    def base(self):
+        """The native ``UnifyLinkBase``; only bind components to it before the hub starts."""
+        return self._hub.native.link(self.index)
+
+    def watch(self, component_id, data_id):
+        """Deliver frames of this ID to the event loop (required for ``request()`` / ``frames()``).
+
+        Existing handlers keep running first, so component state is already updated when a frame
+        arrives here. Must be called before ``AsyncHub.start()``.
+        """
+        key = (component_id, data_id)
+        if key in self._watched:
+            return
+        if self._hub.running:
+            raise RuntimeError("watch() must be called before AsyncHub.start()")
+        if not self._hub.queue.subscribe(self.base, self.index, component_id, data_id):
+            raise RuntimeError("dispatch table full (UNIFY_LINK_MAX_HANDLERS)")
+        self._watched.add(key)
+
+    def send(self, component_id, data_id, payload=b""):
+        """Queue a frame on the link's worker thread; never blocks the event loop."""
+        self._hub.native.send(self.index, component_id, data_id, payload)
+
+    async def request(self, component_id, data_id, timeout=1.0):
+        """Send a zero-length request frame and return the payload of the next frame with this ID.
+
+        The peer answers a request for any ID it registered with a ``dst`` struct (see
+        ``handle_data``). Raises ``asyncio.TimeoutError`` if no answer arrives in time.
+        """
+        key = (component_id, data_id)
+        if key not in self._watched:
+            raise RuntimeError(f"call watch({component_id}, {data_id}) before start() to receive the answer")
+
+        future = asyncio.get_running_loop().create_future()
+        waiters = self._waiters[key]
+        waiters.append(future)
+        self.send(component_id, data_id)
+        try:
+            return await asyncio.wait_for(future, timeout)
+        finally:
+            if not future.done() or future.cancelled():
+                try:
+                    waiters.remove(future)
+                except ValueError:
+                    pass
+
+    async def request_many(self, keys, timeout=1.0):
+        """Issue several requests back-to-back and wait for all answers: one round trip instead of N."""
+        return await asyncio.gather(*(self.request(cid, did, timeout) for cid, did in keys))
+
+    async def frames(self, component_id=None, data_id=None, maxsize=1024):
+        """Async iterator of ``(component_id, data_id, payload)`` for watched IDs matching the filter.
+
+        When the consumer is slower than the link the oldest queued frames are dropped.
+        """
+        queue = asyncio.Queue(maxsize)
+        entry = (component_id, data_id, queue)
+        self._subscribers.append(entry)
+        try:
+            while True:
+                yield await queue.get()
+        finally:
+            self._subscribers.remove(entry)
+
+    def _deliver(self, component_id, data_id, payload):
+        waiters = self._waiters.get((component_id, data_id))
+        while waiters:
+            future = waiters.popleft()
+            if not future.done():
+                future.set_result(payload)
+                break
+
+        for cid, did, queue in self._subscribers:
+            if (cid is None or cid == component_id) and (did is None or did == data_id):
+                if queue.full():
+                    queue.get_nowait()
+                queue.put_nowait((component_id, data_id, payload))
+
+
+class AsyncHub:
+    """Many links served by a few native worker threads, delivered to one asyncio event loop."""
+
+    def __init__(self, worker_count=1, tick_ms=5, queue_capacity=4096):
+        self.native = _ul.LinkHub(worker_count, tick_ms)
+        self.queue = _ul.FrameQueue(queue_capacity)
+        self._links = []
+        self._loop = None
+
+    def add_port(self, path, baud_rate=115200, low_latency=True, hw_flow_control=False):
+        index = self.native.add_port(path, baud_rate, low_latency, hw_flow_control)
+        return self._adopt(index, path)
+
+    def add_fd(self, fd):
+        return self._adopt(self.native.add_fd(fd), f"fd {fd}")
+
+    def __getitem__(self, index):
+        return self._links[index]
+
+    def __len__(self):
+        return len(self._links)
+
+    @property
+    def running(self):
+        return self.native.running
+
+    @property
+    def dropped(self):
+        """Frames lost because the event loop did not drain the native batch in time."""
+        return self.queue.dropped
+
+    async def start(self):
+        if self.running:
+            return
+        if not self.native.start():
+            err = self.native.last_error
+            raise OSError(err, os.strerror(err))
+        self._loop = asyncio.get_running_loop()
+        self._loop.add_reader(self.queue.fileno(), self._on_batch)
+
+    async def stop(self):
+        if self._loop is not None:
+            self._loop.remove_reader(self.queue.fileno())
+            self._loop = None
+        await asyncio.get_running_loop().run_in_executor(None, self.native.stop)
+        self._on_batch()  # frames decoded before the workers stopped
+
+    async def __aenter__(self):
+        return self
+
+    async def __aexit__(self, *exc):
+        await self.stop()
+
+    def _adopt(self, index, what):
+        if index < 0:
+            err = self.native.last_error or errno.EIO
+            raise OSError(err, f"{what}: {os.strerror(err)}")
+        link = AsyncLink(self, index)
+        self._links.append(link)
+        return link
+
+    def _on_batch(self):
+        for index, component_id, data_id, payload in self.queue.drain():
+            self._links[index]._deliver(component_id, data_id, payload)
@@ -2,15 +2,34 @@
 #include "component/motor_link.hpp"
 #include "component/update_Link.hpp"
 #include "unify_link.hpp"
+#include "unify_link_dispatch.hpp"
+#include "unify_link_mirror.hpp"
+#include "unify_link_monitor.hpp"
+#if defined(__unix__) || defined(__APPLE__)
+#include "unify_link_capture.hpp"
+#define UNIFY_LINK_HAS_CAPTURE 1
+#endif
+#if defined(UNIFY_LINK_HAS_SERIAL)
+#include "unify_link_hub.hpp"
+#include "unify_link_serial.hpp"
+#endif
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <cstring>
 #include <iterator>
+#include <memory>
+#include <mutex>
 #include <pybind11/functional.h>
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <stdexcept>
+#include <system_error>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace py = pybind11;
@@ -20,19 +39,19 @@ namespace
 {
     template <typename T, size_t N>
     std::vector<T> copy_array(const T (&src)[N])
-    {
+    {
         return std::vector<T>(src, src + N);
-    }
+    }
 
     template <typename T, size_t N>
     void assign_array(T (&dst)[N], const std::vector<T> &src, const char *name)
-    {
+    {
         if (src.size() != N)
         {
             throw std::invalid_argument(std::string("Expected ") + std::to_string(N) + " items for " + name);
         }
         std::copy(src.begin(), src.end(), dst);
-    }
+    }
 
     std::string char_array_to_string(const char *src, size_t max_len)
     {
@@ -46,46 +65,428 @@ namespace
         std::memcpy(dst, value.data(), copy_len);
     }
 
-    bool push_recv_data(Unify_link_base &base, const py::bytes &data)
+    // 缓冲区协议视图（bytes / bytearray / memoryview / numpy 等连续内存），不拷贝数据；
+    // 持有期间导出方不能改变大小（bytearray resize 会抛 BufferError）
+    class buffer_view_t
     {
-        std::string view = data;
-        const uint32_t len = static_cast<uint32_t>(view.size());
-        if (len == 0 || len > base.rec_buff.remain())
+    public:
+        explicit buffer_view_t(const py::handle &obj, bool writable = false)
         {
-            return false;
+            if (PyObject_GetBuffer(obj.ptr(), &view, writable ? PyBUF_WRITABLE : PyBUF_SIMPLE) != 0)
+                throw py::error_already_set();
         }
 
-        base.rev_data_push(reinterpret_cast<const uint8_t *>(view.data()), len);
-        return true;
+        ~buffer_view_t() { PyBuffer_Release(&view); }
+
+        buffer_view_t(const buffer_view_t &) = delete;
+        buffer_view_t &operator=(const buffer_view_t &) = delete;
+
+        uint8_t *data() const { return static_cast<uint8_t *>(view.buf); }
+        size_t size() const { return static_cast<size_t>(view.len); }
+
+    private:
+        Py_buffer view{};
+    };
+
+    // 接收与解析期间释放 GIL：Python 回调（组件回调、on_reliable_failed 等）在调用时自行重新获取
+    uint32_t push_recv_data(Unify_link_base &base, const py::buffer &data)
+    {
+        buffer_view_t view(data);
+        py::gil_scoped_release release;
+        // 与 C++ 调用方相同：放不下时保留能放下的前缀，其余计入 rx_overflow_bytes
+        return base.rev_data_push(view.data(), static_cast<uint32_t>(view.size()));
     }
 
     py::bytes pop_send_buffer(Unify_link_base &base)
     {
-        const uint32_t available = base.send_buff_used();
+        const auto seg = base.send_buff_peek();
+        const uint32_t available = seg.size();
         if (available == 0)
         {
             return py::bytes();
         }
 
-        std::vector<uint8_t> tmp(available);
-        uint32_t written = 0;
-        base.send_buff_pop(tmp.data(), &written);
-        return py::bytes(reinterpret_cast<const char *>(tmp.data()), static_cast<py::ssize_t>(written));
+        // 直接从环形缓冲区的两段拷贝进新建的 bytes 对象，避免中间 std::vector
+        PyObject *obj = PyBytes_FromStringAndSize(nullptr, static_cast<py::ssize_t>(available));
+        if (obj == nullptr)
+        {
+            throw py::error_already_set();
+        }
+        char *out = PyBytes_AS_STRING(obj);
+        std::memcpy(out, seg.ptr[0], seg.len[0]);
+        std::memcpy(out + seg.len[0], seg.ptr[1], seg.len[1]);
+
+        base.send_buff_consume(available);
+        return py::reinterpret_steal<py::bytes>(obj);
+    }
+
+    // 写入调用方预分配的可写缓冲区，返回写入字节数；缓冲区放不下的部分留到下次
+    uint32_t pop_send_into(Unify_link_base &base, const py::buffer &buffer)
+    {
+        buffer_view_t view(buffer, true);
+        const auto seg = base.send_buff_peek();
+        const uint32_t n = static_cast<uint32_t>(std::min<size_t>(seg.size(), view.size()));
+        if (n == 0)
+        {
+            return 0;
+        }
+
+        const uint32_t first = std::min(n, seg.len[0]);
+        std::memcpy(view.data(), seg.ptr[0], first);
+        std::memcpy(view.data() + first, seg.ptr[1], n - first);
+        base.send_buff_consume(n);
+        return n;
+    }
+
+    // 分片发送期间 C++ 侧直接引用载荷：每条链路保留正在分片发送的缓冲区视图，下一次分片发送时释放
+    std::unordered_map<const Unify_link_base *, std::unique_ptr<buffer_view_t>> &fragment_payloads()
+    {
+        static auto *payloads = new std::unordered_map<const Unify_link_base *, std::unique_ptr<buffer_view_t>>();
+        return *payloads;
+    }
+
+    bool send_fragmented_bytes(Unify_link_base &base, uint8_t component_id, uint8_t data_id, const py::buffer &payload)
+    {
+        auto view = std::make_unique<buffer_view_t>(payload);
+        if (view->size() >= 0xFFFF || base.fragment_pending())
+            return false;
+
+        const uint8_t *data = view->data();
+        const auto size = static_cast<uint16_t>(view->size());
+        fragment_payloads()[&base] = std::move(view);
+        return base.send_fragmented(component_id, data_id, data, size);
     }
 
     uint16_t build_send_data_bytes(Unify_link_base &base, uint8_t component_id, uint8_t data_id,
-                                   const py::bytes &payload)
-    {
-        std::string view = payload;
-        const auto len = static_cast<uint16_t>(view.size());
-        return base.build_send_data(component_id, data_id, reinterpret_cast<const uint8_t *>(view.data()), len);
-    }
-
+                                   const py::buffer &payload)
+    {
+        buffer_view_t view(payload);
+        if (view.size() > Unify_link_base::max_payload_length)
+            return 0; // 与 C++ 一致：超长消息须显式 send_fragmented()
+
+        return base.build_send_data(component_id, data_id, view.data(), static_cast<uint16_t>(view.size()));
+    }
+
+    uint16_t send_reliable_bytes(Unify_link_base &base, uint8_t component_id, uint8_t data_id,
+                                 const py::buffer &payload)
+    {
+        buffer_view_t view(payload);
+        if (view.size() > Unify_link_base::max_payload_length)
+            return 0;
+        return base.send_reliable(component_id, data_id, view.data(), static_cast<uint16_t>(view.size()));
+    }
+
     bool register_any_payload(Unify_link_base &base, uint8_t component_id, uint8_t data_id)
-    {
+    {
         return base.register_handle_data(component_id, data_id, nullptr, handle_data_func_t{}, 0xFFFF);
-    }
-
+    }
+
+    // 主机端打包超时、固件重传超时使用的毫秒时钟
+    uint32_t host_clock_ms()
+    {
+        using namespace std::chrono;
+        return static_cast<uint32_t>(duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count());
+    }
+
+    void set_bundle_policy(Unify_link_base &base, uint16_t max_bytes, uint32_t deadline_ms)
+    {
+        base.set_clock(&host_clock_ms);
+        base.set_bundle_policy(max_bytes, deadline_ms);
+    }
+
+    void register_default_any_payload(Unify_link_base &base)
+    {
+        base.register_default_handle_data(handle_data_func_t{}, 0xFFFF);
+    }
+
+    py::list stats_messages(const Unify_link_base &base)
+    {
+        std::array<Unify_link_base::message_stats_t, Link_stats_t<UNIFY_LINK_STATS_SLOTS>::capacity()> all;
+        const uint16_t count = base.stats.messages(all.data(), static_cast<uint16_t>(all.size()));
+        py::list out;
+        for (uint16_t i = 0; i < count; ++i)
+            out.append(all[i]);
+        return out;
+    }
+
+    py::object message_stats(const Unify_link_base &base, uint8_t component_id, uint8_t data_id)
+    {
+        Unify_link_base::message_stats_t stats;
+        if (!base.stats.message(component_id, data_id, &stats))
+            return py::none();
+        return py::cast(stats);
+    }
+
+#if UNIFY_LINK_LATENCY
+    // 时延直方图使用微秒时钟，与毫秒的 set_clock() 分开
+    uint32_t host_clock_us()
+    {
+        using namespace std::chrono;
+        return static_cast<uint32_t>(duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count());
+    }
+
+    py::object wire_min_delta(const Unify_link_base &base)
+    {
+        int32_t delta = 0;
+        if (!base.latency.wire_min_delta(&delta))
+            return py::none();
+        return py::cast(delta);
+    }
+#endif
+
+    // ===== NumPy 结构化视图 =====
+    // 载荷结构体是 #pragma pack(1) 的紧凑布局，dtype 按字段偏移逐一描述，视图直接指向组件内的数组
+    py::dtype make_dtype(std::vector<std::string> names, std::vector<std::string> formats,
+                         std::vector<size_t> offsets, size_t itemsize)
+    {
+        py::dict spec;
+        spec["names"] = names;
+        spec["formats"] = formats;
+        spec["offsets"] = offsets;
+        spec["itemsize"] = itemsize;
+        return py::dtype::from_args(spec);
+    }
+
+    const py::dtype &motor_feedback_dtype()
+    {
+        using T = Motor_link_t::feedback_t;
+        static auto *dtype = new py::dtype(make_dtype(
+            {"position", "speed", "current", "temperature", "error_code"}, {"u2", "i2", "u2", "i1", "u1"},
+            {offsetof(T, position), offsetof(T, speed), offsetof(T, current), offsetof(T, temperature),
+             offsetof(T, error_code)},
+            sizeof(T)));
+        return *dtype;
+    }
+
+    const py::dtype &motor_set_dtype()
+    {
+        using T = Motor_link_t::set_t;
+        static auto *dtype = new py::dtype(make_dtype({"set", "set_extra", "set_extra2"}, {"i2", "i2", "i2"},
+                                                      {offsetof(T, set), offsetof(T, set_extra), offsetof(T, set_extra2)},
+                                                      sizeof(T)));
+        return *dtype;
+    }
+
+    const py::dtype &encoder_basic_dtype()
+    {
+        using T = Encoder_link_t::encoder_basic_t;
+        static auto *dtype = new py::dtype(make_dtype({"position", "velocity", "error_code"}, {"u2", "i4", "u1"},
+                                                      {offsetof(T, position), offsetof(T, velocity), offsetof(T, error_code)},
+                                                      sizeof(T)));
+        return *dtype;
+    }
+
+    // 可写视图，owner 保证组件对象至少与数组同寿命；parse_data_task 在其他线程运行时读到的可能是正在更新的条目
+    template <typename T, size_t N>
+    py::array struct_view(T (&values)[N], const py::dtype &dtype, const py::object &owner)
+    {
+        return py::array(dtype, {static_cast<py::ssize_t>(N)}, {static_cast<py::ssize_t>(sizeof(T))}, values, owner);
+    }
+
+    // 时间戳与 time.monotonic() 同源（steady_clock）
+    double monotonic_seconds()
+    {
+        using namespace std::chrono;
+        return duration<double>(steady_clock::now().time_since_epoch()).count();
+    }
+
+    // 快照历史环：预分配 capacity×N 的结构化数组，每次收到整组数据追加一行；追加在解析线程中进行，不需要 GIL
+    template <typename T, size_t N>
+    class Snapshot_history_t
+    {
+    public:
+        Snapshot_history_t(size_t capacity, const py::dtype &dtype)
+            : samples(dtype, {static_cast<py::ssize_t>(capacity), static_cast<py::ssize_t>(N)}),
+              timestamps(static_cast<py::ssize_t>(capacity)), capacity(capacity)
+        {
+            rows = static_cast<T *>(samples.mutable_data());
+            times = timestamps.mutable_data();
+        }
+
+        void append(const T (&row)[N], double t)
+        {
+            const uint64_t n = written.load(std::memory_order_relaxed);
+            const size_t slot = static_cast<size_t>(n % capacity);
+            std::memcpy(rows + slot * N, row, sizeof(row));
+            times[slot] = t;
+            written.store(n + 1, std::memory_order_release);
+        }
+
+        uint64_t count() const { return written.load(std::memory_order_acquire); }
+        size_t size() const { return static_cast<size_t>(std::min<uint64_t>(count(), capacity)); }
+
+        // 按时间顺序拷贝最近的 n 行：(samples[n, N], timestamps[n])
+        py::tuple latest(size_t n) const
+        {
+            const uint64_t end = count();
+            n = std::min(n, size());
+            py::array out(samples.dtype(), {static_cast<py::ssize_t>(n), static_cast<py::ssize_t>(N)});
+            py::array_t<double> out_times(static_cast<py::ssize_t>(n));
+            T *dst = static_cast<T *>(out.mutable_data());
+            double *dst_times = out_times.mutable_data();
+            for (size_t i = 0; i < n; ++i)
+            {
+                const size_t slot = static_cast<size_t>((end - n + i) % capacity);
+                std::memcpy(dst + i * N, rows + slot * N, sizeof(T) * N);
+                dst_times[i] = times[slot];
+            }
+            return py::make_tuple(out, out_times);
+        }
+
+        py::array samples;
+        py::array_t<double> timestamps;
+        const size_t capacity;
+
+    private:
+        T *rows = nullptr;
+        double *times = nullptr;
+        std::atomic<uint64_t> written{0};
+    };
+
+    using Motor_history_t = Snapshot_history_t<Motor_link_t::feedback_t, Motor_link_t::MAX_MOTORS>;
+
+    // on_motor_basic_updated 中保存的可调用对象：先追加历史（无 GIL），有 Python 回调时才获取 GIL
+    // 通过 std::function::target 取回，历史与回调随组件对象一起销毁
+    struct Motor_basic_hook_t
+    {
+        std::shared_ptr<Motor_history_t> history;
+        py::object callback;
+
+        void operator()(const Motor_link_t::feedback_t (&data)[Motor_link_t::MAX_MOTORS]) const
+        {
+            if (history)
+                history->append(data, monotonic_seconds());
+            if (callback)
+            {
+                py::gil_scoped_acquire gil;
+                callback(copy_array(data));
+            }
+        }
+    };
+
+    Motor_basic_hook_t &motor_basic_hook(Motor_link_t &self)
+    {
+        if (self.on_motor_basic_updated.target<Motor_basic_hook_t>() == nullptr)
+            self.on_motor_basic_updated = Motor_basic_hook_t{};
+        return *self.on_motor_basic_updated.target<Motor_basic_hook_t>();
+    }
+
+#if defined(UNIFY_LINK_HAS_SERIAL)
+    // 解码帧 → asyncio 的批量队列：工作线程在处理函数链中追加，队列由空变非空时写一次 eventfd，
+    // 事件循环 add_reader(fileno()) 后一次 drain() 取走整批（单消费者）。
+    // 记录表与载荷区按容量一次性预留，工作线程入队时不再分配：任一方装满即丢弃该帧
+    class Frame_queue_t
+    {
+    public:
+        explicit Frame_queue_t(size_t capacity) : capacity(capacity)
+        {
+            wake_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (wake_fd < 0)
+                throw std::system_error(errno, std::generic_category(), "eventfd");
+            records.reserve(capacity);
+            drained.reserve(capacity);
+            payload.reserve(capacity * kPayloadPerRecord);
+            drained_payload.reserve(capacity * kPayloadPerRecord);
+        }
+
+        ~Frame_queue_t() { ::close(wake_fd); }
+
+        Frame_queue_t(const Frame_queue_t &) = delete;
+        Frame_queue_t &operator=(const Frame_queue_t &) = delete;
+
+        int fileno() const { return wake_fd; }
+        uint64_t dropped() const { return dropped_count.load(std::memory_order_relaxed); }
+
+        // 在 (component_id, data_id) 现有处理函数之后追加入队（组件仍照常更新状态），未注册的 ID 按任意长度注册；
+        // 仅在 hub.start() 之前调用
+        bool subscribe(Unify_link_base &link, uint32_t index, uint8_t component_id, uint8_t data_id)
+        {
+            const registered_item_t *item = link.registered_table.find(component_id, data_id);
+            void *dst = item != nullptr ? item->dst : nullptr;
+            const uint16_t length = item != nullptr ? item->payload_length : 0xFFFF;
+            return link.register_handle_data(component_id, data_id, dst,
+                                             _chain(index, component_id, data_id,
+                                                    item != nullptr ? item->callback : handle_data_func_t{}),
+                                             length);
+        }
+
+        void push(uint32_t index, uint8_t component_id, uint8_t data_id, const uint8_t *data, uint16_t len)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (records.size() >= capacity || payload.size() + len > payload.capacity())
+            {
+                dropped_count.store(dropped_count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                return;
+            }
+            const bool was_empty = records.empty();
+            records.push_back({index, static_cast<uint32_t>(payload.size()), len, component_id, data_id});
+            payload.insert(payload.end(), data, data + len);
+            if (was_empty)
+            {
+                const uint64_t one = 1;
+                (void)!::write(wake_fd, &one, sizeof(one));
+            }
+        }
+
+        // [(link_index, component_id, data_id, payload: bytes), ...]
+        py::list drain()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                uint64_t counter;
+                (void)!::read(wake_fd, &counter, sizeof(counter));
+                records.swap(drained);
+                payload.swap(drained_payload);
+            }
+
+            py::list out(drained.size());
+            for (size_t i = 0; i < drained.size(); ++i)
+            {
+                const record_t &r = drained[i];
+                out[i] = py::make_tuple(r.index, r.component_id, r.data_id,
+                                        py::bytes(reinterpret_cast<const char *>(drained_payload.data()) + r.offset,
+                                                  r.length));
+            }
+            drained.clear();
+            drained_payload.clear();
+            return out;
+        }
+
+        const size_t capacity;
+
+    private:
+        static constexpr size_t kPayloadPerRecord = 64; // 批量载荷区 = capacity × 64 字节
+
+        struct record_t
+        {
+            uint32_t index;
+            uint32_t offset;
+            uint16_t length;
+            uint8_t component_id;
+            uint8_t data_id;
+        };
+
+        handle_data_func_t _chain(uint32_t index, uint8_t component_id, uint8_t data_id, handle_data_func_t prev)
+        {
+            return [this, index, component_id, data_id, prev](const uint8_t *data, uint16_t len)
+            {
+                if (prev && !prev(data, len))
+                    return false;
+                push(index, component_id, data_id, data, len);
+                return true;
+            };
+        }
+
+        int wake_fd = -1;
+        std::mutex mutex;
+        std::vector<record_t> records;
+        std::vector<uint8_t> payload;
+        std::vector<record_t> drained; // 仅 drain() 使用，与 records 交换以复用容量
+        std::vector<uint8_t> drained_payload;
+        std::atomic<uint64_t> dropped_count{0};
+    };
+#endif
+
 } // namespace
 
 PYBIND11_MODULE(unify_link, m)
@@ -98,11 +499,14 @@ PYBIND11_MODULE(unify_link, m)
     m.attr("COMPONENT_ID_ENCODERS") = py::int_(COMPONENT_ID_ENCODERS);
     m.attr("COMPONENT_ID_EXAMPLES") = py::int_(COMPONENT_ID_EXAMPLES);
     m.attr("FRAME_HEADER") = py::int_(FRAME_HEADER);
+    m.attr("FRAME_FLAG_BUNDLE") = py::int_(FRAME_FLAG_BUNDLE);
+    m.attr("FRAME_FLAG_ACK_REQ") = py::int_(FRAME_FLAG_ACK_REQ);
+    m.attr("FRAME_FLAG_FRAGMENT") = py::int_(FRAME_FLAG_FRAGMENT);
     m.attr("MAX_FRAME_DATA_LENGTH") = py::int_(MAX_FRAME_DATA_LENGTH);
     m.attr("MAX_FRAME_LENGTH") = py::int_(MAX_FRAME_LENGTH);
 
     py::class_<unify_link_frame_head_t>(m, "FrameHead")
-        .def(py::init<>())
+        .def(py::init<>())
         .def_readwrite("frame_header", &unify_link_frame_head_t::frame_header)
         .def_readwrite("seq_id", &unify_link_frame_head_t::seq_id)
         .def_readwrite("component_id", &unify_link_frame_head_t::component_id)
@@ -114,23 +518,315 @@ PYBIND11_MODULE(unify_link, m)
         .def_readwrite("payload_length_and_sign", &unify_link_frame_head_t::payload_length_and_sign)
         .def_readwrite("crc16", &unify_link_frame_head_t::crc16);
 
-    py::class_<Unify_link_base>(m, "UnifyLinkBase")
+    using stats_totals_t = Unify_link_base::stats_totals_t;
+    py::class_<stats_totals_t>(m, "LinkStatsTotals")
+        .def_readonly("rx_frames", &stats_totals_t::rx_frames)
+        .def_readonly("rx_bytes", &stats_totals_t::rx_bytes)
+        .def_readonly("rx_messages", &stats_totals_t::rx_messages)
+        .def_readonly("decode_errors", &stats_totals_t::decode_errors)
+        .def_readonly("length_errors", &stats_totals_t::length_errors)
+        .def_readonly("crc_errors", &stats_totals_t::crc_errors)
+        .def_readonly("seq_lost", &stats_totals_t::seq_lost)
+        .def_readonly("resync_count", &stats_totals_t::resync_count)
+        .def_readonly("resync_skipped_bytes", &stats_totals_t::resync_skipped_bytes)
+        .def_readonly("rx_overflow_bytes", &stats_totals_t::rx_overflow_bytes)
+        .def_readonly("tx_frames", &stats_totals_t::tx_frames)
+        .def_readonly("tx_bytes", &stats_totals_t::tx_bytes)
+        .def_readonly("tx_drops", &stats_totals_t::tx_drops);
+
+    using message_stats_t = Unify_link_base::message_stats_t;
+    py::class_<message_stats_t>(m, "MessageStats")
+        .def_readonly("component_id", &message_stats_t::component_id)
+        .def_readonly("data_id", &message_stats_t::data_id)
+        .def_readonly("rx_messages", &message_stats_t::rx_messages)
+        .def_readonly("rx_bytes", &message_stats_t::rx_bytes)
+        .def_readonly("decode_errors", &message_stats_t::decode_errors)
+        .def_readonly("length_errors", &message_stats_t::length_errors)
+        .def_readonly("crc_errors", &message_stats_t::crc_errors)
+        .def_readonly("tx_frames", &message_stats_t::tx_frames)
+        .def_readonly("tx_bytes", &message_stats_t::tx_bytes)
+        .def_readonly("tx_drops", &message_stats_t::tx_drops);
+
+    // Windowed monitor fed by the raw-frame tap; aggregation runs in C++ on the parsing thread
+    using message_rate_t = Link_monitor::message_rate_t;
+    py::class_<message_rate_t>(m, "MessageRate")
+        .def_readonly("component_id", &message_rate_t::component_id)
+        .def_readonly("data_id", &message_rate_t::data_id)
+        .def_readonly("flags", &message_rate_t::flags)
+        .def_readonly("frames", &message_rate_t::frames)
+        .def_readonly("bytes", &message_rate_t::bytes)
+        .def_readonly("frames_per_sec", &message_rate_t::frames_per_sec)
+        .def_readonly("bytes_per_sec", &message_rate_t::bytes_per_sec);
+
+    using monitor_snapshot_t = Link_monitor::snapshot_t;
+    py::class_<monitor_snapshot_t>(m, "MonitorSnapshot")
+        .def_readonly("totals", &monitor_snapshot_t::totals)
+        .def_readonly("window_ms", &monitor_snapshot_t::window)
+        .def_readonly("tap_frames", &monitor_snapshot_t::tap_frames)
+        .def_readonly("rx_frames_per_sec", &monitor_snapshot_t::rx_frames_per_sec)
+        .def_readonly("rx_bytes_per_sec", &monitor_snapshot_t::rx_bytes_per_sec)
+        .def_readonly("crc_errors_per_sec", &monitor_snapshot_t::crc_errors_per_sec)
+        .def_readonly("decode_errors_per_sec", &monitor_snapshot_t::decode_errors_per_sec)
+        .def_readonly("seq_lost_per_sec", &monitor_snapshot_t::seq_lost_per_sec);
+
+    py::class_<Link_monitor>(m, "LinkMonitor")
+        .def(py::init([](Unify_link_base &base, uint32_t bucket_ms)
+                      { return std::make_unique<Link_monitor>(base, &host_clock_ms, bucket_ms); }),
+             py::arg("link_base"), py::arg("bucket_ms") = 100, py::keep_alive<1, 2>(),
+             "Attach to the link's frame tap; rates cover the last 10 buckets")
+        .def(
+            "snapshot",
+            [](Link_monitor &self)
+            {
+                monitor_snapshot_t snap;
+                self.snapshot(&snap);
+                return snap;
+            },
+            "Totals plus windowed frame/byte/error rates; call from one thread (e.g. the UI timer)")
+        .def(
+            "messages",
+            [](const Link_monitor &self)
+            {
+                std::array<message_rate_t, Link_monitor::capacity()> all;
+                const uint16_t count = self.messages(all.data(), static_cast<uint16_t>(all.size()));
+                return std::vector<message_rate_t>(all.begin(), all.begin() + count);
+            },
+            "MessageRate for every (component_id, data_id) seen on the wire")
+        .def(
+            "message",
+            [](const Link_monitor &self, uint8_t component_id, uint8_t data_id) -> py::object
+            {
+                message_rate_t rate;
+                if (!self.message(component_id, data_id, &rate))
+                    return py::none();
+                return py::cast(rate);
+            },
+            py::arg("component_id"), py::arg("data_id"))
+        .def_property_readonly("window_ms", &Link_monitor::window_span);
+
+    // 按组件并行分发：执行线程调用 Python 回调时自行获取 GIL，因此停止 / 析构（join）前必须释放 GIL
+    struct dispatcher_deleter
+    {
+        void operator()(Parallel_dispatcher *dispatcher) const
+        {
+            py::gil_scoped_release release;
+            delete dispatcher;
+        }
+    };
+    using dispatcher_holder = std::unique_ptr<Parallel_dispatcher, dispatcher_deleter>;
+
+    py::class_<Parallel_dispatcher::lane_stats_t>(m, "DispatchLaneStats")
+        .def_readonly("enqueued", &Parallel_dispatcher::lane_stats_t::enqueued)
+        .def_readonly("dispatched", &Parallel_dispatcher::lane_stats_t::dispatched)
+        .def_readonly("dropped", &Parallel_dispatcher::lane_stats_t::dropped)
+        .def_readonly("failed", &Parallel_dispatcher::lane_stats_t::failed)
+        .def_readonly("high_water", &Parallel_dispatcher::lane_stats_t::high_water);
+
+    py::class_<Parallel_dispatcher, dispatcher_holder>(m, "ParallelDispatcher")
+        .def(py::init([](Unify_link_base &base) { return dispatcher_holder(new Parallel_dispatcher(base)); }),
+             py::arg("link_base"), py::keep_alive<1, 2>(),
+             "Create after the components are constructed; offload() then start() before parsing")
+        .def("offload", &Parallel_dispatcher::offload, py::arg("component_id"),
+             "Move every handler of this component to its own executor thread; False if none is registered")
+        .def("start", &Parallel_dispatcher::start)
+        .def("stop", &Parallel_dispatcher::stop, py::call_guard<py::gil_scoped_release>(),
+             "Drain the queues and join the executor threads")
+        .def("flush", &Parallel_dispatcher::flush, py::call_guard<py::gil_scoped_release>(),
+             "Wait until every queued frame has been dispatched")
+        .def("restore", &Parallel_dispatcher::restore, "Put the original handlers back (after stop())")
+        .def(
+            "stats",
+            [](const Parallel_dispatcher &self, uint8_t component_id) -> py::object
+            {
+                Parallel_dispatcher::lane_stats_t stats;
+                if (!self.stats(component_id, &stats))
+                    return py::none();
+                return py::cast(stats);
+            },
+            py::arg("component_id"))
+        .def_property_readonly("running", &Parallel_dispatcher::running_threads);
+
+#if defined(UNIFY_LINK_HAS_CAPTURE)
+    // 流量录制 / 回放：写入端线程安全，回放在 C++ 中推送与解析（释放 GIL）
+    py::enum_<Capture_record_type>(m, "CaptureRecordType")
+        .value("RX", Capture_record_type::RX)
+        .value("TX", Capture_record_type::TX)
+        .value("FRAME", Capture_record_type::FRAME);
+
+    py::class_<Capture_reader::replay_stats_t>(m, "ReplayStats")
+        .def_readonly("records", &Capture_reader::replay_stats_t::records)
+        .def_readonly("rx_bytes", &Capture_reader::replay_stats_t::rx_bytes)
+        .def_readonly("tx_bytes", &Capture_reader::replay_stats_t::tx_bytes)
+        .def_readonly("captured_frames", &Capture_reader::replay_stats_t::captured_frames)
+        .def_readonly("elapsed_s", &Capture_reader::replay_stats_t::elapsed_s);
+
+    py::class_<Capture_writer>(m, "CaptureWriter")
         .def(py::init<>())
-        .def("parse_data_task", &Unify_link_base::parse_data_task, "Parse received buffer and dispatch frames")
+        .def("open", &Capture_writer::open, py::arg("path"), py::arg("chunk_size") = Capture_writer::kDefaultChunkSize,
+             "Create the capture file; returns False and sets last_error on failure")
+        .def("close", &Capture_writer::close, "Flush the last chunk and write the chunk index")
+        .def("flush", &Capture_writer::flush, "Write buffered records as a complete chunk")
+        .def(
+            "rx", [](Capture_writer &self, const py::buffer &data)
+            {
+                buffer_view_t view(data);
+                self.rx(view.data(), static_cast<uint32_t>(view.size()));
+            },
+            py::arg("data"))
+        .def(
+            "tx", [](Capture_writer &self, const py::buffer &data)
+            {
+                buffer_view_t view(data);
+                self.tx(view.data(), static_cast<uint32_t>(view.size()));
+            },
+            py::arg("data"))
+        .def("attach_frames", &Capture_writer::attach_frames<Unify_link_base>, py::arg("link_base"),
+             py::keep_alive<1, 2>(), "Record every valid frame head decoded by the link (chains existing taps)")
+        .def("detach_frames", &Capture_writer::detach_frames)
+        .def_property_readonly("is_open", &Capture_writer::is_open)
+        .def_property_readonly("records", &Capture_writer::records)
+        .def_property_readonly("last_error", &Capture_writer::last_error);
+
+    py::class_<Capture_reader>(m, "CaptureReader")
+        .def(py::init<>())
+        .def("open", &Capture_reader::open, py::arg("path"), "Memory-map a capture file; False on error (last_error)")
+        .def("close", &Capture_reader::close)
+        .def("rewind", &Capture_reader::rewind)
+        .def("seek", &Capture_reader::seek, py::arg("time_ns"))
+        .def(
+            "next",
+            [](Capture_reader &self) -> py::object
+            {
+                Capture_reader::record_t r;
+                if (!self.next(&r))
+                    return py::none();
+                return py::make_tuple(r.type, r.time_ns,
+                                      py::bytes(reinterpret_cast<const char *>(r.data), r.length));
+            },
+            "Next (type, time_ns, bytes) record, or None at the end")
+        .def("replay", &Capture_reader::replay<Unify_link_base>, py::arg("link_base"), py::arg("speed") = 0.0,
+             py::call_guard<py::gil_scoped_release>(),
+             "Feed the remaining RX bytes into the link: speed 0 = as fast as possible, 1.0 = original timing")
+        .def_property_readonly("is_open", &Capture_reader::is_open)
+        .def_property_readonly("indexed", &Capture_reader::indexed)
+        .def_property_readonly("chunk_count", &Capture_reader::chunk_count)
+        .def_property_readonly("record_count", &Capture_reader::record_count)
+        .def_property_readonly("duration_ns", &Capture_reader::duration_ns)
+        .def_property_readonly("start_unix_ns", [](const Capture_reader &self) { return self.file_head().start_unix_ns; })
+        .def_property_readonly("last_error", &Capture_reader::last_error);
+#endif
+
+    py::class_<Unify_link_base> base_class(m, "UnifyLinkBase");
+    base_class.def(py::init<>())
+        .def("parse_data_task", &Unify_link_base::parse_data_task, py::call_guard<py::gil_scoped_release>(),
+             "Parse received buffer and dispatch frames (releases the GIL; callbacks re-acquire it)")
         .def("rev_data_push", &push_recv_data, py::arg("data"),
-             "Push raw bytes into the receive buffer. Returns False if the data does not fit.")
+             "Push raw bytes from any contiguous buffer (bytes, bytearray, memoryview, numpy) without copying. "
+             "Returns the number of bytes accepted; a chunk that does not fit keeps its prefix and the rest is "
+             "counted in rx_overflow_bytes.")
         .def("register_any_payload", &register_any_payload, py::arg("component_id"), py::arg("data_id"),
              "Register a handler that accepts any payload length for the given component/data ID.")
+        .def("register_default_any_payload", &register_default_any_payload,
+             "Accept any payload length for every component/data ID that has no registered handler.")
         .def("build_send_data", &build_send_data_bytes, py::arg("component_id"), py::arg("data_id"), py::arg("payload"),
              "Build a packet into the send buffer from raw payload bytes")
+        .def("set_bundle_policy", &set_bundle_policy, py::arg("max_bytes"), py::arg("deadline_ms") = 0,
+             "Coalesce small messages into bundle frames of up to max_bytes payload; 0 disables bundling.")
+        .def("flush_bundle", &Unify_link_base::flush_bundle, "Emit the pending bundle frame, returns its length")
+        .def("bundle_poll", &Unify_link_base::bundle_poll, "Emit the pending bundle frame once its deadline passed")
+        .def_property_readonly("bundle_pending", &Unify_link_base::bundle_pending)
+        .def("set_tx_priority", &Unify_link_base::set_tx_priority, py::arg("component_id"), py::arg("data_id"),
+             py::arg("priority"), py::arg("latest_wins") = false,
+             "Configure the TX class of an ID; latest_wins replaces a still-queued frame of the same ID in place")
+        .def_readonly("tx_replaced_count", &Unify_link_base::tx_replaced_count)
+        .def(
+            "send_reliable",
+            [](Unify_link_base &self, uint8_t component_id, uint8_t data_id, const py::buffer &payload)
+            {
+                self.set_clock(&host_clock_ms); // 重传超时以毫秒计
+                return send_reliable_bytes(self, component_id, data_id, payload);
+            },
+            py::arg("component_id"), py::arg("data_id"), py::arg("payload"),
+            "Send a frame that is retransmitted until the peer acknowledges it; returns 0 when the window is full")
+        .def(
+            "set_reliable",
+            [](Unify_link_base &self, uint8_t component_id, uint8_t data_id, bool enable)
+            {
+                self.set_clock(&host_clock_ms);
+                return self.set_reliable(component_id, data_id, enable);
+            },
+            py::arg("component_id"), py::arg("data_id"), py::arg("enable") = true,
+            "Route every build_send_data()/component send of this ID through send_reliable()")
+        .def("reliable_poll", &Unify_link_base::reliable_poll, "Retransmit unacknowledged frames whose RTO expired")
+        .def("send_fragmented", &send_fragmented_bytes, py::arg("component_id"), py::arg("data_id"), py::arg("payload"),
+             "Send a message larger than one frame as FRAME_FLAG_FRAGMENT frames; False while another is in progress")
+        .def("fragment_poll", &Unify_link_base::fragment_poll, "Queue further fragments as the send buffer drains")
+        .def_property_readonly("fragment_pending", &Unify_link_base::fragment_pending)
+        .def_readwrite("fragment_queue_limit", &Unify_link_base::fragment_queue_limit)
+        .def_property_readonly("reliable_pending", &Unify_link_base::reliable_pending)
+        .def_property_readonly("reliable_rto", &Unify_link_base::reliable_rto)
+        .def_property_readonly("reliable_srtt", &Unify_link_base::reliable_srtt)
+        .def_readwrite("reliable_rto_initial", &Unify_link_base::reliable_rto_initial)
+        .def_readwrite("reliable_rto_min", &Unify_link_base::reliable_rto_min)
+        .def_readwrite("reliable_rto_max", &Unify_link_base::reliable_rto_max)
+        .def_readwrite("reliable_max_retries", &Unify_link_base::reliable_max_retries)
+        .def_readonly("reliable_retransmit_count", &Unify_link_base::reliable_retransmit_count)
+        .def_readonly("reliable_fail_count", &Unify_link_base::reliable_fail_count)
+        .def_readonly("reliable_duplicate_count", &Unify_link_base::reliable_duplicate_count)
+        .def_readwrite("on_reliable_failed", &Unify_link_base::on_reliable_failed)
         .def("pop_send_buffer", &pop_send_buffer,
              "Pop all buffered outbound bytes as a Python bytes object (empties the buffer)")
+        .def("pop_send_into", &pop_send_into, py::arg("buffer"),
+             "Copy buffered outbound bytes into a preallocated writable buffer; returns the number of bytes written")
         .def_property_readonly("send_buff_used", &Unify_link_base::send_buff_used)
         .def_property_readonly("send_buff_remain", &Unify_link_base::send_buff_remain)
         .def_readonly("last_seq_id", &Unify_link_base::last_seq_id)
-        .def_readonly("com_error_count", &Unify_link_base::com_error_count)
-        .def_readonly("decode_error_count", &Unify_link_base::decode_error_count)
-        .def_readonly("success_count", &Unify_link_base::success_count);
+        .def_property_readonly("com_error_count", &Unify_link_base::com_error_count)
+        .def_property_readonly("decode_error_count", &Unify_link_base::decode_error_count)
+        .def_property_readonly("success_count", &Unify_link_base::success_count)
+        .def_property_readonly("rx_overflow_count",
+                               [](const Unify_link_base &self) { return self.rx_overflow_count.load(); })
+        .def_property_readonly("rx_overflow_bytes",
+                               [](const Unify_link_base &self) { return self.rx_overflow_bytes.load(); })
+        .def("stats_totals", &Unify_link_base::stats_totals, "Link-wide counters; safe to call from any thread")
+        .def("stats_messages", &stats_messages, "Counters for every (component_id, data_id) seen so far")
+        .def("message_stats", &message_stats, py::arg("component_id"), py::arg("data_id"),
+             "Counters for one (component_id, data_id), or None if it was never seen");
+
+#if UNIFY_LINK_LATENCY
+    py::enum_<Latency_stage>(m, "LatencyStage")
+        .value("TX_QUEUE", Latency_stage::TX_QUEUE)
+        .value("WIRE", Latency_stage::WIRE)
+        .value("RX_QUEUE", Latency_stage::RX_QUEUE)
+        .value("HANDLER", Latency_stage::HANDLER);
+
+    py::class_<Latency_histogram>(m, "LatencyHistogram")
+        .def_property_readonly("count", &Latency_histogram::count)
+        .def_property_readonly("min", &Latency_histogram::min)
+        .def_property_readonly("max", &Latency_histogram::max)
+        .def_property_readonly("mean", &Latency_histogram::mean)
+        .def("percentile", &Latency_histogram::percentile, py::arg("p"), "Upper bound of the bucket holding the p-th percentile (us)");
+
+    base_class
+        .def("enable_latency", [](Unify_link_base &self) { self.set_latency_clock(&host_clock_us); },
+             "Start sampling latency with a microsecond host clock")
+        .def("set_timestamped", &Unify_link_base::set_timestamped, py::arg("component_id"), py::arg("data_id"),
+             py::arg("enable") = true, "Send this ID with a 4-byte sender timestamp (FRAME_FLAG_TIMESTAMP)")
+        .def("latency_histogram", &Unify_link_base::latency_histogram, py::arg("component_id"), py::arg("data_id"),
+             py::arg("stage"), py::return_value_policy::reference_internal,
+             "LatencyHistogram for one ID and stage, or None before the first sample")
+        .def("wire_min_delta", &wire_min_delta, "Smallest (arrival - peer timestamp) seen so far, or None")
+        .def_static(
+            "estimate_clock_offset",
+            [](int32_t local_min, int32_t peer_min)
+            {
+                int32_t offset = 0;
+                int32_t delay = 0;
+                decltype(Unify_link_base::latency)::estimate_clock_offset(local_min, peer_min, &offset, &delay);
+                return py::make_tuple(offset, delay);
+            },
+            py::arg("local_min"), py::arg("peer_min"), "(offset, one_way_delay) from both ends' wire_min_delta()");
+#endif
 
     // Encoder bindings
     py::enum_<Encoder_link_t::ErrorCode>(m, "EncoderErrorCode")
@@ -153,7 +849,7 @@ PYBIND11_MODULE(unify_link, m)
         .def_readwrite("max_velocity", &Encoder_link_t::encoder_info_t::max_velocity)
         .def_readwrite("max_position", &Encoder_link_t::encoder_info_t::max_position)
         .def_readwrite("run_time", &Encoder_link_t::encoder_info_t::run_time)
-        .def_property(
+        .def_property(
             "model", [](const Encoder_link_t::encoder_info_t &self)
             { return char_array_to_string(self.model, sizeof(self.model)); },
             [](Encoder_link_t::encoder_info_t &self, const std::string &value)
@@ -172,6 +868,10 @@ PYBIND11_MODULE(unify_link, m)
 
     py::class_<Encoder_link_t>(m, "EncoderLink")
         .def(py::init<Unify_link_base &>(), py::arg("link_base"), py::keep_alive<1, 2>())
+        .def_property_readonly(
+            "encoder_basic_view", [](py::object self)
+            { return struct_view(self.cast<Encoder_link_t &>().encoder_basic, encoder_basic_dtype(), self); },
+            "Zero-copy NumPy structured array over encoder_basic (updated in place by parse_data_task)")
         .def_property(
             "encoder_basic", [](Encoder_link_t &self) { return copy_array(self.encoder_basic); },
             [](Encoder_link_t &self, const std::vector<Encoder_link_t::encoder_basic_t> &values)
@@ -227,11 +927,11 @@ PYBIND11_MODULE(unify_link, m)
         .def_readwrite("firmware_version", &Motor_link_t::info_t::firmware_version);
 
     py::class_<Motor_link_t::settings_t>(m, "MotorSettings")
-        .def(py::init<>())
+        .def(py::init<>())
         .def_readwrite("motor_id", &Motor_link_t::settings_t::motor_id)
         .def_readwrite("feedback_interval", &Motor_link_t::settings_t::feedback_interval)
         .def_readwrite("reset_id", &Motor_link_t::settings_t::reset_id)
-        .def_property(
+        .def_property(
             "mode", [](const Motor_link_t::settings_t &self) { return self.mode; },
             [](Motor_link_t::settings_t &self, Motor_link_t::MotorMode mode) { self.mode = mode; });
 
@@ -258,6 +958,18 @@ PYBIND11_MODULE(unify_link, m)
         .def_readwrite("speed_pid", &Motor_link_t::pid_t::speed_pid)
         .def_readwrite("position_pid", &Motor_link_t::pid_t::position_pid);
 
+    py::class_<Motor_history_t, std::shared_ptr<Motor_history_t>>(m, "MotorHistory")
+        .def_readonly("samples", &Motor_history_t::samples,
+                      "Ring storage, shape (capacity, MAX_MOTORS); row count % capacity is written next")
+        .def_readonly("timestamps", &Motor_history_t::timestamps, "Receive time of each row (time.monotonic() seconds)")
+        .def_readonly("capacity", &Motor_history_t::capacity)
+        .def_property_readonly("count", &Motor_history_t::count, "Snapshots appended so far (not capped at capacity)")
+        .def("__len__", &Motor_history_t::size)
+        .def(
+            "latest", [](const Motor_history_t &self, py::object n)
+            { return self.latest(n.is_none() ? self.capacity : n.cast<size_t>()); },
+            py::arg("n") = py::none(), "Chronological copy of the last n rows: (samples, timestamps)");
+
     py::class_<Motor_link_t>(m, "MotorLink")
         .def(py::init<Unify_link_base &>(), py::arg("link_base"), py::keep_alive<1, 2>())
         .def_property(
@@ -279,17 +991,42 @@ PYBIND11_MODULE(unify_link, m)
         .def_property(
             "motor_pid", [](Motor_link_t &self) { return self.motor_pid; },
             [](Motor_link_t &self, const Motor_link_t::pid_t &value) { self.motor_pid = value; })
+        .def_property_readonly(
+            "motor_basic_view", [](py::object self)
+            { return struct_view(self.cast<Motor_link_t &>().motor_basic, motor_feedback_dtype(), self); },
+            "Zero-copy NumPy structured array over motor_basic (updated in place by parse_data_task)")
+        .def_property_readonly(
+            "motor_set_view", [](py::object self)
+            { return struct_view(self.cast<Motor_link_t &>().motor_set, motor_set_dtype(), self); },
+            "Writable zero-copy NumPy structured array over motor_set; call send_motor_set_data() after editing")
         .def_property(
             "on_motor_basic_updated",
-            [](Motor_link_t &) { return py::none(); },
-            [](Motor_link_t &self, const py::function &cb)
+            [](Motor_link_t &self) -> py::object
             {
-                self.on_motor_basic_updated = [cb](const Motor_link_t::feedback_t (&data)[Motor_link_t::MAX_MOTORS])
-                {
-                    py::gil_scoped_acquire gil;
-                    cb(copy_array(data));
-                };
-            })
+                const auto *hook = self.on_motor_basic_updated.target<Motor_basic_hook_t>();
+                return hook != nullptr && hook->callback ? hook->callback : py::none();
+            },
+            [](Motor_link_t &self, const py::object &cb)
+            { motor_basic_hook(self).callback = cb.is_none() ? py::object() : cb; })
+        .def(
+            "enable_history",
+            [](Motor_link_t &self, size_t capacity)
+            {
+                if (capacity == 0)
+                    throw std::invalid_argument("capacity must be positive");
+                auto history = std::make_shared<Motor_history_t>(capacity, motor_feedback_dtype());
+                motor_basic_hook(self).history = history;
+                return history;
+            },
+            py::arg("capacity"),
+            "Record every motor_basic update into a preallocated ring; call before parsing starts in another thread")
+        .def("disable_history", [](Motor_link_t &self) { motor_basic_hook(self).history.reset(); })
+        .def_property_readonly("history",
+                               [](Motor_link_t &self) -> std::shared_ptr<Motor_history_t>
+                               {
+                                   const auto *hook = self.on_motor_basic_updated.target<Motor_basic_hook_t>();
+                                   return hook != nullptr ? hook->history : nullptr;
+                               })
         .def_readwrite("on_motor_info_updated", &Motor_link_t::on_motor_info_updated)
         .def_readwrite("on_motor_settings_updated", &Motor_link_t::on_motor_settings_updated)
         .def_property(
@@ -315,6 +1052,14 @@ PYBIND11_MODULE(unify_link, m)
              py::overload_cast<const Motor_link_t::settings_t &>(&Motor_link_t::send_motor_setting_data),
              py::arg("settings"))
         .def("send_motor_set_data", py::overload_cast<>(&Motor_link_t::send_motor_set_data))
+        .def("send_motor_basic_delta", py::overload_cast<>(&Motor_link_t::send_motor_basic_delta),
+             "Send only the feedback entries that changed since the last send (periodic full keyframe)")
+        .def("send_motor_set_delta", py::overload_cast<>(&Motor_link_t::send_motor_set_delta),
+             "Send only the setpoint entries that changed since the last send (periodic full keyframe)")
+        .def("request_keyframe", &Motor_link_t::request_keyframe)
+        .def("set_reliable_config", &Motor_link_t::set_reliable_config, py::arg("enable") = true,
+             "Acknowledge/retransmit setting and PID messages (call reliable_poll() on the link periodically)")
+        .def_readwrite("keyframe_interval", &Motor_link_t::keyframe_interval)
         .def("set_motor_mode", &Motor_link_t::set_motor_mode, py::arg("motor_id"), py::arg("mode"))
         .def("set_motor_current", &Motor_link_t::set_motor_current, py::arg("motor_id"), py::arg("currentq"),
              py::arg("currentd") = 0)
@@ -327,6 +1072,67 @@ PYBIND11_MODULE(unify_link, m)
         .def_readonly_static("MAX_MOTORS", &Motor_link_t::MAX_MOTORS);
 
     // Update bindings
+    // 状态快照：设备端按请求流式发送登记的状态块，主机端按 (代数, CRC) 只取回变化的块
+    py::class_<Snapshot_server>(m, "SnapshotServer")
+        .def(py::init<Unify_link_base &>(), py::arg("link_base"), py::keep_alive<1, 2>())
+        .def("add_registered", &Snapshot_server::add_registered, py::arg("component_id"),
+             "Add every fixed-length registered dst of this component; returns the number added")
+        .def(
+            "add_motor", [](Snapshot_server &self, Motor_link_t &motor) { return add_motor_snapshot(self, motor); },
+            py::arg("motor"), py::keep_alive<1, 2>(), "Add motor_info, motor_settings and motor_pid")
+        .def(
+            "add_encoder", [](Snapshot_server &self, Encoder_link_t &encoder)
+            { return add_encoder_snapshot(self, encoder); }, py::arg("encoder"), py::keep_alive<1, 2>(),
+            "Add encoder_info and encoder_setting")
+        .def("touch", &Snapshot_server::touch, py::arg("component_id"), py::arg("data_id"),
+             "Send this blob on the next request even if it did not change")
+        .def("poll", &Snapshot_server::poll, "Continue a snapshot that did not fit in the send buffer")
+        .def_property_readonly("streaming", &Snapshot_server::streaming)
+        .def_property_readonly("size", &Snapshot_server::size)
+        .def_property_readonly("request_count", &Snapshot_server::request_count);
+
+    py::class_<State_mirror::entry_t>(m, "MirrorEntry")
+        .def_readonly("component_id", &State_mirror::entry_t::component_id)
+        .def_readonly("data_id", &State_mirror::entry_t::data_id)
+        .def_readonly("count", &State_mirror::entry_t::count)
+        .def_readonly("element_length", &State_mirror::entry_t::element_length)
+        .def_readonly("generation", &State_mirror::entry_t::generation)
+        .def_readonly("crc", &State_mirror::entry_t::crc)
+        .def_readonly("valid", &State_mirror::entry_t::valid);
+
+    py::class_<State_mirror::sync_result_t>(m, "SyncResult")
+        .def_readonly("entries", &State_mirror::sync_result_t::entries)
+        .def_readonly("fetched", &State_mirror::sync_result_t::fetched)
+        .def_readonly("frames", &State_mirror::sync_result_t::frames)
+        .def_readonly("complete", &State_mirror::sync_result_t::complete);
+
+    py::class_<State_mirror>(m, "StateMirror")
+        .def(py::init<Unify_link_base &>(), py::arg("link_base"), py::keep_alive<1, 2>())
+        .def("request", &State_mirror::request, py::arg("full") = false,
+             "Request a snapshot carrying the known versions; only changed blobs are sent back")
+        .def("invalidate", &State_mirror::invalidate, "Forget every version so the next request fetches all")
+        .def_property_readonly("busy", &State_mirror::busy)
+        .def_property_readonly("synced", &State_mirror::synced)
+        .def_property_readonly("last_result", &State_mirror::last_result)
+        .def(
+            "entries",
+            [](const State_mirror &self)
+            {
+                std::vector<State_mirror::entry_t> out;
+                for (uint8_t i = 0; i < self.size(); ++i)
+                    out.push_back(self[i]);
+                return out;
+            })
+        .def(
+            "find",
+            [](const State_mirror &self, uint8_t component_id, uint8_t data_id) -> py::object
+            {
+                const auto *entry = self.find(component_id, data_id);
+                return entry != nullptr ? py::cast(*entry) : py::none();
+            },
+            py::arg("component_id"), py::arg("data_id"))
+        .def_readwrite("on_synced", &State_mirror::on_synced, "Called with a SyncResult when the snapshot ends");
+
     py::class_<Update_Link_t::firmware_info_t>(m, "FirmwareInfo")
         .def(py::init<>())
         .def_property(
@@ -339,6 +1145,15 @@ PYBIND11_MODULE(unify_link, m)
         .def(py::init<>())
         .def_readwrite("crc16", &Update_Link_t::firmware_crc_t::crc16);
 
+    py::enum_<Update_Link_t::FirmwareStatus>(m, "FirmwareStatus")
+        .value("IDLE", Update_Link_t::FirmwareStatus::IDLE)
+        .value("BUSY", Update_Link_t::FirmwareStatus::BUSY)
+        .value("DONE", Update_Link_t::FirmwareStatus::DONE)
+        .value("CRC_ERROR", Update_Link_t::FirmwareStatus::CRC_ERROR)
+        .value("WRITE_ERROR", Update_Link_t::FirmwareStatus::WRITE_ERROR)
+        .value("REJECTED", Update_Link_t::FirmwareStatus::REJECTED)
+        .value("TIMEOUT", Update_Link_t::FirmwareStatus::TIMEOUT);
+
     py::class_<Update_Link_t>(m, "UpdateLink")
         .def(py::init<Unify_link_base &>(), py::arg("link_base"), py::keep_alive<1, 2>())
         .def_property(
@@ -349,5 +1164,123 @@ PYBIND11_MODULE(unify_link, m)
             [](Update_Link_t &self, const Update_Link_t::firmware_crc_t &value) { self.firmware_crc = value; })
         .def("send_firmware_info", py::overload_cast<>(&Update_Link_t::send_firmware_info))
         .def("send_firmware_crc", py::overload_cast<>(&Update_Link_t::send_firmware_crc))
+        // 镜像在传输期间被 C++ 侧直接引用：keep_alive 保证 bytes 对象至少与 UpdateLink 同寿命
+        .def(
+            "start_firmware_transfer", [](Update_Link_t &self, const py::bytes &image, uint16_t chunk_size)
+            {
+                char *data = nullptr;
+                Py_ssize_t size = 0;
+                PyBytes_AsStringAndSize(image.ptr(), &data, &size);
+                self.link_base.set_clock(&host_clock_ms); // 重传超时以毫秒计
+                return self.start_firmware_transfer(reinterpret_cast<const uint8_t *>(data),
+                                                    static_cast<uint32_t>(size), chunk_size);
+            },
+            py::arg("image"), py::arg("chunk_size") = 0, py::keep_alive<1, 2>())
+        .def("firmware_transfer_task", &Update_Link_t::firmware_transfer_task)
+        .def_property_readonly("firmware_send_status", &Update_Link_t::firmware_send_status)
+        .def_property_readonly("firmware_receive_status", &Update_Link_t::firmware_receive_status)
+        .def_property_readonly("firmware_acked_bytes", &Update_Link_t::firmware_acked_bytes)
+        .def_readwrite("fw_retransmit_timeout", &Update_Link_t::fw_retransmit_timeout)
+        .def_readwrite("fw_max_retries", &Update_Link_t::fw_max_retries)
+        .def_readwrite("fw_ack_every", &Update_Link_t::fw_ack_every)
+        .def_readwrite("on_firmware_sent", &Update_Link_t::on_firmware_sent)
         .def_readonly_static("component_id", &Update_Link_t::component_id);
+
+#if defined(UNIFY_LINK_HAS_SERIAL)
+    // Linux serial transport: reads/writes the link buffers directly, poll_once() runs without the GIL
+    py::class_<Serial_transport>(m, "SerialTransport")
+        .def(py::init<Unify_link_base &>(), py::arg("link_base"), py::keep_alive<1, 2>())
+        .def(
+            "open",
+            [](Serial_transport &self, const std::string &path, uint32_t baud_rate, bool low_latency,
+               bool hw_flow_control)
+            {
+                Serial_transport::options_t options;
+                options.baud_rate = baud_rate;
+                options.low_latency = low_latency;
+                options.hw_flow_control = hw_flow_control;
+                return self.open(path.c_str(), options);
+            },
+            py::arg("path"), py::arg("baud_rate") = 115200, py::arg("low_latency") = true,
+            py::arg("hw_flow_control") = false, "Open the tty in raw mode; returns False and sets last_error on failure")
+        .def("close", &Serial_transport::close)
+        .def("poll_once", &Serial_transport::poll_once, py::arg("timeout_ms") = 10,
+             py::call_guard<py::gil_scoped_release>(),
+             "Wait up to timeout_ms for I/O, parse received frames and drain the send buffer")
+        .def("wake", &Serial_transport::wake, "Interrupt a poll_once() running in another thread; frames must still be sent from the polling thread")
+        .def_property_readonly("is_open", &Serial_transport::is_open)
+        .def_property_readonly("last_error", &Serial_transport::last_error)
+        .def_property_readonly("low_latency_enabled", &Serial_transport::low_latency_enabled)
+        .def_readonly("rx_bytes", &Serial_transport::rx_bytes)
+        .def_readonly("tx_bytes", &Serial_transport::tx_bytes)
+        .def_readonly("read_calls", &Serial_transport::read_calls)
+        .def_readonly("write_calls", &Serial_transport::write_calls)
+        .def(
+            "set_capture",
+            [](Serial_transport &self, Capture_writer *writer)
+            { self.set_byte_tap(writer != nullptr ? writer->byte_tap() : byte_tap_func_t{}); },
+            py::arg("writer"), py::keep_alive<1, 2>(),
+            "Record every byte read from / written to the tty (None to stop); set before polling");
+
+    // Multi-link hub: worker threads own the links; Python only reads the published statistics
+    py::class_<Link_hub::link_stats_t>(m, "LinkHubStats")
+        .def_readonly("rx_bytes", &Link_hub::link_stats_t::rx_bytes)
+        .def_readonly("tx_bytes", &Link_hub::link_stats_t::tx_bytes)
+        .def_readonly("success_count", &Link_hub::link_stats_t::success_count)
+        .def_readonly("com_error_count", &Link_hub::link_stats_t::com_error_count)
+        .def_readonly("decode_error_count", &Link_hub::link_stats_t::decode_error_count)
+        .def_readonly("resync_count", &Link_hub::link_stats_t::resync_count)
+        .def_readonly("open", &Link_hub::link_stats_t::open)
+        .def_readonly("error", &Link_hub::link_stats_t::error);
+
+    py::class_<Link_hub>(m, "LinkHub")
+        .def(py::init<unsigned, int>(), py::arg("worker_count") = 1, py::arg("tick_ms") = 5)
+        .def(
+            "add_port",
+            [](Link_hub &self, const std::string &path, uint32_t baud_rate, bool low_latency, bool hw_flow_control)
+            {
+                Link_hub::transport_type::options_t options;
+                options.baud_rate = baud_rate;
+                options.low_latency = low_latency;
+                options.hw_flow_control = hw_flow_control;
+                return self.add_port(path.c_str(), options);
+            },
+            py::arg("path"), py::arg("baud_rate") = 115200, py::arg("low_latency") = true,
+            py::arg("hw_flow_control") = false, "Open a tty before start(); returns the link index or -1")
+        .def("add_fd", &Link_hub::add_fd, py::arg("fd"))
+        .def("link", &Link_hub::link, py::arg("index"), py::return_value_policy::reference_internal,
+             "Link object; bind components and callbacks before start()")
+        .def("worker_of", &Link_hub::worker_of, py::arg("index"))
+        .def("start", &Link_hub::start)
+        .def("stop", &Link_hub::stop, py::call_guard<py::gil_scoped_release>())
+        .def(
+            "send",
+            [](Link_hub &self, size_t index, uint8_t component_id, uint8_t data_id, const py::buffer &payload)
+            {
+                buffer_view_t view(payload);
+                if (index >= self.size() || view.size() > 0xFFFE)
+                    throw std::out_of_range("link index or payload length out of range");
+                std::vector<uint8_t> copy(view.data(), view.data() + view.size());
+                self.post(index, [component_id, data_id, copy = std::move(copy)](Unify_link_base &link)
+                          { link.build_send_data(component_id, data_id, copy.data(), static_cast<uint16_t>(copy.size())); });
+            },
+            py::arg("index"), py::arg("component_id"), py::arg("data_id"), py::arg("payload"),
+            "Thread-safe: queue a frame on the link's worker thread (an empty payload is a request frame)")
+        .def("stats", &Link_hub::stats, py::arg("index"))
+        .def("total_stats", &Link_hub::total_stats)
+        .def("__len__", &Link_hub::size)
+        .def_property_readonly("running", &Link_hub::running)
+        .def_property_readonly("worker_count", &Link_hub::worker_count)
+        .def_property_readonly("last_error", &Link_hub::last_error);
+
+    // Decoded-frame batches for asyncio (see unify_link.aio)
+    py::class_<Frame_queue_t>(m, "FrameQueue")
+        .def(py::init<size_t>(), py::arg("capacity") = 4096)
+        .def("fileno", &Frame_queue_t::fileno, "eventfd that becomes readable when a batch is waiting")
+        .def("subscribe", &Frame_queue_t::subscribe, py::arg("link_base"), py::arg("index"), py::arg("component_id"),
+             py::arg("data_id"), "Queue every accepted frame of this ID after its existing handler; before start()")
+        .def("drain", &Frame_queue_t::drain, "Take the whole batch: [(index, component_id, data_id, payload), ...]")
+        .def_readonly("capacity", &Frame_queue_t::capacity)
+        .def_property_readonly("dropped", &Frame_queue_t::dropped, "Frames discarded because the batch was full");
+#endif
 }
@@ -0,0 +1,132 @@
+/**
+ * @file alloc_audit_test.cpp
+ * @brief Asserts that the steady-state send/parse hot path performs no heap allocation
+ */
+
+#define UNIFY_LINK_ALLOC_AUDIT_IMPLEMENT
+#define UNIFY_LINK_RELIABLE_STORE 2048
+#include "unify_link_alloc_audit.hpp"
+
+#include "link_test_helpers.hpp"
+#include "unify_link_dispatch.hpp"
+#include "unify_link_monitor.hpp"
+
+#include <gtest/gtest.h>
+#include <memory>
+
+using namespace unify_link;
+
+namespace
+{
+    uint32_t g_now_ms = 0;
+    uint32_t test_clock() { return g_now_ms; }
+} // namespace
+
+using unify_link_test::pipe_all;
+
+// 夹具对象（含链路）在审计区间之外构造
+class AllocAuditTest : public unify_link_test::Device_host_test
+{
+protected:
+    void SetUp() override { ASSERT_TRUE(alloc_audit::hooked()); }
+
+    // 一轮稳态流量：组件发送、请求 / 应答、回调
+    void traffic()
+    {
+        for (uint8_t id = 0; id < Motor_link_t::MAX_MOTORS; ++id)
+        {
+            device_motor.motor_basic[id].position++;
+            device_motor.send_motor_info_data(id);
+        }
+        device_motor.send_motor_basic_data();
+        device_encoder.encoder_basic[0].velocity++;
+        device_encoder.send_encoder_basic_data();
+        pipe_all(device, host);
+
+        host_motor.send_motor_set_data();
+        host.build_send_data(COMPONENT_ID_MOTORS, Motor_link_t::MOTOR_BASIC_ID, nullptr, 0); // 请求
+        pipe_all(host, device);
+        pipe_all(device, host);
+    }
+};
+
+TEST_F(AllocAuditTest, AuditCountsAllocationsInScope)
+{
+    Alloc_audit_scope audit;
+    auto p = std::make_unique<int>(1);
+    EXPECT_EQ(audit.allocations(), 1u);
+    EXPECT_EQ(audit.all_threads(), 1u);
+}
+
+TEST_F(AllocAuditTest, SendAndParseHotPathDoesNotAllocate)
+{
+    uint32_t info_calls = 0;
+    host_motor.on_motor_info_updated = [&info_calls](const Motor_link_t::info_t &) { info_calls++; };
+
+    traffic(); // 预热
+    const uint32_t before = host.success_count();
+
+    Alloc_audit_scope audit;
+    for (int i = 0; i < 100; ++i)
+        traffic();
+    EXPECT_EQ(audit.allocations(), 0u);
+
+    EXPECT_GT(host.success_count(), before);
+    EXPECT_EQ(info_calls, 101u * Motor_link_t::MAX_MOTORS);
+}
+
+TEST_F(AllocAuditTest, MonitorReliableAndBundlesDoNotAllocate)
+{
+    device.set_clock(&test_clock);
+    host.set_clock(&test_clock);
+    Link_monitor monitor(host, &test_clock);
+    ASSERT_TRUE(device.set_reliable(COMPONENT_ID_MOTORS, Motor_link_t::MOTOR_INFO_ID));
+    device.set_bundle_policy(256, 2);
+
+    traffic();
+    Alloc_audit_scope audit;
+    for (int i = 0; i < 100; ++i)
+    {
+        traffic();
+        device.flush_bundle();
+        pipe_all(device, host);
+        pipe_all(host, device); // 链路确认
+        device.reliable_poll();
+        g_now_ms++;
+    }
+    EXPECT_EQ(audit.allocations(), 0u);
+
+    Link_monitor::snapshot_t snap;
+    monitor.snapshot(&snap);
+    EXPECT_GT(snap.totals.rx_frames, 0u);
+}
+
+TEST_F(AllocAuditTest, ParallelDispatchUsesFramePoolOnly)
+{
+    uint32_t info_calls = 0;
+    host_motor.on_motor_info_updated = [&info_calls](const Motor_link_t::info_t &) { info_calls++; };
+
+    auto dispatcher = std::make_unique<Parallel_dispatcher>(host);
+    ASSERT_TRUE(dispatcher->offload(COMPONENT_ID_MOTORS));
+    dispatcher->start();
+    traffic();
+    dispatcher->flush();
+
+    Alloc_audit_scope audit;
+    for (int i = 0; i < 100; ++i)
+    {
+        traffic();
+        dispatcher->flush();
+    }
+    EXPECT_EQ(audit.all_threads(), 0u); // 包括执行线程
+
+    dispatcher->stop();
+    EXPECT_EQ(info_calls, 101u * Motor_link_t::MAX_MOTORS);
+    EXPECT_EQ(dispatcher->frame_pool().in_use(), 0u);
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
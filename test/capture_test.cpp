@@ -0,0 +1,322 @@
+/**
+ * @file capture_test.cpp
+ * @brief Unit tests for the traffic capture file writer, mmap reader and replay
+ */
+
+#include "unify_link_capture.hpp"
+#include "unify_link_monitor.hpp"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using namespace unify_link;
+
+namespace
+{
+    uint32_t zero_clock() { return 0; }
+} // namespace
+
+class CaptureTest : public ::testing::Test
+{
+protected:
+    std::string path;
+
+    void SetUp() override
+    {
+        path = ::testing::TempDir() + "unify_link_capture_" +
+               ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".ulcap";
+    }
+
+    void TearDown() override { ::unlink(path.c_str()); }
+
+    // 设备发送 count 帧电机反馈，主机解析并录制：返回主机解析成功的帧数
+    uint64_t record_session(Capture_writer &writer, uint32_t count, uint32_t chunk_size = 4096)
+    {
+        Unify_link_base device;
+        Unify_link_base host;
+        uint8_t dst[16] = {0};
+        host.register_handle_data(COMPONENT_ID_MOTORS, 0x01, dst, nullptr, sizeof(dst));
+
+        EXPECT_TRUE(writer.open(path.c_str(), chunk_size));
+        writer.attach_frames(host);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            uint8_t payload[16];
+            for (uint8_t &b : payload)
+                b = static_cast<uint8_t>(i);
+            device.build_send_data(COMPONENT_ID_MOTORS, 0x01, payload, sizeof(payload));
+
+            uint8_t bytes[2 * MAX_SEND_BUFF_LENGTH];
+            uint32_t len = 0;
+            device.send_buff_pop(bytes, &len);
+            writer.rx(bytes, len);
+            host.rev_data_push(bytes, len);
+            host.parse_data_task();
+        }
+        writer.detach_frames();
+        return host.success_count();
+    }
+};
+
+TEST_F(CaptureTest, ReplayReproducesRecordedFrames)
+{
+    Capture_writer writer;
+    ASSERT_EQ(record_session(writer, 500), 500u);
+    EXPECT_EQ(writer.records(), 1000u); // RX 字节块 + 帧边界
+    ASSERT_TRUE(writer.close());
+
+    Capture_reader reader;
+    ASSERT_TRUE(reader.open(path.c_str()));
+    EXPECT_TRUE(reader.indexed());
+    EXPECT_GT(reader.chunk_count(), 1u);
+    EXPECT_EQ(reader.record_count(), 1000u);
+
+    Unify_link_base replayed;
+    uint8_t dst[16] = {0};
+    replayed.register_handle_data(COMPONENT_ID_MOTORS, 0x01, dst, nullptr, sizeof(dst));
+    const auto stats = reader.replay(replayed);
+    EXPECT_EQ(stats.records, 1000u);
+    EXPECT_EQ(stats.captured_frames, 500u);
+    EXPECT_EQ(replayed.success_count(), 500u);
+    EXPECT_EQ(replayed.com_error_count(), 0u);
+    EXPECT_EQ(dst[0], static_cast<uint8_t>(499));
+}
+
+TEST_F(CaptureTest, FrameRecordsHoldFrameHeads)
+{
+    Capture_writer writer;
+    record_session(writer, 3);
+    writer.close();
+
+    Capture_reader reader;
+    ASSERT_TRUE(reader.open(path.c_str()));
+    Capture_reader::record_t r;
+    std::vector<Capture_reader::record_t> frames;
+    uint64_t last_ns = 0;
+    while (reader.next(&r))
+    {
+        EXPECT_GE(r.time_ns, last_ns);
+        last_ns = r.time_ns;
+        if (r.type == Capture_record_type::FRAME)
+            frames.push_back(r);
+    }
+    ASSERT_EQ(frames.size(), 3u);
+    unify_link_frame_head_t head;
+    ASSERT_EQ(frames[2].length, sizeof(head));
+    std::memcpy(&head, frames[2].data, sizeof(head));
+    EXPECT_EQ(head.component_id, COMPONENT_ID_MOTORS);
+    EXPECT_EQ(head.data_id, 0x01);
+    EXPECT_EQ(head.length(), 16u);
+}
+
+TEST_F(CaptureTest, AttachChainsWithExistingTap)
+{
+    Unify_link_base device;
+    Unify_link_base host;
+    Link_monitor monitor{host, &zero_clock};
+    {
+        Capture_writer writer;
+        ASSERT_TRUE(writer.open(path.c_str()));
+        writer.attach_frames(host);
+
+        const uint8_t payload[4] = {0};
+        device.build_send_data(COMPONENT_ID_ENCODERS, 0x02, payload, sizeof(payload));
+        uint8_t bytes[64];
+        uint32_t len = 0;
+        device.send_buff_pop(bytes, &len);
+        host.rev_data_push(bytes, len);
+        host.parse_data_task();
+        EXPECT_EQ(writer.records(), 1u);
+    } // 析构时只摘除写入器自己的 tap
+
+    Link_monitor::snapshot_t snap;
+    monitor.snapshot(&snap);
+    EXPECT_EQ(snap.tap_frames, 1u);
+
+    const uint8_t payload[4] = {0};
+    device.build_send_data(COMPONENT_ID_ENCODERS, 0x02, payload, sizeof(payload));
+    uint8_t bytes[64];
+    uint32_t len = 0;
+    device.send_buff_pop(bytes, &len);
+    host.rev_data_push(bytes, len);
+    host.parse_data_task();
+    monitor.snapshot(&snap);
+    EXPECT_EQ(snap.tap_frames, 2u);
+}
+
+TEST_F(CaptureTest, DetachKeepsObserverAttachedLater)
+{
+    Unify_link_base device;
+    Unify_link_base host;
+    Capture_writer writer;
+    ASSERT_TRUE(writer.open(path.c_str()));
+    writer.attach_frames(host);
+    Link_monitor monitor{host, &zero_clock}; // 在写入器之后接入
+
+    auto deliver = [&]
+    {
+        const uint8_t payload[4] = {0};
+        device.build_send_data(COMPONENT_ID_ENCODERS, 0x02, payload, sizeof(payload));
+        uint8_t bytes[64];
+        uint32_t len = 0;
+        device.send_buff_pop(bytes, &len);
+        host.rev_data_push(bytes, len);
+        host.parse_data_task();
+    };
+
+    deliver();
+    ASSERT_TRUE(writer.close());
+    deliver();
+
+    EXPECT_EQ(writer.records(), 1u);
+    Link_monitor::snapshot_t snap;
+    monitor.snapshot(&snap);
+    EXPECT_EQ(snap.tap_frames, 2u);
+}
+
+TEST_F(CaptureTest, UnclosedFileIsRecoveredByScanning)
+{
+    Capture_writer writer;
+    record_session(writer, 200, 1024);
+    ASSERT_TRUE(writer.flush());
+
+    // 模拟进程崩溃：文件没有索引，且最后一个块只写了一部分
+    Capture_reader full;
+    ASSERT_TRUE(full.open(path.c_str()));
+    EXPECT_FALSE(full.indexed());
+    const size_t chunks = full.chunk_count();
+    full.close();
+
+    struct stat st{};
+    ASSERT_EQ(::stat(path.c_str(), &st), 0);
+    const std::string crashed = path + ".crashed";
+    {
+        std::vector<uint8_t> bytes(static_cast<size_t>(st.st_size) - 10);
+        const int in = ::open(path.c_str(), O_RDONLY);
+        const int out = ::open(crashed.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        ASSERT_EQ(::read(in, bytes.data(), bytes.size()), static_cast<ssize_t>(bytes.size()));
+        ASSERT_EQ(::write(out, bytes.data(), bytes.size()), static_cast<ssize_t>(bytes.size()));
+        ::close(in);
+        ::close(out);
+    }
+
+    Capture_reader reader;
+    ASSERT_TRUE(reader.open(crashed.c_str()));
+    EXPECT_FALSE(reader.indexed());
+    EXPECT_EQ(reader.chunk_count(), chunks - 1);
+
+    Unify_link_base replayed;
+    uint8_t dst[16] = {0};
+    replayed.register_handle_data(COMPONENT_ID_MOTORS, 0x01, dst, nullptr, sizeof(dst));
+    const auto stats = reader.replay(replayed);
+    EXPECT_EQ(replayed.success_count(), stats.captured_frames);
+    EXPECT_LT(stats.captured_frames, 200u);
+    EXPECT_GT(stats.captured_frames, 0u);
+    ::unlink(crashed.c_str());
+}
+
+TEST_F(CaptureTest, SeekFindsFirstRecordAtOrAfterTime)
+{
+    Capture_writer writer;
+    record_session(writer, 300, 1024);
+    writer.close();
+
+    Capture_reader reader;
+    ASSERT_TRUE(reader.open(path.c_str()));
+    std::vector<uint64_t> times;
+    Capture_reader::record_t r;
+    while (reader.next(&r))
+        times.push_back(r.time_ns);
+
+    const uint64_t target = times[times.size() * 2 / 3];
+    reader.seek(target);
+    ASSERT_TRUE(reader.next(&r));
+    EXPECT_EQ(r.time_ns, *std::lower_bound(times.begin(), times.end(), target));
+
+    reader.seek(0);
+    ASSERT_TRUE(reader.next(&r));
+    EXPECT_EQ(r.time_ns, times.front());
+
+    reader.seek(times.back() + 1);
+    EXPECT_FALSE(reader.next(&r));
+}
+
+TEST_F(CaptureTest, CorruptedRecordLengthStopsOnlyItsChunk)
+{
+    Capture_writer writer;
+    record_session(writer, 200, 1024);
+    writer.close();
+
+    uint64_t total = 0;
+    {
+        Capture_reader reader;
+        ASSERT_TRUE(reader.open(path.c_str()));
+        ASSERT_GT(reader.chunk_count(), 2u);
+        total = reader.record_count();
+    }
+
+    // 第一块第一条记录的长度改为越出块（及文件映射）的值
+    const int fd = ::open(path.c_str(), O_RDWR);
+    ASSERT_GE(fd, 0);
+    capture_chunk_head_t first_chunk;
+    ASSERT_EQ(::pread(fd, &first_chunk, sizeof(first_chunk), sizeof(capture_file_head_t)),
+              static_cast<ssize_t>(sizeof(first_chunk)));
+    const uint16_t bogus = 0xFFFF;
+    const off_t length_at = sizeof(capture_file_head_t) + sizeof(capture_chunk_head_t) + sizeof(uint64_t);
+    ASSERT_EQ(::pwrite(fd, &bogus, sizeof(bogus), length_at), static_cast<ssize_t>(sizeof(bogus)));
+    ::close(fd);
+
+    Capture_reader reader;
+    ASSERT_TRUE(reader.open(path.c_str()));
+    uint64_t read = 0;
+    Capture_reader::record_t r;
+    while (reader.next(&r))
+    {
+        EXPECT_NE(r.length, bogus);
+        read++;
+    }
+    EXPECT_EQ(read, total - first_chunk.records);
+
+    reader.seek(0); // 块内顺序前进同样止于损坏的记录
+    ASSERT_TRUE(reader.next(&r));
+    EXPECT_NE(r.length, bogus);
+}
+
+TEST_F(CaptureTest, LargeByteBlocksAreSplitAndRejectsForeignFiles)
+{
+    Capture_writer writer;
+    ASSERT_TRUE(writer.open(path.c_str()));
+    std::vector<uint8_t> block(150000, 0x5A);
+    writer.tx(block.data(), static_cast<uint32_t>(block.size()));
+    EXPECT_EQ(writer.records(), 3u);
+    writer.close();
+
+    Capture_reader reader;
+    ASSERT_TRUE(reader.open(path.c_str()));
+    Capture_reader::record_t r;
+    uint64_t total = 0;
+    while (reader.next(&r))
+    {
+        EXPECT_EQ(r.type, Capture_record_type::TX);
+        total += r.length;
+    }
+    EXPECT_EQ(total, block.size());
+    reader.close();
+
+    const int fd = ::open(path.c_str(), O_WRONLY | O_TRUNC);
+    ASSERT_GE(fd, 0);
+    const char junk[64] = "not a capture";
+    ASSERT_EQ(::write(fd, junk, sizeof(junk)), static_cast<ssize_t>(sizeof(junk)));
+    ::close(fd);
+    EXPECT_FALSE(reader.open(path.c_str()));
+    EXPECT_EQ(reader.last_error(), EINVAL);
+    EXPECT_FALSE(reader.open((path + ".missing").c_str()));
+    EXPECT_EQ(reader.last_error(), ENOENT);
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
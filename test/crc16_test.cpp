@@ -6,6 +6,7 @@
 #include "CRC16.hpp"
 
 #include <gtest/gtest.h>
+#include <vector>
 
 using namespace unify_link;
 
@@ -104,6 +105,81 @@ TEST_F(CRC16Test, TableIntegrity)
     EXPECT_NE(crc16_table[255], 0x0000);
 }
 
+TEST_F(CRC16Test, ModbusCheckValue)
+{
+    // CRC-16/MODBUS check value over "123456789"
+    const uint8_t data[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    EXPECT_EQ(computeCRC(data, sizeof(data)), 0x4B37);
+}
+
+TEST_F(CRC16Test, SliceTablesExtendBaseTable)
+{
+    for (int i = 0; i < 256; ++i)
+    {
+        EXPECT_EQ(crc16_slice8_table[0][i], crc16_table[i]);
+        for (int k = 0; k < 4; ++k)
+            EXPECT_EQ(crc16_slice4_table[k][i], crc16_slice8_table[k][i]);
+    }
+}
+
+TEST_F(CRC16Test, EnginesMatchBytewise)
+{
+    std::vector<uint8_t> data(1031);
+    uint32_t state = 0x12345678;
+    for (auto &b : data)
+    {
+        state = state * 1664525u + 1013904223u;
+        b = static_cast<uint8_t>(state >> 24);
+    }
+
+    // Every length/offset combination exercises the 4/8 byte main loops and their byte-wise tails.
+    for (uint16_t len = 0; len <= 64; ++len)
+    {
+        for (size_t off = 0; off < 8; ++off)
+        {
+            const uint16_t ref = crc16_calculation_bytewise(data.data() + off, len);
+            ASSERT_EQ(crc16_calculation_slice4(data.data() + off, len), ref) << "len=" << len << " off=" << off;
+            ASSERT_EQ(crc16_calculation_slice8(data.data() + off, len), ref) << "len=" << len << " off=" << off;
+            ASSERT_EQ(crc16_calculation(data.data() + off, len), ref) << "len=" << len << " off=" << off;
+        }
+    }
+
+    const uint16_t ref = crc16_calculation_bytewise(data.data(), static_cast<uint16_t>(data.size()), 0x1D0F);
+    EXPECT_EQ(crc16_calculation_slice4(data.data(), static_cast<uint16_t>(data.size()), 0x1D0F), ref);
+    EXPECT_EQ(crc16_calculation_slice8(data.data(), static_cast<uint16_t>(data.size()), 0x1D0F), ref);
+}
+
+TEST_F(CRC16Test, ChainedCalculationMatchesSinglePass)
+{
+    uint8_t data[100];
+    for (int i = 0; i < 100; ++i)
+        data[i] = static_cast<uint8_t>(i * 7);
+
+    // Header/payload are CRC'd in two calls; splitting must not change the result.
+    const uint16_t single = computeCRC(data, sizeof(data));
+    const uint16_t chained = crc16_calculation(data + 6, 94, crc16_calculation(data, 6));
+    EXPECT_EQ(single, chained);
+}
+
+TEST_F(CRC16Test, CombineMatchesSinglePass)
+{
+    std::vector<uint8_t> data(1000);
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = static_cast<uint8_t>(i * 13 + 5);
+
+    const uint16_t single = computeCRC(data.data(), data.size());
+    for (uint32_t split : {0u, 1u, 7u, 8u, 9u, 500u, 999u, 1000u})
+    {
+        const uint16_t crc_a = computeCRC(data.data(), split);
+        const uint16_t crc_b0 = crc16_calculation(data.data() + split, static_cast<uint16_t>(data.size() - split), 0);
+        EXPECT_EQ(crc16_combine(crc_a, crc_b0, static_cast<uint32_t>(data.size() - split)), single) << split;
+    }
+
+    // 推进零字节与直接计算零字节一致
+    const std::vector<uint8_t> zeros(37, 0);
+    EXPECT_EQ(crc16_shift(0x1234, 37), crc16_calculation_bytewise(zeros.data(), 37, 0x1234));
+}
+
 int main(int argc, char **argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -64,7 +64,7 @@ TEST_F(EncoderLinkTest, EncoderInfoRoundTrip)
     encoder_link->send_encoder_info_data(sent);
     roundTrip();
 
-    EXPECT_EQ(link_base.success_count, 1u);
+    EXPECT_EQ(link_base.success_count(), 1u);
     EXPECT_EQ(encoder_link->encoder_info.encoder_id, sent.encoder_id);
     EXPECT_EQ(encoder_link->encoder_info.resolution, sent.resolution);
     EXPECT_EQ(encoder_link->encoder_info.max_velocity, sent.max_velocity);
@@ -80,7 +80,7 @@ TEST_F(EncoderLinkTest, EncoderSettingRoundTrip)
     encoder_link->send_encoder_setting_data(sent);
     roundTrip();
 
-    EXPECT_EQ(link_base.success_count, 1u);
+    EXPECT_EQ(link_base.success_count(), 1u);
     EXPECT_EQ(encoder_link->encoder_setting.feedback_interval, sent.feedback_interval);
     EXPECT_EQ(encoder_link->encoder_setting.reset_id, sent.reset_id);
 }
@@ -94,7 +94,7 @@ TEST_F(EncoderLinkTest, MultipleEncoders)
         roundTrip();
     }
 
-    EXPECT_EQ(link_base.success_count, Encoder_link_t::MAX_ENCODERS);
+    EXPECT_EQ(link_base.success_count(), Encoder_link_t::MAX_ENCODERS);
 }
 
 TEST_F(EncoderLinkTest, ErrorCodes)
@@ -0,0 +1,99 @@
+/**
+ * @file frame_pool_test.cpp
+ * @brief Unit tests for the fixed-capacity frame pool
+ */
+
+#include "unify_link_pool.hpp"
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using namespace unify_link;
+
+TEST(FramePoolTest, AcquireCopiesPayloadAndReleasesOnDestruction)
+{
+    Frame_pool_t<4, 32> pool;
+    const uint8_t payload[5] = {1, 2, 3, 4, 5};
+    {
+        auto frame = pool.acquire_copy(0x10, 0x20, payload, sizeof(payload));
+        ASSERT_TRUE(frame);
+        EXPECT_EQ(frame->component_id, 0x10);
+        EXPECT_EQ(frame->data_id, 0x20);
+        EXPECT_EQ(frame->length, 5u);
+        EXPECT_EQ(frame->data[4], 5);
+        EXPECT_EQ(pool.in_use(), 1u);
+
+        auto moved = std::move(frame);
+        EXPECT_FALSE(frame);
+        EXPECT_TRUE(moved);
+        EXPECT_EQ(pool.in_use(), 1u);
+    }
+    EXPECT_EQ(pool.in_use(), 0u);
+    EXPECT_EQ(pool.high_water(), 1u);
+}
+
+TEST(FramePoolTest, ExhaustionAndOversizeReturnEmpty)
+{
+    Frame_pool_t<3, 16> pool;
+    std::vector<Frame_pool_t<3, 16>::Frame_ref> held;
+    for (int i = 0; i < 3; ++i)
+    {
+        held.push_back(pool.acquire(1, static_cast<uint8_t>(i), 16));
+        ASSERT_TRUE(held.back());
+    }
+    EXPECT_FALSE(pool.acquire(1, 9, 1));
+    EXPECT_EQ(pool.exhausted(), 1u);
+
+    held.pop_back();
+    EXPECT_FALSE(pool.acquire(1, 9, 17)); // 超过槽大小
+    EXPECT_EQ(pool.exhausted(), 2u);
+    EXPECT_TRUE(pool.acquire(1, 9, 16));
+}
+
+TEST(FramePoolTest, DetachedIndexRoundTrip)
+{
+    Frame_pool_t<2, 8> pool;
+    const uint16_t slot = pool.acquire(3, 4, 2).detach();
+    EXPECT_EQ(pool.in_use(), 1u);
+    EXPECT_EQ(pool.frame(slot).data_id, 4);
+    pool.release(slot);
+    EXPECT_EQ(pool.in_use(), 0u);
+}
+
+TEST(FramePoolTest, ConcurrentAcquireReleaseNeverSharesSlot)
+{
+    Frame_pool_t<16, 8> pool;
+    std::atomic<uint32_t> owners[16] = {};
+    std::atomic<bool> conflict{false};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+        threads.emplace_back(
+            [&]
+            {
+                for (int i = 0; i < 20000; ++i)
+                {
+                    const uint16_t slot = pool.acquire_index();
+                    if (slot == Frame_pool_t<16, 8>::kNone)
+                        continue;
+                    if (owners[slot].fetch_add(1) != 0)
+                        conflict = true;
+                    owners[slot].fetch_sub(1);
+                    pool.release(slot);
+                }
+            });
+    for (auto &t : threads)
+        t.join();
+
+    EXPECT_FALSE(conflict.load());
+    EXPECT_EQ(pool.in_use(), 0u);
+    EXPECT_LE(pool.high_water(), 16u);
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,183 @@
+/**
+ * @file latency_test.cpp
+ * @brief Unit tests for the opt-in latency instrumentation (UNIFY_LINK_LATENCY=1)
+ */
+
+#define UNIFY_LINK_LATENCY 1
+
+#include "link_test_helpers.hpp"
+#include "unify_link.hpp"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace unify_link;
+using unify_link_test::push_all;
+
+namespace
+{
+    uint32_t g_host_us = 0;
+    constexpr uint32_t kDeviceOffset = 5000; // 设备时钟比主机快 5ms
+
+    uint32_t host_clock() { return g_host_us; }
+    uint32_t device_clock() { return g_host_us + kDeviceOffset; }
+} // namespace
+
+TEST(LatencyHistogramTest, BucketsCoverRangeWithBoundedError)
+{
+    for (uint32_t v : {0u, 1u, 7u, 8u, 15u, 16u, 100u, 1000u, 12345u, 1u << 20, 0xFFFFFFFFu})
+    {
+        const uint32_t b = Latency_histogram::bucket_of(v);
+        ASSERT_LT(b, Latency_histogram::kBuckets);
+        EXPECT_LE(Latency_histogram::bucket_low(b), v);
+        EXPECT_GE(Latency_histogram::bucket_high(b), v);
+        EXPECT_LE(Latency_histogram::bucket_high(b) - Latency_histogram::bucket_low(b), v / 8);
+    }
+
+    Latency_histogram h;
+    for (uint32_t v = 1; v <= 1000; ++v)
+        h.record(v);
+    EXPECT_EQ(h.count(), 1000u);
+    EXPECT_EQ(h.min(), 1u);
+    EXPECT_EQ(h.max(), 1000u);
+    EXPECT_NEAR(h.mean(), 500.5, 1e-9);
+    EXPECT_NEAR(h.percentile(50), 500, 500 / 8.0);
+    EXPECT_NEAR(h.percentile(99), 990, 990 / 8.0);
+    EXPECT_EQ(h.percentile(100), 1000u);
+}
+
+class LatencyTest : public ::testing::Test
+{
+protected:
+    Unify_link_base host;
+    Unify_link_base device;
+    uint8_t dst[8] = {0};
+
+    void SetUp() override
+    {
+        g_host_us = 1000;
+        host.set_latency_clock(&host_clock);
+        device.set_latency_clock(&device_clock);
+    }
+};
+
+TEST_F(LatencyTest, MeasuresSendQueueResidency)
+{
+    const uint8_t payload[8] = {0};
+    host.build_send_data(COMPONENT_ID_MOTORS, 0x04, payload, sizeof(payload));
+    g_host_us += 250;
+    host.build_send_data(COMPONENT_ID_MOTORS, 0x04, payload, sizeof(payload));
+    g_host_us += 100;
+
+    uint8_t bytes[64];
+    uint32_t len = 0;
+    host.send_buff_pop(bytes, &len);
+
+    const Latency_histogram *queue = host.latency_histogram(COMPONENT_ID_MOTORS, 0x04, Latency_stage::TX_QUEUE);
+    ASSERT_NE(queue, nullptr);
+    EXPECT_EQ(queue->count(), 2u);
+    EXPECT_EQ(queue->min(), 100u);
+    EXPECT_EQ(queue->max(), 350u);
+}
+
+TEST_F(LatencyTest, MeasuresReceiveQueueAndHandler)
+{
+    device.register_handle_data(COMPONENT_ID_MOTORS, 0x01, dst,
+                                [](const uint8_t *, uint16_t)
+                                {
+                                    g_host_us += 40; // 处理函数耗时
+                                    return true;
+                                },
+                                sizeof(dst));
+
+    const uint8_t payload[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    host.build_send_data(COMPONENT_ID_MOTORS, 0x01, payload, sizeof(payload));
+    push_all(host, device);
+    g_host_us += 300;
+    device.parse_data_task();
+
+    EXPECT_EQ(device.success_count(), 1u);
+    const auto *queued = device.latency_histogram(COMPONENT_ID_MOTORS, 0x01, Latency_stage::RX_QUEUE);
+    const auto *handler = device.latency_histogram(COMPONENT_ID_MOTORS, 0x01, Latency_stage::HANDLER);
+    ASSERT_NE(queued, nullptr);
+    ASSERT_NE(handler, nullptr);
+    EXPECT_EQ(queued->max(), 300u);
+    EXPECT_EQ(handler->max(), 40u);
+
+    // 未带时间戳的帧没有单向时延样本
+    EXPECT_EQ(device.latency_histogram(COMPONENT_ID_MOTORS, 0x01, Latency_stage::WIRE)->count(), 0u);
+}
+
+TEST_F(LatencyTest, TimestampedFramesEstimateOneWayDelayAndOffset)
+{
+    device.register_handle_data(COMPONENT_ID_MOTORS, 0x01, dst, nullptr, sizeof(dst));
+    host.register_handle_data(COMPONENT_ID_ENCODERS, 0x01, dst, nullptr, sizeof(dst));
+    ASSERT_TRUE(host.set_timestamped(COMPONENT_ID_MOTORS, 0x01));
+    ASSERT_TRUE(device.set_timestamped(COMPONENT_ID_ENCODERS, 0x01));
+
+    const uint8_t payload[8] = {9, 8, 7, 6, 5, 4, 3, 2};
+    for (uint32_t delay : {120u, 80u, 200u})
+    {
+        ASSERT_EQ(host.build_send_data(COMPONENT_ID_MOTORS, 0x01, payload, sizeof(payload)),
+                  sizeof(unify_link_frame_head_t) + 4 + sizeof(payload));
+        g_host_us += delay; // 线路时延
+        push_all(host, device);
+        device.parse_data_task();
+
+        device.build_send_data(COMPONENT_ID_ENCODERS, 0x01, payload, sizeof(payload));
+        g_host_us += delay;
+        push_all(device, host);
+        host.parse_data_task();
+    }
+
+    EXPECT_EQ(device.success_count(), 3u);
+    EXPECT_EQ(std::memcmp(dst, payload, sizeof(payload)), 0); // 时间戳已剥离
+
+    const auto *wire = device.latency_histogram(COMPONENT_ID_MOTORS, 0x01, Latency_stage::WIRE);
+    ASSERT_NE(wire, nullptr);
+    EXPECT_EQ(wire->count(), 3u);
+    EXPECT_EQ(wire->min(), 0u);
+    EXPECT_EQ(wire->max(), 200u - 80u); // 高于（当时）最小单向时延的部分
+
+    int32_t device_min = 0;
+    int32_t host_min = 0;
+    ASSERT_TRUE(device.latency.wire_min_delta(&device_min));
+    ASSERT_TRUE(host.latency.wire_min_delta(&host_min));
+    EXPECT_EQ(device_min, static_cast<int32_t>(kDeviceOffset + 80));
+    EXPECT_EQ(host_min, static_cast<int32_t>(80 - kDeviceOffset));
+
+    int32_t offset = 0;
+    int32_t delay = 0;
+    decltype(device.latency)::estimate_clock_offset(device_min, host_min, &offset, &delay);
+    EXPECT_EQ(offset, static_cast<int32_t>(kDeviceOffset));
+    EXPECT_EQ(delay, 80);
+}
+
+TEST_F(LatencyTest, TimestampedFrameUsesCombinedFlagBits)
+{
+    host.set_timestamped(COMPONENT_ID_MOTORS, 0x01);
+    const uint8_t payload[8] = {0};
+    host.build_send_data(COMPONENT_ID_MOTORS, 0x01, payload, sizeof(payload));
+
+    uint8_t bytes[64];
+    uint32_t len = 0;
+    host.send_buff_pop(bytes, &len);
+    unify_link_frame_head_t head;
+    std::memcpy(&head, bytes, sizeof(head));
+    EXPECT_EQ(head.flags(), FRAME_FLAG_TIMESTAMP);
+    EXPECT_EQ(head.length(), sizeof(payload) + 4);
+
+    // 接收端未设置时延时钟时照常剥离时间戳，不当作打包或分片帧
+    Unify_link_base plain;
+    plain.register_handle_data(COMPONENT_ID_MOTORS, 0x01, dst, nullptr, sizeof(dst));
+    plain.rev_data_push(bytes, len);
+    plain.parse_data_task();
+    EXPECT_EQ(plain.success_count(), 1u);
+    EXPECT_EQ(plain.decode_error_count(), 0u);
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,61 @@
+/**
+ * @file link_footprint_test.cpp
+ * @brief RAM footprint of links built with the default configuration macros
+ */
+
+#include "unify_link.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace unify_link;
+
+namespace
+{
+    // sizeof(Unify_link_base) (2048/2048/512) before the dispatch table moved into the link; the
+    // std::unordered_map it replaced kept its nodes on the heap and is not part of this number
+    constexpr size_t kBaselineLinkBytes = 5272;
+    // Reliable, bundle and fragment bookkeeping, tx rules, frame taps
+    constexpr size_t kBookkeepingBytes = 1024;
+} // namespace
+
+TEST(LinkFootprintTest, DefaultLinkStaysNearBaseline)
+{
+    // Optional features cost nothing unless their macro is set
+    EXPECT_EQ(Unify_link_base::reliable_store_size, 0u);
+    EXPECT_EQ(Link_stats_t<UNIFY_LINK_STATS_SLOTS>::capacity(), 0u);
+
+    const size_t buffers = Unify_link_base::rx_buff_size + Unify_link_base::tx_buff_size +
+                           Unify_link_base::max_payload_length;
+    EXPECT_LE(sizeof(Unify_link_base), buffers + sizeof(Dispatch_table<UNIFY_LINK_MAX_HANDLERS>) + kBookkeepingBytes);
+    EXPECT_LE(sizeof(Unify_link_base), kBaselineLinkBytes + sizeof(Dispatch_table<UNIFY_LINK_MAX_HANDLERS>) + 512);
+}
+
+TEST(LinkFootprintTest, DispatchTableIsCompact)
+{
+    // Items, their keys and a one-byte index of at most 4x the capacity: nothing sized by the id space
+    using Table = Dispatch_table<UNIFY_LINK_MAX_HANDLERS>;
+    EXPECT_LE(Table::kIndexSize, 4 * UNIFY_LINK_MAX_HANDLERS);
+    EXPECT_LE(sizeof(Table), UNIFY_LINK_MAX_HANDLERS * (sizeof(registered_item_t) + sizeof(uint16_t)) +
+                                 Table::kIndexSize + sizeof(void *));
+}
+
+TEST(LinkFootprintTest, SmallLinkScalesWithTemplateParameters)
+{
+    // Buffers, dispatch table and per-id stats all follow the link's own parameters
+    using Small_link = Unify_link_t<256, 256, 64>;
+    EXPECT_LE(sizeof(Small_link), 3u * 1024);
+
+    using Tiny_link = Unify_link_t<256, 256, 64, 1, 8>;
+    EXPECT_LT(sizeof(Tiny_link), 2u * 1024);
+    EXPECT_EQ(sizeof(Small_link) - sizeof(Tiny_link),
+              sizeof(Dispatch_table<UNIFY_LINK_MAX_HANDLERS>) - sizeof(Dispatch_table<8>));
+
+    using Counted_link = Unify_link_t<256, 256, 64, 1, 8, 16>;
+    EXPECT_EQ(sizeof(Counted_link) - sizeof(Tiny_link), sizeof(Link_stats_t<16>) - sizeof(Link_stats_t<0>));
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,181 @@
+/**
+ * @file link_hub_test.cpp
+ * @brief Unit tests for the multi-link hub (socket pairs stand in for serial ports)
+ */
+
+#include "motor_link.hpp"
+#include "unify_link_hub.hpp"
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <set>
+#include <sys/socket.h>
+#include <vector>
+
+using namespace unify_link;
+
+class LinkHubTest : public ::testing::Test
+{
+protected:
+    static constexpr size_t kLinks = 12;
+    static constexpr unsigned kWorkers = 3;
+
+    Link_hub hub{kWorkers, 2};
+    std::vector<int> peer_fds;
+
+    void SetUp() override
+    {
+        for (size_t i = 0; i < kLinks; ++i)
+        {
+            int fds[2];
+            ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+            ASSERT_EQ(hub.add_fd(fds[0]), static_cast<int>(i));
+            peer_fds.push_back(fds[1]);
+        }
+    }
+
+    void TearDown() override
+    {
+        hub.stop();
+        for (int fd : peer_fds)
+            ::close(fd);
+    }
+
+    template <typename Pred>
+    static bool wait_for(Pred pred)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!pred())
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+                return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+};
+
+TEST_F(LinkHubTest, LinksArePinnedEvenlyAcrossWorkers)
+{
+    std::vector<int> per_worker(kWorkers, 0);
+    for (size_t i = 0; i < kLinks; ++i)
+        per_worker[hub.worker_of(i)]++;
+    for (int count : per_worker)
+        EXPECT_EQ(count, static_cast<int>(kLinks / kWorkers));
+}
+
+TEST_F(LinkHubTest, TransportsShareTheWorkerEventLoop)
+{
+    // 每条链路只占一个 fd：epoll / eventfd 按工作线程创建，不随链路分配
+    for (size_t i = 0; i < kLinks; ++i)
+    {
+        EXPECT_TRUE(hub.transport(i).is_open());
+        EXPECT_FALSE(hub.transport(i).has_event_loop());
+    }
+}
+
+TEST_F(LinkHubTest, ReceivesOnEveryLinkOnItsPinnedWorker)
+{
+    std::vector<std::set<std::thread::id>> threads(kLinks);
+    std::vector<uint8_t> last(kLinks, 0);
+    for (size_t i = 0; i < kLinks; ++i)
+    {
+        hub.link(i).register_handle_data(COMPONENT_ID_MOTORS, 0x01, nullptr,
+                                         [&, i](const uint8_t *data, uint16_t)
+                                         {
+                                             threads[i].insert(std::this_thread::get_id());
+                                             last[i] = data[0];
+                                             return true;
+                                         },
+                                         1);
+    }
+    ASSERT_TRUE(hub.start());
+    EXPECT_EQ(hub.add_fd(0), -1); // 运行中不能添加链路
+    EXPECT_EQ(hub.last_error(), EBUSY);
+
+    constexpr int kFrames = 50;
+    for (size_t i = 0; i < kLinks; ++i)
+    {
+        Unify_link_base peer;
+        for (int n = 0; n < kFrames; ++n)
+        {
+            const uint8_t value = static_cast<uint8_t>(n + i);
+            peer.build_send_data(COMPONENT_ID_MOTORS, 0x01, &value, 1);
+        }
+        uint8_t bytes[MAX_SEND_BUFF_LENGTH * 2];
+        uint32_t len = 0;
+        peer.send_buff_pop(bytes, &len);
+        ASSERT_EQ(::write(peer_fds[i], bytes, len), static_cast<ssize_t>(len));
+    }
+
+    ASSERT_TRUE(wait_for([&] { return hub.total_stats().success_count == kLinks * kFrames; }));
+    hub.stop();
+
+    for (size_t i = 0; i < kLinks; ++i)
+    {
+        const auto s = hub.stats(i);
+        EXPECT_EQ(s.success_count, static_cast<uint64_t>(kFrames));
+        EXPECT_EQ(s.com_error_count, 0u);
+        EXPECT_TRUE(s.open);
+        EXPECT_EQ(threads[i].size(), 1u);
+        EXPECT_EQ(last[i], static_cast<uint8_t>(kFrames - 1 + i));
+    }
+}
+
+TEST_F(LinkHubTest, PostedSendsRunOnWorkerAndReachPeer)
+{
+    std::vector<Motor_link_t> motors;
+    motors.reserve(kLinks);
+    for (size_t i = 0; i < kLinks; ++i)
+        motors.emplace_back(hub.link(i));
+    ASSERT_TRUE(hub.start());
+
+    for (size_t i = 0; i < kLinks; ++i)
+    {
+        hub.post(i,
+                 [&, i](Unify_link_base &)
+                 {
+                     motors[i].motor_set[0].set = static_cast<int16_t>(100 + i);
+                     motors[i].send_motor_set_data();
+                 });
+    }
+
+    for (size_t i = 0; i < kLinks; ++i)
+    {
+        Unify_link_base peer;
+        Motor_link_t peer_motor(peer);
+        uint8_t bytes[512];
+        ASSERT_TRUE(wait_for(
+            [&]
+            {
+                const ssize_t n = ::recv(peer_fds[i], bytes, sizeof(bytes), MSG_DONTWAIT);
+                if (n > 0)
+                {
+                    peer.rev_data_push(bytes, static_cast<uint32_t>(n));
+                    peer.parse_data_task();
+                }
+                return peer.success_count() == 1;
+            }));
+        EXPECT_EQ(peer_motor.motor_set[0].set, static_cast<int16_t>(100 + i));
+    }
+
+    ASSERT_TRUE(wait_for([&] { return hub.total_stats().tx_bytes != 0; }));
+}
+
+TEST_F(LinkHubTest, ClosedPeerMarksOnlyThatLinkFailed)
+{
+    ASSERT_TRUE(hub.start());
+    ::close(peer_fds[5]);
+    peer_fds[5] = -1;
+
+    ASSERT_TRUE(wait_for([&] { return !hub.stats(5).open; }));
+    EXPECT_EQ(hub.stats(5).error, EPIPE);
+    EXPECT_TRUE(hub.stats(4).open);
+    EXPECT_FALSE(hub.total_stats().open);
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,165 @@
+/**
+ * @file link_monitor_test.cpp
+ * @brief Unit tests for the raw-frame tap and the windowed link monitor
+ */
+
+#include "link_test_helpers.hpp"
+#include "unify_link_monitor.hpp"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+using namespace unify_link;
+using unify_link_test::pipe_all;
+
+namespace
+{
+    uint32_t g_now_ms = 0;
+    uint32_t test_clock() { return g_now_ms; }
+} // namespace
+
+TEST(FrameTapTest, SeesEveryValidFrameIncludingUnregisteredIds)
+{
+    Unify_link_base tx;
+    Unify_link_base rx;
+    std::vector<std::pair<uint8_t, uint16_t>> seen;
+    rx.set_frame_tap([&](const unify_link_frame_head_t &head, const uint8_t *payload, uint16_t len)
+                     {
+                         seen.emplace_back(head.data_id, len);
+                         EXPECT_EQ(payload[0], head.data_id);
+                     });
+
+    for (uint8_t id = 1; id <= 3; ++id)
+    {
+        const uint8_t payload[4] = {id, 0, 0, 0};
+        tx.build_send_data(COMPONENT_ID_MOTORS, id, payload, sizeof(payload));
+    }
+    pipe_all(tx, rx);
+
+    ASSERT_EQ(seen.size(), 3u);
+    EXPECT_EQ(seen[2], (std::pair<uint8_t, uint16_t>{3, 4}));
+    EXPECT_EQ(rx.decode_error_count(), 3u); // 未注册，但 tap 仍然看到
+
+    // CRC 错误的帧不经过 tap
+    const uint8_t payload[4] = {9, 0, 0, 0};
+    tx.build_send_data(COMPONENT_ID_MOTORS, 9, payload, sizeof(payload));
+    uint8_t bytes[64];
+    uint32_t len = 0;
+    tx.send_buff_pop(bytes, &len);
+    bytes[len - 1] ^= 0xFF;
+    rx.rev_data_push(bytes, len);
+    rx.parse_data_task();
+    EXPECT_EQ(seen.size(), 3u);
+}
+
+class LinkMonitorTest : public ::testing::Test
+{
+protected:
+    Unify_link_base tx;
+    Unify_link_base rx;
+    Link_monitor monitor{rx, &test_clock, 100};
+
+    void SetUp() override { g_now_ms = 10000; }
+
+    // period_ms 间隔发送 count 帧（载荷 8 字节，整帧 16 字节）
+    void stream(uint8_t data_id, uint32_t count, uint32_t period_ms)
+    {
+        const uint8_t payload[8] = {0};
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            tx.build_send_data(COMPONENT_ID_ENCODERS, data_id, payload, sizeof(payload));
+            pipe_all(tx, rx);
+            g_now_ms += period_ms;
+        }
+    }
+};
+
+TEST_F(LinkMonitorTest, ReportsWindowedRatesPerId)
+{
+    stream(1, 200, 5); // 200 Hz，持续 1 s
+
+    Link_monitor::message_rate_t rate;
+    ASSERT_TRUE(monitor.message(COMPONENT_ID_ENCODERS, 1, &rate));
+    EXPECT_EQ(rate.frames, 200u);
+    EXPECT_EQ(rate.bytes, 200u * 16);
+    EXPECT_NEAR(rate.frames_per_sec, 200.0f, 200.0f * 0.05f);
+    EXPECT_NEAR(rate.bytes_per_sec, 3200.0f, 3200.0f * 0.05f);
+    EXPECT_FALSE(monitor.message(COMPONENT_ID_ENCODERS, 2, &rate));
+
+    Link_monitor::snapshot_t snap;
+    monitor.snapshot(&snap);
+    EXPECT_EQ(snap.tap_frames, 200u);
+    EXPECT_EQ(snap.window, 1000u);
+    EXPECT_NEAR(snap.rx_frames_per_sec, 200.0f, 10.0f);
+}
+
+TEST_F(LinkMonitorTest, RatesDecayToZeroWhenIdle)
+{
+    stream(1, 100, 10);
+    g_now_ms += 2000;
+
+    Link_monitor::message_rate_t rates[4];
+    ASSERT_EQ(monitor.messages(rates, 4), 1);
+    EXPECT_EQ(rates[0].frames, 100u);
+    EXPECT_EQ(rates[0].frames_per_sec, 0.0f);
+
+    Link_monitor::snapshot_t snap;
+    monitor.snapshot(&snap);
+    EXPECT_EQ(snap.rx_bytes_per_sec, 0.0f);
+}
+
+TEST_F(LinkMonitorTest, ErrorRatesUseSampledTotals)
+{
+    Link_monitor::snapshot_t snap;
+    monitor.snapshot(&snap); // 基准样本
+
+    // 0.5 s 内 10 个 CRC 错误帧
+    const uint8_t payload[8] = {0};
+    for (int i = 0; i < 10; ++i)
+    {
+        tx.build_send_data(COMPONENT_ID_ENCODERS, 1, payload, sizeof(payload));
+        uint8_t bytes[64];
+        uint32_t len = 0;
+        tx.send_buff_pop(bytes, &len);
+        bytes[len - 1] ^= 0x5A;
+        rx.rev_data_push(bytes, len);
+        rx.parse_data_task();
+        g_now_ms += 50;
+    }
+
+    monitor.snapshot(&snap);
+    EXPECT_EQ(snap.totals.crc_errors, 10u);
+    EXPECT_NEAR(snap.crc_errors_per_sec, 20.0f, 0.01f);
+    EXPECT_EQ(snap.tap_frames, 0u);
+}
+
+TEST(FrameTapTest, StackedMonitorsDetachInAnyOrder)
+{
+    Unify_link_base tx;
+    Unify_link_base rx;
+    uint32_t raw_frames = 0;
+    rx.set_frame_tap([&raw_frames](const unify_link_frame_head_t &, const uint8_t *, uint16_t) { raw_frames++; });
+
+    auto first = std::make_unique<Link_monitor>(rx, &test_clock);
+    Link_monitor second(rx, &test_clock);
+    const uint8_t payload[4] = {1, 2, 3, 4};
+    tx.build_send_data(COMPONENT_ID_MOTORS, 0x01, payload, sizeof(payload));
+    pipe_all(tx, rx);
+
+    // 先接入的监视器先析构：不能摘掉后接入的监视器，也不能留下指向已析构对象的 tap
+    first.reset();
+    tx.build_send_data(COMPONENT_ID_MOTORS, 0x01, payload, sizeof(payload));
+    pipe_all(tx, rx);
+
+    Link_monitor::snapshot_t snap;
+    second.snapshot(&snap);
+    EXPECT_EQ(snap.tap_frames, 2u);
+    EXPECT_EQ(raw_frames, 2u);
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,50 @@
+/**
+ * @file link_test_helpers.hpp
+ * @brief Shared helpers for tests that run a device link against a host link in process
+ */
+
+#ifndef UNIFY_LINK_TEST_HELPERS_HPP
+#define UNIFY_LINK_TEST_HELPERS_HPP
+
+#include "encoder_link.hpp"
+#include "motor_link.hpp"
+#include "unify_link.hpp"
+
+#include <gtest/gtest.h>
+
+namespace unify_link_test
+{
+    // 线路缓冲区放在静态区：搬运数据不访问堆（分配审计测试依赖这一点），也不占测试线程的栈
+    inline uint8_t g_wire[2 * MAX_SEND_BUFF_LENGTH];
+
+    // 把 tx 的发送缓冲区整体写入 rx 的接收缓冲区（不解析），返回字节数
+    inline uint32_t push_all(unify_link::Unify_link_base &tx, unify_link::Unify_link_base &rx)
+    {
+        uint32_t len = 0;
+        tx.send_buff_pop(g_wire, &len);
+        rx.rev_data_push(g_wire, len);
+        return len;
+    }
+
+    // 同 push_all()，随后 rx 解析
+    inline uint32_t pipe_all(unify_link::Unify_link_base &tx, unify_link::Unify_link_base &rx)
+    {
+        const uint32_t len = push_all(tx, rx);
+        rx.parse_data_task();
+        return len;
+    }
+
+    // 设备 / 主机两条链路，各挂一个电机与编码器组件
+    class Device_host_test : public ::testing::Test
+    {
+    protected:
+        unify_link::Unify_link_base device;
+        unify_link::Unify_link_base host;
+        unify_link::Motor_link_t device_motor{device};
+        unify_link::Motor_link_t host_motor{host};
+        unify_link::Encoder_link_t device_encoder{device};
+        unify_link::Encoder_link_t host_encoder{host};
+    };
+} // namespace unify_link_test
+
+#endif // UNIFY_LINK_TEST_HELPERS_HPP
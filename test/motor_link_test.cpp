@@ -3,6 +3,7 @@
  * @brief Unit tests for Motor_link component
  */
 
+#include "encoder_link.hpp"
 #include "motor_link.hpp"
 #include "unify_link.hpp"
 
@@ -71,7 +72,7 @@ TEST_F(MotorLinkTest, MotorInfoRoundTrip)
                               reinterpret_cast<const uint8_t *>(&sent), sizeof(sent));
     roundTrip();
 
-    EXPECT_EQ(link_base.success_count, 1u);
+    EXPECT_EQ(link_base.success_count(), 1u);
     // motor_id=5，所以数据应该在 motor_info[5]
     EXPECT_EQ(motor_link->motor_info[5].motor_id, sent.motor_id);
     EXPECT_FLOAT_EQ(motor_link->motor_info[5].ratio, sent.ratio);
@@ -92,7 +93,7 @@ TEST_F(MotorLinkTest, MotorSettingRoundTrip)
                               reinterpret_cast<const uint8_t *>(&sent), sizeof(sent));
     roundTrip();
 
-    EXPECT_EQ(link_base.success_count, 1u);
+    EXPECT_EQ(link_base.success_count(), 1u);
     EXPECT_EQ(motor_link->motor_settings[sent.motor_id].feedback_interval, sent.feedback_interval);
     EXPECT_EQ(motor_link->motor_settings[sent.motor_id].reset_id, sent.reset_id);
     EXPECT_EQ(motor_link->motor_settings[sent.motor_id].mode, sent.mode);
@@ -111,7 +112,7 @@ TEST_F(MotorLinkTest, MotorSetCurrentRoundTrip)
     motor_link->send_motor_set_data(sent);
     roundTrip();
 
-    EXPECT_EQ(link_base.success_count, 1u);
+    EXPECT_EQ(link_base.success_count(), 1u);
     for (int i = 0; i < Motor_link_t::MAX_MOTORS; ++i)
     {
         EXPECT_EQ(motor_link->motor_set[i].set, sent[i].set);
@@ -236,7 +237,133 @@ TEST_F(MotorLinkTest, MultipleFrames)
         EXPECT_EQ(motor_link->motor_info[i].motor_id, static_cast<uint8_t>(i));
     }
 
-    EXPECT_EQ(link_base.success_count, 8u);
+    EXPECT_EQ(link_base.success_count(), 8u);
+}
+
+// Sender side of the delta tests: a separate link/component pair pushing into link_base
+class MotorDeltaTest : public MotorLinkTest
+{
+protected:
+    Unify_link_base tx_link;
+    Motor_link_t tx_motor{tx_link};
+
+    // Returns the number of bytes transferred
+    uint32_t deliver(bool drop = false)
+    {
+        uint8_t frame[512];
+        uint32_t len = 0;
+        tx_link.send_buff_pop(frame, &len);
+        if (!drop)
+        {
+            link_base.rev_data_push(frame, len);
+            link_base.parse_data_task();
+        }
+        return len;
+    }
+};
+
+TEST_F(MotorDeltaTest, FirstSendIsKeyframeThenOnlyChangedEntries)
+{
+    for (uint8_t i = 0; i < Motor_link_t::MAX_MOTORS; ++i)
+        tx_motor.motor_set[i] = {static_cast<int16_t>(i * 10), 0, 0};
+
+    tx_motor.send_motor_set_delta();
+    EXPECT_EQ(deliver(), sizeof(unify_link_frame_head_t) + sizeof(tx_motor.motor_set));
+    EXPECT_EQ(memcmp(motor_link->motor_set, tx_motor.motor_set, sizeof(tx_motor.motor_set)), 0);
+
+    // 无变化：不发送
+    tx_motor.send_motor_set_delta();
+    EXPECT_EQ(deliver(), 0u);
+
+    tx_motor.motor_set[3].set = 333;
+    tx_motor.motor_set[6].set_extra = -6;
+    tx_motor.send_motor_set_delta();
+    EXPECT_EQ(deliver(), sizeof(unify_link_frame_head_t) + 1 + 2 * sizeof(Motor_link_t::set_t));
+    EXPECT_EQ(memcmp(motor_link->motor_set, tx_motor.motor_set, sizeof(tx_motor.motor_set)), 0);
+    EXPECT_EQ(link_base.decode_error_count(), 0u);
+}
+
+TEST_F(MotorDeltaTest, BasicDeltaInvokesCallbackWithFullArray)
+{
+    int calls = 0;
+    motor_link->on_motor_basic_updated = [&calls](const Motor_link_t::feedback_t (&)[Motor_link_t::MAX_MOTORS])
+    { ++calls; };
+
+    tx_motor.send_motor_basic_delta();
+    deliver();
+    tx_motor.motor_basic[0].position = 1234;
+    tx_motor.send_motor_basic_delta();
+    deliver();
+
+    EXPECT_EQ(calls, 2);
+    EXPECT_EQ(motor_link->motor_basic[0].position, 1234);
+    EXPECT_EQ(memcmp(motor_link->motor_basic, tx_motor.motor_basic, sizeof(tx_motor.motor_basic)), 0);
+}
+
+TEST_F(MotorDeltaTest, LossRejectsDeltasUntilKeyframe)
+{
+    tx_motor.keyframe_interval = 4;
+    tx_motor.send_motor_set_delta();
+    deliver();
+
+    // 丢失一个增量帧
+    tx_motor.motor_set[1].set = 11;
+    tx_motor.send_motor_set_delta();
+    deliver(true);
+
+    // 下一个增量帧暴露序号缺口，被拒绝
+    tx_motor.motor_set[2].set = 22;
+    tx_motor.send_motor_set_delta();
+    deliver();
+    EXPECT_EQ(link_base.com_error_count(), 1u);
+    EXPECT_EQ(link_base.decode_error_count(), 1u);
+    EXPECT_NE(motor_link->motor_set[2].set, 22);
+    EXPECT_FALSE(motor_link->set_delta_rx.synced);
+
+    // 周期关键帧恢复同步
+    for (int i = 0; i < 3; ++i)
+    {
+        tx_motor.motor_set[4].set = static_cast<int16_t>(40 + i);
+        tx_motor.send_motor_set_delta();
+        deliver();
+    }
+    EXPECT_TRUE(motor_link->set_delta_rx.synced);
+    EXPECT_EQ(memcmp(motor_link->motor_set, tx_motor.motor_set, sizeof(tx_motor.motor_set)), 0);
+}
+
+TEST_F(MotorLinkTest, ReliableConfigNeedsReliableStore)
+{
+    // 默认构建不开启可靠发送（UNIFY_LINK_RELIABLE_STORE = 0），配置失败而不是静默丢帧
+    EXPECT_FALSE(motor_link->set_reliable_config());
+    EXPECT_TRUE(motor_link->set_reliable_config(false));
+    motor_link->send_motor_setting_data(0);
+    EXPECT_NE(link_base.send_buff_used(), 0u);
+}
+
+TEST_F(MotorLinkTest, SendReliableWithoutStoreSendsNothing)
+{
+    // 空载荷帧在副本存储为 0 时也不能入队：没有副本就无法重传，对端确认也无从对应
+    const uint32_t used = link_base.send_buff_used();
+    EXPECT_EQ(link_base.send_reliable(COMPONENT_ID_MOTORS, 0x01, nullptr, 0), 0u);
+    EXPECT_EQ(link_base.send_buff_used(), used);
+    EXPECT_EQ(link_base.reliable_pending(), 0u);
+}
+
+TEST(ComponentRegistrationTest, FullDispatchTableIsReported)
+{
+    // 8 项的分发表放得下电机组件（7 项），编码器组件只能注册进 1 项
+    using Tiny_link = Unify_link_t<256, 256, 64, 1, 8>;
+    Tiny_link link;
+    Motor_link_basic_t<Tiny_link> motor(link);
+    Encoder_link_basic_t<Tiny_link> encoder(link);
+    EXPECT_TRUE(motor.registered);
+    EXPECT_FALSE(encoder.registered);
+
+    Unify_link_base roomy;
+    Motor_link_t roomy_motor(roomy);
+    Encoder_link_t roomy_encoder(roomy);
+    EXPECT_TRUE(roomy_motor.registered);
+    EXPECT_TRUE(roomy_encoder.registered);
 }
 
 TEST_F(MotorLinkTest, ErrorCodes)
@@ -0,0 +1,171 @@
+/**
+ * @file parallel_dispatch_test.cpp
+ * @brief Unit tests for per-component parallel dispatch on executor threads
+ */
+
+#include "link_test_helpers.hpp"
+#include "unify_link_dispatch.hpp"
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using namespace unify_link;
+
+using unify_link_test::pipe_all;
+
+class ParallelDispatchTest : public unify_link_test::Device_host_test
+{
+};
+
+TEST_F(ParallelDispatchTest, OffloadedHandlersRunInOrderOnExecutorThread)
+{
+    std::vector<uint8_t> order;
+    std::thread::id handler_thread;
+    host_motor.on_motor_info_updated = [&](const Motor_link_t::info_t &info)
+    {
+        handler_thread = std::this_thread::get_id();
+        order.push_back(info.motor_id);
+    };
+
+    Parallel_dispatcher dispatcher(host);
+    ASSERT_TRUE(dispatcher.offload(COMPONENT_ID_MOTORS));
+    EXPECT_FALSE(dispatcher.offload(COMPONENT_ID_MOTORS));
+    EXPECT_FALSE(dispatcher.offload(0x42)); // 没有注册的处理函数
+    ASSERT_TRUE(dispatcher.start());
+
+    for (uint8_t round = 0; round < 5; ++round)
+    {
+        for (uint8_t id = 0; id < Motor_link_t::MAX_MOTORS; ++id)
+        {
+            Motor_link_t::info_t info{};
+            info.motor_id = id;
+            info.firmware_version = round;
+            device_motor.send_motor_info_data(info);
+        }
+        pipe_all(device, host);
+        dispatcher.flush(); // 每通道默认最多排队 32 帧
+    }
+
+    ASSERT_EQ(order.size(), 40u);
+    for (size_t i = 0; i < order.size(); ++i)
+        EXPECT_EQ(order[i], i % Motor_link_t::MAX_MOTORS);
+    EXPECT_NE(handler_thread, std::this_thread::get_id());
+    EXPECT_EQ(host_motor.motor_info[3].firmware_version, 4u);
+    EXPECT_EQ(host.success_count(), 40u);
+
+    Parallel_dispatcher::lane_stats_t stats;
+    ASSERT_TRUE(dispatcher.stats(COMPONENT_ID_MOTORS, &stats));
+    EXPECT_EQ(stats.enqueued, 40u);
+    EXPECT_EQ(stats.dispatched, 40u);
+    EXPECT_EQ(stats.dropped, 0u);
+}
+
+TEST_F(ParallelDispatchTest, SlowComponentDoesNotStallOtherComponents)
+{
+    std::atomic<int> slow_calls{0};
+    host_motor.on_motor_basic_updated = [&](const Motor_link_t::feedback_t (&)[Motor_link_t::MAX_MOTORS])
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        slow_calls++;
+    };
+
+    Parallel_dispatcher dispatcher(host);
+    ASSERT_TRUE(dispatcher.offload(COMPONENT_ID_MOTORS));
+    dispatcher.start();
+
+    const auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < 10; ++i)
+    {
+        device_motor.send_motor_basic_data();
+        device_encoder.encoder_basic[0].position = static_cast<uint16_t>(i);
+        device_encoder.send_encoder_basic_data();
+        pipe_all(device, host);
+        EXPECT_EQ(host_encoder.encoder_basic[0].position, i); // 编码器仍在解析线程上即时处理
+    }
+    const auto parse_time = std::chrono::steady_clock::now() - begin;
+    EXPECT_LT(parse_time, std::chrono::milliseconds(100)); // 远小于 10 × 20ms
+    EXPECT_LT(slow_calls.load(), 10);
+
+    dispatcher.stop(); // 停止前处理完已入队的帧
+    EXPECT_EQ(slow_calls.load(), 10);
+}
+
+TEST_F(ParallelDispatchTest, FullQueueDropsInsteadOfBlockingParser)
+{
+    std::atomic<bool> release{false};
+    host_motor.on_motor_info_updated = [&](const Motor_link_t::info_t &)
+    {
+        while (!release.load())
+            std::this_thread::yield();
+    };
+
+    Parallel_dispatcher_t<Unify_link_base, 64, 8> dispatcher(host);
+    ASSERT_TRUE(dispatcher.offload(COMPONENT_ID_MOTORS));
+    dispatcher.start();
+
+    Motor_link_t::info_t info{};
+    for (int i = 0; i < 100; ++i)
+    {
+        device_motor.send_motor_info_data(info);
+        pipe_all(device, host);
+    }
+
+    Parallel_dispatcher_t<Unify_link_base, 64, 8>::lane_stats_t stats;
+    dispatcher.stats(COMPONENT_ID_MOTORS, &stats);
+    EXPECT_GT(stats.dropped, 0u);
+    EXPECT_EQ(stats.enqueued + stats.dropped, 100u);
+    EXPECT_LE(stats.high_water, 8u);
+    EXPECT_LE(dispatcher.frame_pool().high_water(), 8u);
+
+    release = true;
+    dispatcher.flush();
+    dispatcher.stats(COMPONENT_ID_MOTORS, &stats);
+    EXPECT_EQ(stats.dispatched, stats.enqueued);
+    EXPECT_EQ(dispatcher.frame_pool().in_use(), 0u); // 槽全部归还
+}
+
+TEST_F(ParallelDispatchTest, LengthChecksAndRequestsStayOnParser)
+{
+    Parallel_dispatcher dispatcher(host);
+    ASSERT_TRUE(dispatcher.offload(COMPONENT_ID_MOTORS));
+    dispatcher.start();
+
+    // 长度不符的帧在解析线程计为失败，不入队
+    const uint8_t wrong[3] = {0};
+    device.build_send_data(COMPONENT_ID_MOTORS, Motor_link_t::MOTOR_INFO_ID, wrong, sizeof(wrong));
+    pipe_all(device, host);
+    EXPECT_EQ(host.decode_error_count(), 1u);
+
+    // 对带 dst 的 ID（MOTOR_BASIC_ID）的请求帧仍由主机按当前值应答
+    host_motor.motor_basic[2].position = 1234;
+    device.build_send_data(COMPONENT_ID_MOTORS, Motor_link_t::MOTOR_BASIC_ID, nullptr, 0);
+    pipe_all(device, host);
+    pipe_all(host, device);
+    EXPECT_EQ(device_motor.motor_basic[2].position, 1234);
+
+    Parallel_dispatcher::lane_stats_t stats;
+    dispatcher.stats(COMPONENT_ID_MOTORS, &stats);
+    EXPECT_EQ(stats.enqueued, 0u);
+}
+
+TEST_F(ParallelDispatchTest, DestructionRestoresInlineHandlers)
+{
+    {
+        Parallel_dispatcher dispatcher(host);
+        ASSERT_TRUE(dispatcher.offload(COMPONENT_ID_ENCODERS));
+        dispatcher.start();
+    }
+
+    device_encoder.encoder_basic[1].velocity = -77;
+    device_encoder.send_encoder_basic_data();
+    pipe_all(device, host);
+    EXPECT_EQ(host_encoder.encoder_basic[1].velocity, -77);
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
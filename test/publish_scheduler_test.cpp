@@ -0,0 +1,192 @@
+/**
+ * @file publish_scheduler_test.cpp
+ * @brief Unit tests for the rate-limited, deadband-suppressed telemetry publisher
+ */
+
+#include "encoder_link.hpp"
+#include "motor_link.hpp"
+#include "publish_scheduler.hpp"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace unify_link;
+
+namespace
+{
+    uint32_t g_now_ms = 0;
+    uint32_t test_clock() { return g_now_ms; }
+
+    // 取走发送缓冲区中的全部帧，返回帧数
+    uint32_t drain_frames(Unify_link_base &link)
+    {
+        uint8_t bytes[2 * MAX_SEND_BUFF_LENGTH];
+        uint32_t len = 0;
+        link.send_buff_pop(bytes, &len);
+        uint32_t frames = 0;
+        for (uint32_t at = 0; at + sizeof(unify_link_frame_head_t) <= len; ++frames)
+        {
+            unify_link_frame_head_t head;
+            std::memcpy(&head, bytes + at, sizeof(head));
+            at += sizeof(head) + head.length();
+        }
+        return frames;
+    }
+} // namespace
+
+class PublishSchedulerTest : public ::testing::Test
+{
+protected:
+    Unify_link_base device;
+    Encoder_link_t encoder{device};
+    Publish_scheduler scheduler{&test_clock};
+
+    void SetUp() override { g_now_ms = 1000; }
+
+    // 每 1ms poll 一次，返回每个 tick 发出的帧数
+    std::vector<uint32_t> run(uint32_t ticks, void (*step)(Encoder_link_t &) = nullptr)
+    {
+        std::vector<uint32_t> sent;
+        for (uint32_t i = 0; i < ticks; ++i)
+        {
+            if (step != nullptr)
+                step(encoder);
+            scheduler.poll();
+            sent.push_back(drain_frames(device));
+            g_now_ms++;
+        }
+        return sent;
+    }
+
+    static uint32_t total(const std::vector<uint32_t> &sent)
+    {
+        uint32_t n = 0;
+        for (uint32_t s : sent)
+            n += s;
+        return n;
+    }
+};
+
+TEST_F(PublishSchedulerTest, PublishesAtConfiguredFeedbackInterval)
+{
+    encoder.encoder_setting.feedback_interval = 10;
+    const int id = add_encoder_basic_stream(scheduler, encoder);
+    ASSERT_EQ(id, 0);
+
+    const auto sent = run(100, [](Encoder_link_t &e) { e.encoder_basic[0].position++; });
+    EXPECT_EQ(total(sent), 10u);
+    EXPECT_EQ(sent[0], 1u); // 首条流不错开
+    EXPECT_EQ(sent[10], 1u);
+    EXPECT_EQ(sent[5], 0u);
+
+    // 周期由设置决定，运行中修改立即生效；0 表示暂停
+    encoder.encoder_setting.feedback_interval = 5;
+    EXPECT_EQ(total(run(100, [](Encoder_link_t &e) { e.encoder_basic[0].position++; })), 20u);
+    encoder.encoder_setting.feedback_interval = 0;
+    EXPECT_EQ(total(run(50, [](Encoder_link_t &e) { e.encoder_basic[0].position++; })), 0u);
+    EXPECT_EQ(scheduler.time_to_next(g_now_ms), UINT32_MAX);
+}
+
+TEST_F(PublishSchedulerTest, DeadbandSuppressesSmallChangesAndHeartbeatForcesResend)
+{
+    encoder.encoder_setting.feedback_interval = 10;
+    Encoder_link_t::basic_deadband_t deadband;
+    deadband.position = 5;
+    deadband.velocity = 100;
+    const int id = add_encoder_basic_stream(scheduler, encoder, deadband, 50);
+
+    // 抖动在死区内：只有首帧与心跳
+    const auto sent = run(200, [](Encoder_link_t &e) { e.encoder_basic[1].position = (g_now_ms & 1) ? 65535 : 2; });
+    EXPECT_EQ(total(sent), 4u); // t = 0, 50, 100, 150
+    EXPECT_EQ(scheduler.stats(id)->sent, total(sent));
+    EXPECT_EQ(scheduler.stats(id)->sent + scheduler.stats(id)->suppressed, 20u);
+
+    // 速度越过死区立即在下一个周期发送
+    encoder.encoder_basic[3].velocity = 1000;
+    EXPECT_EQ(total(run(10)), 1u);
+
+    // 错误码变化总是发送
+    encoder.encoder_basic[0].error_code = Encoder_link_t::ErrorCode::INTERNAL_ERR;
+    EXPECT_EQ(total(run(10)), 1u);
+}
+
+TEST_F(PublishSchedulerTest, StaggersStreamsWithEqualIntervals)
+{
+    uint32_t calls[4] = {0};
+    for (uint32_t &c : calls)
+        scheduler.add_stream(
+            [&c, this](bool)
+            {
+                c++;
+                const uint8_t payload[4] = {0};
+                return device.build_send_data(COMPONENT_ID_ENCODERS, 0x10, payload, sizeof(payload)) != 0
+                           ? Publish_result::SENT
+                           : Publish_result::BLOCKED;
+            },
+            8u);
+
+    const auto sent = run(80);
+    EXPECT_EQ(total(sent), 40u);
+    for (uint32_t s : sent)
+        EXPECT_LE(s, 1u) << "streams aligned on one tick";
+    for (uint32_t c : calls)
+        EXPECT_EQ(c, 10u);
+}
+
+TEST_F(PublishSchedulerTest, BlockedPublishIsRetriedOnNextPoll)
+{
+    encoder.encoder_setting.feedback_interval = 20;
+    const int id = add_encoder_basic_stream(scheduler, encoder);
+
+    // 占满发送缓冲区
+    const uint8_t filler[4] = {0};
+    while (device.build_send_data(COMPONENT_ID_MOTORS, 0x20, filler, sizeof(filler)) != 0)
+    {
+    }
+    scheduler.poll();
+    EXPECT_EQ(scheduler.stats(id)->blocked, 1u);
+    EXPECT_EQ(scheduler.stats(id)->sent, 0u);
+
+    drain_frames(device);
+    g_now_ms += 3;
+    scheduler.poll();
+    EXPECT_EQ(scheduler.stats(id)->sent, 1u);
+    EXPECT_EQ(drain_frames(device), 1u);
+    EXPECT_EQ(scheduler.time_to_next(g_now_ms), 17u); // 相位不因重试而改变
+}
+
+TEST_F(PublishSchedulerTest, MotorStreamUsesFastestConfiguredMotor)
+{
+    Motor_link_t motor{device};
+    EXPECT_EQ(motor.feedback_interval(), 0u);
+    motor.motor_settings[2].feedback_interval = 20;
+    motor.motor_settings[5].feedback_interval = 4;
+    EXPECT_EQ(motor.feedback_interval(), 4u);
+
+    Motor_link_t::basic_deadband_t deadband;
+    deadband.current = 10;
+    add_motor_basic_stream(scheduler, motor, deadband);
+
+    EXPECT_EQ(motor.publish_motor_basic(deadband), Publish_result::SENT);
+    motor.motor_basic[4].current = 8;
+    EXPECT_EQ(motor.publish_motor_basic(deadband), Publish_result::SUPPRESSED);
+    motor.motor_basic[4].temperature = 40;
+    EXPECT_EQ(motor.publish_motor_basic(deadband), Publish_result::SENT);
+    drain_frames(device);
+
+    uint32_t frames = 0;
+    for (int i = 0; i < 40; ++i)
+    {
+        motor.motor_basic[0].position = static_cast<uint16_t>(motor.motor_basic[0].position + 1);
+        scheduler.poll();
+        frames += drain_frames(device);
+        g_now_ms++;
+    }
+    EXPECT_EQ(frames, 10u);
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,223 @@
+/**
+ * @file serial_transport_test.cpp
+ * @brief Unit tests for the Linux serial transport, driven through a pseudo terminal
+ */
+
+#include "unify_link_serial.hpp"
+
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <thread>
+#include <vector>
+
+using namespace unify_link;
+
+class SerialTransportTest : public ::testing::Test
+{
+protected:
+    int master = -1;
+    std::string slave_path;
+
+    Unify_link_base link;
+    Serial_transport transport{link};
+
+    // 对端：直接在 pty master 上收发原始字节
+    Unify_link_base peer;
+
+    void SetUp() override
+    {
+        master = ::posix_openpt(O_RDWR | O_NOCTTY);
+        if (master < 0 || ::grantpt(master) != 0 || ::unlockpt(master) != 0)
+            GTEST_SKIP() << "pseudo terminals unavailable";
+        slave_path = ::ptsname(master);
+
+        termios tio{};
+        ::tcgetattr(master, &tio);
+        ::cfmakeraw(&tio);
+        ::tcsetattr(master, TCSANOW, &tio);
+    }
+
+    void TearDown() override
+    {
+        transport.close();
+        if (master >= 0)
+            ::close(master);
+    }
+
+    void write_peer_frames()
+    {
+        uint8_t bytes[MAX_SEND_BUFF_LENGTH];
+        uint32_t len = 0;
+        peer.send_buff_pop(bytes, &len);
+        ASSERT_EQ(::write(master, bytes, len), static_cast<ssize_t>(len));
+    }
+
+    std::vector<uint8_t> read_master(size_t want)
+    {
+        std::vector<uint8_t> out;
+        for (int i = 0; i < 100 && out.size() < want; ++i)
+        {
+            uint8_t bytes[1024];
+            const ssize_t n = ::read(master, bytes, sizeof(bytes));
+            if (n > 0)
+                out.insert(out.end(), bytes, bytes + n);
+            else
+                transport.poll_once(5);
+        }
+        return out;
+    }
+};
+
+TEST_F(SerialTransportTest, OpenFailsWithErrno)
+{
+    EXPECT_FALSE(transport.open("/dev/does-not-exist-unify-link"));
+    EXPECT_EQ(transport.last_error(), ENOENT);
+    EXPECT_FALSE(transport.is_open());
+    EXPECT_FALSE(transport.poll_once(0));
+}
+
+TEST_F(SerialTransportTest, ReceivesFramesIntoRecBuff)
+{
+    uint8_t dst[16] = {0};
+    link.register_handle_data(COMPONENT_ID_MOTORS, 0x01, dst, nullptr, sizeof(dst));
+    ASSERT_TRUE(transport.open(slave_path.c_str()));
+
+    uint8_t payload[16];
+    for (int frame = 0; frame < 20; ++frame)
+    {
+        for (uint8_t i = 0; i < sizeof(payload); ++i)
+            payload[i] = static_cast<uint8_t>(frame + i);
+        peer.build_send_data(COMPONENT_ID_MOTORS, 0x01, payload, sizeof(payload));
+    }
+    write_peer_frames();
+
+    for (int i = 0; i < 100 && link.success_count() < 20; ++i)
+        ASSERT_TRUE(transport.poll_once(10));
+
+    EXPECT_EQ(link.success_count(), 20u);
+    EXPECT_EQ(link.com_error_count(), 0u);
+    EXPECT_EQ(std::memcmp(dst, payload, sizeof(payload)), 0);
+    EXPECT_EQ(transport.rx_bytes, 20u * (sizeof(unify_link_frame_head_t) + sizeof(payload)));
+}
+
+TEST_F(SerialTransportTest, DrainsSendBuffWithWritev)
+{
+    ASSERT_TRUE(transport.open(slave_path.c_str()));
+
+    uint8_t dst[32] = {0};
+    peer.register_handle_data(COMPONENT_ID_UPDATE, 0x02, dst, nullptr, sizeof(dst));
+
+    uint8_t payload[32];
+    uint32_t expected = 0;
+    for (int frame = 0; frame < 50; ++frame)
+    {
+        std::memset(payload, frame, sizeof(payload));
+        expected += link.build_send_data(COMPONENT_ID_UPDATE, 0x02, payload, sizeof(payload));
+        ASSERT_TRUE(transport.poll_once(0)); // 发送缓冲区多次回绕
+    }
+
+    const std::vector<uint8_t> wire = read_master(expected);
+    ASSERT_EQ(wire.size(), expected);
+    EXPECT_EQ(link.send_buff_used(), 0u);
+    EXPECT_EQ(transport.tx_bytes, expected);
+
+    peer.rev_data_push(wire.data(), static_cast<uint32_t>(wire.size()));
+    peer.parse_data_task();
+    EXPECT_EQ(peer.success_count(), 50u);
+    EXPECT_EQ(dst[0], 49);
+}
+
+TEST_F(SerialTransportTest, CustomBaudRateIsAccepted)
+{
+    Serial_transport::options_t options;
+    options.baud_rate = 250000; // 非标准波特率走 termios2
+    ASSERT_TRUE(transport.open(slave_path.c_str(), options)) << std::strerror(transport.last_error());
+    EXPECT_FALSE(transport.low_latency_enabled()); // pty 没有 TIOCSSERIAL
+}
+
+TEST(SerialTransportSocketTest, AttachedSocketRoundTripAndPost)
+{
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+
+    Unify_link_base a;
+    Unify_link_base b;
+    Serial_transport ta(a);
+    Serial_transport tb(b);
+    ASSERT_TRUE(ta.attach(fds[0]));
+    ASSERT_TRUE(tb.attach(fds[1]));
+
+    uint8_t dst[4] = {0};
+    b.register_handle_data(COMPONENT_ID_ENCODERS, 0x01, dst, nullptr, sizeof(dst));
+    const uint8_t payload[4] = {1, 2, 3, 4};
+
+    // 其他线程投递发送任务，由事件循环线程执行并发出
+    std::thread::id sender;
+    std::thread poster(
+        [&]
+        {
+            ta.post(
+                [&](Unify_link_base &link)
+                {
+                    sender = std::this_thread::get_id();
+                    link.build_send_data(COMPONENT_ID_ENCODERS, 0x01, payload, sizeof(payload));
+                });
+        });
+    poster.join();
+    ASSERT_TRUE(ta.poll_once(10));
+    EXPECT_EQ(sender, std::this_thread::get_id());
+    for (int i = 0; i < 10 && b.success_count() == 0; ++i)
+        ASSERT_TRUE(tb.poll_once(10));
+
+    EXPECT_EQ(b.success_count(), 1u);
+    EXPECT_EQ(std::memcmp(dst, payload, sizeof(payload)), 0);
+
+    ta.close(); // 对端关闭后读到 EOF
+    EXPECT_FALSE(tb.poll_once(10));
+    EXPECT_EQ(tb.last_error(), EPIPE);
+}
+
+TEST(SerialTransportSocketTest, AttachWithoutEventLoopIsDrivenExternally)
+{
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+
+    Unify_link_base a;
+    Unify_link_base b;
+    Serial_transport ta(a);
+    Serial_transport tb(b);
+    ASSERT_TRUE(ta.attach(fds[0], false));
+    ASSERT_TRUE(tb.attach(fds[1], false));
+    EXPECT_FALSE(ta.has_event_loop());
+    tb.wake(); // 没有 eventfd，空操作
+
+    // 不带事件循环时 poll_once() 不可用，读写由调用方按就绪事件驱动
+    EXPECT_FALSE(ta.poll_once(0));
+    EXPECT_EQ(ta.last_error(), EINVAL);
+
+    uint8_t dst[4] = {0};
+    b.register_handle_data(COMPONENT_ID_ENCODERS, 0x01, dst, nullptr, sizeof(dst));
+    const uint8_t payload[4] = {1, 2, 3, 4};
+    a.build_send_data(COMPONENT_ID_ENCODERS, 0x01, payload, sizeof(payload));
+    ASSERT_TRUE(ta.wants_write());
+    ASSERT_TRUE(ta.handle_writable());
+    ASSERT_TRUE(tb.handle_readable());
+    EXPECT_EQ(b.success_count(), 1u);
+    EXPECT_EQ(std::memcmp(dst, payload, sizeof(payload)), 0);
+}
+
+TEST(SerialTransportSocketTest, AttachFailureReportsErrno)
+{
+    Unify_link_base a;
+    Serial_transport ta(a);
+    EXPECT_FALSE(ta.attach(-1));
+    EXPECT_EQ(ta.last_error(), EBADF);
+    EXPECT_FALSE(ta.is_open());
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -1,87 +1,137 @@
-#include "../unify_link.hpp"
+/**
+ * @file spsc_ringbuffer_test.cpp
+ * @brief Cross-thread correctness of Circular_buffer and Spsc_ring_buffer
+ *
+ * A producer thread stands in for the ISR and the test thread for the main loop. Throughput is measured by
+ * BM_ring_cross_thread in the benchmark suite, not here.
+ */
 
-#include <cassert>
+#include "unify_link.hpp"
+
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
-#include <iostream>
+#include <gtest/gtest.h>
 #include <thread>
 #include <vector>
-#include <atomic>
 
-// This is a host-side stress test that approximates an ISR producer + main-loop consumer.
-// Producer pushes bytes in increasing order; consumer reads and validates sequence.
+using namespace unify_link;
 
-static constexpr uint32_t kBufSize = 1024;
-static constexpr uint32_t kTotalBytes = 200000;
-
-int main()
+namespace
+{
+    constexpr uint32_t kBufSize = 1024;
+    constexpr uint32_t kChunk = 64;
+    constexpr uint32_t kDropBytes = 200000;
+    constexpr uint32_t kStreamBytes = 256 * 1024;
+} // namespace
+
+template <typename Ring>
+class SpscRingTest : public ::testing::Test
 {
-    unify_link::Circular_buffer<uint8_t, kBufSize> rb;
+protected:
+    Ring ring;
+};
 
-    std::atomic<bool> done{false};
+using Ring_types = ::testing::Types<Circular_buffer<uint8_t, kBufSize>, Spsc_ring_buffer<uint8_t, kBufSize>>;
+TYPED_TEST_SUITE(SpscRingTest, Ring_types);
 
-    std::thread producer([&]() {
-        uint32_t v = 0;
-        std::vector<uint8_t> chunk(64);
+// 满时整块丢弃（与库的中断推送策略相同）：消费者看到的字节在块内连续，块之间只会跳过整块
+TYPED_TEST(SpscRingTest, DropOnFullLosesWholeChunksOnly)
+{
+    auto &rb = this->ring;
+    std::atomic<bool> done{false};
 
-        while (v < kTotalBytes)
+    std::thread producer(
+        [&]
         {
-            uint32_t n = 0;
-            for (; n < chunk.size() && v < kTotalBytes; ++n, ++v)
-                chunk[n] = static_cast<uint8_t>(v & 0xFF);
-
-            // simulate ISR: if buffer is full, drop this chunk (same policy as library)
-            (void)rb.push_data(chunk.data(), n);
-        }
-
-        done.store(true, std::memory_order_release);
-    });
+            uint8_t chunk[kChunk];
+            for (uint32_t v = 0; v < kDropBytes; v += kChunk)
+            {
+                for (uint32_t i = 0; i < kChunk; ++i)
+                    chunk[i] = static_cast<uint8_t>(v + i);
+                (void)rb.push_data(chunk, kChunk);
+            }
+            done.store(true, std::memory_order_release);
+        });
 
-    // With drop-on-full, continuity isn't guaranteed.
-    // We only require that bytes arrive in-order (no reordering/corruption).
+    uint32_t received = 0;
     int last = -1;
-    std::vector<uint8_t> out(64);
-
+    bool ordered = true;
+    uint8_t out[kChunk];
     while (!done.load(std::memory_order_acquire) || rb.used() > 0)
     {
-        uint32_t avail = rb.used();
-        if (avail == 0)
+        const uint32_t n = std::min<uint32_t>(rb.used(), kChunk);
+        if (n == 0)
+        {
+            std::this_thread::yield();
             continue;
+        }
 
-        uint32_t to_read = (avail > out.size()) ? static_cast<uint32_t>(out.size()) : avail;
-        uint32_t got = rb.read_data(out.data(), to_read);
-        assert(got == to_read);
-
-        // Validate monotonic order modulo 256.
-        // Since our policy is drop-on-full, consumer should never see out-of-order.
-        for (uint32_t i = 0; i < got; ++i)
+        ordered = ordered && rb.read_data(out, n) == n;
+        for (uint32_t i = 0; i < n; ++i, ++received)
         {
-            int cur = static_cast<int>(out[i]);
+            const int cur = out[i];
             if (last != -1)
             {
-                int expected_next = (last + 1) & 0xFF;
-                if (cur != expected_next)
-                {
-                    // Drop detected. Ensure still moving forward in modulo space by accepting resync.
-                    // If it goes backwards (excluding wrap), flag corruption.
-                    // Backwards detection: if last < 128 and cur > last and cur != expected_next is fine; true backward is hard in mod.
-                    // We'll enforce: cur must not equal last (stuck) and must be a valid byte.
-                    if (cur == last)
-                    {
-                        std::cerr << "Non-progressing stream (possible corruption): last=" << last
-                                  << " cur=" << cur << "\n";
-                        return 2;
-                    }
-                }
+                const uint8_t step = static_cast<uint8_t>(cur - last - 1);
+                // 块内必须连续；块边界处可跳过若干整块
+                ordered = ordered && (received % kChunk == 0 ? step % kChunk == 0 : step == 0);
             }
             last = cur;
         }
-
-        rb.pop_data(got);
+        rb.pop_data(n);
     }
+    producer.join();
+
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(received % kChunk, 0u);
+    EXPECT_GT(received, 0u);
+}
+
+// 满时重试：每个字节都按序到达
+TYPED_TEST(SpscRingTest, LosslessStreamArrivesInOrder)
+{
+    auto &rb = this->ring;
+
+    std::thread producer(
+        [&]
+        {
+            uint8_t chunk[kChunk];
+            for (uint32_t v = 0; v < kStreamBytes; v += kChunk)
+            {
+                for (uint32_t i = 0; i < kChunk; ++i)
+                    chunk[i] = static_cast<uint8_t>(v + i);
+                while (rb.push_data(chunk, kChunk) == 0)
+                    std::this_thread::yield();
+            }
+        });
 
+    uint32_t received = 0;
+    uint32_t mismatches = 0;
+    std::vector<uint8_t> out(256);
+    while (received < kStreamBytes)
+    {
+        const uint32_t n = std::min<uint32_t>(rb.used(), static_cast<uint32_t>(out.size()));
+        if (n == 0)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        rb.read_data(out.data(), n);
+        for (uint32_t i = 0; i < n; ++i)
+            mismatches += out[i] != static_cast<uint8_t>(received + i);
+        rb.pop_data(n);
+        received += n;
+    }
     producer.join();
 
-    // expected may be < kTotalBytes if drops occurred; what's important is no UB/corruption/order issues.
-    std::cout << "SPSC ring buffer test OK\n";
-    return 0;
+    EXPECT_EQ(mismatches, 0u);
+    EXPECT_EQ(rb.used(), 0u);
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
 }
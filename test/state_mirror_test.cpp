@@ -0,0 +1,275 @@
+/**
+ * @file state_mirror_test.cpp
+ * @brief Unit tests for bulk snapshot requests and the versioned host mirror
+ */
+
+#include "link_test_helpers.hpp"
+#include "unify_link_mirror.hpp"
+#include "unify_link_static.hpp"
+
+#include <cstring>
+#include <gtest/gtest.h>
+
+using namespace unify_link;
+
+using unify_link_test::g_wire;
+using unify_link_test::pipe_all;
+
+class StateMirrorTest : public unify_link_test::Device_host_test
+{
+protected:
+    Snapshot_server server{device};
+    State_mirror mirror{host};
+
+    void SetUp() override
+    {
+        for (uint8_t i = 0; i < Motor_link_t::MAX_MOTORS; ++i)
+        {
+            device_motor.motor_info[i] = {};
+            device_motor.motor_info[i].motor_id = i;
+            device_motor.motor_info[i].ratio = 10.0f + i;
+            std::snprintf(device_motor.motor_info[i].model, sizeof(device_motor.motor_info[i].model), "M%u", i);
+            device_motor.motor_settings[i].motor_id = i;
+            device_motor.motor_settings[i].feedback_interval = static_cast<uint8_t>(i + 1);
+        }
+        device_motor.motor_pid = {};
+        device_encoder.encoder_info = {};
+        device_encoder.encoder_info.resolution = 14;
+        device_encoder.encoder_setting.feedback_interval = 5;
+
+        ASSERT_EQ(add_motor_snapshot(server, device_motor), 3u);
+        ASSERT_EQ(add_encoder_snapshot(server, device_encoder), 2u);
+    }
+
+    // 一次同步：请求 → 设备应答（必要时分多次 poll），返回设备发出的帧批次数
+    int sync(bool full = false)
+    {
+        EXPECT_TRUE(mirror.request(full));
+        pipe_all(host, device);
+        int batches = 0;
+        while (mirror.busy() && batches < 100)
+        {
+            pipe_all(device, host);
+            server.poll();
+            batches++;
+        }
+        return batches;
+    }
+};
+
+TEST_F(StateMirrorTest, OneRequestFetchesEveryRegisteredBlob)
+{
+    sync();
+    ASSERT_FALSE(mirror.busy());
+    EXPECT_TRUE(mirror.synced());
+    EXPECT_EQ(server.request_count(), 1u);
+
+    const auto &result = mirror.last_result();
+    EXPECT_TRUE(result.complete);
+    EXPECT_EQ(result.entries, 5u);
+    EXPECT_EQ(result.fetched, 5u);
+    EXPECT_EQ(result.frames, 2u * Motor_link_t::MAX_MOTORS + 3u);
+
+    for (uint8_t i = 0; i < Motor_link_t::MAX_MOTORS; ++i)
+    {
+        EXPECT_FLOAT_EQ(host_motor.motor_info[i].ratio, 10.0f + i);
+        EXPECT_EQ(host_motor.motor_settings[i].feedback_interval, i + 1);
+    }
+    EXPECT_EQ(host_encoder.encoder_info.resolution, 14);
+    EXPECT_EQ(host_encoder.encoder_setting.feedback_interval, 5);
+
+    const auto *info = mirror.find(COMPONENT_ID_MOTORS, Motor_link_t::MOTOR_INFO_ID);
+    ASSERT_NE(info, nullptr);
+    EXPECT_TRUE(info->valid);
+    EXPECT_EQ(info->count, Motor_link_t::MAX_MOTORS);
+    EXPECT_EQ(info->element_length, sizeof(Motor_link_t::info_t));
+}
+
+TEST_F(StateMirrorTest, ResyncRefetchesOnlyChangedBlobs)
+{
+    sync();
+    const auto before = *mirror.find(COMPONENT_ID_MOTORS, Motor_link_t::MOTOR_SETTING_ID);
+
+    sync();
+    EXPECT_EQ(mirror.last_result().fetched, 0u);
+    EXPECT_EQ(mirror.last_result().frames, 0u);
+    EXPECT_TRUE(mirror.synced());
+
+    device_motor.motor_settings[6].feedback_interval = 99;
+    sync();
+    EXPECT_EQ(mirror.last_result().fetched, 1u);
+    EXPECT_EQ(mirror.last_result().frames, Motor_link_t::MAX_MOTORS);
+    EXPECT_EQ(host_motor.motor_settings[6].feedback_interval, 99);
+
+    const auto *after = mirror.find(COMPONENT_ID_MOTORS, Motor_link_t::MOTOR_SETTING_ID);
+    EXPECT_EQ(after->generation, before.generation + 1);
+    EXPECT_NE(after->crc, before.crc);
+
+    // touch() 强制重发；full 请求取回全部
+    server.touch(COMPONENT_ID_ENCODERS, Encoder_link_t::ENCODER_INFO_ID);
+    sync();
+    EXPECT_EQ(mirror.last_result().fetched, 1u);
+    sync(true);
+    EXPECT_EQ(mirror.last_result().fetched, 5u);
+}
+
+TEST_F(StateMirrorTest, LargeSnapshotStreamsAcrossPolls)
+{
+    static uint8_t device_blob[6][400];
+    static uint8_t host_blob[6][400];
+    for (int i = 0; i < 6; ++i)
+        std::memset(device_blob[i], 0x10 + i, sizeof(device_blob[i]));
+    std::memset(host_blob, 0, sizeof(host_blob));
+
+    // 元素首字节作为编号
+    for (uint8_t i = 0; i < 6; ++i)
+        device_blob[i][0] = i;
+    host.register_handle_data(
+        COMPONENT_ID_EXAMPLES, 0x30, nullptr,
+        [](const uint8_t *data, uint16_t len)
+        {
+            std::memcpy(host_blob[data[0]], data, len);
+            return true;
+        },
+        sizeof(host_blob[0]));
+    ASSERT_TRUE(server.add_array(COMPONENT_ID_EXAMPLES, 0x30, device_blob));
+    EXPECT_GT(sizeof(device_blob), MAX_SEND_BUFF_LENGTH);
+
+    const int batches = sync();
+    EXPECT_GT(batches, 1);
+    EXPECT_TRUE(mirror.synced());
+    EXPECT_EQ(std::memcmp(host_blob[5] + 1, device_blob[5] + 1, sizeof(host_blob[5]) - 1), 0);
+    EXPECT_FALSE(server.streaming());
+}
+
+TEST_F(StateMirrorTest, CorruptedFrameLeavesEntriesStale)
+{
+    ASSERT_TRUE(mirror.request());
+    pipe_all(host, device);
+
+    // 破坏设备应答中的一个数据帧（清单之后的第一个 MOTOR_INFO 帧）
+    uint32_t len = 0;
+    device.send_buff_pop(g_wire, &len);
+    unify_link_frame_head_t head;
+    std::memcpy(&head, g_wire, sizeof(head));
+    const uint32_t second = sizeof(head) + head.length();
+    g_wire[second + sizeof(head) + 4] ^= 0x5A;
+    host.rev_data_push(g_wire, len);
+    host.parse_data_task();
+
+    ASSERT_FALSE(mirror.busy());
+    EXPECT_FALSE(mirror.synced());
+    EXPECT_FALSE(mirror.last_result().complete);
+    EXPECT_FALSE(mirror.find(COMPONENT_ID_MOTORS, Motor_link_t::MOTOR_INFO_ID)->valid);
+
+    sync();
+    EXPECT_TRUE(mirror.synced());
+    EXPECT_EQ(mirror.last_result().fetched, 5u);
+}
+
+TEST_F(StateMirrorTest, BundledSnapshotAndStaleReplies)
+{
+    device.set_bundle_policy(MAX_FRAME_DATA_LENGTH);
+    sync();
+    EXPECT_TRUE(mirror.synced());
+    EXPECT_EQ(host_motor.motor_settings[3].feedback_interval, 4);
+    EXPECT_FALSE(device.bundle_pending());
+
+    // 旧请求的应答被忽略，只有最新请求生效
+    ASSERT_TRUE(mirror.request(true));
+    pipe_all(host, device);
+    uint32_t stale_len = 0;
+    uint8_t stale[2 * MAX_SEND_BUFF_LENGTH];
+    device.send_buff_pop(stale, &stale_len);
+
+    int syncs = 0;
+    mirror.on_synced = [&syncs](const State_mirror::sync_result_t &) { syncs++; };
+    sync();
+    host.rev_data_push(stale, stale_len);
+    host.parse_data_task();
+    EXPECT_EQ(syncs, 1);
+    EXPECT_EQ(mirror.last_result().fetched, 0u);
+}
+
+TEST_F(StateMirrorTest, ChangeBeyond64KiBIsDetected)
+{
+    static uint8_t device_blob[255][300];
+    std::memset(device_blob, 0x5A, sizeof(device_blob));
+    host.register_handle_data(COMPONENT_ID_EXAMPLES, 0x31, nullptr, nullptr, sizeof(device_blob[0]));
+    ASSERT_TRUE(server.add_array(COMPONENT_ID_EXAMPLES, 0x31, device_blob));
+    EXPECT_GT(sizeof(device_blob), 0xFFFFu);
+
+    sync();
+    ASSERT_TRUE(mirror.synced());
+
+    device_blob[254][299] ^= 0xFF; // 整块第 76499 字节
+    sync();
+    EXPECT_EQ(mirror.last_result().fetched, 1u);
+    EXPECT_EQ(mirror.last_result().frames, 255u);
+}
+
+TEST(StateMirrorSizedLinkTest, ManifestFitsSmallLinkFrame)
+{
+    using Small_link = Unify_link_t<256, 256, 64>;
+    static_assert(2 + snapshot_max_entries<Small_link> * sizeof(snapshot_manifest_entry_t) <= 64);
+
+    Small_link device;
+    Small_link host;
+    Encoder_link_basic_t<Small_link> device_encoder(device);
+    Encoder_link_basic_t<Small_link> host_encoder(host);
+    Snapshot_server_t<Small_link> server(device);
+    State_mirror_t<Small_link> mirror(host);
+    EXPECT_TRUE(server.registered());
+    EXPECT_TRUE(mirror.registered());
+
+    device_encoder.encoder_info = {};
+    device_encoder.encoder_info.resolution = 12;
+    ASSERT_EQ(add_encoder_snapshot(server, device_encoder), 2u);
+    uint8_t too_long[65] = {0};
+    EXPECT_FALSE(server.add(COMPONENT_ID_EXAMPLES, 0x01, too_long, sizeof(too_long)));
+
+    auto pipe = [](Small_link &tx, Small_link &rx)
+    {
+        uint8_t bytes[512];
+        uint32_t len = 0;
+        tx.send_buff_pop(bytes, &len);
+        rx.rev_data_push(bytes, len);
+        rx.parse_data_task();
+    };
+
+    ASSERT_TRUE(mirror.request());
+    pipe(host, device);
+    for (int i = 0; i < 10 && mirror.busy(); ++i)
+    {
+        pipe(device, host);
+        server.poll();
+    }
+    EXPECT_TRUE(mirror.synced());
+    EXPECT_EQ(mirror.size(), 2u);
+    EXPECT_EQ(host_encoder.encoder_info.resolution, 12);
+}
+
+TEST(StateMirrorSizedLinkTest, FullDispatchTableIsReported)
+{
+    using Tiny_link = Unify_link_t<256, 256, 64, 1, 8>;
+    Tiny_link host;
+    Motor_link_basic_t<Tiny_link> host_motor(host); // 占用 7 项
+    State_mirror_t<Tiny_link> mirror(host);
+    EXPECT_FALSE(mirror.registered());
+}
+
+TEST(StateMirrorStaticTest, AddRegisteredCoversStaticRoutes)
+{
+    Unify_link_static<Encoder_link_t> device;
+    Snapshot_server_t<Unify_link_static<Encoder_link_t>> server(device);
+
+    // 编码器的 static_routes 全部是数据路由：basic、info、setting
+    EXPECT_EQ(server.add_registered(COMPONENT_ID_ENCODERS), 3u);
+    EXPECT_EQ(server.add_registered(COMPONENT_ID_MOTORS), 0u);
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
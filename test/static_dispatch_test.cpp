@@ -0,0 +1,151 @@
+/**
+ * @file static_dispatch_test.cpp
+ * @brief Unit tests for compile-time handler registration (Unify_link_static)
+ *
+ * Built with -fno-rtti (see CMakeLists.txt) to make sure firmware builds can use it.
+ */
+
+#include "encoder_link.hpp"
+#include "motor_link.hpp"
+#include "unify_link.hpp"
+#include "unify_link_static.hpp"
+#include "update_Link.hpp"
+
+#include <gtest/gtest.h>
+#include <type_traits>
+
+using namespace unify_link;
+
+class StaticDispatchTest : public ::testing::Test
+{
+protected:
+    Unify_link_static<Motor_link_t, Encoder_link_t, Update_Link_t> link;
+
+    void roundTrip()
+    {
+        uint8_t frame[1024];
+        uint32_t len = 0;
+        link.send_buff_pop(frame, &len);
+        link.rev_data_push(frame, len);
+        link.parse_data_task();
+    }
+};
+
+TEST_F(StaticDispatchTest, ComponentsBoundToLink)
+{
+    EXPECT_EQ(&link.get<Motor_link_t>().link_base, &link);
+    EXPECT_EQ(&link.get<Encoder_link_t>().link_base, &link);
+    EXPECT_EQ(&link.get<Update_Link_t>().link_base, &link);
+}
+
+TEST_F(StaticDispatchTest, MotorBasicRoundTripInvokesCallback)
+{
+    auto &motor = link.get<Motor_link_t>();
+
+    int calls = 0;
+    motor.on_motor_basic_updated = [&calls](const Motor_link_t::feedback_t (&)[Motor_link_t::MAX_MOTORS]) { ++calls; };
+
+    Motor_link_t::feedback_t sent[Motor_link_t::MAX_MOTORS] = {};
+    for (uint8_t i = 0; i < Motor_link_t::MAX_MOTORS; ++i)
+    {
+        sent[i].position = static_cast<uint16_t>(1000 + i);
+        sent[i].speed = static_cast<int16_t>(-i);
+    }
+    motor.send_motor_basic_data(sent);
+    roundTrip();
+
+    EXPECT_EQ(link.success_count(), 1u);
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(memcmp(motor.motor_basic, sent, sizeof(sent)), 0);
+}
+
+TEST_F(StaticDispatchTest, MotorInfoCallbackRoute)
+{
+    auto &motor = link.get<Motor_link_t>();
+
+    Motor_link_t::info_t info{};
+    info.motor_id = 3;
+    info.ratio = 9.0f;
+    motor.send_motor_info_data(info);
+    roundTrip();
+
+    EXPECT_EQ(link.success_count(), 1u);
+    EXPECT_EQ(motor.motor_info[3].motor_id, 3);
+    EXPECT_FLOAT_EQ(motor.motor_info[3].ratio, 9.0f);
+}
+
+TEST_F(StaticDispatchTest, EncoderAndUpdateRoundTrip)
+{
+    auto &encoder = link.get<Encoder_link_t>();
+    auto &update = link.get<Update_Link_t>();
+
+    Encoder_link_t::encoder_setting_t setting = {.feedback_interval = 5, .reset_id = 2};
+    encoder.send_encoder_setting_data(setting);
+    roundTrip();
+
+    Update_Link_t::firmware_crc_t crc = {.crc16 = 0xCAFE};
+    update.send_firmware_crc(crc);
+    roundTrip();
+
+    EXPECT_EQ(link.success_count(), 2u);
+    EXPECT_EQ(encoder.encoder_setting.feedback_interval, 5);
+    EXPECT_EQ(update.firmware_crc.crc16, 0xCAFE);
+}
+
+TEST_F(StaticDispatchTest, LengthMismatchRejected)
+{
+    const uint8_t short_payload[3] = {1, 2, 3};
+    EXPECT_FALSE(link.handle_data(Encoder_link_t::component_id, Encoder_link_t::ENCODER_SETTING_ID, short_payload,
+                                  sizeof(short_payload)));
+    EXPECT_FALSE(link.handle_data(Motor_link_t::component_id, Motor_link_t::MOTOR_SET_ID, short_payload,
+                                  sizeof(short_payload)));
+}
+
+TEST_F(StaticDispatchTest, RequestFrameRepliesWithMember)
+{
+    auto &encoder = link.get<Encoder_link_t>();
+    encoder.encoder_setting = {.feedback_interval = 7, .reset_id = 1};
+
+    EXPECT_TRUE(link.handle_data(Encoder_link_t::component_id, Encoder_link_t::ENCODER_SETTING_ID, nullptr, 0));
+    EXPECT_EQ(link.send_buff_used(), sizeof(unify_link_frame_head_t) + sizeof(Encoder_link_t::encoder_setting_t));
+}
+
+TEST_F(StaticDispatchTest, UnroutedIdsFallBackToRuntimeTable)
+{
+    uint8_t extra[4] = {0};
+    link.register_handle_data(COMPONENT_ID_EXAMPLES, 0x01, extra, nullptr, sizeof(extra));
+    // An unlisted data id of a static component also falls through.
+    link.register_handle_data(Motor_link_t::component_id, 0x7F, nullptr, nullptr, 0xFFFF);
+
+    const uint8_t payload[4] = {4, 3, 2, 1};
+    EXPECT_TRUE(link.handle_data(COMPONENT_ID_EXAMPLES, 0x01, payload, sizeof(payload)));
+    EXPECT_EQ(memcmp(extra, payload, sizeof(payload)), 0);
+    EXPECT_TRUE(link.handle_data(Motor_link_t::component_id, 0x7F, payload, 1));
+    EXPECT_FALSE(link.handle_data(COMPONENT_ID_EXAMPLES, 0x02, payload, 1));
+}
+
+TEST(StaticDispatchSizedTest, SizedLinkFromComponentLinkType)
+{
+    using Small_link = Unify_link_t<512, 512, 256>;
+    Unify_link_static<Encoder_link_basic_t<Small_link>, Update_Link_basic_t<Small_link>> link;
+    static_assert(std::is_base_of_v<Small_link, decltype(link)>, "static link must derive from the sized link");
+
+    auto &update = link.get<Update_Link_basic_t<Small_link>>();
+    Update_Link_t::firmware_crc_t crc = {.crc16 = 0xBEEF};
+    update.send_firmware_crc(crc);
+
+    uint8_t frame[64];
+    uint32_t len = 0;
+    link.send_buff_pop(frame, &len);
+    link.rev_data_push(frame, len);
+    link.parse_data_task();
+
+    EXPECT_EQ(link.success_count(), 1u);
+    EXPECT_EQ(update.firmware_crc.crc16, 0xBEEF);
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
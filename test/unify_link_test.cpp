@@ -3,6 +3,9 @@
  * @brief Unit tests for Unify_link core functionality
  */
 
+#define UNIFY_LINK_STATS_SLOTS 32     // per-ID stats tables are off by default
+#define UNIFY_LINK_RELIABLE_STORE 2048 // so are reliable sends
+
 #include "encoder_link.hpp"
 #include "motor_link.hpp"
 #include "unify_link.hpp"
@@ -11,9 +14,17 @@
 #include <chrono>
 #include <gtest/gtest.h>
 #include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 using namespace unify_link;
 
+// 默认构建（UNIFY_LINK_LATENCY=0）不包含任何时延测量成员
+template <typename Link>
+concept has_latency_tracker = requires(Link &link) { link.latency; };
+static_assert(!has_latency_tracker<Unify_link_base>, "latency instrumentation must compile out by default");
+
 // ============================================================================
 // Circular Buffer Tests
 // ============================================================================
@@ -129,6 +140,187 @@ TEST_F(CircularBufferTest, WrapAround)
     }
 }
 
+TEST_F(CircularBufferTest, PeekContiguousView)
+{
+    uint8_t input[] = {0x10, 0x20, 0x30, 0x40, 0x50};
+    buffer.push_data(input, 5);
+
+    const uint8_t *view = buffer.peek(3, 1);
+    ASSERT_NE(view, nullptr);
+    EXPECT_EQ(view[0], 0x20);
+    EXPECT_EQ(view[2], 0x40);
+
+    // Not enough data
+    EXPECT_EQ(buffer.peek(5, 1), nullptr);
+
+    // peek doesn't consume data
+    EXPECT_EQ(buffer.used(), 5u);
+}
+
+TEST_F(CircularBufferTest, PeekRejectsWrappedRange)
+{
+    uint8_t data1[200] = {0};
+    uint8_t data2[100] = {0};
+
+    buffer.push_data(data1, 200);
+    buffer.pop_data(150);
+    buffer.push_data(data2, 100); // wraps around the ring end
+
+    // [150, 256) is contiguous, anything beyond crosses the end
+    EXPECT_NE(buffer.peek(106), nullptr);
+    EXPECT_EQ(buffer.peek(107), nullptr);
+    EXPECT_NE(buffer.peek(40, 106), nullptr);
+}
+
+TEST_F(CircularBufferTest, ReserveAndCommit)
+{
+    auto seg = buffer.reserve(4);
+    ASSERT_EQ(seg.size(), 4u);
+    EXPECT_EQ(seg.len[1], 0u);
+
+    const uint8_t data[4] = {1, 2, 3, 4};
+    seg.write(0, data, 4);
+
+    // Not visible until committed
+    EXPECT_EQ(buffer.used(), 0u);
+    buffer.commit(4);
+    EXPECT_EQ(buffer.used(), 4u);
+
+    uint8_t out[4] = {0};
+    buffer.read_data(out, 4);
+    EXPECT_EQ(memcmp(out, data, 4), 0);
+}
+
+TEST_F(CircularBufferTest, ReserveSplitsAtRingEnd)
+{
+    uint8_t filler[250] = {0};
+    buffer.push_data(filler, 250);
+    buffer.pop_data(250);
+
+    auto seg = buffer.reserve(10);
+    ASSERT_EQ(seg.size(), 10u);
+    EXPECT_EQ(seg.len[0], 6u);
+    EXPECT_EQ(seg.len[1], 4u);
+
+    uint8_t data[10];
+    for (int i = 0; i < 10; ++i)
+        data[i] = static_cast<uint8_t>(0x30 + i);
+    seg.write(0, data, 3);
+    seg.write(3, data + 3, 7); // crosses the segment boundary
+    buffer.commit(10);
+
+    uint8_t out[10] = {0};
+    EXPECT_EQ(buffer.read_data(out, 10), 10u);
+    EXPECT_EQ(memcmp(out, data, 10), 0);
+}
+
+TEST_F(CircularBufferTest, ReserveFailsWhenFull)
+{
+    EXPECT_EQ(buffer.reserve(BUFFER_SIZE).size(), 0u);
+    EXPECT_EQ(buffer.reserve(BUFFER_SIZE - 1).size(), BUFFER_SIZE - 1);
+}
+
+TEST_F(CircularBufferTest, PeekSegmentsAndConsume)
+{
+    uint8_t filler[200] = {0};
+    buffer.push_data(filler, 200);
+    buffer.pop_data(200);
+
+    uint8_t data[100];
+    for (int i = 0; i < 100; ++i)
+        data[i] = static_cast<uint8_t>(i);
+    buffer.push_data(data, 100); // 56 bytes before the ring end, 44 after
+
+    auto seg = buffer.peek_segments();
+    EXPECT_EQ(seg.size(), 100u);
+    EXPECT_EQ(seg.len[0], 56u);
+    EXPECT_EQ(seg.len[1], 44u);
+    EXPECT_EQ(memcmp(seg.ptr[0], data, 56), 0);
+    EXPECT_EQ(memcmp(seg.ptr[1], data + 56, 44), 0);
+
+    uint32_t len = 0;
+    const uint8_t *first = buffer.peek_contiguous(&len);
+    EXPECT_EQ(first, seg.ptr[0]);
+    EXPECT_EQ(len, 56u);
+
+    // Partial write: only consume what left the wire
+    buffer.consume(30);
+    first = buffer.peek_contiguous(&len);
+    EXPECT_EQ(len, 26u);
+    EXPECT_EQ(first[0], 30);
+    EXPECT_EQ(buffer.used(), 70u);
+}
+
+// ============================================================================
+// Power-of-two SPSC Ring Buffer Tests
+// ============================================================================
+
+class SpscRingBufferTest : public ::testing::Test
+{
+protected:
+    static constexpr uint32_t BUFFER_SIZE = 256;
+    Spsc_ring_buffer<uint8_t, BUFFER_SIZE> buffer;
+};
+
+TEST_F(SpscRingBufferTest, FullCapacityUsable)
+{
+    EXPECT_EQ(buffer.remain(), BUFFER_SIZE);
+
+    std::vector<uint8_t> data(BUFFER_SIZE, 0x5A);
+    EXPECT_EQ(buffer.push_data(data.data(), BUFFER_SIZE), BUFFER_SIZE);
+    EXPECT_EQ(buffer.remain(), 0u);
+
+    uint8_t extra = 0;
+    EXPECT_EQ(buffer.push_data(&extra, 1), 0u);
+}
+
+TEST_F(SpscRingBufferTest, WrapAroundKeepsOrder)
+{
+    // Repeated pushes/pops move the monotonic indices around the ring many times
+    uint8_t in[100];
+    uint8_t out[100];
+    for (int round = 0; round < 50; ++round)
+    {
+        for (int i = 0; i < 100; ++i)
+            in[i] = static_cast<uint8_t>(round + i);
+
+        ASSERT_EQ(buffer.push_data(in, 100), 100u);
+        ASSERT_EQ(buffer.read_data(out, 100), 100u);
+        ASSERT_EQ(memcmp(in, out, 100), 0);
+        ASSERT_EQ(buffer.pop_data(100), 100u);
+    }
+    EXPECT_EQ(buffer.used(), 0u);
+}
+
+TEST_F(SpscRingBufferTest, ReservePeekConsume)
+{
+    uint8_t filler[200] = {0};
+    buffer.push_data(filler, 200);
+    buffer.pop_data(200);
+
+    auto seg = buffer.reserve(100);
+    ASSERT_EQ(seg.size(), 100u);
+    EXPECT_EQ(seg.len[0], 56u);
+
+    uint8_t data[100];
+    for (int i = 0; i < 100; ++i)
+        data[i] = static_cast<uint8_t>(i);
+    seg.write(0, data, 100);
+    buffer.commit(100);
+
+    EXPECT_EQ(buffer.peek(57), nullptr);
+    ASSERT_NE(buffer.peek(56), nullptr);
+
+    auto rd = buffer.peek_segments();
+    EXPECT_EQ(rd.size(), 100u);
+    EXPECT_EQ(memcmp(rd.ptr[1], data + 56, 44), 0);
+
+    buffer.consume(60);
+    uint8_t out[40];
+    EXPECT_EQ(buffer.read_data(out, 40), 40u);
+    EXPECT_EQ(memcmp(out, data + 60, 40), 0);
+}
+
 // ============================================================================
 // Frame Header Tests
 // ============================================================================
@@ -193,9 +385,9 @@ protected:
 
 TEST_F(UnifyLinkBaseTest, InitialCounters)
 {
-    EXPECT_EQ(link.success_count, 0u);
-    EXPECT_EQ(link.com_error_count, 0u);
-    EXPECT_EQ(link.decode_error_count, 0u);
+    EXPECT_EQ(link.success_count(), 0u);
+    EXPECT_EQ(link.com_error_count(), 0u);
+    EXPECT_EQ(link.decode_error_count(), 0u);
 }
 
 TEST_F(UnifyLinkBaseTest, BuildAndParseFrame)
@@ -223,12 +415,93 @@ TEST_F(UnifyLinkBaseTest, BuildAndParseFrame)
     link.rev_data_push(frame_buffer, frame_len);
     link.parse_data_task();
 
-    EXPECT_EQ(link.success_count, 1u);
+    EXPECT_EQ(link.success_count(), 1u);
 
     // Verify received data matches sent data
     EXPECT_EQ(memcmp(received_data, payload, 64), 0);
 }
 
+TEST_F(UnifyLinkBaseTest, ReRegisterReplacesHandler)
+{
+    uint8_t first[4] = {0};
+    uint8_t second[4] = {0};
+    EXPECT_TRUE(link.register_handle_data(0x02, 0x07, first, nullptr, sizeof(first)));
+    EXPECT_TRUE(link.register_handle_data(0x02, 0x07, second, nullptr, sizeof(second)));
+
+    const uint8_t payload[4] = {1, 2, 3, 4};
+    EXPECT_TRUE(link.handle_data(0x02, 0x07, payload, sizeof(payload)));
+    EXPECT_EQ(memcmp(second, payload, sizeof(payload)), 0);
+    EXPECT_EQ(first[0], 0);
+}
+
+TEST_F(UnifyLinkBaseTest, DispatchTableCapacity)
+{
+    // Handlers are limited by UNIFY_LINK_MAX_HANDLERS, across any mix of component ids
+    for (int n = 0; n < UNIFY_LINK_MAX_HANDLERS; ++n)
+    {
+        EXPECT_TRUE(link.register_handle_data(static_cast<uint8_t>(0x80 + n % 8), static_cast<uint8_t>(n), nullptr,
+                                              nullptr, 0xFFFF));
+    }
+    EXPECT_FALSE(link.register_handle_data(0xF0, 0x01, nullptr, nullptr, 0xFFFF));
+    // Re-registering an existing id reuses its entry
+    EXPECT_TRUE(link.register_handle_data(0x80, 0x00, nullptr, nullptr, 0xFFFF));
+
+    const uint8_t payload[2] = {0};
+    EXPECT_TRUE(link.handle_data(0x80, 0x00, payload, sizeof(payload)));
+    EXPECT_TRUE(link.handle_data(static_cast<uint8_t>(0x80 + (UNIFY_LINK_MAX_HANDLERS - 1) % 8),
+                                 static_cast<uint8_t>(UNIFY_LINK_MAX_HANDLERS - 1), payload, sizeof(payload)));
+    EXPECT_FALSE(link.handle_data(0xF0, 0x01, payload, sizeof(payload)));
+    EXPECT_FALSE(link.handle_data(0x81, 0x00, payload, sizeof(payload)));
+}
+
+TEST(DispatchTableTest, FindsEveryKeyOfAFullTable)
+{
+    // 同组件连续 ID 与跨组件同 ID 都会产生探测冲突，满表时每个键仍可找到
+    Dispatch_table<254> table;
+    std::vector<registered_item_t *> items;
+    for (int n = 0; n < 254; ++n)
+    {
+        registered_item_t *item = table.insert(static_cast<uint8_t>(n % 3), static_cast<uint8_t>(n / 3));
+        ASSERT_NE(item, nullptr);
+        item->payload_length = static_cast<uint16_t>(n);
+        items.push_back(item);
+    }
+    EXPECT_EQ(table.size(), 254u);
+    EXPECT_EQ(table.insert(0x10, 0x10), nullptr);
+
+    for (int n = 0; n < 254; ++n)
+        EXPECT_EQ(table.find(static_cast<uint8_t>(n % 3), static_cast<uint8_t>(n / 3)), items[n]);
+    EXPECT_EQ(table.find(0x03, 0x00), nullptr);
+    EXPECT_EQ(table.find(0x00, 0xFF), nullptr);
+}
+
+TEST(DispatchTableTest, CapacityIsPerLink)
+{
+    Unify_link_t<256, 256, 64, 1, 4> link;
+    for (uint8_t id = 0; id < 4; ++id)
+        EXPECT_TRUE(link.register_handle_data(COMPONENT_ID_MOTORS, id, nullptr, nullptr, 0xFFFF));
+    EXPECT_FALSE(link.register_handle_data(COMPONENT_ID_MOTORS, 0x04, nullptr, nullptr, 0xFFFF));
+    EXPECT_LT(sizeof(link.registered_table), sizeof(Dispatch_table<UNIFY_LINK_MAX_HANDLERS>));
+}
+
+TEST_F(UnifyLinkBaseTest, DefaultHandlerCatchesUnregisteredIds)
+{
+    const uint8_t payload[3] = {9, 8, 7};
+    EXPECT_FALSE(link.handle_data(0x33, 0x44, payload, sizeof(payload)));
+
+    int calls = 0;
+    link.register_default_handle_data(
+        [&calls](const uint8_t *, uint16_t)
+        {
+            ++calls;
+            return true;
+        });
+
+    EXPECT_TRUE(link.handle_data(0x33, 0x44, payload, sizeof(payload)));
+    EXPECT_TRUE(link.handle_data(0x55, 0x01, payload, 1));
+    EXPECT_EQ(calls, 2);
+}
+
 TEST_F(UnifyLinkBaseTest, SequenceIdIncrement)
 {
     uint8_t dummy_data[16] = {0};
@@ -247,7 +520,142 @@ TEST_F(UnifyLinkBaseTest, SequenceIdIncrement)
         link.parse_data_task();
     }
 
-    EXPECT_EQ(link.success_count, 5u);
+    EXPECT_EQ(link.success_count(), 5u);
+}
+
+TEST_F(UnifyLinkBaseTest, FrameWrappingRingEnd)
+{
+    // 72-byte frames do not divide the receive buffer evenly, so some of them straddle the ring end
+    // and have to be parsed through the bounce copy instead of the zero-copy view.
+    uint8_t received[64] = {0};
+    link.register_handle_data(0x01, 0x02, received, nullptr, sizeof(received));
+
+    constexpr int kFrames = 64;
+    for (int n = 0; n < kFrames; ++n)
+    {
+        uint8_t payload[64];
+        for (int i = 0; i < 64; ++i)
+            payload[i] = static_cast<uint8_t>(n + i);
+
+        link.build_send_data(0x01, 0x02, payload, sizeof(payload));
+
+        uint8_t frame[128];
+        uint32_t len = 0;
+        link.send_buff_pop(frame, &len);
+
+        link.rev_data_push(frame, len);
+        link.parse_data_task();
+
+        ASSERT_EQ(memcmp(received, payload, sizeof(payload)), 0) << "frame " << n;
+    }
+
+    EXPECT_EQ(link.success_count(), static_cast<uint64_t>(kFrames));
+    EXPECT_EQ(link.com_error_count(), 0u);
+}
+
+TEST_F(UnifyLinkBaseTest, PartialFrameWaitsForRemainder)
+{
+    uint8_t received[32] = {0};
+    link.register_handle_data(0x01, 0x03, received, nullptr, sizeof(received));
+
+    uint8_t payload[32];
+    for (int i = 0; i < 32; ++i)
+        payload[i] = static_cast<uint8_t>(0xF0 - i);
+    link.build_send_data(0x01, 0x03, payload, sizeof(payload));
+
+    uint8_t frame[64];
+    uint32_t len = 0;
+    link.send_buff_pop(frame, &len);
+
+    link.rev_data_push(frame, 20);
+    link.parse_data_task();
+    EXPECT_EQ(link.success_count(), 0u);
+
+    link.rev_data_push(frame + 20, len - 20);
+    link.parse_data_task();
+    EXPECT_EQ(link.success_count(), 1u);
+    EXPECT_EQ(memcmp(received, payload, sizeof(payload)), 0);
+}
+
+TEST_F(UnifyLinkBaseTest, SendFrameSerialisesInPlace)
+{
+    uint8_t received[12] = {0};
+    link.register_handle_data(0x01, 0x05, received, nullptr, sizeof(received));
+
+    auto frame = link.begin_send_frame(0x01, 0x05, sizeof(received));
+    ASSERT_TRUE(frame.valid());
+    const uint32_t a = 0x11223344;
+    const uint32_t b = 0x55667788;
+    const uint32_t c = 0x99AABBCC;
+    EXPECT_TRUE(frame.put(a));
+    EXPECT_TRUE(frame.put(b));
+    EXPECT_TRUE(frame.put(c));
+    EXPECT_FALSE(frame.put(c)); // beyond the reserved payload
+    EXPECT_EQ(link.commit_send_frame(frame), sizeof(unify_link_frame_head_t) + sizeof(received));
+
+    uint8_t wire[64];
+    uint32_t len = 0;
+    link.send_buff_pop(wire, &len);
+    link.rev_data_push(wire, len);
+    link.parse_data_task();
+
+    EXPECT_EQ(link.success_count(), 1u);
+    EXPECT_EQ(memcmp(received, &a, 4), 0);
+    EXPECT_EQ(memcmp(received + 8, &c, 4), 0);
+}
+
+TEST_F(UnifyLinkBaseTest, IncompleteSendFrameIsDiscarded)
+{
+    auto frame = link.begin_send_frame(0x01, 0x05, 8);
+    ASSERT_TRUE(frame.valid());
+    const uint32_t value = 1;
+    frame.put(value);
+
+    EXPECT_EQ(link.commit_send_frame(frame), 0u);
+    EXPECT_EQ(link.send_buff_used(), 0u);
+
+    // The sequence id is only consumed by committed frames
+    uint8_t received[4] = {0};
+    link.register_handle_data(0x01, 0x06, received, nullptr, sizeof(received));
+    link.build_send_data(0x01, 0x06, reinterpret_cast<const uint8_t *>(&value), sizeof(value));
+    uint8_t wire[32];
+    uint32_t len = 0;
+    link.send_buff_pop(wire, &len);
+    EXPECT_EQ(wire[offsetof(unify_link_frame_head_t, seq_id)], 0);
+}
+
+TEST_F(UnifyLinkBaseTest, OversizedSendFrameRejected)
+{
+    EXPECT_FALSE(link.begin_send_frame(0x01, 0x05, MAX_FRAME_DATA_LENGTH + 1).valid());
+    EXPECT_TRUE(link.begin_send_frame(0x01, 0x05, MAX_FRAME_DATA_LENGTH).valid());
+}
+
+TEST_F(UnifyLinkBaseTest, SendBuffDrainInSegments)
+{
+    uint8_t received[40] = {0};
+    link.register_handle_data(0x01, 0x08, received, nullptr, sizeof(received));
+
+    uint8_t payload[40];
+    for (int i = 0; i < 40; ++i)
+        payload[i] = static_cast<uint8_t>(i ^ 0x5A);
+
+    // Drain in small partial "DMA" writes straight from the ring
+    for (int n = 0; n < 100; ++n)
+    {
+        ASSERT_GT(link.build_send_data(0x01, 0x08, payload, sizeof(payload)), 0u);
+        while (link.send_buff_used() > 0)
+        {
+            uint32_t len = 0;
+            const uint8_t *span = link.send_buff_peek_contiguous(&len);
+            const uint32_t chunk = std::min<uint32_t>(len, 13);
+            link.rev_data_push(span, chunk);
+            link.send_buff_consume(chunk);
+        }
+        link.parse_data_task();
+    }
+
+    EXPECT_EQ(link.success_count(), 100u);
+    EXPECT_EQ(memcmp(received, payload, sizeof(payload)), 0);
 }
 
 TEST_F(UnifyLinkBaseTest, InvalidFrameHeader)
@@ -256,7 +664,7 @@ TEST_F(UnifyLinkBaseTest, InvalidFrameHeader)
     link.rev_data_push(garbage, 5);
     link.parse_data_task();
 
-    EXPECT_EQ(link.success_count, 0u);
+    EXPECT_EQ(link.success_count(), 0u);
 }
 
 TEST_F(UnifyLinkBaseTest, TransmissionErrorCrcCorruptionIncrementsNoSuccess)
@@ -278,20 +686,1167 @@ TEST_F(UnifyLinkBaseTest, TransmissionErrorCrcCorruptionIncrementsNoSuccess)
     // CRC16 is the last 2 bytes in unify_link_frame_head_t.
     frame[offsetof(unify_link_frame_head_t, crc16)] ^= 0xFF;
 
-    const uint64_t success_before = link.success_count;
-    const uint64_t decode_err_before = link.decode_error_count;
-    const uint64_t com_err_before = link.com_error_count;
+    const uint64_t success_before = link.success_count();
+    const uint64_t decode_err_before = link.decode_error_count();
+    const uint64_t com_err_before = link.com_error_count();
 
     link.rev_data_push(frame, len);
     link.parse_data_task();
 
     // CRC mismatch frames are dropped internally (by sliding 1 byte and re-syncing),
     // so they should not count as success and should not call handle_data().
-    EXPECT_EQ(link.success_count, success_before);
-    EXPECT_EQ(link.decode_error_count, decode_err_before);
+    EXPECT_EQ(link.success_count(), success_before);
+    EXPECT_EQ(link.decode_error_count(), decode_err_before);
 
     // Sequence error counter should not change either because CRC-failed frames never reach seq check.
-    EXPECT_EQ(link.com_error_count, com_err_before);
+    EXPECT_EQ(link.com_error_count(), com_err_before);
+}
+
+// ============================================================================
+// Bundle (Message Coalescing) Tests
+// ============================================================================
+
+namespace
+{
+    uint32_t fake_clock_now = 0;
+    uint32_t fake_clock() { return fake_clock_now; }
+} // namespace
+
+class BundleTest : public ::testing::Test
+{
+protected:
+    Unify_link_base tx;
+    Unify_link_base rx;
+
+    void deliver()
+    {
+        uint8_t frame[MAX_RECV_BUFF_LENGTH];
+        uint32_t len = 0;
+        tx.send_buff_pop(frame, &len);
+        rx.rev_data_push(frame, len);
+        rx.parse_data_task();
+    }
+};
+
+TEST_F(BundleTest, RecordsShareOneFrame)
+{
+    tx.set_bundle_policy(64);
+
+    const uint8_t a[4] = {1, 2, 3, 4};
+    const uint8_t b[2] = {5, 6};
+    EXPECT_EQ(tx.build_send_data(0x01, 0x03, a, sizeof(a)), 2u + sizeof(a));
+    EXPECT_EQ(tx.build_send_data(0x01, 0x07, b, sizeof(b)), 2u + sizeof(b));
+    EXPECT_EQ(tx.send_buff_used(), 0u); // 仍在打包中
+
+    EXPECT_EQ(tx.flush_bundle(), sizeof(unify_link_frame_head_t) + 2 + sizeof(a) + 2 + sizeof(b));
+    EXPECT_FALSE(tx.bundle_pending());
+
+    auto seg = tx.send_buff_peek();
+    unify_link_frame_head_t head;
+    memcpy(&head, seg.ptr[0], sizeof(head));
+    EXPECT_EQ(head.flags(), FRAME_FLAG_BUNDLE);
+
+    uint8_t dst_a[4] = {0};
+    uint8_t dst_b[2] = {0};
+    rx.register_handle_data(0x01, 0x03, dst_a, nullptr, sizeof(dst_a));
+    rx.register_handle_data(0x01, 0x07, dst_b, nullptr, sizeof(dst_b));
+    deliver();
+
+    EXPECT_EQ(rx.success_count(), 2u); // 按记录计数
+    EXPECT_EQ(rx.decode_error_count(), 0u);
+    EXPECT_EQ(memcmp(dst_a, a, sizeof(a)), 0);
+    EXPECT_EQ(memcmp(dst_b, b, sizeof(b)), 0);
+}
+
+TEST_F(BundleTest, SizeLimitFlushes)
+{
+    tx.set_bundle_policy(14);
+
+    const uint8_t payload[6] = {0};
+    tx.build_send_data(0x02, 0x01, payload, 4);
+    tx.build_send_data(0x02, 0x02, payload, 4);
+    EXPECT_EQ(tx.send_buff_used(), 0u);
+
+    // 第三条放不下：前两条先成帧发出
+    tx.build_send_data(0x02, 0x03, payload, 4);
+    EXPECT_EQ(tx.send_buff_used(), sizeof(unify_link_frame_head_t) + 12u);
+    EXPECT_TRUE(tx.bundle_pending());
+
+    // 恰好填满上限时立即发出
+    tx.build_send_data(0x02, 0x04, payload, 6);
+    EXPECT_FALSE(tx.bundle_pending());
+    EXPECT_EQ(tx.send_buff_used(), 2 * sizeof(unify_link_frame_head_t) + 12u + 14u);
+}
+
+TEST_F(BundleTest, DeadlineFlushes)
+{
+    fake_clock_now = 100;
+    tx.set_clock(fake_clock);
+    tx.set_bundle_policy(128, 5);
+
+    const uint8_t payload[2] = {7, 8};
+    tx.build_send_data(0x02, 0x02, payload, sizeof(payload));
+
+    fake_clock_now = 104;
+    tx.bundle_poll();
+    EXPECT_TRUE(tx.bundle_pending());
+
+    fake_clock_now = 105;
+    tx.bundle_poll();
+    EXPECT_FALSE(tx.bundle_pending());
+    EXPECT_EQ(tx.send_buff_used(), sizeof(unify_link_frame_head_t) + 2u + sizeof(payload));
+}
+
+TEST_F(BundleTest, LargeAndOtherComponentFramesKeepOrder)
+{
+    tx.set_bundle_policy(32);
+
+    const uint8_t small[2] = {1, 2};
+    uint8_t large[100] = {0};
+    tx.build_send_data(0x01, 0x01, small, sizeof(small));
+    tx.build_send_data(0x01, 0x02, large, sizeof(large)); // 超出打包上限：先发包再单独成帧
+    tx.build_send_data(0x03, 0x01, small, sizeof(small));
+    tx.build_send_data(0x01, 0x03, small, sizeof(small)); // 组件切换：前一包发出
+    tx.flush_bundle();
+
+    std::vector<std::pair<uint8_t, uint8_t>> order;
+    rx.register_default_handle_data(nullptr);
+    for (uint8_t cid : {0x01, 0x03})
+    {
+        for (uint8_t did = 1; did <= 3; ++did)
+        {
+            rx.register_handle_data(cid, did, nullptr,
+                                    [&order, cid, did](const uint8_t *, uint16_t)
+                                    {
+                                        order.emplace_back(cid, did);
+                                        return true;
+                                    },
+                                    0xFFFF);
+        }
+    }
+    deliver();
+
+    const std::vector<std::pair<uint8_t, uint8_t>> expected = {{0x01, 0x01}, {0x01, 0x02}, {0x03, 0x01}, {0x01, 0x03}};
+    EXPECT_EQ(order, expected);
+    EXPECT_EQ(rx.com_error_count(), 0u);
+}
+
+TEST_F(BundleTest, TruncatedRecordCountsDecodeError)
+{
+    // 手工构造：第二条记录声明 9 字节但只剩 1 字节
+    const uint8_t records[] = {0x01, 0x01, 0xAA, 0x02, 0x09, 0xBB};
+    auto frame = tx.begin_send_frame(0x01, 0x00, sizeof(records));
+    frame.write(records, sizeof(records));
+    tx.commit_send_frame(frame);
+
+    // 把 flags 改成打包帧并重算 CRC
+    uint8_t raw[64];
+    uint32_t len = 0;
+    tx.send_buff_pop(raw, &len);
+    unify_link_frame_head_t head;
+    memcpy(&head, raw, sizeof(head));
+    head.set_flags_and_length(FRAME_FLAG_BUNDLE, sizeof(records));
+    uint16_t crc = crc16_calculation(reinterpret_cast<const uint8_t *>(&head), offsetof(unify_link_frame_head_t, crc16));
+    head.crc16 = crc16_calculation(raw + sizeof(head), sizeof(records), crc);
+    memcpy(raw, &head, sizeof(head));
+
+    rx.register_handle_data(0x01, 0x01, nullptr, nullptr, 0xFFFF);
+    rx.rev_data_push(raw, len);
+    rx.parse_data_task();
+
+    EXPECT_EQ(rx.success_count(), 1u);
+    EXPECT_EQ(rx.decode_error_count(), 1u);
+
+    // 截断的记录计到记录头中的 data_id，而不是 0
+    Unify_link_base::message_stats_t m;
+    ASSERT_TRUE(rx.stats.message(0x01, 0x02, &m));
+    EXPECT_EQ(m.decode_errors, 1u);
+    EXPECT_FALSE(rx.stats.message(0x01, 0x00, &m));
+}
+
+// ============================================================================
+// TX Priority / Latest-Value-Wins Tests
+// ============================================================================
+
+namespace
+{
+    template <typename Tx>
+    void pipe_all(Tx &tx, Unify_link_base &rx)
+    {
+        uint8_t frame[4 * MAX_RECV_BUFF_LENGTH];
+        uint32_t len = 0;
+        tx.send_buff_pop(frame, &len);
+        rx.rev_data_push(frame, len);
+        rx.parse_data_task();
+    }
+} // namespace
+
+TEST(TxPriorityTest, HighPriorityFrameOvertakesQueuedBulk)
+{
+    Unify_link_t<2048, 2048, 512, 2> tx;
+    tx.set_tx_priority(COMPONENT_ID_MOTORS, 0x04, 0);
+    EXPECT_EQ(tx.tx_priority_of(COMPONENT_ID_MOTORS, 0x04), 0);
+    EXPECT_EQ(tx.tx_priority_of(COMPONENT_ID_UPDATE, 0x01), 1);
+
+    uint8_t bulk[256] = {0};
+    const uint8_t setpoint[6] = {1, 2, 3, 4, 5, 6};
+    tx.build_send_data(COMPONENT_ID_UPDATE, 0x01, bulk, sizeof(bulk));
+    tx.build_send_data(COMPONENT_ID_UPDATE, 0x01, bulk, sizeof(bulk));
+    tx.build_send_data(COMPONENT_ID_MOTORS, 0x04, setpoint, sizeof(setpoint));
+
+    std::vector<uint8_t> order;
+    Unify_link_base rx;
+    rx.register_default_handle_data(
+        [&order](const uint8_t *, uint16_t len)
+        {
+            order.push_back(len == sizeof(setpoint) ? 0 : 1);
+            return true;
+        });
+    pipe_all(tx, rx);
+
+    // 序号在发出时分配，接收端不会把重排看作丢帧
+    EXPECT_EQ(order, (std::vector<uint8_t>{0, 1, 1}));
+    EXPECT_EQ(rx.success_count(), 3u);
+    EXPECT_EQ(rx.com_error_count(), 0u);
+}
+
+TEST(TxPriorityTest, BurstLimitBoundsLatency)
+{
+    Unify_link_t<2048, 2048, 512, 2> tx;
+    tx.set_tx_priority(COMPONENT_ID_MOTORS, 0x04, 0);
+    tx.set_tx_burst_limit(300);
+
+    uint8_t bulk[100] = {0};
+    for (int i = 0; i < 6; ++i)
+        tx.build_send_data(COMPONENT_ID_UPDATE, 0x01, bulk, sizeof(bulk));
+
+    // 第一个突发只包含 2 整帧（2 * 108 <= 300 < 3 * 108）
+    auto seg = tx.send_buff_peek();
+    EXPECT_EQ(seg.size(), 2u * (sizeof(unify_link_frame_head_t) + sizeof(bulk)));
+
+    // 突发进行中到达的高优先级帧在当前突发完成后立即发出
+    const uint8_t setpoint[6] = {0};
+    tx.build_send_data(COMPONENT_ID_MOTORS, 0x04, setpoint, sizeof(setpoint));
+    tx.send_buff_consume(seg.size() - 10);
+    EXPECT_EQ(tx.send_buff_peek().size(), 10u); // 不切换，先发完当前帧
+    tx.send_buff_consume(10);
+
+    seg = tx.send_buff_peek();
+    EXPECT_EQ(seg.size(), sizeof(unify_link_frame_head_t) + sizeof(setpoint));
+    unify_link_frame_head_t head;
+    seg.read(0, reinterpret_cast<uint8_t *>(&head), sizeof(head));
+    EXPECT_EQ(head.component_id, COMPONENT_ID_MOTORS);
+    EXPECT_EQ(head.seq_id, 2); // 前两帧已使用序号 0、1
+}
+
+TEST(TxPriorityTest, LatestValueWinsReplacesQueuedFrame)
+{
+    Unify_link_base tx;
+    Unify_link_base rx;
+    tx.set_tx_priority(COMPONENT_ID_ENCODERS, 0x01, 0, true);
+
+    uint8_t dst[4] = {0};
+    rx.register_handle_data(COMPONENT_ID_ENCODERS, 0x01, dst, nullptr, sizeof(dst));
+
+    for (uint8_t v = 1; v <= 5; ++v)
+    {
+        const uint8_t sample[4] = {v, v, v, v};
+        EXPECT_NE(tx.build_send_data(COMPONENT_ID_ENCODERS, 0x01, sample, sizeof(sample)), 0u);
+    }
+    EXPECT_EQ(tx.send_buff_used(), sizeof(unify_link_frame_head_t) + sizeof(dst));
+    EXPECT_EQ(tx.tx_replaced_count, 4u);
+
+    pipe_all(tx, rx);
+    EXPECT_EQ(rx.success_count(), 1u); // CRC 随替换重新计算
+    EXPECT_EQ(dst[0], 5);
+}
+
+TEST(TxPriorityTest, LatestValueWinsSkipsFrameInFlight)
+{
+    Unify_link_base tx;
+    tx.set_tx_priority(COMPONENT_ID_ENCODERS, 0x01, 0, true);
+
+    const uint8_t first[4] = {1, 1, 1, 1};
+    const uint8_t second[4] = {2, 2, 2, 2};
+    tx.build_send_data(COMPONENT_ID_ENCODERS, 0x01, first, sizeof(first));
+
+    // DMA 已取走第一帧但尚未完成：新值必须另起一帧
+    auto seg = tx.send_buff_peek();
+    tx.build_send_data(COMPONENT_ID_ENCODERS, 0x01, second, sizeof(second));
+    EXPECT_EQ(tx.tx_replaced_count, 0u);
+    EXPECT_EQ(tx.send_buff_used(), 2 * (sizeof(unify_link_frame_head_t) + sizeof(first)));
+
+    uint8_t in_flight[4];
+    seg.read(sizeof(unify_link_frame_head_t), in_flight, sizeof(in_flight));
+    EXPECT_EQ(memcmp(in_flight, first, sizeof(first)), 0);
+}
+
+TEST(TxPriorityTest, LatestValueWinsTracksConsumeFromInterrupt)
+{
+    Unify_link_base tx;
+    Unify_link_base rx;
+    tx.set_tx_priority(COMPONENT_ID_ENCODERS, 0x01, 0, true);
+    uint8_t dst[4] = {0};
+    rx.register_handle_data(COMPONENT_ID_ENCODERS, 0x01, dst, nullptr, sizeof(dst));
+    uint8_t other[16] = {0};
+    rx.register_handle_data(COMPONENT_ID_MOTORS, 0x01, other, nullptr, sizeof(other));
+
+    // 多轮使环形缓冲区回绕：每轮一帧在发送中，最新值帧排在其后
+    for (uint8_t round = 0; round < 200; ++round)
+    {
+        tx.build_send_data(COMPONENT_ID_MOTORS, 0x01, other, sizeof(other));
+        auto seg = tx.send_buff_peek();
+        std::vector<uint8_t> wire(seg.size());
+        seg.read(0, wire.data(), seg.size());
+        const uint8_t v1[4] = {round, 1, 1, 1};
+        tx.build_send_data(COMPONENT_ID_ENCODERS, 0x01, v1, sizeof(v1));
+
+        // 完成中断消费掉部分在途字节后再替换：替换必须落在最新值帧上，而不是在途帧或其后的字节
+        tx.send_buff_consume(static_cast<uint32_t>(wire.size() / 2));
+        const uint8_t v2[4] = {round, 2, 2, 2};
+        tx.build_send_data(COMPONENT_ID_ENCODERS, 0x01, v2, sizeof(v2));
+        tx.send_buff_consume(static_cast<uint32_t>(wire.size() - wire.size() / 2));
+
+        seg = tx.send_buff_peek();
+        const size_t at = wire.size();
+        wire.resize(at + seg.size());
+        seg.read(0, wire.data() + at, seg.size());
+        tx.send_buff_consume(seg.size());
+
+        rx.rev_data_push(wire.data(), static_cast<uint32_t>(wire.size()));
+        rx.parse_data_task();
+        ASSERT_EQ(dst[0], round);
+        ASSERT_EQ(dst[1], 2);
+    }
+    EXPECT_EQ(tx.tx_replaced_count, 200u);
+    EXPECT_EQ(rx.success_count(), 400u);
+    EXPECT_EQ(rx.stats_totals().crc_errors, 0u);
+}
+
+// ============================================================================
+// Sized Link Tests
+// ============================================================================
+
+// ============================================================================
+// Reliable Delivery Tests
+// ============================================================================
+
+class ReliableTest : public ::testing::Test
+{
+protected:
+    Unify_link_base tx;
+    Unify_link_base rx;
+    std::vector<uint8_t> delivered;
+
+    void SetUp() override
+    {
+        fake_clock_now = 0;
+        tx.set_clock(fake_clock);
+        rx.set_clock(fake_clock);
+        rx.register_handle_data(COMPONENT_ID_MOTORS, 0x03, nullptr,
+                                [this](const uint8_t *data, uint16_t len)
+                                {
+                                    EXPECT_EQ(len, 1u);
+                                    delivered.push_back(data[0]);
+                                    return true;
+                                },
+                                1);
+    }
+
+    void send(uint8_t value) { EXPECT_NE(tx.send_reliable(COMPONENT_ID_MOTORS, 0x03, &value, 1), 0u); }
+
+    // 把 from 的待发数据丢弃
+    static void drop_all(Unify_link_base &from)
+    {
+        uint8_t frame[MAX_SEND_BUFF_LENGTH];
+        uint32_t len = 0;
+        from.send_buff_pop(frame, &len);
+    }
+
+    void expire()
+    {
+        fake_clock_now += tx.reliable_rto();
+        tx.reliable_poll();
+    }
+};
+
+TEST_F(ReliableTest, DeliveredOnceAndAcknowledged)
+{
+    send(7);
+    EXPECT_EQ(tx.reliable_pending(), 1u);
+
+    fake_clock_now = 30;
+    pipe_all(tx, rx);
+    pipe_all(rx, tx);
+
+    EXPECT_EQ(delivered, std::vector<uint8_t>({7}));
+    EXPECT_EQ(tx.reliable_pending(), 0u);
+    EXPECT_EQ(tx.reliable_srtt(), 30u);
+    EXPECT_EQ(tx.reliable_rto(), 30u + 4 * 15u);
+    EXPECT_EQ(tx.reliable_retransmit_count, 0u);
+}
+
+TEST_F(ReliableTest, LostFrameIsRetransmittedAfterTimeout)
+{
+    send(1);
+    drop_all(tx);
+
+    fake_clock_now = tx.reliable_rto_initial - 1;
+    tx.reliable_poll();
+    EXPECT_EQ(tx.send_buff_used(), 0u);
+
+    fake_clock_now = tx.reliable_rto_initial;
+    tx.reliable_poll();
+    EXPECT_EQ(tx.reliable_retransmit_count, 1u);
+    EXPECT_EQ(tx.reliable_rto(), 2 * tx.reliable_rto_initial);
+
+    pipe_all(tx, rx);
+    pipe_all(rx, tx);
+    EXPECT_EQ(delivered, std::vector<uint8_t>({1}));
+    EXPECT_EQ(tx.reliable_pending(), 0u);
+    EXPECT_EQ(tx.reliable_srtt(), 0u); // 重传过的帧不参与 RTT 采样
+}
+
+TEST_F(ReliableTest, LostAckDoesNotDeliverTwice)
+{
+    send(5);
+    pipe_all(tx, rx);
+    drop_all(rx);
+
+    expire();
+    pipe_all(tx, rx);
+    pipe_all(rx, tx);
+
+    EXPECT_EQ(delivered, std::vector<uint8_t>({5}));
+    EXPECT_EQ(rx.reliable_duplicate_count, 1u);
+    EXPECT_EQ(tx.reliable_pending(), 0u);
+}
+
+TEST_F(ReliableTest, GapIsRepairedInOrder)
+{
+    send(1);
+    drop_all(tx);
+    send(2);
+    send(3);
+    pipe_all(tx, rx); // 2、3 在 1 之前到达：不交付
+    pipe_all(rx, tx);
+    EXPECT_TRUE(delivered.empty());
+    EXPECT_EQ(tx.reliable_pending(), 3u);
+
+    expire();
+    pipe_all(tx, rx);
+    pipe_all(rx, tx);
+    EXPECT_EQ(delivered, std::vector<uint8_t>({1, 2, 3}));
+    EXPECT_EQ(tx.reliable_pending(), 0u);
+}
+
+TEST_F(ReliableTest, GivesUpAfterMaxRetriesAndResyncs)
+{
+    tx.reliable_max_retries = 1;
+    int failed = 0;
+    tx.on_reliable_failed = [&](uint8_t cid, uint8_t did)
+    {
+        EXPECT_EQ(cid, COMPONENT_ID_MOTORS);
+        EXPECT_EQ(did, 0x03);
+        failed++;
+    };
+
+    send(1);
+    pipe_all(tx, rx);
+    pipe_all(rx, tx);
+
+    send(2);
+    drop_all(tx);
+    expire();
+    drop_all(tx);
+    expire();
+    EXPECT_EQ(failed, 1);
+    EXPECT_EQ(tx.reliable_fail_count, 1u);
+    EXPECT_EQ(tx.reliable_pending(), 0u);
+
+    // 下一帧带同步位，接收端跳过被放弃的序号
+    send(3);
+    pipe_all(tx, rx);
+    pipe_all(rx, tx);
+    EXPECT_EQ(delivered, std::vector<uint8_t>({1, 3}));
+    EXPECT_EQ(tx.reliable_pending(), 0u);
+}
+
+TEST_F(ReliableTest, RestartedSenderIsRenumbered)
+{
+    for (uint8_t v = 1; v <= 3; ++v)
+    {
+        send(v);
+        pipe_all(tx, rx);
+        pipe_all(rx, tx);
+    }
+
+    Unify_link_base restarted; // 序号重新从 0 开始
+    restarted.set_clock(fake_clock);
+    const uint8_t value = 9;
+    restarted.send_reliable(COMPONENT_ID_MOTORS, 0x03, &value, 1);
+    pipe_all(restarted, rx); // 看起来是重复帧，只应答
+    pipe_all(rx, restarted); // 应答不在窗口内：重新编号后立即重传
+    pipe_all(restarted, rx);
+    pipe_all(rx, restarted);
+
+    EXPECT_EQ(delivered, std::vector<uint8_t>({1, 2, 3, 9}));
+    EXPECT_EQ(restarted.reliable_pending(), 0u);
+}
+
+TEST_F(ReliableTest, RestartedReceiverRequestsResync)
+{
+    send(1);
+    pipe_all(tx, rx);
+    pipe_all(rx, tx);
+
+    Unify_link_base restarted; // 未同步，不接受不带同步位的帧
+    restarted.register_handle_data(COMPONENT_ID_MOTORS, 0x03, nullptr,
+                                   [this](const uint8_t *data, uint16_t)
+                                   {
+                                       delivered.push_back(data[0]);
+                                       return true;
+                                   },
+                                   1);
+    send(2);
+    pipe_all(tx, restarted);
+    EXPECT_EQ(delivered, std::vector<uint8_t>({1}));
+    pipe_all(restarted, tx); // 应答请求重新同步：立即带同步位重传
+    EXPECT_EQ(tx.reliable_retransmit_count, 1u);
+    pipe_all(tx, restarted);
+    pipe_all(restarted, tx);
+
+    EXPECT_EQ(delivered, std::vector<uint8_t>({1, 2}));
+    EXPECT_EQ(tx.reliable_pending(), 0u);
+}
+
+TEST_F(ReliableTest, ReliableRuleLeavesTelemetryUnacknowledged)
+{
+    EXPECT_TRUE(tx.set_reliable(COMPONENT_ID_MOTORS, 0x03));
+
+    const uint8_t setting = 4;
+    const uint8_t telemetry[4] = {1, 2, 3, 4};
+    tx.template send_packet<COMPONENT_ID_MOTORS>(0x03, setting);
+    tx.build_send_data(COMPONENT_ID_MOTORS, 0x01, telemetry, sizeof(telemetry));
+    EXPECT_EQ(tx.reliable_pending(), 1u);
+
+    uint8_t frame[MAX_SEND_BUFF_LENGTH];
+    uint32_t len = 0;
+    tx.send_buff_pop(frame, &len);
+    unify_link_frame_head_t first;
+    unify_link_frame_head_t second;
+    std::memcpy(&first, frame, sizeof(first));
+    std::memcpy(&second, frame + sizeof(first) + first.length(), sizeof(second));
+    EXPECT_EQ(first.flags(), FRAME_FLAG_ACK_REQ);
+    EXPECT_EQ(first.length(), 2u);
+    EXPECT_EQ(second.flags(), 0u);
+
+    rx.rev_data_push(frame, len);
+    rx.parse_data_task();
+    EXPECT_EQ(delivered, std::vector<uint8_t>({4}));
+    EXPECT_EQ(rx.decode_error_count(), 1u); // 0x01 未注册
+    pipe_all(rx, tx);
+    EXPECT_EQ(tx.reliable_pending(), 0u);
+}
+
+TEST_F(ReliableTest, WindowLimitsOutstandingFrames)
+{
+    for (uint8_t i = 0; i < UNIFY_LINK_RELIABLE_WINDOW; ++i)
+        send(i);
+
+    const uint8_t extra = 0xEE;
+    EXPECT_EQ(tx.send_reliable(COMPONENT_ID_MOTORS, 0x03, &extra, 1), 0u);
+
+    pipe_all(tx, rx);
+    pipe_all(rx, tx);
+    EXPECT_EQ(delivered.size(), static_cast<size_t>(UNIFY_LINK_RELIABLE_WINDOW));
+    EXPECT_NE(tx.send_reliable(COMPONENT_ID_MOTORS, 0x03, &extra, 1), 0u);
+}
+
+TEST_F(ReliableTest, FrameThatDoesNotFitAfterBundleFlushIsNotQueued)
+{
+    // 打开的打包帧预留的空间不计入 send_buff_remain()，发出打包帧后可靠帧可能放不下
+    tx.set_bundle_policy(256);
+    const uint8_t big[280] = {0};
+    while (tx.send_buff_remain() >= 2 * 300)
+        ASSERT_NE(tx.build_send_data(COMPONENT_ID_UPDATE, 0x20, big, sizeof(big)), 0u);
+    const uint32_t remain = tx.send_buff_remain();
+    ASSERT_GE(remain, 264u);
+    ASSERT_LT(remain, static_cast<uint32_t>(MAX_FRAME_DATA_LENGTH));
+
+    const uint8_t record[100] = {0};
+    ASSERT_NE(tx.build_send_data(COMPONENT_ID_MOTORS, 0x01, record, sizeof(record)), 0u);
+    ASSERT_TRUE(tx.bundle_pending());
+
+    const uint8_t payload[MAX_FRAME_DATA_LENGTH] = {0};
+    const uint16_t len = static_cast<uint16_t>(remain - sizeof(unify_link_frame_head_t) - 1); // 整帧恰好等于 remain
+    EXPECT_EQ(tx.send_reliable(COMPONENT_ID_MOTORS, 0x03, payload, len), 0u);
+    EXPECT_EQ(tx.reliable_pending(), 0u);
+
+    // 未入队的帧不占用序号：下一帧照常交付
+    drop_all(tx);
+    send(5);
+    pipe_all(tx, rx);
+    pipe_all(rx, tx);
+    EXPECT_EQ(delivered, std::vector<uint8_t>({5}));
+    EXPECT_EQ(tx.reliable_pending(), 0u);
+}
+
+TEST(ReliableStoreTest, StoreIsOptInAndSizedByLink)
+{
+    static_assert(Unify_link_base::reliable_store_size == UNIFY_LINK_RELIABLE_STORE);
+    static_assert(Unify_link_t<512, 256, 64>::reliable_store_size == 256);
+}
+
+// ============================================================================
+// Fragmentation Tests
+// ============================================================================
+
+class FragmentTest : public ::testing::Test
+{
+protected:
+    static constexpr uint16_t kLarge = 20000;
+
+    Unify_link_base tx;
+    Unify_link_base rx;
+    std::vector<uint8_t> table = std::vector<uint8_t>(kLarge);
+    std::vector<uint8_t> dst = std::vector<uint8_t>(kLarge);
+    int completed = 0;
+
+    void SetUp() override
+    {
+        for (size_t i = 0; i < table.size(); ++i)
+            table[i] = static_cast<uint8_t>(i * 7 + (i >> 8));
+        rx.register_handle_data(COMPONENT_ID_UPDATE, 0x10, dst.data(),
+                                [this](const uint8_t *data, uint16_t len)
+                                {
+                                    EXPECT_EQ(data, dst.data()); // 原地重组，无中转拷贝
+                                    EXPECT_EQ(len, kLarge);
+                                    completed++;
+                                    return true;
+                                },
+                                kLarge);
+    }
+
+    void transfer()
+    {
+        for (int i = 0; i < 1000 && (tx.fragment_pending() || tx.send_buff_used() != 0); ++i)
+        {
+            pipe_all(tx, rx);
+            tx.fragment_poll();
+        }
+    }
+};
+
+TEST_F(FragmentTest, LargeMessageIsReassembledInPlace)
+{
+    // 超长消息不会隐式分片：build_send_data() 返回后调用方的缓冲区可能已失效
+    EXPECT_EQ(tx.build_send_data(COMPONENT_ID_UPDATE, 0x10, table.data(), kLarge), 0u);
+    EXPECT_EQ(tx.send_buff_used(), 0u);
+
+    EXPECT_TRUE(tx.send_fragmented(COMPONENT_ID_UPDATE, 0x10, table.data(), kLarge));
+    EXPECT_TRUE(tx.fragment_pending());
+    EXPECT_LE(tx.send_buff_used(), tx.fragment_queue_limit + tx.max_frame_length);
+
+    // 分片发送期间不接受第二条超长消息
+    EXPECT_FALSE(tx.send_fragmented(COMPONENT_ID_UPDATE, 0x10, table.data(), kLarge));
+
+    transfer();
+    EXPECT_FALSE(tx.fragment_pending());
+    EXPECT_EQ(completed, 1);
+    EXPECT_EQ(rx.success_count(), 1u);
+    EXPECT_EQ(rx.decode_error_count(), 0u);
+    EXPECT_EQ(dst, table);
+}
+
+TEST_F(FragmentTest, SmallFramesInterleaveWithFragments)
+{
+    uint8_t small_rx = 0;
+    std::vector<uint16_t> order; // 收到小帧时已重组的字节数
+    rx.register_handle_data(COMPONENT_ID_MOTORS, 0x04, &small_rx,
+                            [&](const uint8_t *, uint16_t)
+                            {
+                                order.push_back(rx.rx_fragment.received);
+                                return true;
+                            },
+                            1);
+
+    tx.send_fragmented(COMPONENT_ID_UPDATE, 0x10, table.data(), kLarge);
+    pipe_all(tx, rx);
+    tx.fragment_poll();
+
+    const uint8_t setpoint = 42;
+    tx.build_send_data(COMPONENT_ID_MOTORS, 0x04, &setpoint, 1);
+    transfer();
+
+    ASSERT_EQ(order.size(), 1u);
+    EXPECT_LT(order[0], 5u * MAX_FRAME_DATA_LENGTH); // 小帧最多排在两个分片之后
+    EXPECT_EQ(small_rx, setpoint);
+    EXPECT_EQ(completed, 1);
+    EXPECT_EQ(dst, table);
+}
+
+TEST_F(FragmentTest, LostFragmentDropsMessageUntilNextStart)
+{
+    tx.send_fragmented(COMPONENT_ID_UPDATE, 0x10, table.data(), kLarge);
+    uint8_t frames[4 * MAX_RECV_BUFF_LENGTH];
+    uint32_t len = 0;
+    tx.send_buff_pop(frames, &len); // 前两个分片丢失
+    tx.fragment_poll();
+    transfer();
+
+    EXPECT_EQ(completed, 0);
+    const uint64_t errors = rx.decode_error_count();
+    EXPECT_GT(errors, 0u);
+
+    tx.send_fragmented(COMPONENT_ID_UPDATE, 0x10, table.data(), kLarge);
+    transfer();
+    EXPECT_EQ(completed, 1);
+    EXPECT_EQ(rx.decode_error_count(), errors);
+    EXPECT_EQ(dst, table);
+}
+
+TEST_F(FragmentTest, LengthMismatchIsRejected)
+{
+    tx.send_fragmented(COMPONENT_ID_UPDATE, 0x10, table.data(), kLarge - 1);
+    transfer();
+    EXPECT_EQ(completed, 0);
+    EXPECT_EQ(rx.success_count(), 0u);
+    EXPECT_GT(rx.decode_error_count(), 0u);
+}
+
+// ============================================================================
+// Statistics Tests
+// ============================================================================
+
+class StatsTest : public ::testing::Test
+{
+protected:
+    Unify_link_base tx;
+    Unify_link_base rx;
+    uint8_t dst[8] = {0};
+
+    void SetUp() override { rx.register_handle_data(COMPONENT_ID_MOTORS, 0x01, dst, nullptr, sizeof(dst)); }
+
+    Unify_link_base::message_stats_t message(Unify_link_base &link, uint8_t component_id, uint8_t data_id)
+    {
+        Unify_link_base::message_stats_t m;
+        EXPECT_TRUE(link.stats.message(component_id, data_id, &m));
+        return m;
+    }
+};
+
+TEST_F(StatsTest, CountsPerMessageOnBothSides)
+{
+    const uint8_t payload[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    for (int i = 0; i < 5; ++i)
+        tx.build_send_data(COMPONENT_ID_MOTORS, 0x01, payload, sizeof(payload));
+    tx.build_send_data(COMPONENT_ID_MOTORS, 0x01, payload, 4);   // 长度不符
+    tx.build_send_data(COMPONENT_ID_ENCODERS, 0x02, payload, 2); // 未注册
+    pipe_all(tx, rx);
+
+    const auto sent = message(tx, COMPONENT_ID_MOTORS, 0x01);
+    EXPECT_EQ(sent.tx_frames, 6u);
+    EXPECT_EQ(sent.tx_bytes, 5u * 16 + 12);
+
+    const auto motors = message(rx, COMPONENT_ID_MOTORS, 0x01);
+    EXPECT_EQ(motors.rx_messages, 5u);
+    EXPECT_EQ(motors.rx_bytes, 5u * sizeof(payload));
+    EXPECT_EQ(motors.decode_errors, 1u);
+    EXPECT_EQ(motors.length_errors, 1u);
+
+    const auto unknown = message(rx, COMPONENT_ID_ENCODERS, 0x02);
+    EXPECT_EQ(unknown.rx_messages, 0u);
+    EXPECT_EQ(unknown.decode_errors, 1u);
+    EXPECT_EQ(unknown.length_errors, 0u);
+
+    const auto totals = rx.stats_totals();
+    EXPECT_EQ(totals.rx_frames, 7u);
+    EXPECT_EQ(totals.rx_bytes, 5u * 16 + 12 + 10);
+    EXPECT_EQ(totals.rx_messages, rx.success_count());
+    EXPECT_EQ(totals.decode_errors, rx.decode_error_count());
+    EXPECT_EQ(totals.length_errors, 1u);
+    EXPECT_EQ(tx.stats_totals().tx_frames, 7u);
+
+    Unify_link_base::message_stats_t all[Link_stats_t<UNIFY_LINK_STATS_SLOTS>::capacity()];
+    EXPECT_EQ(rx.stats.messages(all, Link_stats_t<UNIFY_LINK_STATS_SLOTS>::capacity()), 2u);
+    Unify_link_base::message_stats_t none;
+    EXPECT_FALSE(rx.stats.message(COMPONENT_ID_UPDATE, 0x01, &none));
+}
+
+TEST_F(StatsTest, BundleRecordsAreCountedIndividually)
+{
+    tx.set_bundle_policy(128);
+    const uint8_t payload[8] = {0};
+    for (int i = 0; i < 3; ++i)
+        tx.build_send_data(COMPONENT_ID_MOTORS, 0x01, payload, sizeof(payload));
+    tx.flush_bundle();
+    pipe_all(tx, rx);
+
+    EXPECT_EQ(message(tx, COMPONENT_ID_MOTORS, 0x01).tx_frames, 3u);
+    EXPECT_EQ(tx.stats_totals().tx_frames, 1u); // 线上只有一帧
+    EXPECT_EQ(message(rx, COMPONENT_ID_MOTORS, 0x01).rx_messages, 3u);
+    EXPECT_EQ(rx.stats_totals().rx_frames, 1u);
+}
+
+TEST_F(StatsTest, CrcErrorsResyncAndSequenceGaps)
+{
+    const uint8_t payload[8] = {0};
+    uint8_t wire[64];
+    uint32_t len = 0;
+
+    tx.build_send_data(COMPONENT_ID_MOTORS, 0x01, payload, sizeof(payload));
+    pipe_all(tx, rx); // 先让该 ID 出现在统计表中
+
+    tx.build_send_data(COMPONENT_ID_MOTORS, 0x01, payload, sizeof(payload));
+    tx.send_buff_pop(wire, &len);
+    wire[len - 1] ^= 0x55; // 损坏载荷
+    rx.rev_data_push(wire, len);
+
+    tx.build_send_data(COMPONENT_ID_MOTORS, 0x01, payload, sizeof(payload));
+    pipe_all(tx, rx);
+
+    EXPECT_EQ(message(rx, COMPONENT_ID_MOTORS, 0x01).crc_errors, 1u);
+    const auto totals = rx.stats_totals();
+    EXPECT_EQ(totals.crc_errors, 1u);
+    EXPECT_EQ(totals.seq_lost, rx.com_error_count());
+    EXPECT_EQ(totals.seq_lost, 1u);
+    EXPECT_EQ(totals.resync_count, 1u);
+    EXPECT_EQ(totals.resync_skipped_bytes, len);
+}
+
+TEST_F(StatsTest, SendQueueFullCountsDrops)
+{
+    const uint8_t payload[200] = {0};
+    int accepted = 0;
+    for (int i = 0; i < 20; ++i)
+        accepted += tx.build_send_data(COMPONENT_ID_UPDATE, 0x03, payload, sizeof(payload)) != 0;
+
+    const auto m = message(tx, COMPONENT_ID_UPDATE, 0x03);
+    EXPECT_EQ(m.tx_frames, static_cast<uint64_t>(accepted));
+    EXPECT_EQ(m.tx_drops, static_cast<uint64_t>(20 - accepted));
+    EXPECT_EQ(tx.stats_totals().tx_drops, static_cast<uint64_t>(20 - accepted));
+}
+
+TEST_F(StatsTest, SnapshotsFromAnotherThreadAreMonotonic)
+{
+    std::atomic<bool> done{false};
+    uint64_t last = 0;
+    bool monotonic = true;
+    std::thread reader(
+        [&]
+        {
+            while (!done.load())
+            {
+                // 总计先于分消息计数更新：先读分消息，再读总计
+                Unify_link_base::message_stats_t m;
+                const bool seen = rx.stats.message(COMPONENT_ID_MOTORS, 0x01, &m);
+                const uint64_t now = rx.stats_totals().rx_messages;
+                monotonic = monotonic && now >= last && (!seen || m.rx_messages <= now);
+                last = now;
+            }
+        });
+
+    const uint8_t payload[8] = {0};
+    for (int i = 0; i < 2000; ++i)
+    {
+        tx.build_send_data(COMPONENT_ID_MOTORS, 0x01, payload, sizeof(payload));
+        pipe_all(tx, rx);
+    }
+    done = true;
+    reader.join();
+
+    EXPECT_TRUE(monotonic);
+    EXPECT_EQ(rx.stats_totals().rx_messages, 2000u);
+}
+
+TEST_F(StatsTest, LegacyCountersAreViewsOfStats)
+{
+    const uint8_t payload[8] = {0};
+    tx.build_send_data(COMPONENT_ID_MOTORS, 0x01, payload, sizeof(payload));
+    tx.build_send_data(COMPONENT_ID_UPDATE, 0x7E, payload, sizeof(payload)); // 未注册
+    pipe_all(tx, rx);
+
+    const auto totals = rx.stats_totals();
+    EXPECT_EQ(rx.success_count(), 1u);
+    EXPECT_EQ(rx.success_count(), totals.rx_messages);
+    EXPECT_EQ(rx.decode_error_count(), 1u);
+    EXPECT_EQ(rx.decode_error_count(), totals.decode_errors);
+    EXPECT_EQ(rx.resync_count(), totals.resync_count);
+}
+
+TEST(IdSlotTableTest, ProbesPastCollisionsAndReportsFull)
+{
+    struct slot_t
+    {
+        std::atomic<uint32_t> tag{0};
+        uint32_t value = 0;
+    };
+    detail::id_slot_table<slot_t, 3> table;
+
+    // (0, 0) 与 (0, 3) 起点相同，后者探测到下一个槽位
+    table.insert(0, 0)->value = 1;
+    table.insert(0, 3)->value = 2;
+    table.insert(1, 0)->value = 3;
+    EXPECT_EQ(table.insert(2, 0), nullptr); // 表满
+    EXPECT_EQ(table.insert(0, 3)->value, 2u);
+
+    const auto &view = table;
+    ASSERT_NE(view.find(1, 0), nullptr);
+    EXPECT_EQ(view.find(1, 0)->value, 3u);
+    EXPECT_EQ(view.find(2, 0), nullptr);
+
+    uint32_t tagged = 0;
+    for (const slot_t &slot : view)
+    {
+        const uint32_t tag = slot.tag.load();
+        tagged += tag != 0;
+        EXPECT_EQ(view.find(decltype(table)::component_of(tag), decltype(table)::data_of(tag)), &slot);
+    }
+    EXPECT_EQ(tagged, 3u);
+}
+
+TEST(LinkStatsTest, TxCountersAcceptConcurrentWriters)
+{
+    // 应用线程发送与解析上下文回复 / 确认帧同时写发送侧统计
+    Link_stats_t<4> stats;
+    constexpr int kPerThread = 100000;
+    auto writer = [&](uint8_t data_id)
+    {
+        for (int i = 0; i < kPerThread; ++i)
+        {
+            stats.on_tx_frame(10);
+            stats.on_tx_message(COMPONENT_ID_MOTORS, data_id, 10);
+        }
+    };
+    std::thread a(writer, 0x01);
+    std::thread b(writer, 0x02);
+    a.join();
+    b.join();
+
+    const auto totals = stats.totals();
+    EXPECT_EQ(totals.tx_frames, 2u * kPerThread);
+    EXPECT_EQ(totals.tx_bytes, 20u * kPerThread);
+    Link_stats_t<4>::message_t m;
+    ASSERT_TRUE(stats.message(COMPONENT_ID_MOTORS, 0x01, &m));
+    EXPECT_EQ(m.tx_frames, static_cast<uint64_t>(kPerThread));
+    ASSERT_TRUE(stats.message(COMPONENT_ID_MOTORS, 0x02, &m));
+    EXPECT_EQ(m.tx_frames, static_cast<uint64_t>(kPerThread));
+}
+
+// 模拟循环 DMA：按 DMA 写指针把字节直接写入 rev_dma_buffer()，再报告新的写入位置
+class DmaReceiveTest : public ::testing::Test
+{
+protected:
+    Unify_link_base tx;
+    Unify_link_base rx;
+    uint32_t dma_pos = 0;
+    uint8_t dst[32] = {0};
+
+    void SetUp() override { rx.register_handle_data(COMPONENT_ID_MOTORS, 0x03, dst, nullptr, sizeof(dst)); }
+
+    void dma_write(const uint8_t *data, uint32_t len)
+    {
+        for (uint32_t i = 0; i < len; ++i)
+        {
+            rx.rev_dma_buffer()[dma_pos] = data[i];
+            dma_pos = (dma_pos + 1) % Unify_link_base::rev_dma_size;
+        }
+    }
+
+    std::vector<uint8_t> frames(int count, uint8_t base)
+    {
+        std::vector<uint8_t> bytes;
+        uint8_t payload[32];
+        uint8_t frame[64];
+        for (int n = 0; n < count; ++n)
+        {
+            std::memset(payload, base + n, sizeof(payload));
+            tx.build_send_data(COMPONENT_ID_MOTORS, 0x03, payload, sizeof(payload));
+            uint32_t len = 0;
+            tx.send_buff_pop(frame, &len);
+            bytes.insert(bytes.end(), frame, frame + len);
+        }
+        return bytes;
+    }
+};
+
+TEST_F(DmaReceiveTest, IdleLineUpdatesParseAcrossWrap)
+{
+    // 每次以不规则的块大小写入并在“空闲线中断”里报告位置，多次绕过环尾
+    uint32_t frames_sent = 0;
+    for (int round = 0; round < 40; ++round)
+    {
+        const auto bytes = frames(3, static_cast<uint8_t>(round));
+        frames_sent += 3;
+        for (size_t off = 0; off < bytes.size(); off += 37)
+        {
+            const uint32_t n = static_cast<uint32_t>(std::min<size_t>(37, bytes.size() - off));
+            dma_write(bytes.data() + off, n);
+            rx.rev_dma_update(dma_pos == 0 ? Unify_link_base::rev_dma_size : dma_pos); // TC 中断报告整圈
+        }
+        rx.parse_data_task();
+    }
+
+    EXPECT_EQ(rx.success_count(), frames_sent);
+    EXPECT_EQ(rx.com_error_count(), 0u);
+    EXPECT_EQ(rx.rx_overflow_count.load(), 0u);
+    EXPECT_EQ(dst[0], static_cast<uint8_t>(39 + 2));
+}
+
+TEST_F(DmaReceiveTest, OverrunIsCountedAndStreamResyncs)
+{
+    // 消费者停顿期间 DMA 写入超过一个环的空闲空间：旧数据被覆盖
+    const auto burst = frames(60, 0);
+    ASSERT_GT(burst.size(), Unify_link_base::rev_dma_size);
+    for (size_t off = 0; off < burst.size(); off += 256)
+    {
+        const uint32_t n = static_cast<uint32_t>(std::min<size_t>(256, burst.size() - off));
+        dma_write(burst.data() + off, n);
+        rx.rev_dma_update(dma_pos);
+    }
+
+    EXPECT_EQ(rx.rx_overflow_count.load(), 1u);
+    EXPECT_EQ(rx.rx_overflow_bytes.load(), burst.size() - (Unify_link_base::rev_dma_size - 1));
+
+    rx.parse_data_task(); // 丢弃被覆盖的内容
+    EXPECT_EQ(rx.rec_buff.used(), 0u);
+
+    const auto after = frames(2, 0x70);
+    dma_write(after.data(), static_cast<uint32_t>(after.size()));
+    rx.rev_dma_update(dma_pos);
+    const uint64_t before = rx.success_count();
+    rx.parse_data_task();
+    EXPECT_EQ(rx.success_count(), before + 2);
+    EXPECT_EQ(dst[0], 0x71);
+}
+
+TEST_F(DmaReceiveTest, OverrunDuringParseDropsTheFrame)
+{
+    const auto bytes = frames(10, 0x10);
+    dma_write(bytes.data(), static_cast<uint32_t>(bytes.size()));
+    rx.rev_dma_update(dma_pos);
+
+    // 第一帧分发前 DMA 又写入一整圈：当前帧与环内剩余的帧边界都已失效
+    const auto flood = frames(60, 0x50);
+    bool flooded = false;
+    rx.set_frame_tap([&](const unify_link_frame_head_t &, const uint8_t *, uint16_t)
+    {
+        if (flooded)
+            return;
+        flooded = true;
+        for (size_t off = 0; off + 256 <= flood.size(); off += 256)
+        {
+            dma_write(flood.data() + off, 256);
+            rx.rev_dma_update(dma_pos);
+        }
+    });
+    rx.parse_data_task();
+
+    EXPECT_TRUE(flooded);
+    EXPECT_EQ(rx.success_count(), 0u);
+    EXPECT_EQ(dst[0], 0u);
+    EXPECT_EQ(rx.rec_buff.used(), 0u);
+    EXPECT_EQ(rx.rx_overflow_count.load(), 1u);
+    EXPECT_EQ(rx.resync_count(), 1u);
+}
+
+TEST_F(DmaReceiveTest, RestartRealignsWithDmaStart)
+{
+    const auto partial = frames(1, 0x10);
+    dma_write(partial.data(), 20); // 半帧后 UART 出错，DMA 被停止
+    rx.rev_dma_update(dma_pos);
+
+    rx.rev_dma_restart();
+    dma_pos = 0;
+    EXPECT_EQ(rx.rec_buff.head.load(), 0u);
+    EXPECT_EQ(rx.rx_overflow_count.load(), 1u);
+    EXPECT_EQ(rx.rx_overflow_bytes.load(), 20u); // 丢弃的半帧
+    EXPECT_EQ(rx.stats_totals().rx_overflow_bytes, 20u);
+
+    rx.parse_data_task();
+    EXPECT_EQ(rx.rec_buff.used(), 0u);
+
+    const auto after = frames(3, 0x20);
+    dma_write(after.data(), static_cast<uint32_t>(after.size()));
+    rx.rev_dma_update(dma_pos);
+    rx.parse_data_task();
+    EXPECT_EQ(rx.success_count(), 3u);
+    EXPECT_EQ(rx.com_error_count(), 1u); // 被截断的那一帧表现为序号跳变
+}
+
+TEST_F(DmaReceiveTest, PartialPushKeepsPrefixAndCountsRest)
+{
+    const auto bytes = frames(70, 0); // 70 * 40 字节 > 接收环容量
+    const uint32_t accepted = rx.rev_data_push(bytes.data(), static_cast<uint32_t>(bytes.size()));
+
+    EXPECT_EQ(accepted, Unify_link_base::rx_buff_size - 1);
+    EXPECT_EQ(rx.rx_overflow_count.load(), 1u);
+    EXPECT_EQ(rx.rx_overflow_bytes.load(), bytes.size() - accepted);
+
+    rx.parse_data_task();
+    EXPECT_EQ(rx.success_count(), accepted / 40); // 能放下的完整帧都被解析
+}
+
+TEST(SizedLinkTest, DefaultAliasKeepsLegacySizes)
+{
+    EXPECT_TRUE((std::is_same_v<Unify_link_base, Unify_link_t<>>));
+    EXPECT_EQ(Unify_link_base::rx_buff_size, static_cast<uint32_t>(MAX_RECV_BUFF_LENGTH));
+    EXPECT_EQ(Unify_link_base::tx_buff_size, static_cast<uint32_t>(MAX_SEND_BUFF_LENGTH));
+    EXPECT_EQ(Unify_link_base::max_payload_length, MAX_FRAME_DATA_LENGTH);
+}
+
+TEST(SizedLinkTest, SmallLinkUsesLessRamAndEnforcesMaxPayload)
+{
+    // 8 个处理函数、不做按 ID 统计：整条链路不到 2.5 KB（其中可靠发送副本 256 字节）
+    using Small_link = Unify_link_t<128, 256, 64, 1, 8, 0>;
+    static_assert(Small_link::reliable_store_size == 256);
+    EXPECT_LT(sizeof(Small_link), 2560u);
+
+    Small_link link;
+    uint8_t payload[65] = {0};
+    // 超过本链路 MaxPayload 的消息被拒绝，需要时显式分片发送
+    EXPECT_EQ(link.build_send_data(0x01, 0x01, payload, 65), 0u);
+    EXPECT_EQ(link.send_buff_used(), 0u);
+    EXPECT_TRUE(link.send_fragmented(0x01, 0x01, payload, 65));
+    EXPECT_FALSE(link.fragment_pending());
+    EXPECT_EQ(link.send_buff_used(), 2 * (sizeof(unify_link_frame_head_t) + sizeof(unify_link_fragment_head_t)) + 65u);
+    EXPECT_EQ(link.build_send_data(0x01, 0x01, payload, 64), 64u + sizeof(unify_link_frame_head_t));
+
+    // 超过本链路 MaxPayload 的帧在接收端按非法帧头跳过
+    Unify_link_base big;
+    big.build_send_data(0x01, 0x02, payload, 65);
+    uint8_t frame[128];
+    uint32_t len = 0;
+    big.send_buff_pop(frame, &len);
+
+    uint8_t dst[65] = {0};
+    link.register_handle_data(0x01, 0x02, dst, nullptr, 65);
+    link.rev_data_push(frame, len);
+    link.parse_data_task();
+    EXPECT_EQ(link.success_count(), 0u);
+    EXPECT_GT(link.resync_skipped_bytes(), 0u);
+}
+
+TEST(SizedLinkTest, ComponentsBindToSizedLink)
+{
+    using Small_link = Unify_link_t<256, 256, 128>;
+    Small_link link;
+    Encoder_link_basic_t<Small_link> encoder(link);
+
+    // 载荷类型在不同尺寸链路之间共享
+    Encoder_link_t::encoder_setting_t setting = {.feedback_interval = 5, .reset_id = 2};
+    encoder.send_encoder_setting_data(setting);
+
+    uint8_t frame[64];
+    uint32_t len = 0;
+    link.send_buff_pop(frame, &len);
+    link.rev_data_push(frame, len);
+    link.parse_data_task();
+
+    EXPECT_EQ(link.success_count(), 1u);
+    EXPECT_EQ(encoder.encoder_setting.feedback_interval, 5);
+    EXPECT_EQ(encoder.encoder_setting.reset_id, 2);
 }
 
 // ============================================================================
@@ -334,7 +1889,7 @@ TEST_F(IntegrationTest, MotorLinkRoundTrip)
     link_base.rev_data_push(frame, len);
     link_base.parse_data_task();
 
-    EXPECT_EQ(link_base.success_count, 1u);
+    EXPECT_EQ(link_base.success_count(), 1u);
 
     // Verify the received data - motor_id=1，所以数据在 motor_info[1]
     EXPECT_EQ(motor_link.motor_info[1].motor_id, sent_info.motor_id);
@@ -365,7 +1920,7 @@ TEST_F(IntegrationTest, EncoderLinkRoundTrip)
     link_base.rev_data_push(frame, len);
     link_base.parse_data_task();
 
-    EXPECT_EQ(link_base.success_count, 1u);
+    EXPECT_EQ(link_base.success_count(), 1u);
     EXPECT_EQ(encoder_link.encoder_info.encoder_id, sent_info.encoder_id);
     EXPECT_EQ(encoder_link.encoder_info.resolution, sent_info.resolution);
 }
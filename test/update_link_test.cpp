@@ -7,6 +7,7 @@
 #include "update_Link.hpp"
 
 #include <gtest/gtest.h>
+#include <vector>
 
 using namespace unify_link;
 
@@ -40,6 +41,9 @@ TEST_F(UpdateLinkTest, DataIds)
 {
     EXPECT_EQ(Update_Link_t::FIRMWARE_INFO_ID, 1);
     EXPECT_EQ(Update_Link_t::FIRMWARE_CRC_ID, 2);
+    EXPECT_EQ(Update_Link_t::FIRMWARE_BEGIN_ID, 3);
+    EXPECT_EQ(Update_Link_t::FIRMWARE_CHUNK_ID, 4);
+    EXPECT_EQ(Update_Link_t::FIRMWARE_ACK_ID, 5);
 }
 
 TEST_F(UpdateLinkTest, FirmwareCrcRoundTrip)
@@ -49,7 +53,7 @@ TEST_F(UpdateLinkTest, FirmwareCrcRoundTrip)
     update_link->send_firmware_crc(sent);
     roundTrip();
 
-    EXPECT_EQ(link_base.success_count, 1u);
+    EXPECT_EQ(link_base.success_count(), 1u);
     EXPECT_EQ(update_link->firmware_crc.crc16, sent.crc16);
 }
 
@@ -64,10 +68,217 @@ TEST_F(UpdateLinkTest, FirmwareInfoRoundTrip)
     update_link->send_firmware_info(sent);
     roundTrip();
 
-    EXPECT_EQ(link_base.success_count, 1u);
+    EXPECT_EQ(link_base.success_count(), 1u);
     EXPECT_EQ(std::memcmp(update_link->firmware_info.firmware_data, sent.firmware_data, sizeof(sent.firmware_data)), 0);
 }
 
+namespace
+{
+    uint32_t fw_clock_now = 0;
+    uint32_t fw_clock() { return fw_clock_now; }
+
+    // 把 from 的全部待发帧送到 to，drop 返回 true 的帧被丢弃
+    template <typename Drop>
+    void pump(Unify_link_base &from, Unify_link_base &to, Drop drop)
+    {
+        uint8_t bytes[MAX_SEND_BUFF_LENGTH];
+        uint32_t len = 0;
+        from.send_buff_pop(bytes, &len);
+
+        uint32_t pos = 0;
+        while (pos + sizeof(unify_link_frame_head_t) <= len)
+        {
+            unify_link_frame_head_t head;
+            std::memcpy(&head, bytes + pos, sizeof(head));
+            const uint32_t frame_len = sizeof(head) + head.length();
+            if (!drop(head, bytes + pos + sizeof(head)))
+            {
+                to.rev_data_push(bytes + pos, frame_len);
+                to.parse_data_task();
+            }
+            pos += frame_len;
+        }
+    }
+
+    bool keep_all(const unify_link_frame_head_t &, const uint8_t *) { return false; }
+} // namespace
+
+class FirmwareTransferTest : public ::testing::Test
+{
+protected:
+    Unify_link_base host_link;
+    Unify_link_base device_link;
+    Update_Link_t host{host_link};
+    Update_Link_t device{device_link};
+
+    std::vector<uint8_t> image;
+    std::vector<uint8_t> flash;
+    std::vector<Update_Link_t::FirmwareStatus> sent;
+    std::vector<Update_Link_t::FirmwareStatus> received;
+    uint32_t chunk_writes = 0;
+
+    void SetUp() override
+    {
+        fw_clock_now = 0;
+        host_link.set_clock(fw_clock);
+        device_link.set_clock(fw_clock);
+
+        image.resize(10000);
+        for (size_t i = 0; i < image.size(); ++i)
+            image[i] = static_cast<uint8_t>((i * 131) ^ (i >> 7));
+
+        device.on_firmware_begin = [this](uint32_t total)
+        {
+            flash.assign(total, 0xFF);
+            return true;
+        };
+        device.on_firmware_chunk = [this](uint32_t offset, const uint8_t *data, uint16_t len)
+        {
+            std::memcpy(flash.data() + offset, data, len);
+            chunk_writes++;
+            return true;
+        };
+        device.on_firmware_received = [this](Update_Link_t::FirmwareStatus s) { received.push_back(s); };
+        host.on_firmware_sent = [this](Update_Link_t::FirmwareStatus s) { sent.push_back(s); };
+    }
+
+    template <typename Drop>
+    void run(Drop drop, int max_steps = 1000)
+    {
+        for (int step = 0; step < max_steps && host.firmware_send_status() == Update_Link_t::FirmwareStatus::BUSY;
+             ++step)
+        {
+            host.firmware_transfer_task();
+            pump(host_link, device_link, drop);
+            pump(device_link, host_link, keep_all);
+            fw_clock_now += 10;
+        }
+    }
+
+    static bool is_chunk(const unify_link_frame_head_t &head, const uint8_t *payload, uint32_t offset)
+    {
+        if (head.component_id != Update_Link_t::component_id || head.data_id != Update_Link_t::FIRMWARE_CHUNK_ID)
+            return false;
+        Update_Link_t::firmware_chunk_head_t chunk;
+        std::memcpy(&chunk, payload, sizeof(chunk));
+        return chunk.offset == offset;
+    }
+};
+
+TEST_F(FirmwareTransferTest, StreamsWholeImage)
+{
+    ASSERT_TRUE(host.start_firmware_transfer(image.data(), static_cast<uint32_t>(image.size()), 200));
+    run(keep_all);
+
+    ASSERT_EQ(sent.size(), 1u);
+    EXPECT_EQ(sent[0], Update_Link_t::FirmwareStatus::DONE);
+    ASSERT_EQ(received.size(), 1u);
+    EXPECT_EQ(received[0], Update_Link_t::FirmwareStatus::DONE);
+    EXPECT_EQ(flash, image);
+    EXPECT_EQ(device.fw_rx.running_crc, crc16_calculation(image.data(), static_cast<uint16_t>(image.size())));
+    EXPECT_EQ(chunk_writes, 50u);
+    EXPECT_EQ(host.fw_tx.retransmit_count, 0u);
+}
+
+TEST_F(FirmwareTransferTest, LostChunkIsResentAfterNack)
+{
+    bool dropped = false;
+    auto drop_once = [&](const unify_link_frame_head_t &head, const uint8_t *payload)
+    {
+        if (!dropped && is_chunk(head, payload, 400))
+        {
+            dropped = true;
+            return true;
+        }
+        return false;
+    };
+
+    ASSERT_TRUE(host.start_firmware_transfer(image.data(), static_cast<uint32_t>(image.size()), 200));
+    run(drop_once);
+
+    EXPECT_TRUE(dropped);
+    ASSERT_EQ(sent.size(), 1u);
+    EXPECT_EQ(sent[0], Update_Link_t::FirmwareStatus::DONE);
+    EXPECT_EQ(flash, image);
+    EXPECT_EQ(chunk_writes, 50u);
+    EXPECT_EQ(host.fw_tx.retransmit_count, 1u);
+}
+
+TEST_F(FirmwareTransferTest, LostTailIsResentAfterTimeout)
+{
+    int drops = 0;
+    const uint32_t last = static_cast<uint32_t>(image.size()) / 200 * 200 - 200;
+    auto drop_tail = [&](const unify_link_frame_head_t &head, const uint8_t *payload)
+    {
+        if (drops < 2 && is_chunk(head, payload, last))
+        {
+            drops++;
+            return true;
+        }
+        return false;
+    };
+
+    ASSERT_TRUE(host.start_firmware_transfer(image.data(), static_cast<uint32_t>(image.size()), 200));
+    run(drop_tail);
+
+    EXPECT_EQ(drops, 2);
+    ASSERT_EQ(sent.size(), 1u);
+    EXPECT_EQ(sent[0], Update_Link_t::FirmwareStatus::DONE);
+    EXPECT_EQ(flash, image);
+}
+
+TEST_F(FirmwareTransferTest, CorruptedImageReportsCrcError)
+{
+    ASSERT_TRUE(host.start_firmware_transfer(image.data(), static_cast<uint32_t>(image.size()), 200));
+    host.fw_tx.image_crc ^= 0x1234; // BEGIN 已发出，但仍在等待 ACK：重发的 BEGIN 带错误 CRC
+    fw_clock_now += host.fw_retransmit_timeout;
+    run(keep_all);
+
+    ASSERT_EQ(received.size(), 1u);
+    EXPECT_EQ(received[0], Update_Link_t::FirmwareStatus::CRC_ERROR);
+    ASSERT_EQ(sent.size(), 1u);
+    EXPECT_EQ(sent[0], Update_Link_t::FirmwareStatus::CRC_ERROR);
+}
+
+TEST_F(FirmwareTransferTest, WriteFailureAbortsTransfer)
+{
+    device.on_firmware_chunk = [](uint32_t offset, const uint8_t *, uint16_t) { return offset < 1000; };
+
+    ASSERT_TRUE(host.start_firmware_transfer(image.data(), static_cast<uint32_t>(image.size()), 200));
+    run(keep_all);
+
+    ASSERT_EQ(sent.size(), 1u);
+    EXPECT_EQ(sent[0], Update_Link_t::FirmwareStatus::WRITE_ERROR);
+    EXPECT_EQ(device.firmware_receive_status(), Update_Link_t::FirmwareStatus::WRITE_ERROR);
+}
+
+TEST_F(FirmwareTransferTest, UnresponsiveDeviceEndsWithTimeout)
+{
+    auto drop_all = [](const unify_link_frame_head_t &, const uint8_t *) { return true; };
+
+    ASSERT_TRUE(host.start_firmware_transfer(image.data(), static_cast<uint32_t>(image.size()), 200));
+    run(drop_all);
+
+    ASSERT_EQ(sent.size(), 1u);
+    EXPECT_EQ(sent[0], Update_Link_t::FirmwareStatus::TIMEOUT);
+    EXPECT_EQ(host.firmware_send_status(), Update_Link_t::FirmwareStatus::TIMEOUT);
+    EXPECT_EQ(host.fw_tx.image, nullptr);
+}
+
+TEST_F(FirmwareTransferTest, ChunkBeyondWindowIsRejected)
+{
+    const Update_Link_t::firmware_begin_t begin = {10000, 200, 0};
+    ASSERT_TRUE(device.handle_firmware_begin(reinterpret_cast<const uint8_t *>(&begin), sizeof(begin)));
+
+    // 第 40 个分块远在 32 块窗口之外
+    uint8_t chunk[sizeof(Update_Link_t::firmware_chunk_head_t) + 200] = {};
+    const Update_Link_t::firmware_chunk_head_t head = {40 * 200};
+    std::memcpy(chunk, &head, sizeof(head));
+    EXPECT_FALSE(device.handle_firmware_chunk(chunk, sizeof(chunk)));
+    EXPECT_EQ(chunk_writes, 0u);
+    EXPECT_EQ(device.fw_rx.ack_bits, 0u);
+}
+
 int main(int argc, char **argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
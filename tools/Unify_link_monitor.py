@@ -1,8 +1,7 @@
 import threading
 import time
 import tkinter as tk
-from collections import defaultdict, deque
-from dataclasses import dataclass
+from collections import deque
 from tkinter import ttk
 
 import importlib
@@ -35,89 +34,16 @@ BAUD_RATES = [
 FRAME_HEADER = int(ul.FRAME_HEADER)
 
 
-@dataclass
-class FrameInfo:
-    comp_id: int
-    data_id: int
-    ts: float
-    length: int
-
-
-class StreamStats:
-    def __init__(self) -> None:
-        self._lock = threading.Lock()
-        self.rx_bytes_total = 0
-        self.tx_bytes_total = 0
-        self.rx_counts = defaultdict(int)
-        self.tx_counts = defaultdict(int)
-        self.rx_times: dict[tuple[int, int], deque[float]] = defaultdict(deque)
-        self.tx_times: dict[tuple[int, int], deque[float]] = defaultdict(deque)
-
-    def add_rx(self, byte_count: int, frames: list[FrameInfo]) -> None:
-        with self._lock:
-            self.rx_bytes_total += byte_count
-            for info in frames:
-                key = (info.comp_id, info.data_id)
-                self.rx_counts[key] += 1
-                self.rx_times[key].append(info.ts)
-
-    def add_tx(self, byte_count: int, comp_id: int, data_id: int) -> None:
-        ts = time.monotonic()
-        with self._lock:
-            self.tx_bytes_total += byte_count
-            key = (comp_id, data_id)
-            self.tx_counts[key] += 1
-            self.tx_times[key].append(ts)
-
-    def snapshot(self) -> dict:
-        with self._lock:
-            return {
-                "rx_bytes_total": self.rx_bytes_total,
-                "tx_bytes_total": self.tx_bytes_total,
-                "rx_counts": dict(self.rx_counts),
-                "tx_counts": dict(self.tx_counts),
-                "rx_times": {k: deque(v) for k, v in self.rx_times.items()},
-                "tx_times": {k: deque(v) for k, v in self.tx_times.items()},
-            }
-
-
-def parse_frames(buffer: bytearray) -> list[FrameInfo]:
-    frames: list[FrameInfo] = []
-    while True:
-        idx = buffer.find(bytes([FRAME_HEADER]))
-        if idx == -1:
-            buffer.clear()
-            break
-        if idx > 0:
-            del buffer[:idx]
-        if len(buffer) < 8:
-            break
-        payload_len = int.from_bytes(buffer[4:6], "little") & 0x1FFF
-        frame_len = 8 + payload_len
-        if len(buffer) < frame_len:
-            break
-        comp_id = buffer[2]
-        data_id = buffer[3]
-        frames.append(
-            FrameInfo(comp_id=comp_id, data_id=data_id, ts=time.monotonic(), length=payload_len)
-        )
-        del buffer[:frame_len]
-    return frames
-
-
 class UnifyLinkMonitor:
     def __init__(self, root: tk.Tk) -> None:
         self.root = root
         self.base = ul.UnifyLinkBase()
-        self.stats = StreamStats()
+        # Frame/byte/error rates are aggregated in C++ from the link's frame tap; the UI only takes snapshots
+        self.monitor = ul.LinkMonitor(self.base, bucket_ms=100)
         self.ser: serial.Serial | None = None
         self.reader_thread: threading.Thread | None = None
         self.stop_event = threading.Event()
 
-        self._last_rate_time = time.monotonic()
-        self._bytes_since_rate = 0
-        self._current_rate_kb = 0.0
-        self._last_rx_total = 0
         self._reader_error: str | None = None
 
         self._history_span = 120.0
@@ -258,9 +184,7 @@ class UnifyLinkMonitor:
             self.port_var.set(ports[0])
 
     def _register_all_ids(self) -> None:
-        for comp_id in range(256):
-            for data_id in range(256):
-                self.base.register_any_payload(comp_id, data_id)
+        self.base.register_default_any_payload()
 
     def _toggle_connect(self) -> None:
         if self.ser:
@@ -304,7 +228,6 @@ class UnifyLinkMonitor:
         self.status_var.set("Disconnected")
 
     def _reader_loop(self) -> None:
-        buffer = bytearray()
         while not self.stop_event.is_set():
             if not self.ser:
                 break
@@ -315,9 +238,6 @@ class UnifyLinkMonitor:
                 break
             if not data:
                 continue
-            buffer.extend(data)
-            frames = parse_frames(buffer)
-            self.stats.add_rx(len(data), frames)
             self.base.rev_data_push(data)
             self.base.parse_data_task()
 
@@ -359,7 +279,6 @@ class UnifyLinkMonitor:
         except serial.SerialException as exc:
             self.status_var.set(f"Send failed: {exc}")
             return
-        self.stats.add_tx(written, comp_id, data_id)
         self.status_var.set(f"Sent {written} bytes (comp={comp_id}, data={data_id})")
 
     def _schedule_update(self) -> None:
@@ -372,24 +291,14 @@ class UnifyLinkMonitor:
         decode_err = int(self.base.decode_error_count)
 
         now = time.monotonic()
-        elapsed = now - self._last_rate_time
-        snapshot = self.stats.snapshot()
-        delta = snapshot["rx_bytes_total"] - self._last_rx_total
-        if delta > 0:
-            self._bytes_since_rate += delta
-        self._last_rx_total = snapshot["rx_bytes_total"]
-
-        if elapsed >= 0.5:
-            rate = self._bytes_since_rate / elapsed
-            self._current_rate_kb = rate / 1024.0
-            self._bytes_since_rate = 0
-            self._last_rate_time = now
+        snapshot = self.monitor.snapshot()
+        rate_kb = snapshot.rx_bytes_per_sec / 1024.0
 
         self.success_var.set(str(success))
         self.com_error_var.set(str(com_err))
         self.decode_error_var.set(str(decode_err))
-        self.rate_var.set(f"{self._current_rate_kb:.2f} KB/s")
-        self.rx_bytes_var.set(str(snapshot["rx_bytes_total"]))
+        self.rate_var.set(f"{rate_kb:.2f} KB/s")
+        self.rx_bytes_var.set(str(snapshot.totals.rx_bytes))
         if self._reader_error:
             self.status_var.set(self._reader_error)
             self._reader_error = None
@@ -406,7 +315,7 @@ class UnifyLinkMonitor:
             self._decode_history.popleft()
 
         self._speed_times.append(now)
-        self._speed_history.append(self._current_rate_kb)
+        self._speed_history.append(rate_kb)
         while self._speed_times and now - self._speed_times[0] > self._speed_span:
             self._speed_times.popleft()
             self._speed_history.popleft()
@@ -429,29 +338,29 @@ class UnifyLinkMonitor:
         if speed_times:
             self.ax_speed.set_xlim(max(0, speed_times[-1] - self._speed_span), speed_times[-1])
 
-        self._update_stats_view(snapshot, now)
+        self._update_stats_view(snapshot)
 
         self.canvas.draw_idle()
 
-    def _update_stats_view(self, snapshot: dict, now: float) -> None:
+    def _update_stats_view(self, snapshot) -> None:
         for item in self.stats_view.get_children():
             self.stats_view.delete(item)
 
-        rows: list[tuple[int, int, float, int]] = []
-        for key, count in snapshot["rx_counts"].items():
-            times = snapshot["rx_times"].get(key, deque())
-            while times and now - times[0] > 1.0:
-                times.popleft()
-            hz = float(len(times))
-            rows.append((key[0], key[1], hz, count))
-
-        rows.sort(key=lambda r: (-r[2], -r[3], r[0], r[1]))
-        for comp_id, data_id, hz, count in rows[:40]:
-            self.stats_view.insert("", tk.END, values=(comp_id, data_id, f"{hz:.1f}", count))
-
-        tx_total = snapshot["tx_bytes_total"]
-        rx_total = snapshot["rx_bytes_total"]
-        self.right_status.config(text=f"RX bytes: {rx_total} | TX bytes: {tx_total}")
+        rows = sorted(
+            self.monitor.messages(),
+            key=lambda r: (-r.frames_per_sec, -r.frames, r.component_id, r.data_id),
+        )
+        for r in rows[:40]:
+            self.stats_view.insert(
+                "", tk.END, values=(r.component_id, r.data_id, f"{r.frames_per_sec:.1f}", r.frames)
+            )
+
+        totals = snapshot.totals
+        self.right_status.config(
+            text=f"RX bytes: {totals.rx_bytes} | TX bytes: {totals.tx_bytes}"
+            f" | CRC errors: {totals.crc_errors} ({snapshot.crc_errors_per_sec:.1f}/s)"
+            f" | Resync skipped: {totals.resync_skipped_bytes}"
+        )
 
 
 def main() -> None:
@@ -4,19 +4,65 @@
 #include "CRC16.hpp"
 
 #include "unify_link_def.h"
+#include "unify_link_slots.hpp"
 
+#if UNIFY_LINK_LATENCY
+#include "unify_link_latency.hpp"
+#endif
+
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <cmath>
 #include <cstdint>
 #include <cstring>
 #include <functional>
-#include <unordered_map>
+#include <type_traits>
 
 namespace unify_link
 {
     using namespace std;
 
+    // 环形缓冲区中的一段逻辑连续区间，跨越环尾时拆为两段物理连续内存
+    template <typename T>
+    struct ring_segments_t
+    {
+        T *ptr[2] = {nullptr, nullptr};
+        uint32_t len[2] = {0, 0};
+
+        uint32_t size() const { return len[0] + len[1]; }
+
+        // 从逻辑偏移 offset 处读出 n 个元素（自动跨段）
+        void read(uint32_t offset, std::remove_const_t<T> *dst, uint32_t n) const
+        {
+            if (offset < len[0])
+            {
+                const uint32_t first = std::min<uint32_t>(n, len[0] - offset);
+                std::memcpy(dst, ptr[0] + offset, first * sizeof(T));
+                dst += first;
+                n -= first;
+                offset = len[0];
+            }
+            if (n > 0)
+                std::memcpy(dst, ptr[1] + (offset - len[0]), n * sizeof(T));
+        }
+
+        // 将 src[0..n) 写到逻辑偏移 offset 处（自动跨段）
+        void write(uint32_t offset, const std::remove_const_t<T> *src, uint32_t n) const
+        {
+            if (offset < len[0])
+            {
+                const uint32_t first = std::min<uint32_t>(n, len[0] - offset);
+                std::memcpy(ptr[0] + offset, src, first * sizeof(T));
+                src += first;
+                n -= first;
+                offset = len[0];
+            }
+            if (n > 0)
+                std::memcpy(ptr[1] + (offset - len[0]), src, n * sizeof(T));
+        }
+    };
+
     template <typename T, uint32_t N>
     class Circular_buffer
     {
@@ -89,6 +135,55 @@ namespace unify_link
             return len;
         }
 
+        // 零拷贝写入：预留 len 字节的空闲区间，生产者直接写入后调用 commit(len) 发布
+        // 空间不足时返回空区间（size() == 0）；commit 之前消费者不可见
+        ring_segments_t<T> reserve(uint32_t len)
+        {
+            // producer-only
+            ring_segments_t<T> seg;
+            if (len == 0)
+                return seg;
+
+            uint32_t h = head.load(std::memory_order_relaxed);
+            uint32_t t = tail.load(std::memory_order_acquire);
+            uint32_t free_local = N - 1 - (h + N - t) % N;
+            if (len > free_local)
+                return seg;
+
+            seg.ptr[0] = buf.data() + h;
+            seg.len[0] = std::min<uint32_t>(len, N - h);
+            seg.ptr[1] = buf.data();
+            seg.len[1] = len - seg.len[0];
+            return seg;
+        }
+
+        void commit(uint32_t len)
+        {
+            // producer-only，len 不得超过最近一次 reserve() 的长度
+            uint32_t h = head.load(std::memory_order_relaxed);
+            head.store((h + len) % N, std::memory_order_release);
+        }
+
+        // 外部写入（循环 DMA 直接写 buf）：数据已位于 head 处，仅推进 head 发布 n 个元素
+        // DMA 不会等待消费者，n 超过空闲空间时未读数据已被覆盖：head 仍跟随 DMA 位置，返回被覆盖的元素数
+        uint32_t produce(uint32_t n)
+        {
+            // producer-only
+            uint32_t h = head.load(std::memory_order_relaxed);
+            uint32_t t = tail.load(std::memory_order_acquire);
+            uint32_t free_local = N - 1 - (h + N - t) % N;
+
+            head.store((h + n) % N, std::memory_order_release);
+            return n > free_local ? n - free_local : 0;
+        }
+
+        // 丢弃全部未读数据（produce() 溢出后由消费者调用）
+        void discard_all()
+        {
+            // consumer-only
+            tail.store(head.load(std::memory_order_acquire), std::memory_order_release);
+        }
+
         uint32_t read_data(T *dst, uint32_t len) { return read_data(dst, len, 0); }
 
         uint32_t read_data(T *dst, uint32_t len, uint32_t offset) const
@@ -112,6 +207,122 @@ namespace unify_link
             return len; // 不移动 tail
         }
 
+        // 零拷贝读取：返回从 offset 开始、长度为 len 的连续只读视图（不移动 tail）
+        // 若数据不足或区间跨越环尾，返回 nullptr，调用方需回退到 read_data() 拷贝
+        const T *peek(uint32_t len, uint32_t offset = 0) const
+        {
+            // consumer-only
+            uint32_t t = tail.load(std::memory_order_relaxed);
+            uint32_t h = head.load(std::memory_order_acquire);
+            uint32_t used_local = (h + N - t) % N;
+            if (offset + len > used_local)
+                return nullptr;
+
+            uint32_t start = (t + offset) % N;
+            if (len > N - start)
+                return nullptr;
+
+            return buf.data() + start;
+        }
+
+        // 原地改写已提交、尚未消费的 [offset, offset + len) 区间；越界时返回空区间
+        // 仅供生产者在确认消费者不会同时读取该区间时使用（例如发送队列中尚未交给 DMA 的帧）
+        ring_segments_t<T> rewrite_segments(uint32_t len, uint32_t offset)
+        {
+            ring_segments_t<T> seg;
+            uint32_t t = tail.load(std::memory_order_acquire);
+            uint32_t h = head.load(std::memory_order_relaxed);
+            uint32_t used_local = (h + N - t) % N;
+            if (len == 0 || offset + len > used_local)
+                return seg;
+
+            uint32_t start = (t + offset) % N;
+            seg.ptr[0] = buf.data() + start;
+            seg.len[0] = std::min<uint32_t>(len, N - start);
+            seg.ptr[1] = buf.data();
+            seg.len[1] = len - seg.len[0];
+            return seg;
+        }
+
+        // 已提交数据末尾向前 back 个元素处的物理下标（producer-only），与 rewrite_at() 配合定位队列中的帧
+        uint32_t write_index(uint32_t back = 0) const { return (head.load(std::memory_order_relaxed) + N - back) % N; }
+
+        // 未读数据第 offset 个元素的物理下标；仅在消费者不会同时消费时有意义
+        uint32_t index_of(uint32_t offset) const { return (tail.load(std::memory_order_acquire) + offset) % N; }
+
+        // 生产者按物理下标原地改写 [index, index + len)，消费者可与之并发消费。
+        // fence 为已交给消费者的数据末尾（物理下标），消费者不得越过它：只读取一次 tail，
+        // 区间位于 fence 之后且尚未被消费时返回可写区间，否则返回空区间
+        ring_segments_t<T> rewrite_at(uint32_t index, uint32_t len, uint32_t fence)
+        {
+            // producer-only
+            ring_segments_t<T> seg;
+            uint32_t t = tail.load(std::memory_order_acquire);
+            uint32_t h = head.load(std::memory_order_relaxed);
+            uint32_t used_local = (h + N - t) % N;
+            uint32_t offset = (index + N - t) % N;
+            if (len == 0 || offset < (fence + N - t) % N || offset + len > used_local)
+                return seg;
+
+            seg.ptr[0] = buf.data() + index;
+            seg.len[0] = std::min<uint32_t>(len, N - index);
+            seg.ptr[1] = buf.data();
+            seg.len[1] = len - seg.len[0];
+            return seg;
+        }
+
+        // 零拷贝读取全部未读数据：最多两段物理连续区间（适用于 writev / 双段 DMA）
+        ring_segments_t<const T> peek_segments() const
+        {
+            // consumer-only
+            ring_segments_t<const T> seg;
+            uint32_t t = tail.load(std::memory_order_relaxed);
+            uint32_t h = head.load(std::memory_order_acquire);
+            uint32_t used_local = (h + N - t) % N;
+
+            seg.ptr[0] = buf.data() + t;
+            seg.len[0] = std::min<uint32_t>(used_local, N - t);
+            seg.ptr[1] = buf.data();
+            seg.len[1] = used_local - seg.len[0];
+            return seg;
+        }
+
+        // 零拷贝读取从 tail 开始的第一段连续数据（适用于单次 DMA），长度写入 *len
+        const T *peek_contiguous(uint32_t *len) const
+        {
+            const auto seg = peek_segments();
+            *len = seg.len[0];
+            return seg.ptr[0];
+        }
+
+        // 消费 n 个已发送/已处理的数据（n 不得超过 used()），与 pop_data() 相同
+        uint32_t consume(uint32_t n) { return pop_data(n); }
+
+        // 在未读数据中（从 offset 起）查找 value，返回相对 tail 的偏移；未找到时返回 used()
+        // 按环形缓冲区的两段连续区间扫描，字节类型走 memchr
+        uint32_t find(const T &value, uint32_t offset = 0) const
+        {
+            // consumer-only
+            uint32_t t = tail.load(std::memory_order_relaxed);
+            uint32_t h = head.load(std::memory_order_acquire);
+            uint32_t used_local = (h + N - t) % N;
+            if (offset >= used_local)
+                return used_local;
+
+            uint32_t start = (t + offset) % N;
+            uint32_t first = std::min<uint32_t>(used_local - offset, N - start);
+
+            const T *hit = _scan(buf.data() + start, first, value);
+            if (hit != nullptr)
+                return offset + static_cast<uint32_t>(hit - (buf.data() + start));
+
+            hit = _scan(buf.data(), used_local - offset - first, value);
+            if (hit != nullptr)
+                return offset + first + static_cast<uint32_t>(hit - buf.data());
+
+            return used_local;
+        }
+
         // 从尾部弹出数据
         uint32_t pop_data(uint32_t len)
         {
@@ -128,231 +339,1983 @@ namespace unify_link
             tail.store((t + len) % N, std::memory_order_release);
             return len;
         }
-    };
 
-    class Unify_link_base
-    {
-    protected:
-        bool _find_frame_head()
+    private:
+        static const T *_scan(const T *ptr, uint32_t len, const T &value)
         {
-            while (rec_buff.used() >= sizeof(frame_head))
-            {
-                rec_buff.read_data(reinterpret_cast<uint8_t *>(&frame_head), sizeof(frame_head));
-                if (frame_head.frame_header == FRAME_HEADER)
-                    return true;
+            if (len == 0)
+                return nullptr;
 
-                rec_buff.pop_data(1); // 向后滑动 1 字节
+            if constexpr (sizeof(T) == 1 && std::is_integral_v<T>)
+            {
+                return static_cast<const T *>(std::memchr(ptr, static_cast<unsigned char>(value), len));
+            }
+            else
+            {
+                const T *end = ptr + len;
+                const T *hit = std::find(ptr, end, value);
+                return hit == end ? nullptr : hit;
             }
-            return false; // 数据不足
         }
+    };
 
-    public:
-        Circular_buffer<uint8_t, MAX_RECV_BUFF_LENGTH> rec_buff;
+#ifndef UNIFY_LINK_CACHE_LINE_SIZE
+#define UNIFY_LINK_CACHE_LINE_SIZE 64 // MCU 上可定义为 4 以节省 RAM
+#endif
 
-        unify_link_frame_head_t frame_head;
-        std::array<uint8_t, MAX_FRAME_LENGTH> frame_data{};
-        uint8_t last_seq_id = 0xFF;
+    // 2 的幂容量 SPSC 环形缓冲区（Circular_buffer 的高性能变体）：
+    //   - 共有 push_data / reserve / commit / read_data / peek / peek_segments / peek_contiguous / pop_data / consume，
+    //     没有 find / produce / rewrite_segments / discard_all，因此不能直接替换链路的 rec_buff / send_buff
+    //   - 掩码代替 % N，索引为单调递增的 32 位计数，可用满 N 个元素（无哨兵）
+    //   - 生产者/消费者索引位于不同缓存行，各自缓存对端索引，仅在空间/数据不足时才读取对端
+    //   - 无虚函数表
+    template <typename T, uint32_t N>
+    class Spsc_ring_buffer
+    {
+        static_assert(N >= 2 && (N & (N - 1)) == 0, "Spsc_ring_buffer size must be a power of two");
+        static_assert(N <= 0x80000000u, "Spsc_ring_buffer size must fit in 31 bits");
 
-        uint64_t com_error_count = 0;
-        uint64_t decode_error_count = 0;
-        uint64_t success_count = 0;
+        static constexpr uint32_t kMask = N - 1;
 
     public:
-        Unify_link_base()
-        {
-            frame_data.fill(0);
-            registered_map.reserve(UNIFY_LINK_MAX_HANDLERS);
-        }
-
-        void parse_data_task()
-        {
-            while (rec_buff.used() >= sizeof(frame_head))
-            {
-                if (!_find_frame_head())
-                {
-                    break;
-                }
-
-                // 读取数据段
-                const uint16_t payload_len = frame_head.length();
-                if (payload_len > MAX_FRAME_DATA_LENGTH)
-                {
-                    // 非法长度，跳过本字节重新找头
-                    rec_buff.pop_data(1);
-                    continue;
-                }
+        alignas(UNIFY_LINK_CACHE_LINE_SIZE) std::array<T, N> buf{};
 
-                rec_buff.read_data(frame_data.data(), payload_len, sizeof(frame_head));
+        Spsc_ring_buffer() = default;
+        Spsc_ring_buffer(const Spsc_ring_buffer &) = delete;
+        Spsc_ring_buffer &operator=(const Spsc_ring_buffer &) = delete;
 
-                // === 数据长度检查 ===
-                if (rec_buff.used() < sizeof(frame_head) + payload_len)
-                {
-                    break; // 数据不足，等待更多数据
-                }
+        static constexpr uint32_t capacity() { return N; }
 
-                // === CRC 校验 ===
-                uint16_t crc16_calc = crc16_calculation(reinterpret_cast<uint8_t *>(&frame_head),
-                                                        offsetof(unify_link_frame_head_t, crc16));
-                crc16_calc = crc16_calculation(frame_data.data(), payload_len, crc16_calc);
+        uint32_t used() const
+        {
+            const uint32_t t = cons.tail.load(std::memory_order_acquire);
+            const uint32_t h = prod.head.load(std::memory_order_acquire);
+            return h - t;
+        }
 
-                if (crc16_calc != frame_head.crc16)
-                {
-                    rec_buff.pop_data(1); // 跳过本字节重新找头
-                    continue;
-                }
+        uint32_t remain() const { return N - used(); }
 
-                // === 序号检查 ===
-                uint8_t expected = last_seq_id + 1;
-                if (frame_head.seq_id != expected)
-                    com_error_count += (frame_head.seq_id - expected) & 0xFF;
-                last_seq_id = frame_head.seq_id;
+        uint32_t push_data(const T *src, uint32_t len)
+        {
+            // producer-only
+            if (len == 0)
+                return 0;
 
-                // 消费整帧
-                rec_buff.pop_data(sizeof(frame_head) + payload_len);
+            const auto seg = reserve(len);
+            if (seg.size() == 0)
+                return 0;
 
-                // 业务处理
-                if (!handle_data(frame_head.component_id, frame_head.data_id, frame_data.data(), payload_len))
-                    decode_error_count++;
-                else
-                    success_count++; // 成功帧计数
-            }
+            seg.write(0, src, len);
+            commit(len);
+            return len;
         }
 
-        inline void rev_data_push(const uint8_t *data, uint32_t len)
+        ring_segments_t<T> reserve(uint32_t len)
         {
-            if (len == 0 || len > rec_buff.remain())
+            // producer-only
+            ring_segments_t<T> seg;
+            if (len == 0)
+                return seg;
+
+            const uint32_t h = prod.head.load(std::memory_order_relaxed);
+            if (len > N - (h - prod.tail_cache))
             {
-                return; // 数据不足
+                prod.tail_cache = cons.tail.load(std::memory_order_acquire);
+                if (len > N - (h - prod.tail_cache))
+                    return seg;
             }
 
-            rec_buff.push_data(data, len);
+            const uint32_t start = h & kMask;
+            seg.ptr[0] = buf.data() + start;
+            seg.len[0] = std::min<uint32_t>(len, N - start);
+            seg.ptr[1] = buf.data();
+            seg.len[1] = len - seg.len[0];
+            return seg;
         }
 
-    public:
-        static constexpr uint16_t make_key(uint8_t component_id, uint8_t data_id)
+        void commit(uint32_t len)
         {
-            return static_cast<uint16_t>((static_cast<uint16_t>(component_id) << 8) | data_id);
+            // producer-only
+            const uint32_t h = prod.head.load(std::memory_order_relaxed);
+            prod.head.store(h + len, std::memory_order_release);
         }
 
-        std::unordered_map<uint16_t, registered_item_t> registered_map;
+        uint32_t read_data(T *dst, uint32_t len) const { return read_data(dst, len, 0); }
 
-        bool register_handle_data(uint8_t component_id, uint8_t data_id, void *dst, handle_data_func_t func,
-                                  uint16_t length)
+        uint32_t read_data(T *dst, uint32_t len, uint32_t offset) const
         {
-            // 线程/中断安全约束：该函数建议仅在初始化阶段调用。
-            // 运行时若与 parse_data_task() 并发修改 map，会造成未定义行为。
-            auto &item = registered_map[make_key(component_id, data_id)];
-            item.callback = std::move(func);
-            item.dst = dst;
-            item.payload_length = length;
-            return true;
+            // consumer-only
+            if (len == 0)
+                return 0;
+
+            const uint32_t t = cons.tail.load(std::memory_order_relaxed);
+            if (!_readable(t, offset + len))
+                return 0;
+
+            const uint32_t start = (t + offset) & kMask;
+            const uint32_t first = std::min<uint32_t>(len, N - start);
+            std::memcpy(dst, buf.data() + start, first * sizeof(T));
+            std::memcpy(dst + first, buf.data(), (len - first) * sizeof(T));
+            return len;
         }
 
-        bool handle_data(uint8_t component_id, uint8_t data_id, const uint8_t *data, uint16_t len)
+        const T *peek(uint32_t len, uint32_t offset = 0) const
         {
-            auto it = registered_map.find(make_key(component_id, data_id));
-
-            // 未注册
-            if (it == registered_map.end())
-                return false;
+            // consumer-only
+            const uint32_t t = cons.tail.load(std::memory_order_relaxed);
+            if (!_readable(t, offset + len))
+                return nullptr;
+
+            const uint32_t start = (t + offset) & kMask;
+            if (len > N - start)
+                return nullptr;
+            return buf.data() + start;
+        }
 
-            auto dst = it->second.dst;
+        ring_segments_t<const T> peek_segments() const
+        {
+            // consumer-only
+            ring_segments_t<const T> seg;
+            const uint32_t t = cons.tail.load(std::memory_order_relaxed);
+            cons.head_cache = prod.head.load(std::memory_order_acquire);
+            const uint32_t used_local = cons.head_cache - t;
+
+            const uint32_t start = t & kMask;
+            seg.ptr[0] = buf.data() + start;
+            seg.len[0] = std::min<uint32_t>(used_local, N - start);
+            seg.ptr[1] = buf.data();
+            seg.len[1] = used_local - seg.len[0];
+            return seg;
+        }
 
-            // 请求帧 返回请求数据
-            if (len == 0 and dst != nullptr)
-            {
-                return build_send_data(component_id, data_id, reinterpret_cast<const uint8_t *>(dst),
-                                       it->second.payload_length);
-            }
+        const T *peek_contiguous(uint32_t *len) const
+        {
+            const auto seg = peek_segments();
+            *len = seg.len[0];
+            return seg.ptr[0];
+        }
 
-            // 长度不匹配（0xFFFF 表示接受任意长度）
-            if (it->second.payload_length != 0xFFFF && it->second.payload_length != len)
-                return false;
+        uint32_t pop_data(uint32_t len)
+        {
+            // consumer-only
+            if (len == 0)
+                return 0;
 
-            // 复制数据到目标地址
-            if (dst != nullptr)
-                std::memcpy(dst, data, len);
+            const uint32_t t = cons.tail.load(std::memory_order_relaxed);
+            if (!_readable(t, len))
+                return 0;
 
-            // 处理数据 调用回函数
-            const auto &callback = it->second.callback;
-            if (callback)
-                return callback(data, len);
-            return true;
+            cons.tail.store(t + len, std::memory_order_release);
+            return len;
         }
 
-    protected:
-        Circular_buffer<uint8_t, MAX_RECV_BUFF_LENGTH> send_buff;
-        uint8_t send_tmp[MAX_FRAME_LENGTH] = {0};
-        uint8_t seq_id = 0;
+        uint32_t consume(uint32_t n) { return pop_data(n); }
 
-    public:
-        // Convenience helpers for components: send a trivially-copyable object/array as payload.
-        // Usage example from components:
-        //   link_base.send_packet<component_id>(DATA_ID, obj_or_array);
-        template <uint8_t ComponentId, typename T>
-        void send_packet(uint8_t data_id, const T &obj)
+    private:
+        // 消费者侧：先用缓存的 head 判断，不足时才重新读取生产者索引
+        bool _readable(uint32_t t, uint32_t need) const
         {
-            build_send_data(ComponentId, data_id, reinterpret_cast<const uint8_t *>(&obj), sizeof(obj));
+            if (need <= cons.head_cache - t)
+                return true;
+            cons.head_cache = prod.head.load(std::memory_order_acquire);
+            return need <= cons.head_cache - t;
         }
 
-        template <uint8_t ComponentId, typename T, size_t N>
-        void send_packet(uint8_t data_id, const T (&arr)[N])
+        struct alignas(UNIFY_LINK_CACHE_LINE_SIZE) producer_t
         {
-            build_send_data(ComponentId, data_id, reinterpret_cast<const uint8_t *>(arr), sizeof(arr));
+            std::atomic<uint32_t> head{0};
+            uint32_t tail_cache = 0; // 生产者缓存的消费者索引
+        };
+
+        struct alignas(UNIFY_LINK_CACHE_LINE_SIZE) consumer_t
+        {
+            std::atomic<uint32_t> tail{0};
+            mutable uint32_t head_cache = 0; // 消费者缓存的生产者索引
+        };
+
+        producer_t prod;
+        consumer_t cons;
+    };
+
+    // 扁平分发表：注册项连续存放在定长数组中，(component_id, data_id) 经开放寻址索引（线性探测）映射到注册项下标。
+    // 索引槽数为不小于 2 * MaxHandlers 的 2 的幂（负载因子 <= 0.5），查找通常一到两次探测；无堆分配、不支持删除
+    template <uint16_t MaxHandlers>
+    class Dispatch_table
+    {
+        static_assert(MaxHandlers > 0 && MaxHandlers < 0xFF, "MaxHandlers must be in [1, 254]");
+
+        static constexpr uint8_t _index_bits()
+        {
+            uint8_t bits = 1;
+            while ((1u << bits) < 2u * MaxHandlers)
+                bits++;
+            return bits;
         }
 
-        uint16_t build_send_data(const uint8_t component_id, const uint8_t data_id, const uint8_t *data,
-                                 const uint16_t len)
+    public:
+        static constexpr uint8_t kEmpty = 0xFF;
+        static constexpr uint8_t kIndexBits = _index_bits();
+        static constexpr uint16_t kIndexSize = static_cast<uint16_t>(1u << kIndexBits);
+
+        Dispatch_table() { index.fill(kEmpty); }
+
+        registered_item_t *find(uint8_t component_id, uint8_t data_id)
         {
-            if (len > MAX_FRAME_DATA_LENGTH)
+            const uint16_t key = _key(component_id, data_id);
+            for (uint16_t pos = _hash(key);; pos = (pos + 1) & (kIndexSize - 1))
             {
-                return 0; // 超出最大帧长
+                const uint8_t slot = index[pos];
+                if (slot == kEmpty)
+                    return nullptr;
+                if (keys[slot] == key)
+                    return &items[slot];
             }
+        }
 
-            // 如果发送缓冲区空间不足，直接返回 0
-            if (send_buff.remain() < sizeof(unify_link_frame_head_t) + len)
+        // 返回已有注册项，或分配一个新项；容量耗尽时返回 nullptr
+        registered_item_t *insert(uint8_t component_id, uint8_t data_id)
+        {
+            const uint16_t key = _key(component_id, data_id);
+            uint16_t pos = _hash(key);
+            for (; index[pos] != kEmpty; pos = (pos + 1) & (kIndexSize - 1))
             {
-                return 0;
+                if (keys[index[pos]] == key)
+                    return &items[index[pos]];
             }
 
-            unify_link_frame_head_t *head = reinterpret_cast<unify_link_frame_head_t *>(send_tmp);
-            head->frame_header = FRAME_HEADER;
-            head->component_id = component_id;
-            head->data_id = data_id;
-            // 默认 flags=0
-            head->set_flags_and_length(0, len);
-            head->seq_id = seq_id;
-
-            this->seq_id = seq_id + 1;
-
-            std::memcpy(send_tmp + sizeof(unify_link_frame_head_t), data, len);
+            if (item_count >= MaxHandlers)
+                return nullptr;
+            keys[item_count] = key;
+            index[pos] = item_count;
+            return &items[item_count++];
+        }
 
-            // 计算 CRC
-            head->crc16 = crc16_calculation(send_tmp, offsetof(unify_link_frame_head_t, crc16));
-            head->crc16 = crc16_calculation(send_tmp + sizeof(unify_link_frame_head_t), len, head->crc16);
+        uint16_t size() const { return item_count; }
+        static constexpr uint16_t capacity() { return MaxHandlers; }
 
-            // 将数据塞入发送缓冲区
-            send_buff.push_data(send_tmp, sizeof(unify_link_frame_head_t) + len);
+    private:
+        static uint16_t _key(uint8_t component_id, uint8_t data_id)
+        {
+            return static_cast<uint16_t>((static_cast<uint16_t>(component_id) << 8) | data_id);
+        }
 
-            return sizeof(unify_link_frame_head_t) + len;
+        // Fibonacci 散列：乘以 2^16 / φ 后取高位，同组件下连续的 data_id 分散到不同槽
+        static uint16_t _hash(uint16_t key)
+        {
+            return static_cast<uint16_t>((static_cast<uint32_t>(key) * 40503u & 0xFFFFu) >> (16 - kIndexBits));
         }
 
-        uint32_t send_buff_used() const { return send_buff.used(); }
-        uint32_t send_buff_remain() const { return send_buff.remain(); }
+        std::array<uint8_t, kIndexSize> index{};
+        std::array<uint16_t, MaxHandlers> keys{};
+        std::array<registered_item_t, MaxHandlers> items{};
+        uint8_t item_count = 0;
+    };
 
-        void send_buff_pop(uint8_t *data, uint32_t *len)
-        {
-            uint32_t available = send_buff.used();
-            if (available < sizeof(unify_link_frame_head_t))
-            {
-                *len = 0;
-                return; // 数据不足
-            }
+    // 单写者计数器：写端 load + store 不需要原子 RMW 指令，其他线程可随时 relaxed 读取
+    struct stat_counter_t
+    {
+        std::atomic<stat_value_t> value{0};
 
-            send_buff.read_data(data, available);
-            *len = available;
-            send_buff.pop_data(available);
+        void add(stat_value_t n = 1)
+        {
+            value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
         }
+        stat_value_t get() const { return value.load(std::memory_order_relaxed); }
+    };
+
+    // 多写者计数器：用于发送侧，应用发送与解析上下文里的应答 / 确认帧可能同时写入，需要原子 RMW
+    struct shared_counter_t
+    {
+        std::atomic<stat_value_t> value{0};
+
+        void add(stat_value_t n = 1) { value.fetch_add(n, std::memory_order_relaxed); }
+        stat_value_t get() const { return value.load(std::memory_order_relaxed); }
     };
+
+    // 链路统计：全局总计 + 按 (component_id, data_id) 的收 / 发两张定长表，无锁、不分配内存
+    // 接收侧只由解析上下文（parse_data_task）写入；发送侧可能有多个写者（应用发送、解析上下文里的应答与确认帧），
+    // 使用 shared_counter_t；快照可在任意线程读取。Slots 为 0 时不分配按 ID 的表，只保留总计
+    template <uint16_t Slots>
+    class Link_stats_t
+    {
+    public:
+        // 总计快照（帧、字节按线上整帧计）
+        struct totals_t
+        {
+            uint64_t rx_frames = 0;            // CRC 正确的帧
+            uint64_t rx_bytes = 0;             // 上述帧的字节数（含帧头）
+            uint64_t rx_messages = 0;          // 成功交付的消息（打包记录按条计）
+            uint64_t decode_errors = 0;        // 未注册、长度不符、回调拒绝、打包 / 分片格式错误
+            uint64_t length_errors = 0;        // 其中长度与注册长度不符的次数
+            uint64_t crc_errors = 0;           // 帧头合法但 CRC 错误（含重新同步时的伪帧头）
+            uint64_t seq_lost = 0;             // 按序号推算的丢帧数
+            uint64_t resync_count = 0;         // 重新同步次数
+            uint64_t resync_skipped_bytes = 0; // 重新同步跳过的字节数
+            uint64_t rx_overflow_bytes = 0;    // 接收环放不下 / 被 DMA 覆盖而丢弃的字节数
+            uint64_t tx_frames = 0;            // 提交到发送队列的帧
+            uint64_t tx_bytes = 0;             // 上述帧的字节数（含帧头）
+            uint64_t tx_drops = 0;             // 发送队列满而丢弃的消息
+        };
+
+        // 单条消息快照：rx_* 按交付给 handle_data 的消息计（打包记录按条、分片消息按整条），
+        // tx_* 按提交的帧计（打包记录按条、分片按片）；crc_errors 仅在该 ID 已出现过时归入
+        struct message_t
+        {
+            uint8_t component_id = 0;
+            uint8_t data_id = 0;
+            uint64_t rx_messages = 0;
+            uint64_t rx_bytes = 0; // 载荷字节
+            uint64_t decode_errors = 0;
+            uint64_t length_errors = 0;
+            uint64_t crc_errors = 0;
+            uint64_t tx_frames = 0;
+            uint64_t tx_bytes = 0; // 整帧字节（打包记录为记录长度）
+            uint64_t tx_drops = 0;
+        };
+
+        // ===== 接收侧（解析上下文）=====
+        void on_rx_frame(uint32_t bytes)
+        {
+            rx_frames.add();
+            rx_bytes.add(bytes);
+        }
+
+        void on_rx_message(uint8_t component_id, uint8_t data_id, uint16_t len, bool ok)
+        {
+            (ok ? rx_messages : decode_errors).add();
+            if (rx_slot_t *slot = rx_table.insert(component_id, data_id))
+            {
+                if (ok)
+                {
+                    slot->messages.add();
+                    slot->bytes.add(len);
+                }
+                else
+                {
+                    slot->decode_errors.add();
+                }
+            }
+        }
+
+        void on_length_error(uint8_t component_id, uint8_t data_id)
+        {
+            length_errors.add();
+            if (rx_slot_t *slot = rx_table.insert(component_id, data_id))
+                slot->length_errors.add();
+        }
+
+        void on_crc_error(uint8_t component_id, uint8_t data_id)
+        {
+            crc_errors.add();
+            if (rx_slot_t *slot = rx_table.find(component_id, data_id))
+                slot->crc_errors.add();
+        }
+
+        stat_counter_t rx_messages;
+        stat_counter_t decode_errors;
+        stat_counter_t seq_lost;
+        stat_counter_t resync_count;
+        stat_counter_t resync_skipped_bytes;
+
+        // ===== 发送侧（发送上下文）=====
+        void on_tx_frame(uint32_t bytes)
+        {
+            tx_frames.add();
+            tx_bytes.add(bytes);
+        }
+
+        void on_tx_message(uint8_t component_id, uint8_t data_id, uint32_t bytes)
+        {
+            if (tx_slot_t *slot = tx_table.insert(component_id, data_id))
+            {
+                slot->frames.add();
+                slot->bytes.add(bytes);
+            }
+        }
+
+        void on_tx_drop(uint8_t component_id, uint8_t data_id)
+        {
+            tx_drops.add();
+            if (tx_slot_t *slot = tx_table.insert(component_id, data_id))
+                slot->drops.add();
+        }
+
+        // ===== 快照（任意线程）=====
+        totals_t totals() const
+        {
+            totals_t t;
+            t.rx_frames = rx_frames.get();
+            t.rx_bytes = rx_bytes.get();
+            t.rx_messages = rx_messages.get();
+            t.decode_errors = decode_errors.get();
+            t.length_errors = length_errors.get();
+            t.crc_errors = crc_errors.get();
+            t.seq_lost = seq_lost.get();
+            t.resync_count = resync_count.get();
+            t.resync_skipped_bytes = resync_skipped_bytes.get();
+            t.tx_frames = tx_frames.get();
+            t.tx_bytes = tx_bytes.get();
+            t.tx_drops = tx_drops.get();
+            return t;
+        }
+
+        // 单个 ID 的快照；从未出现过时返回 false
+        bool message(uint8_t component_id, uint8_t data_id, message_t *out) const
+        {
+            const rx_slot_t *rx = rx_table.find(component_id, data_id);
+            const tx_slot_t *tx = tx_table.find(component_id, data_id);
+            if (rx == nullptr && tx == nullptr)
+                return false;
+
+            *out = message_t{};
+            out->component_id = component_id;
+            out->data_id = data_id;
+            _fill(rx, out);
+            _fill(tx, out);
+            return true;
+        }
+
+        // 全部已出现 ID 的快照（收、发合并），最多写入 max 条，返回写入条数
+        uint16_t messages(message_t *out, uint16_t max) const
+        {
+            uint16_t count = 0;
+            for (const rx_slot_t &rx : rx_table)
+            {
+                const uint32_t tag = rx.tag.load(std::memory_order_acquire);
+                if (tag != 0 && count < max)
+                    message(_component(tag), _data(tag), &out[count++]);
+            }
+            for (const tx_slot_t &tx : tx_table)
+            {
+                const uint32_t tag = tx.tag.load(std::memory_order_acquire);
+                if (tag != 0 && count < max && rx_table.find(_component(tag), _data(tag)) == nullptr)
+                    message(_component(tag), _data(tag), &out[count++]);
+            }
+            return count;
+        }
+
+        static constexpr uint16_t capacity() { return static_cast<uint16_t>(Slots * 2); }
+
+    private:
+        struct rx_slot_t
+        {
+            std::atomic<uint32_t> tag{0}; // 0 = 空，否则为 key + 1；写入后不再改变
+            stat_counter_t messages;
+            stat_counter_t bytes;
+            stat_counter_t decode_errors;
+            stat_counter_t length_errors;
+            stat_counter_t crc_errors;
+        };
+
+        struct tx_slot_t
+        {
+            std::atomic<uint32_t> tag{0};
+            shared_counter_t frames;
+            shared_counter_t bytes;
+            shared_counter_t drops;
+        };
+
+        static void _fill(const rx_slot_t *rx, message_t *out)
+        {
+            if (rx == nullptr)
+                return;
+            out->rx_messages = rx->messages.get();
+            out->rx_bytes = rx->bytes.get();
+            out->decode_errors = rx->decode_errors.get();
+            out->length_errors = rx->length_errors.get();
+            out->crc_errors = rx->crc_errors.get();
+        }
+
+        static void _fill(const tx_slot_t *tx, message_t *out)
+        {
+            if (tx == nullptr)
+                return;
+            out->tx_frames = tx->frames.get();
+            out->tx_bytes = tx->bytes.get();
+            out->tx_drops = tx->drops.get();
+        }
+
+        stat_counter_t rx_frames;
+        stat_counter_t rx_bytes;
+        stat_counter_t length_errors;
+        stat_counter_t crc_errors;
+        shared_counter_t tx_frames;
+        shared_counter_t tx_bytes;
+        shared_counter_t tx_drops;
+
+        detail::id_slot_table<rx_slot_t, Slots> rx_table;
+        detail::id_slot_table<tx_slot_t, Slots> tx_table;
+
+        static uint8_t _component(uint32_t tag) { return decltype(rx_table)::component_of(tag); }
+        static uint8_t _data(uint32_t tag) { return decltype(rx_table)::data_of(tag); }
+    };
+
+    // 链路缓冲区按模板参数定长：接收环 RxSize、发送环 TxSize、单帧最大载荷 MaxPayload（字节）
+    // 每条链路可按自身流量单独裁剪 RAM，边界检查在编译期常量折叠；默认参数与原全局宏一致（见 Unify_link_base）
+    // TxClasses 为发送优先级数量，每个优先级一个 TxSize 字节的发送队列；MaxHandlers 为分发表可注册的 ID 数，
+    // StatsSlots 为按 ID 统计的表项数（0 只保留总计）。可靠发送的副本存储同样不超过 TxSize（见 reliable_store_size）
+    template <uint32_t RxSize = MAX_RECV_BUFF_LENGTH, uint32_t TxSize = MAX_SEND_BUFF_LENGTH,
+              uint16_t MaxPayload = MAX_FRAME_DATA_LENGTH, uint8_t TxClasses = 1,
+              uint8_t MaxHandlers = UNIFY_LINK_MAX_HANDLERS, uint16_t StatsSlots = UNIFY_LINK_STATS_SLOTS>
+    class Unify_link_t
+    {
+        static_assert(MaxPayload <= unify_link_frame_head_t::kLenMask, "MaxPayload exceeds the 13-bit length field");
+        // Circular_buffer 保留 1 字节哨兵，需至少容纳一个最大帧
+        static_assert(RxSize > MaxPayload + sizeof(unify_link_frame_head_t), "RxSize must hold one maximum frame");
+        static_assert(TxSize > MaxPayload + sizeof(unify_link_frame_head_t), "TxSize must hold one maximum frame");
+        static_assert(TxClasses >= 1 && TxClasses <= 8, "TxClasses must be 1..8");
+
+    public:
+        static constexpr uint32_t rx_buff_size = RxSize;
+        static constexpr uint32_t tx_buff_size = TxSize;
+        static constexpr uint16_t max_payload_length = MaxPayload;
+        static constexpr uint32_t max_frame_length = MaxPayload + sizeof(unify_link_frame_head_t);
+        static constexpr uint8_t tx_classes = TxClasses;
+        static constexpr uint8_t max_handlers = MaxHandlers;
+        static constexpr uint16_t stats_slots = StatsSlots;
+
+    protected:
+        // 重新同步：用 memchr 跳过帧头之前的全部垃圾字节，并以 13bit 长度上限提前剔除伪帧头
+        bool _find_frame_head()
+        {
+            bool found = false;
+            while (rec_buff.used() > 0)
+            {
+                const uint32_t available = rec_buff.used();
+                const uint32_t pos = rec_buff.find(FRAME_HEADER);
+                if (pos > 0)
+                    _skip_bytes(pos);
+
+                if (pos == available || rec_buff.used() < sizeof(frame_head))
+                    break; // 无帧头或帧头不完整，等待更多数据
+
+                rec_buff.read_data(reinterpret_cast<uint8_t *>(&frame_head), sizeof(frame_head));
+                if (frame_head.length() > MaxPayload)
+                {
+                    _skip_bytes(1); // 非法长度，跳过本字节继续查找
+                    continue;
+                }
+
+                found = true;
+                break;
+            }
+            return found;
+        }
+
+        void _skip_bytes(uint32_t len)
+        {
+            rec_buff.pop_data(len);
+            _lat_rx_consume(len);
+            resync_skip_pending += len;
+            stats.resync_skipped_bytes.add(len);
+        }
+
+        // 找到合法帧时结算本次重新同步跳过的字节数
+        void _finish_resync()
+        {
+            if (resync_skip_pending == 0)
+                return;
+
+            last_resync_bytes.store(resync_skip_pending, std::memory_order_relaxed);
+            stats.resync_count.add();
+            resync_skip_pending = 0;
+        }
+
+        uint32_t resync_skip_pending = 0;
+        std::atomic<uint32_t> last_resync_bytes{0};
+
+        void _count_decode(uint8_t component_id, uint8_t data_id, uint16_t len, bool ok)
+        {
+            stats.on_rx_message(component_id, data_id, len, ok);
+        }
+
+        void _lat_rx_consume(uint32_t len)
+        {
+#if UNIFY_LINK_LATENCY
+            latency.on_rx_consume(len);
+#else
+            (void)len;
+#endif
+        }
+
+        void _lat_rx_resync()
+        {
+#if UNIFY_LINK_LATENCY
+            latency.on_rx_resync();
+#endif
+        }
+
+    public:
+        Circular_buffer<uint8_t, RxSize> rec_buff;
+
+        unify_link_frame_head_t frame_head;
+        std::array<uint8_t, MaxPayload> frame_data{}; // 载荷跨越环尾时的中转缓冲区
+        uint8_t last_seq_id = 0xFF;
+
+        // 链路统计，全部计数都在这里（原子计数，可在任意线程读取，见 stats_totals()）
+        Link_stats_t<StatsSlots> stats;
+
+        // 兼容原有接口的计数：均为 stats 的视图，可在任意线程读取
+        uint64_t com_error_count() const { return stats.seq_lost.get(); } // 按序号推算的丢帧数
+        uint64_t decode_error_count() const { return stats.decode_errors.get(); }
+        uint64_t success_count() const { return stats.rx_messages.get(); }
+        uint64_t resync_count() const { return stats.resync_count.get(); } // 重新同步次数（跳过垃圾字节后找到合法帧）
+        uint64_t resync_skipped_bytes() const { return stats.resync_skipped_bytes.get(); } // 累计跳过的字节数
+        uint32_t last_resync_skipped() const // 最近一次重新同步跳过的字节数
+        {
+            return last_resync_bytes.load(std::memory_order_relaxed);
+        }
+        using stats_totals_t = typename Link_stats_t<StatsSlots>::totals_t;
+        using message_stats_t = typename Link_stats_t<StatsSlots>::message_t;
+
+        // 总计快照（附带接收环溢出字节数），可在任意线程调用
+        stats_totals_t stats_totals() const
+        {
+            stats_totals_t totals = stats.totals();
+            totals.rx_overflow_bytes = rx_overflow_bytes.load(std::memory_order_relaxed);
+            return totals;
+        }
+
+        // 原始帧观察：CRC 正确的每一帧（包括未注册 ID、打包、分片、确认帧）在分发之前交给 tap，
+        // 在解析上下文调用；payload 可能指向 rec_buff 内部，仅在回调期间有效。
+        // set_frame_tap() 设置单个 tap 并返回原先的 tap
+        frame_tap_func_t set_frame_tap(frame_tap_func_t tap)
+        {
+            std::swap(frame_tap, tap);
+            return tap;
+        }
+
+        // 可叠加的观察者（Link_monitor_t、Capture_writer）：节点由观察者持有，挂接后在 set_frame_tap() 的 tap 之后调用；
+        // 摘除与挂接顺序无关。与 parse_data_task() 在同一上下文调用，节点在摘除前必须保持有效
+        void add_frame_tap(frame_tap_node_t &node)
+        {
+            remove_frame_tap(node);
+            node.next = tap_nodes;
+            tap_nodes = &node;
+        }
+
+        void remove_frame_tap(frame_tap_node_t &node)
+        {
+            for (frame_tap_node_t **p = &tap_nodes; *p != nullptr; p = &(*p)->next)
+            {
+                if (*p == &node)
+                {
+                    *p = node.next;
+                    node.next = nullptr;
+                    return;
+                }
+            }
+        }
+
+    protected:
+        frame_tap_func_t frame_tap;
+        frame_tap_node_t *tap_nodes = nullptr;
+
+    public:
+        Unify_link_t() { frame_data.fill(0); }
+
+        void parse_data_task()
+        {
+            _drop_on_rx_overrun();
+
+            while (rec_buff.used() >= sizeof(frame_head))
+            {
+                if (!_find_frame_head())
+                {
+                    break;
+                }
+
+                // 读取数据段（长度已在 _find_frame_head() 中校验）
+                const uint16_t payload_len = frame_head.length();
+
+                // === 数据长度检查 ===
+                if (rec_buff.used() < sizeof(frame_head) + payload_len)
+                {
+                    break; // 数据不足，等待更多数据
+                }
+
+                // 载荷在环形缓冲区内连续时直接引用 rec_buff.buf，仅在跨越环尾时拷贝到 frame_data
+                const uint8_t *payload = rec_buff.peek(payload_len, sizeof(frame_head));
+                if (payload == nullptr)
+                {
+                    rec_buff.read_data(frame_data.data(), payload_len, sizeof(frame_head));
+                    payload = frame_data.data();
+                }
+                if (_drop_on_rx_overrun())
+                    continue; // 读取期间被 DMA 覆盖
+
+                // === CRC 校验 ===
+                uint16_t crc16_calc = crc16_calculation(reinterpret_cast<uint8_t *>(&frame_head),
+                                                        offsetof(unify_link_frame_head_t, crc16));
+                crc16_calc = crc16_calculation(payload, payload_len, crc16_calc);
+
+                if (crc16_calc != frame_head.crc16)
+                {
+                    stats.on_crc_error(frame_head.component_id, frame_head.data_id);
+                    _skip_bytes(1); // 跳过本字节重新找头
+                    continue;
+                }
+
+                _finish_resync();
+                stats.on_rx_frame(sizeof(frame_head) + payload_len);
+
+                // === 序号检查 ===
+                uint8_t expected = last_seq_id + 1;
+                if (frame_head.seq_id != expected)
+                {
+                    const uint8_t lost = (frame_head.seq_id - expected) & 0xFF;
+                    stats.seq_lost.add(lost);
+                }
+                last_seq_id = frame_head.seq_id;
+
+                if (frame_tap)
+                    frame_tap(frame_head, payload, payload_len);
+                for (frame_tap_node_t *node = tap_nodes; node != nullptr;)
+                {
+                    frame_tap_node_t *next = node->next; // 回调中可以摘除自身
+                    node->tap(frame_head, payload, payload_len);
+                    node = next;
+                }
+
+#if UNIFY_LINK_LATENCY
+                lat_timed = latency_clock != nullptr &&
+                            latency.rx_arrival(sizeof(frame_head) + payload_len, &lat_arrival);
+                const uint32_t dispatch_at = lat_timed ? latency_clock() : 0;
+#endif
+                if (_drop_on_rx_overrun())
+                    continue; // 载荷可能已被覆盖，不交给处理函数
+
+                // 业务处理（payload 可能指向 rec_buff 内部，因此先处理再消费）
+                // 带时间戳帧复用打包 + 分片两个标志位，须先于单个标志判断
+                if ((frame_head.flags() & FRAME_FLAG_TIMESTAMP) == FRAME_FLAG_TIMESTAMP)
+                {
+                    _dispatch_timestamped(frame_head.component_id, frame_head.data_id, payload, payload_len);
+                }
+                else if (frame_head.flags() & FRAME_FLAG_BUNDLE)
+                {
+                    _dispatch_bundle(frame_head.component_id, payload, payload_len);
+                }
+                else if (frame_head.flags() & FRAME_FLAG_FRAGMENT)
+                {
+                    _dispatch_fragment(frame_head.component_id, frame_head.data_id, payload, payload_len);
+                }
+                else if (frame_head.flags() & FRAME_FLAG_ACK_REQ)
+                {
+                    _dispatch_reliable(frame_head.component_id, frame_head.data_id, payload, payload_len);
+                }
+                else if (frame_head.component_id == COMPONENT_ID_SYSTEM && frame_head.data_id == LINK_ACK_DATA_ID)
+                {
+                    _handle_link_ack(payload, payload_len);
+                }
+                else
+                {
+                    _count_decode(frame_head.component_id, frame_head.data_id, payload_len,
+                                  handle_data(frame_head.component_id, frame_head.data_id, payload, payload_len));
+                }
+
+#if UNIFY_LINK_LATENCY
+                if (lat_timed)
+                    latency.on_rx_dispatch(frame_head.component_id, frame_head.data_id, dispatch_at - lat_arrival,
+                                           latency_clock() - dispatch_at);
+#endif
+
+                // 消费整帧（处理期间发生溢出时 used() 已与帧边界无关，整体丢弃）
+                if (_drop_on_rx_overrun())
+                    continue;
+                rec_buff.pop_data(sizeof(frame_head) + payload_len);
+                _lat_rx_consume(sizeof(frame_head) + payload_len);
+            }
+
+            // 本轮收到的可靠帧合并为一个累计确认
+            if (rel_ack_pending)
+                _send_link_ack();
+        }
+
+        // DMA 覆盖了未读数据，环内的帧边界与已取得的载荷都不可信：整体丢弃，从下一个帧头重新同步
+        bool _drop_on_rx_overrun()
+        {
+            if (!rx_overrun.load(std::memory_order_relaxed) || !rx_overrun.exchange(false, std::memory_order_acquire))
+                return false;
+
+            rec_buff.discard_all();
+            _lat_rx_resync();
+            stats.resync_count.add();
+            return true;
+        }
+
+        // 带时间戳帧：去掉 4 字节发送端时间戳后按普通帧处理（未启用时延测量时同样解析）
+        static constexpr uint16_t kTimestampBytes = sizeof(uint32_t);
+
+        void _dispatch_timestamped(uint8_t component_id, uint8_t data_id, const uint8_t *payload,
+                                   uint16_t payload_len)
+        {
+            if (payload_len < kTimestampBytes)
+            {
+                _count_decode(component_id, data_id, payload_len, false);
+                return;
+            }
+
+#if UNIFY_LINK_LATENCY
+            if (lat_timed)
+            {
+                uint32_t sender_time;
+                std::memcpy(&sender_time, payload, sizeof(sender_time));
+                latency.on_rx_timestamp(component_id, data_id, lat_arrival, sender_time);
+            }
+#endif
+            const uint16_t len = static_cast<uint16_t>(payload_len - kTimestampBytes);
+            _count_decode(component_id, data_id, len,
+                          handle_data(component_id, data_id, payload + kTimestampBytes, len));
+        }
+
+        // 打包帧拆包：逐条记录 [data_id(1) | len(1) | payload(len)] 交给 handle_data，按记录计数
+        void _dispatch_bundle(uint8_t component_id, const uint8_t *payload, uint16_t payload_len)
+        {
+            uint16_t pos = 0;
+            while (pos < payload_len)
+            {
+                if (payload_len - pos < kBundleRecordHead ||
+                    payload[pos + 1] > payload_len - pos - kBundleRecordHead)
+                {
+                    // 记录截断，丢弃剩余部分（记录头的 data_id 字节仍在时记到该 ID 名下）
+                    const uint8_t data_id = payload[pos];
+                    _count_decode(component_id, data_id, static_cast<uint16_t>(payload_len - pos), false);
+                    return;
+                }
+
+                const uint8_t data_id = payload[pos];
+                const uint8_t len = payload[pos + 1];
+                _count_decode(component_id, data_id, len,
+                              handle_data(component_id, data_id, payload + pos + kBundleRecordHead, len));
+                pos = static_cast<uint16_t>(pos + kBundleRecordHead + len);
+            }
+        }
+
+        // 分片重组：按序把分片直接写入注册的 dst（长度须与 total_length 一致），收齐后调用回调；
+        // 同一时刻只重组一条消息，乱序、缺片或被其他 ID 的分片打断时丢弃整条消息，等待下一个 offset 0。
+        // 只查运行时分发表且要求 dst：编译期路由（Unify_link_static）、Parallel_dispatcher_t 移走的 ID、
+        // dst 为 nullptr 的处理函数（例如 State_mirror_t）收不到分片，发往这些 ID 的消息不得超过 MaxPayload
+        struct rx_fragment_t
+        {
+            bool active = false;
+            uint16_t key = 0;
+            uint16_t total = 0;
+            uint16_t received = 0;
+        } rx_fragment;
+
+        void _dispatch_fragment(uint8_t component_id, uint8_t data_id, const uint8_t *payload, uint16_t payload_len)
+        {
+            unify_link_fragment_head_t head;
+            const registered_item_t *item = registered_table.find(component_id, data_id);
+            if (payload_len < sizeof(head) || item == nullptr || item->dst == nullptr)
+            {
+                rx_fragment.active = false;
+                _count_decode(component_id, data_id, payload_len, false);
+                return;
+            }
+
+            std::memcpy(&head, payload, sizeof(head));
+            const uint16_t n = static_cast<uint16_t>(payload_len - sizeof(head));
+            const uint16_t key = make_key(component_id, data_id);
+            if (head.offset == 0)
+                rx_fragment = {true, key, head.total_length, 0};
+
+            if (!rx_fragment.active || rx_fragment.key != key || rx_fragment.total != head.total_length ||
+                rx_fragment.received != head.offset || item->payload_length != head.total_length ||
+                n > head.total_length - head.offset)
+            {
+                rx_fragment.active = false;
+                _count_decode(component_id, data_id, payload_len, false);
+                return;
+            }
+
+            std::memcpy(static_cast<uint8_t *>(item->dst) + head.offset, payload + sizeof(head), n);
+            rx_fragment.received = static_cast<uint16_t>(rx_fragment.received + n);
+            if (rx_fragment.received != rx_fragment.total)
+                return;
+
+            rx_fragment.active = false;
+            const auto &callback = item->callback;
+            _count_decode(component_id, data_id, rx_fragment.total,
+                          !callback || callback(static_cast<const uint8_t *>(item->dst), rx_fragment.total));
+        }
+
+        // 放不下时写入能放下的前缀，其余字节计入 rx_overflow_bytes；返回实际写入的字节数
+        inline uint32_t rev_data_push(const uint8_t *data, uint32_t len)
+        {
+            if (len == 0)
+                return 0;
+
+            const uint32_t fit = std::min<uint32_t>(len, rec_buff.remain());
+            if (fit < len)
+                _count_rx_overflow(len - fit);
+            rev_data_mark(fit);
+            return rec_buff.push_data(data, fit);
+        }
+
+        // 循环 DMA 接收：DMA 以 rev_dma_buffer() 为目标、长度 rev_dma_size 的循环模式直接写入接收环
+        // 中断（空闲线 / 半满 / 全满）中只调用 rev_dma_update()，不拷贝数据
+        static constexpr uint32_t rev_dma_size = RxSize;
+        uint8_t *rev_dma_buffer() { return rec_buff.buf.data(); }
+
+        // DMA 已写入 n 字节
+        inline void rev_dma_produce(uint32_t n)
+        {
+            rev_data_mark(n);
+            const uint32_t overwritten = rec_buff.produce(n);
+            if (rx_overrun.load(std::memory_order_relaxed))
+            {
+                // 消费者尚未丢弃上一次溢出的内容，新数据同样会被丢弃
+                rx_overflow_bytes.store(rx_overflow_bytes.load(std::memory_order_relaxed) + n,
+                                        std::memory_order_relaxed);
+            }
+            else if (overwritten != 0)
+            {
+                _count_rx_overflow(overwritten);
+                rx_overrun.store(true, std::memory_order_release);
+            }
+        }
+
+        // pos：DMA 当前写入位置（rev_dma_size - NDTR，或 HAL 回调的 Size），范围 [0, rev_dma_size]
+        // 两次调用之间 DMA 前进不得超过一整圈（半满 + 全满中断保证这一点）
+        inline void rev_dma_update(uint32_t pos)
+        {
+            const uint32_t h = rec_buff.head.load(std::memory_order_relaxed);
+            rev_dma_produce((pos % RxSize + RxSize - h) % RxSize);
+        }
+
+        // DMA 重启后（例如 UART 溢出错误）写指针回到缓冲区起点：把 head 对齐到 0，未读数据交由消费者丢弃
+        inline void rev_dma_restart()
+        {
+            const uint32_t unread = rec_buff.used(); // 对齐前尚未解析的字节，随后整体丢弃
+            const uint32_t h = rec_buff.head.load(std::memory_order_relaxed);
+            if (h != 0)
+                rec_buff.produce(RxSize - h);
+            _count_rx_overflow(unread);
+            rx_overrun.store(true, std::memory_order_release);
+        }
+
+        // 自行通过 rec_buff.reserve() / commit() 写入的生产者在 commit 前调用，供时延测量记录到达时刻
+        inline void rev_data_mark(uint32_t len)
+        {
+#if UNIFY_LINK_LATENCY
+            if (latency_clock != nullptr && len != 0)
+                latency.on_rx_push(len, latency_clock());
+#else
+            (void)len;
+#endif
+        }
+
+        // 接收溢出统计（生产者侧写入，可在中断中更新）
+        std::atomic<uint32_t> rx_overflow_count{0}; // 溢出事件次数
+        std::atomic<uint32_t> rx_overflow_bytes{0}; // 丢弃 / 被覆盖的字节数
+
+    protected:
+        void _count_rx_overflow(uint32_t bytes)
+        {
+            rx_overflow_count.store(rx_overflow_count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            rx_overflow_bytes.store(rx_overflow_bytes.load(std::memory_order_relaxed) + bytes,
+                                    std::memory_order_relaxed);
+        }
+
+        std::atomic<bool> rx_overrun{false};
+
+    public:
+        static constexpr uint16_t make_key(uint8_t component_id, uint8_t data_id)
+        {
+            return static_cast<uint16_t>((static_cast<uint16_t>(component_id) << 8) | data_id);
+        }
+
+        Dispatch_table<MaxHandlers> registered_table;
+        registered_item_t default_item;   // 未注册 (component_id, data_id) 的兜底处理
+        bool has_default_item = false;
+
+        bool register_handle_data(uint8_t component_id, uint8_t data_id, void *dst, handle_data_func_t func,
+                                  uint16_t length)
+        {
+            // 线程/中断安全约束：该函数建议仅在初始化阶段调用。
+            // 运行时若与 parse_data_task() 并发修改分发表，会造成未定义行为。
+            registered_item_t *item = registered_table.insert(component_id, data_id);
+            if (item == nullptr)
+                return false; // 分发表已满（见模板参数 MaxHandlers / UNIFY_LINK_MAX_HANDLERS）
+
+            item->callback = std::move(func);
+            item->dst = dst;
+            item->payload_length = length;
+            return true;
+        }
+
+        // 注册兜底处理函数：所有未注册的 (component_id, data_id) 都交给它（例如监视工具统计任意帧）
+        void register_default_handle_data(handle_data_func_t func, uint16_t length = 0xFFFF)
+        {
+            default_item.callback = std::move(func);
+            default_item.dst = nullptr;
+            default_item.payload_length = length;
+            has_default_item = true;
+        }
+
+        // 编译期分发入口（由 Unify_link_static 设置）：返回 1/0 表示已处理的结果，<0 表示未命中，继续查分发表
+        using static_dispatch_fn_t = int (*)(Unify_link_t &, uint8_t, uint8_t, const uint8_t *, uint16_t);
+        static_dispatch_fn_t static_dispatch = nullptr;
+
+        bool handle_data(uint8_t component_id, uint8_t data_id, const uint8_t *data, uint16_t len)
+        {
+            if (static_dispatch != nullptr)
+            {
+                const int result = static_dispatch(*this, component_id, data_id, data, len);
+                if (result >= 0)
+                    return result != 0;
+            }
+
+            const registered_item_t *item = registered_table.find(component_id, data_id);
+
+            // 未注册
+            if (item == nullptr)
+            {
+                if (!has_default_item)
+                    return false;
+                item = &default_item;
+            }
+
+            auto dst = item->dst;
+
+            // 请求帧 返回请求数据
+            if (len == 0 and dst != nullptr)
+            {
+                return build_send_data(component_id, data_id, reinterpret_cast<const uint8_t *>(dst),
+                                       item->payload_length);
+            }
+
+            // 长度不匹配（0xFFFF 表示接受任意长度）
+            if (item->payload_length != 0xFFFF && item->payload_length != len)
+            {
+                stats.on_length_error(component_id, data_id);
+                return false;
+            }
+
+            // 复制数据到目标地址
+            if (dst != nullptr)
+                std::memcpy(dst, data, len);
+
+            // 处理数据 调用回函数
+            const auto &callback = item->callback;
+            if (callback)
+                return callback(data, len);
+            return true;
+        }
+
+    protected:
+        // 发送队列：每个优先级一个环形缓冲区，0 为最高优先级；未配置的 (component_id, data_id) 使用最低优先级
+        std::array<Circular_buffer<uint8_t, TxSize>, TxClasses> send_buff;
+        uint8_t seq_id = 0;
+
+        // 发送规则：优先级与“最新值替换”，pending_* 记录该 ID 最近一个仍在队列中的帧
+        struct tx_rule_t
+        {
+            uint16_t key = 0;
+            uint8_t priority = 0;
+            bool latest_wins = false;
+            bool reliable = false; // 经 send_reliable() 发送，等待确认并超时重传
+            bool pending = false;
+#if UNIFY_LINK_LATENCY
+            bool timestamped = false; // 携带发送端时间戳
+#endif
+            uint16_t pending_len = 0;  // 载荷长度
+            uint32_t pending_pos = 0;  // 帧起始位置（该队列环形缓冲区的物理下标）
+        };
+
+        std::array<tx_rule_t, UNIFY_LINK_MAX_TX_RULES> tx_rules{};
+        uint8_t tx_rule_count = 0;
+
+        // 各队列累计提交/消费字节数（回绕计数），用于定位仍在队列中的帧
+        std::array<uint32_t, TxClasses> tx_committed{};
+        std::array<uint32_t, TxClasses> tx_consumed{};
+
+        // 当前突发：send_buff_peek() 交出、尚未 consume 的字节；多优先级时以整帧为单位选择队列
+        uint8_t tx_class = 0;
+        uint32_t tx_burst_left = 0;
+        // 各队列已由 send_buff_peek() 交出的数据末尾（物理下标）；仅在主循环中写入，
+        // send_buff_consume() 不会越过它，最新值替换据此避开正在发送的字节
+        std::array<uint32_t, TxClasses> tx_peek_end{};
+        uint32_t tx_burst_limit = max_frame_length;
+
+        // 多优先级时帧的发出顺序与提交顺序不同，序号与 CRC 在交给 DMA 前才写入帧头
+        static constexpr bool kStampOnDrain = TxClasses > 1;
+
+    public:
+        // 发送帧写入器：由 begin_send_frame() 在 send_buff 中预留整帧空间，
+        // 组件把载荷直接序列化进环形缓冲区，commit_send_frame() 原地计算 CRC 并发布。
+        class Tx_frame
+        {
+        public:
+            bool valid() const { return slot.size() != 0; }
+            uint16_t length() const { return payload_len; }
+            uint16_t written() const { return cursor; }
+
+            // 追加载荷字节，超出预留长度时返回 false
+            bool write(const void *src, uint16_t n)
+            {
+                if (!valid() || n > payload_len - cursor)
+                    return false;
+                if (n == 0)
+                    return true;
+
+                slot.write(sizeof(unify_link_frame_head_t) + cursor, static_cast<const uint8_t *>(src), n);
+                cursor = static_cast<uint16_t>(cursor + n);
+                return true;
+            }
+
+            template <typename T>
+            bool put(const T &obj)
+            {
+                return write(&obj, sizeof(obj));
+            }
+
+        private:
+            friend Unify_link_t;
+
+            ring_segments_t<uint8_t> slot;
+            uint8_t component_id = 0;
+            uint8_t data_id = 0;
+            uint8_t flags = 0;
+            uint8_t priority = 0;
+            uint16_t payload_len = 0;
+            uint16_t cursor = 0;
+        };
+
+        // 预留一帧（帧头 + len 字节载荷）；空间不足或超长时返回无效写入器
+        // 约定：同一时刻只允许一个未提交的帧（单生产者），未提交的帧不占用发送缓冲区
+        // 打包中的帧会先被发出，以保证帧顺序
+        Tx_frame begin_send_frame(uint8_t component_id, uint8_t data_id, uint16_t len)
+        {
+            flush_bundle();
+            Tx_frame frame = _reserve_frame(component_id, data_id, len, tx_priority_of(component_id, data_id));
+            if (!frame.valid() && len <= MaxPayload)
+                stats.on_tx_drop(component_id, data_id);
+            return frame;
+        }
+
+        // 写完全部载荷后提交：写入帧头、计算 CRC、发布到 send_buff；返回整帧长度，未写满时放弃该帧并返回 0
+        uint16_t commit_send_frame(Tx_frame &frame)
+        {
+            if (!frame.valid())
+                return 0;
+
+            if (frame.cursor != frame.payload_len)
+            {
+                frame.slot = {};
+                return 0;
+            }
+
+            return _publish_frame(frame);
+        }
+
+    protected:
+        Tx_frame _reserve_frame(uint8_t component_id, uint8_t data_id, uint16_t len, uint8_t priority)
+        {
+            Tx_frame frame;
+            if (len > MaxPayload)
+                return frame; // 超出最大帧长
+
+            frame.slot = send_buff[priority].reserve(sizeof(unify_link_frame_head_t) + len);
+            if (!frame.valid())
+                return frame; // 发送缓冲区空间不足
+
+            frame.component_id = component_id;
+            frame.data_id = data_id;
+            frame.priority = priority;
+            frame.payload_len = len;
+            return frame;
+        }
+
+        // 帧头（不含 crc16 字段）+ 环形缓冲区中从 offset 起 payload_len 字节载荷的 CRC
+        template <typename Seg>
+        static uint16_t _frame_crc(const unify_link_frame_head_t &head, const Seg &seg, uint32_t offset,
+                                   uint32_t payload_len)
+        {
+            uint16_t crc = crc16_calculation(reinterpret_cast<const uint8_t *>(&head),
+                                             offsetof(unify_link_frame_head_t, crc16));
+            for (int i = 0; i < 2; ++i)
+            {
+                const uint32_t seg_skip = std::min(offset, seg.len[i]);
+                const uint32_t seg_len = std::min(payload_len, seg.len[i] - seg_skip);
+                crc = crc16_calculation(seg.ptr[i] + seg_skip, static_cast<uint16_t>(seg_len), crc);
+                offset -= seg_skip;
+                payload_len -= seg_len;
+            }
+            return crc;
+        }
+
+        // 发布 frame 的前 payload_len 字节载荷（预留空间可以更长，多余部分归还给 send_buff）
+        uint16_t _publish_frame(Tx_frame &frame)
+        {
+            unify_link_frame_head_t head;
+            head.frame_header = FRAME_HEADER;
+            head.component_id = frame.component_id;
+            head.data_id = frame.data_id;
+            head.set_flags_and_length(frame.flags, frame.payload_len);
+            head.seq_id = 0;
+            head.crc16 = 0;
+
+            if constexpr (!kStampOnDrain)
+            {
+                head.seq_id = seq_id;
+                this->seq_id = seq_id + 1;
+
+                // 计算 CRC：帧头在栈上，载荷直接在环形缓冲区中（可能跨越环尾）
+                head.crc16 = _frame_crc(head, frame.slot, sizeof(unify_link_frame_head_t), frame.payload_len);
+            }
+
+            frame.slot.write(0, reinterpret_cast<const uint8_t *>(&head), sizeof(head));
+
+            const uint16_t frame_len = static_cast<uint16_t>(sizeof(unify_link_frame_head_t) + frame.payload_len);
+            send_buff[frame.priority].commit(frame_len);
+            tx_committed[frame.priority] += frame_len;
+#if UNIFY_LINK_LATENCY
+            if (latency_clock != nullptr)
+                latency.on_tx_commit(frame.priority, tx_committed[frame.priority], frame.component_id, frame.data_id,
+                                     latency_clock());
+#endif
+            stats.on_tx_frame(frame_len);
+            if ((frame.flags & FRAME_FLAG_BUNDLE) == 0)
+                stats.on_tx_message(frame.component_id, frame.data_id, frame_len); // 打包记录在追加时计入
+            frame.slot = {};
+            return frame_len;
+        }
+
+        tx_rule_t *_find_tx_rule(uint8_t component_id, uint8_t data_id)
+        {
+            const uint16_t key = make_key(component_id, data_id);
+            for (uint8_t i = 0; i < tx_rule_count; ++i)
+            {
+                if (tx_rules[i].key == key)
+                    return &tx_rules[i];
+            }
+            return nullptr;
+        }
+
+        // 查找或新建规则（新规则使用最低优先级），规则表已满时返回 nullptr
+        tx_rule_t *_obtain_tx_rule(uint8_t component_id, uint8_t data_id)
+        {
+            tx_rule_t *rule = _find_tx_rule(component_id, data_id);
+            if (rule != nullptr || tx_rule_count >= tx_rules.size())
+                return rule;
+
+            rule = &tx_rules[tx_rule_count++];
+            rule->key = make_key(component_id, data_id);
+            rule->priority = static_cast<uint8_t>(TxClasses - 1);
+            return rule;
+        }
+
+        // 最新值替换：同 ID 的上一帧仍在队列中、未交给 DMA 且长度相同时，原地覆盖其载荷
+        bool _replace_pending(tx_rule_t &rule, const uint8_t *data, uint16_t len)
+        {
+            if (!rule.pending || rule.pending_len != len)
+                return false;
+
+            // 帧位置与已交出的末尾均为物理下标，rewrite_at() 只读取一次 tail，
+            // 因此 DMA 完成中断在判定期间 consume 不会使位置失效
+            const uint32_t frame_len = sizeof(unify_link_frame_head_t) + len;
+            const auto seg = send_buff[rule.priority].rewrite_at(rule.pending_pos, frame_len, tx_peek_end[rule.priority]);
+            if (seg.size() == 0)
+            {
+                rule.pending = false; // 已发出或正在发送
+                return false;
+            }
+
+            seg.write(sizeof(unify_link_frame_head_t), data, len);
+
+            if constexpr (!kStampOnDrain)
+            {
+                unify_link_frame_head_t head;
+                seg.read(0, reinterpret_cast<uint8_t *>(&head), sizeof(head));
+                head.crc16 = _frame_crc(head, seg, sizeof(unify_link_frame_head_t), len);
+                seg.write(0, reinterpret_cast<const uint8_t *>(&head), sizeof(head));
+            }
+
+            tx_replaced_count++;
+            return true;
+        }
+
+        // 选择下一个突发：最高优先级的非空队列中不超过 tx_burst_limit 的若干整帧（至少一帧），并写入序号与 CRC
+        void _select_tx_burst()
+        {
+            tx_burst_left = 0;
+            for (uint8_t k = 0; k < TxClasses; ++k)
+            {
+                auto &ring = send_buff[k];
+                const uint32_t available = ring.used();
+                if (available == 0)
+                    continue;
+
+                tx_class = k;
+                uint32_t off = 0;
+                while (off < available)
+                {
+                    unify_link_frame_head_t head;
+                    ring.read_data(reinterpret_cast<uint8_t *>(&head), sizeof(head), off);
+                    const uint32_t frame_len = sizeof(head) + head.length();
+                    if (off != 0 && off + frame_len > tx_burst_limit)
+                        break;
+
+                    const auto seg = ring.rewrite_segments(frame_len, off);
+                    head.seq_id = seq_id;
+                    this->seq_id = seq_id + 1;
+                    head.crc16 = _frame_crc(head, seg, sizeof(head), head.length());
+                    seg.write(0, reinterpret_cast<const uint8_t *>(&head), sizeof(head));
+                    off += frame_len;
+                }
+                tx_burst_left = off;
+                tx_peek_end[k] = ring.index_of(off);
+                return;
+            }
+        }
+
+        // === 打包发送 ===
+        // 打开的打包帧在 send_buff 中预留 bundle_max_bytes 字节载荷空间，记录直接写入其中
+        static constexpr uint16_t kBundleRecordHead = 2; // data_id + len
+
+        Tx_frame bundle_frame;
+        uint16_t bundle_max_bytes = 0; // 0 表示关闭打包
+        uint32_t bundle_deadline = 0;  // 0 表示不按超时发出
+        uint32_t bundle_opened_at = 0;
+        clock_fn_t clock = nullptr;
+
+        uint16_t _bundle_append(uint8_t component_id, uint8_t data_id, const uint8_t *data, uint8_t len)
+        {
+            const uint16_t record_len = static_cast<uint16_t>(kBundleRecordHead + len);
+            const uint8_t priority = tx_priority_of(component_id, data_id);
+
+            // 一个打包帧只承载同一组件、同一优先级的记录；放不下时先发出当前包
+            if (bundle_frame.valid() &&
+                (bundle_frame.component_id != component_id || bundle_frame.priority != priority ||
+                 record_len > bundle_frame.payload_len - bundle_frame.cursor))
+                flush_bundle();
+
+            if (!bundle_frame.valid())
+            {
+                bundle_frame = _reserve_frame(component_id, 0, bundle_max_bytes, priority);
+                if (!bundle_frame.valid())
+                {
+                    stats.on_tx_drop(component_id, data_id);
+                    return 0; // 发送缓冲区空间不足
+                }
+                bundle_frame.flags = FRAME_FLAG_BUNDLE;
+                bundle_opened_at = now();
+            }
+
+            const uint8_t record_head[kBundleRecordHead] = {data_id, len};
+            bundle_frame.write(record_head, kBundleRecordHead);
+            bundle_frame.write(data, len);
+            stats.on_tx_message(component_id, data_id, record_len);
+
+            // 尺寸策略：剩余空间连一个空记录都放不下时立即发出
+            if (bundle_frame.payload_len - bundle_frame.cursor < kBundleRecordHead)
+                flush_bundle();
+            else
+                bundle_poll();
+            return record_len;
+        }
+
+    public:
+        // 设置时钟源（打包超时等使用），未设置时 now() 恒为 0
+        void set_clock(clock_fn_t fn) { clock = fn; }
+        uint32_t now() const { return clock != nullptr ? clock() : 0; }
+
+        // 打包模式：长度 <= 255 的消息以记录形式合并进同组件的打包帧（FRAME_FLAG_BUNDLE），
+        // 载荷累计到 max_bytes 或自首条记录起超过 deadline（时钟单位）时发出；max_bytes = 0 关闭打包
+        void set_bundle_policy(uint16_t max_bytes, uint32_t deadline = 0)
+        {
+            flush_bundle();
+            bundle_max_bytes = std::min<uint16_t>(max_bytes, MaxPayload);
+            if (bundle_max_bytes < kBundleRecordHead)
+                bundle_max_bytes = 0;
+            bundle_deadline = deadline;
+        }
+
+        bool bundle_enabled() const { return bundle_max_bytes != 0; }
+        bool bundle_pending() const { return bundle_frame.valid(); }
+
+        // 发出当前打包帧，返回整帧长度（无待发包时返回 0）
+        uint16_t flush_bundle()
+        {
+            if (!bundle_frame.valid())
+                return 0;
+
+            bundle_frame.payload_len = bundle_frame.cursor;
+            bundle_frame.flags = FRAME_FLAG_BUNDLE;
+            return _publish_frame(bundle_frame);
+        }
+
+        // 超时检查：在发送任务中周期调用（先于 send_buff_peek / send_buff_pop）
+        void bundle_poll()
+        {
+            if (bundle_frame.valid() && bundle_deadline != 0 && now() - bundle_opened_at >= bundle_deadline)
+                flush_bundle();
+        }
+
+    protected:
+        // === 分片发送 ===
+        // 超长消息不整体进入发送缓冲区：fragment_poll() 在队列积压低于 fragment_queue_limit 时逐片写入，
+        // 其间提交的其他帧排在后续分片之前发出
+        static constexpr uint16_t kFragmentChunk =
+            static_cast<uint16_t>(MaxPayload - sizeof(unify_link_fragment_head_t));
+
+        struct tx_fragment_t
+        {
+            const uint8_t *data = nullptr;
+            uint16_t total = 0;
+            uint16_t offset = 0;
+            uint8_t component_id = 0;
+            uint8_t data_id = 0;
+        } tx_fragment;
+
+    public:
+        uint32_t fragment_queue_limit = 2 * max_frame_length; // 分片所在队列积压超过该字节数时暂停写入分片
+
+        // 分片发送 data[0..len)（须显式调用，build_send_data() 拒绝超过单帧载荷上限的消息）：
+        // 不拷贝整条消息，data 须保持有效直到 fragment_pending() 为 false；已有消息在分片发送时返回 false。
+        // 接收端须以同样长度注册带 dst 的运行时处理函数（见 _dispatch_fragment）
+        bool send_fragmented(uint8_t component_id, uint8_t data_id, const uint8_t *data, uint16_t len)
+        {
+            if (tx_fragment.data != nullptr || data == nullptr || len == 0 || len == 0xFFFF)
+                return false;
+
+            tx_fragment = {data, len, 0, component_id, data_id};
+            fragment_poll();
+            return true;
+        }
+
+        bool fragment_pending() const { return tx_fragment.data != nullptr; }
+
+        // 在发送任务中周期调用（与 bundle_poll() / reliable_poll() 一起），随发送缓冲区腾出空间写入后续分片
+        void fragment_poll()
+        {
+            if (tx_fragment.data == nullptr)
+                return;
+
+            const uint8_t priority = tx_priority_of(tx_fragment.component_id, tx_fragment.data_id);
+            while (tx_fragment.offset < tx_fragment.total && send_buff[priority].used() < fragment_queue_limit)
+            {
+                const uint16_t n = std::min<uint16_t>(kFragmentChunk, tx_fragment.total - tx_fragment.offset);
+                Tx_frame frame = begin_send_frame(tx_fragment.component_id, tx_fragment.data_id,
+                                                  static_cast<uint16_t>(sizeof(unify_link_fragment_head_t) + n));
+                if (!frame.valid())
+                    break; // 发送缓冲区空间不足
+
+                const unify_link_fragment_head_t head = {tx_fragment.total, tx_fragment.offset};
+                frame.flags = FRAME_FLAG_FRAGMENT;
+                frame.put(head);
+                frame.write(tx_fragment.data + tx_fragment.offset, n);
+                commit_send_frame(frame);
+                tx_fragment.offset = static_cast<uint16_t>(tx_fragment.offset + n);
+            }
+
+            if (tx_fragment.offset >= tx_fragment.total)
+                tx_fragment = {};
+        }
+
+        uint64_t tx_replaced_count = 0; // 被“最新值替换”覆盖、未发出的旧帧数
+
+        // 发送规则：priority 0 为最高（>= TxClasses 时取最低）；latest_wins 为 true 时，
+        // 经 build_send_data()/send_packet() 发送的同 ID 帧若上一帧仍在队列中未发出，则原地替换为新值
+        // （latest_wins 要求发送与 send_buff_peek() 在同一上下文调用；DMA 完成中断中可并发调用 send_buff_consume()，
+        //  但消费量不得超过 send_buff_peek() 交出的字节）
+        bool set_tx_priority(uint8_t component_id, uint8_t data_id, uint8_t priority, bool latest_wins = false)
+        {
+            tx_rule_t *rule = _obtain_tx_rule(component_id, data_id);
+            if (rule == nullptr)
+                return false; // 规则表已满（见 UNIFY_LINK_MAX_TX_RULES）
+
+            rule->priority = std::min<uint8_t>(priority, TxClasses - 1);
+            rule->latest_wins = latest_wins;
+            rule->pending = false;
+            return true;
+        }
+
+        uint8_t tx_priority_of(uint8_t component_id, uint8_t data_id)
+        {
+            const tx_rule_t *rule = _find_tx_rule(component_id, data_id);
+            return rule != nullptr ? rule->priority : static_cast<uint8_t>(TxClasses - 1);
+        }
+
+        // 多优先级时单次 send_buff_peek() 最多交出的字节数（至少一整帧），即高优先级帧最坏的排队延迟
+        void set_tx_burst_limit(uint32_t bytes) { tx_burst_limit = bytes; }
+
+    protected:
+        // === 可靠发送 ===
+        // 可靠帧载荷 = [tag(1) | 原载荷]，tag 低 7bit 为可靠序号，bit7 为同步位（发送端新会话或放弃了更早的帧）。
+        // 接收端只按序交付，并以累计确认（期望的下一个序号；bit7 置位表示接收端未同步）应答；发送端 go-back-N：
+        // 最早未确认帧超过 RTO（按 RTT 自适应，Jacobson/Karels）后重传全部未确认帧。
+        static constexpr uint8_t kRelSeqMask = 0x7F;
+        static constexpr uint8_t kRelSync = 0x80;
+        static_assert(UNIFY_LINK_RELIABLE_WINDOW >= 1 && UNIFY_LINK_RELIABLE_WINDOW <= 32,
+                      "UNIFY_LINK_RELIABLE_WINDOW must be 1..32");
+
+    public:
+        // 保存待确认载荷的字节数：UNIFY_LINK_RELIABLE_STORE，且不超过本链路的 TxSize；为 0 时不支持可靠发送
+        static constexpr uint32_t reliable_store_size = std::min<uint32_t>(UNIFY_LINK_RELIABLE_STORE, TxSize);
+
+    protected:
+
+        struct reliable_entry_t
+        {
+            uint8_t component_id = 0;
+            uint8_t data_id = 0;
+            uint8_t seq = 0;
+            bool sync = false;
+            uint16_t len = 0;
+            uint8_t retries = 0;
+            uint32_t sent_at = 0;
+        };
+
+        // 待确认帧按序号顺序排队，载荷按同样顺序保存在 rel_store 中
+        std::array<reliable_entry_t, UNIFY_LINK_RELIABLE_WINDOW> rel_entries{};
+        uint8_t rel_head = 0;
+        uint8_t rel_count = 0;
+        Circular_buffer<uint8_t, reliable_store_size + 1> rel_store; // +1 为环形缓冲区的哨兵字节
+        uint8_t rel_next_seq = 0;
+        bool rel_sync = true;
+
+        uint32_t rel_srtt = 0;
+        uint32_t rel_rttvar = 0;
+        uint32_t rel_rto = 0;
+        bool rel_has_rtt = false;
+
+        // 接收端
+        uint8_t rel_expected = 0;
+        bool rel_rx_synced = false;
+        bool rel_ack_pending = false;
+
+        reliable_entry_t &_rel_entry(uint8_t i) { return rel_entries[(rel_head + i) % UNIFY_LINK_RELIABLE_WINDOW]; }
+
+        // 把 entry 写成一帧，载荷为 first 与 second 两段（对应 rel_store 回绕的两段）；
+        // 发送缓冲区空间不足（包括打包发送刷出后的剩余空间）时返回 false，不写入任何内容
+        bool _write_reliable(reliable_entry_t &entry, const uint8_t *first, uint16_t first_len, const uint8_t *second,
+                             uint16_t second_len)
+        {
+            Tx_frame frame = begin_send_frame(entry.component_id, entry.data_id, static_cast<uint16_t>(entry.len + 1));
+            if (!frame.valid())
+                return false;
+
+            frame.flags = FRAME_FLAG_ACK_REQ;
+            frame.put(static_cast<uint8_t>(entry.seq | (entry.sync ? kRelSync : 0)));
+            frame.write(first, first_len);
+            frame.write(second, second_len);
+            _publish_frame(frame);
+            entry.sent_at = now();
+            return true;
+        }
+
+        // 重传 entry（载荷位于 rel_store 的 store_offset 处）
+        bool _transmit_reliable(reliable_entry_t &entry, uint32_t store_offset)
+        {
+            const auto seg = rel_store.rewrite_segments(entry.len, store_offset);
+            return _write_reliable(entry, seg.ptr[0], static_cast<uint16_t>(seg.len[0]), seg.ptr[1],
+                                   static_cast<uint16_t>(seg.len[1]));
+        }
+
+        // 按序重传全部未确认帧
+        void _retransmit_reliable()
+        {
+            uint32_t offset = 0;
+            for (uint8_t i = 0; i < rel_count; ++i)
+            {
+                reliable_entry_t &entry = _rel_entry(i);
+                if (!_transmit_reliable(entry, offset))
+                    return; // 发送缓冲区已满，剩余帧保持超时状态，下次 reliable_poll() 继续
+                if (entry.retries < 0xFF)
+                    entry.retries++;
+                offset += entry.len;
+                reliable_retransmit_count++;
+            }
+        }
+
+        void _pop_reliable_head()
+        {
+            rel_store.pop_data(_rel_entry(0).len);
+            rel_head = static_cast<uint8_t>((rel_head + 1) % UNIFY_LINK_RELIABLE_WINDOW);
+            rel_count--;
+        }
+
+        void _update_rto(uint32_t sample)
+        {
+            if (!rel_has_rtt)
+            {
+                rel_srtt = sample;
+                rel_rttvar = sample / 2;
+                rel_has_rtt = true;
+            }
+            else
+            {
+                const uint32_t err = sample > rel_srtt ? sample - rel_srtt : rel_srtt - sample;
+                rel_rttvar = (3 * rel_rttvar + err) / 4;
+                rel_srtt = (7 * rel_srtt + sample) / 8;
+            }
+            rel_rto = rel_srtt + std::max<uint32_t>(1, 4 * rel_rttvar);
+            rel_rto = std::min(std::max(rel_rto, reliable_rto_min), reliable_rto_max);
+        }
+
+        void _dispatch_reliable(uint8_t component_id, uint8_t data_id, const uint8_t *payload, uint16_t payload_len)
+        {
+            if (payload_len < 1)
+            {
+                _count_decode(component_id, data_id, payload_len, false);
+                return;
+            }
+
+            rel_ack_pending = true;
+            const uint8_t tag = payload[0];
+            const uint8_t seq = tag & kRelSeqMask;
+            const uint8_t ahead = (seq - rel_expected) & kRelSeqMask;
+            const bool behind = ahead > kRelSeqMask - UNIFY_LINK_RELIABLE_WINDOW;
+
+            if (!rel_rx_synced && (tag & kRelSync) == 0)
+                return; // 尚未同步（例如本端刚重启）：应答中请求发送端重新同步
+
+            if (rel_rx_synced && ahead != 0)
+            {
+                if (behind)
+                {
+                    reliable_duplicate_count++; // 确认丢失后的重传，只需重新应答
+                    return;
+                }
+                if ((tag & kRelSync) == 0)
+                    return; // 前面的帧丢失，等待发送端按序重传
+            }
+
+            rel_rx_synced = true;
+            rel_expected = (seq + 1) & kRelSeqMask;
+            _count_decode(component_id, data_id, static_cast<uint16_t>(payload_len - 1),
+                          handle_data(component_id, data_id, payload + 1, static_cast<uint16_t>(payload_len - 1)));
+        }
+
+        void _send_link_ack()
+        {
+            rel_ack_pending = false;
+            Tx_frame frame = begin_send_frame(COMPONENT_ID_SYSTEM, LINK_ACK_DATA_ID, 1);
+            if (!frame.valid())
+                return; // 发送缓冲区已满：对端超时重传后会再次应答
+            frame.put(rel_rx_synced ? rel_expected : kRelSync);
+            _publish_frame(frame);
+        }
+
+        void _handle_link_ack(const uint8_t *payload, uint16_t payload_len)
+        {
+            _count_decode(COMPONENT_ID_SYSTEM, LINK_ACK_DATA_ID, payload_len, payload_len == 1);
+            if (payload_len != 1)
+                return;
+
+            if (rel_count == 0)
+                return;
+
+            if (payload[0] & kRelSync)
+            {
+                // 对端未同步：最早未确认帧带上同步位立即重传
+                if (!_rel_entry(0).sync)
+                {
+                    _rel_entry(0).sync = true;
+                    _retransmit_reliable();
+                }
+                return;
+            }
+
+            const uint8_t ack = payload[0] & kRelSeqMask;
+            const uint8_t acked = (ack - _rel_entry(0).seq) & kRelSeqMask;
+            if (acked > rel_count)
+            {
+                // 对端期望的序号不在发送窗口内（例如本端重启后序号从 0 开始）：同步帧按对端序号重新编号后重传
+                if (_rel_entry(0).sync)
+                {
+                    for (uint8_t i = 0; i < rel_count; ++i)
+                        _rel_entry(i).seq = (ack + i) & kRelSeqMask;
+                    rel_next_seq = (ack + rel_count) & kRelSeqMask;
+                    _retransmit_reliable();
+                }
+                return;
+            }
+
+            // Karn 算法：只用未重传过的帧采样 RTT
+            const uint32_t t = now();
+            bool sampled = false;
+            uint32_t sample = 0;
+            for (uint8_t i = 0; i < acked; ++i)
+            {
+                const reliable_entry_t &entry = _rel_entry(0);
+                if (entry.retries == 0)
+                {
+                    sample = t - entry.sent_at;
+                    sampled = true;
+                }
+                _pop_reliable_head();
+            }
+            if (sampled)
+                _update_rto(sample);
+        }
+
+    public:
+        uint32_t reliable_rto_initial = 100; // 尚无 RTT 样本时的重传超时（时钟单位，见 set_clock）
+        uint32_t reliable_rto_min = 10;
+        uint32_t reliable_rto_max = 2000;
+        uint8_t reliable_max_retries = 5; // 超过后放弃该帧并调用 on_reliable_failed
+
+        uint64_t reliable_retransmit_count = 0;
+        uint64_t reliable_fail_count = 0;
+        uint64_t reliable_duplicate_count = 0; // 接收端收到的重复可靠帧
+
+        std::function<void(uint8_t component_id, uint8_t data_id)> on_reliable_failed;
+
+        // 可靠发送：帧带 FRAME_FLAG_ACK_REQ，保留副本直到对端确认，超时按 RTO 重传（需要 set_clock）。
+        // 返回整帧长度；待确认帧已满（UNIFY_LINK_RELIABLE_WINDOW）、副本存储（reliable_store_size）或发送缓冲区空间不足时
+        // 返回 0，此时不入队、不占用序号；未启用可靠发送（reliable_store_size == 0）时总是返回 0。
+        // 同一链路的可靠帧应使用同一优先级，否则多优先级调度造成的乱序会触发重传。
+        uint16_t send_reliable(uint8_t component_id, uint8_t data_id, const uint8_t *data, uint16_t len)
+        {
+            if constexpr (reliable_store_size == 0)
+                return 0; // 长度为 0 的帧也会通过下面的空间检查，但没有存储就无法重传
+            if (len >= MaxPayload || rel_count >= UNIFY_LINK_RELIABLE_WINDOW || rel_store.remain() < len)
+                return 0;
+
+            reliable_entry_t &entry = _rel_entry(rel_count);
+            entry = reliable_entry_t{};
+            entry.component_id = component_id;
+            entry.data_id = data_id;
+            entry.seq = rel_next_seq;
+            entry.sync = rel_sync;
+            entry.len = len;
+
+            // 先写帧：begin_send_frame() 会先刷出打包中的帧，剩余空间只有在预留时才能确定
+            if (!_write_reliable(entry, data, len, nullptr, 0))
+                return 0;
+            rel_store.push_data(data, len);
+
+            if (rel_count == 0 && !rel_has_rtt)
+                rel_rto = reliable_rto_initial;
+            rel_count++;
+            rel_next_seq = (rel_next_seq + 1) & kRelSeqMask;
+            rel_sync = false;
+            return static_cast<uint16_t>(sizeof(unify_link_frame_head_t) + len + 1);
+        }
+
+        // 对 (component_id, data_id) 启用/关闭可靠模式：之后经 build_send_data()/send_packet() 发送的该 ID 帧走 send_reliable()
+        bool set_reliable(uint8_t component_id, uint8_t data_id, bool enable = true)
+        {
+            if (enable && reliable_store_size == 0)
+                return false; // 未启用可靠发送（见 UNIFY_LINK_RELIABLE_STORE）
+            tx_rule_t *rule = _obtain_tx_rule(component_id, data_id);
+            if (rule == nullptr)
+                return false; // 规则表已满（见 UNIFY_LINK_MAX_TX_RULES）
+            rule->reliable = enable;
+            return true;
+        }
+
+        // 超时检查：在发送任务中周期调用；最早未确认帧超时后重传全部未确认帧并加倍 RTO
+        void reliable_poll()
+        {
+            if (rel_count == 0 || now() - _rel_entry(0).sent_at < rel_rto)
+                return;
+
+            if (_rel_entry(0).retries >= reliable_max_retries)
+            {
+                const reliable_entry_t failed = _rel_entry(0);
+                _pop_reliable_head();
+                reliable_fail_count++;
+                if (rel_count != 0)
+                    _rel_entry(0).sync = true; // 让对端跳过被放弃的序号
+                else
+                    rel_sync = true;
+                if (on_reliable_failed)
+                    on_reliable_failed(failed.component_id, failed.data_id);
+                if (rel_count == 0)
+                    return;
+            }
+
+            rel_rto = std::min(rel_rto * 2, reliable_rto_max);
+            _retransmit_reliable();
+        }
+
+        uint8_t reliable_pending() const { return rel_count; }
+        uint32_t reliable_rto() const { return rel_rto; }
+        uint32_t reliable_srtt() const { return rel_srtt; }
+
+        // Convenience helpers for components: send a trivially-copyable object/array as payload.
+        // Usage example from components:
+        //   link_base.send_packet<component_id>(DATA_ID, obj_or_array);
+        template <uint8_t ComponentId, typename T>
+        void send_packet(uint8_t data_id, const T &obj)
+        {
+            build_send_data(ComponentId, data_id, reinterpret_cast<const uint8_t *>(&obj), sizeof(obj));
+        }
+
+        template <uint8_t ComponentId, typename T, size_t N>
+        void send_packet(uint8_t data_id, const T (&arr)[N])
+        {
+            build_send_data(ComponentId, data_id, reinterpret_cast<const uint8_t *>(arr), sizeof(arr));
+        }
+
+        // 返回写入的字节数：单帧为整帧长度，打包时为记录长度；发送缓冲区空间不足或 len 超过 MaxPayload 时返回 0
+        // （build_send_data() 返回后不再引用 data，超长消息用 send_fragmented()）
+        uint16_t build_send_data(const uint8_t component_id, const uint8_t data_id, const uint8_t *data,
+                                 const uint16_t len)
+        {
+            tx_rule_t *rule = _find_tx_rule(component_id, data_id);
+            if (rule != nullptr && rule->reliable)
+                return send_reliable(component_id, data_id, data, len);
+
+#if UNIFY_LINK_LATENCY
+            if (rule != nullptr && rule->timestamped && latency_clock != nullptr && len + kTimestampBytes <= MaxPayload)
+                return _send_timestamped(component_id, data_id, data, len);
+#endif
+
+            if (len > MaxPayload)
+                return 0; // 超出单帧载荷上限
+
+            const bool latest_wins = rule != nullptr && rule->latest_wins;
+            if (latest_wins)
+            {
+                if (_replace_pending(*rule, data, len))
+                    return static_cast<uint16_t>(sizeof(unify_link_frame_head_t) + len);
+            }
+            else if (bundle_enabled() && len <= 0xFF && kBundleRecordHead + len <= bundle_max_bytes)
+            {
+                return _bundle_append(component_id, data_id, data, static_cast<uint8_t>(len));
+            }
+
+            Tx_frame frame = begin_send_frame(component_id, data_id, len);
+            if (!frame.valid())
+                return 0;
+
+            frame.write(data, len);
+            const uint16_t frame_len = commit_send_frame(frame);
+            if (latest_wins && frame_len != 0)
+            {
+                rule->pending = true;
+                rule->pending_len = len;
+                rule->pending_pos = send_buff[frame.priority].write_index(frame_len);
+            }
+            return frame_len;
+        }
+
+        // 全部优先级队列中待发送的字节数
+        uint32_t send_buff_used() const
+        {
+            uint32_t total = 0;
+            for (const auto &ring : send_buff)
+                total += ring.used();
+            return total;
+        }
+
+        // 最低优先级（默认）队列的剩余空间
+        uint32_t send_buff_remain() const { return send_buff[TxClasses - 1].remain(); }
+
+        // 将发送缓冲区全部数据按优先级顺序拷贝到 data（需能容纳 send_buff_used() 字节）并清空
+        void send_buff_pop(uint8_t *data, uint32_t *len)
+        {
+            *len = 0;
+            if (send_buff_used() < sizeof(unify_link_frame_head_t))
+                return; // 数据不足
+
+            while (true)
+            {
+                const auto seg = send_buff_peek();
+                const uint32_t n = seg.size();
+                if (n == 0)
+                    break;
+
+                seg.read(0, data + *len, n);
+                *len += n;
+                send_buff_consume(n);
+            }
+        }
+
+        // 零拷贝发送：DMA / writev 直接从环形缓冲区取数据，发送完成后只消费实际写出的字节
+        //   auto seg = link.send_buff_peek();            // 最多两段
+        //   n = writev(fd, seg...);  link.send_buff_consume(n);
+        // 多优先级时每次只交出一个队列中的若干整帧（见 set_tx_burst_limit），消费完后才切换到更高优先级的队列
+        ring_segments_t<const uint8_t> send_buff_peek()
+        {
+            if constexpr (TxClasses == 1)
+            {
+                const auto seg = send_buff[0].peek_segments();
+                tx_burst_left = seg.size();
+                tx_peek_end[0] = send_buff[0].write_index();
+                return seg;
+            }
+            else
+            {
+                if (tx_burst_left == 0)
+                    _select_tx_burst();
+
+                auto seg = send_buff[tx_class].peek_segments();
+                seg.len[0] = std::min(seg.len[0], tx_burst_left);
+                seg.len[1] = std::min(seg.len[1], tx_burst_left - seg.len[0]);
+                return seg;
+            }
+        }
+
+        const uint8_t *send_buff_peek_contiguous(uint32_t *len)
+        {
+            const auto seg = send_buff_peek();
+            *len = seg.len[0];
+            return seg.ptr[0];
+        }
+
+        void send_buff_consume(uint32_t len)
+        {
+            len = std::min(len, send_buff[tx_class].used());
+            send_buff[tx_class].consume(len);
+            tx_consumed[tx_class] += len;
+            tx_burst_left -= std::min(len, tx_burst_left);
+#if UNIFY_LINK_LATENCY
+            if (latency_clock != nullptr)
+                latency.on_tx_consume(tx_class, tx_consumed[tx_class], latency_clock());
+#endif
+        }
+
+#if UNIFY_LINK_LATENCY
+        // === 时延测量（UNIFY_LINK_LATENCY=1）===
+        // 时延时钟独立于 set_clock()，建议使用微秒；未设置时不采样，也不发送时间戳
+        void set_latency_clock(clock_fn_t fn) { latency_clock = fn; }
+
+        // 该 ID 的帧携带发送端时间戳（FRAME_FLAG_TIMESTAMP，载荷多 4 字节），对端据此统计单向时延；
+        // 不与打包 / 最新值替换 / 可靠发送叠加
+        bool set_timestamped(uint8_t component_id, uint8_t data_id, bool enable = true)
+        {
+            tx_rule_t *rule = _obtain_tx_rule(component_id, data_id);
+            if (rule == nullptr)
+                return false; // 规则表已满（见 UNIFY_LINK_MAX_TX_RULES）
+            rule->timestamped = enable;
+            return true;
+        }
+
+        // 直方图；该 ID 尚无样本时返回 nullptr
+        const Latency_histogram *latency_histogram(uint8_t component_id, uint8_t data_id, Latency_stage stage) const
+        {
+            return latency.histogram(component_id, data_id, stage);
+        }
+
+        Latency_tracker_t<UNIFY_LINK_LATENCY_SLOTS, TxClasses> latency;
+
+    protected:
+        uint16_t _send_timestamped(uint8_t component_id, uint8_t data_id, const uint8_t *data, uint16_t len)
+        {
+            Tx_frame frame = begin_send_frame(component_id, data_id, static_cast<uint16_t>(len + kTimestampBytes));
+            if (!frame.valid())
+                return 0;
+
+            frame.flags = FRAME_FLAG_TIMESTAMP;
+            frame.put(latency_clock());
+            frame.write(data, len);
+            return commit_send_frame(frame);
+        }
+
+        clock_fn_t latency_clock = nullptr;
+        uint32_t lat_arrival = 0; // 当前解析帧的到达时刻
+        bool lat_timed = false;
+#endif
+    };
+
+    // 默认尺寸链路（与旧版 Unify_link_base 相同的 RAM 占用与行为）
+    using Unify_link_base = Unify_link_t<>;
 }; // namespace unify_link
 #endif // UNIFY_LINK_HPP
@@ -0,0 +1,187 @@
+#ifndef UNIFY_LINK_ALLOC_AUDIT_HPP
+#define UNIFY_LINK_ALLOC_AUDIT_HPP
+
+// 堆分配审计（测试 / 调试用）：统计一段代码内 operator new 的调用次数，用于断言热路径
+// （parse_data_task()、build_send_data()、组件发送函数等）在稳态下不分配堆内存。
+//
+// 用法：在且仅在一个翻译单元（通常是测试文件）中
+//     #define UNIFY_LINK_ALLOC_AUDIT_IMPLEMENT
+//     #include "unify_link_alloc_audit.hpp"
+// 以替换全局 operator new/delete；其余文件只包含头文件即可使用 Alloc_audit_scope。
+//
+//     {
+//         Alloc_audit_scope audit;
+//         link.parse_data_task();
+//         EXPECT_EQ(audit.allocations(), 0u);
+//     }
+//
+// 计数分为本线程（thread_local）与全部线程两类，后者用于覆盖执行线程等其他线程上的分配。
+// set_trap(true) 后，审计区间内的任何分配都会立即调用 trap 函数（默认 std::abort），便于在调试器中定位分配点。
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+
+namespace unify_link
+{
+    namespace alloc_audit
+    {
+        struct state_t
+        {
+            std::atomic<uint64_t> total{0}; // 审计开启期间全部线程的分配次数
+            std::atomic<uint32_t> active{0}; // 存活的 Alloc_audit_scope 数
+            std::atomic<bool> trap{false};
+            void (*trap_fn)(std::size_t) = nullptr;
+        };
+
+        inline state_t &state()
+        {
+            static state_t s;
+            return s;
+        }
+
+        inline uint64_t &thread_count()
+        {
+            thread_local uint64_t count = 0;
+            return count;
+        }
+
+        // 由替换的 operator new 调用
+        inline void on_allocation(std::size_t size)
+        {
+            state_t &s = state();
+            thread_count()++;
+            if (s.active.load(std::memory_order_relaxed) == 0)
+                return;
+            s.total.fetch_add(1, std::memory_order_relaxed);
+            if (s.trap.load(std::memory_order_relaxed))
+            {
+                if (s.trap_fn != nullptr)
+                    s.trap_fn(size);
+                else
+                    std::abort();
+            }
+        }
+
+        // 审计区间内发生分配时调用 fn（为 nullptr 时 std::abort）；仅在没有活动区间时修改
+        inline void set_trap(bool enable, void (*fn)(std::size_t) = nullptr)
+        {
+            state().trap_fn = fn;
+            state().trap.store(enable, std::memory_order_relaxed);
+        }
+
+        // 替换 operator new 的翻译单元存在时为 true，测试可据此跳过断言
+        inline bool &hooked()
+        {
+            static bool value = false;
+            return value;
+        }
+    } // namespace alloc_audit
+
+    // 审计区间：构造时记下计数，allocations() 返回区间内本线程的分配次数，all_threads() 为全部线程
+    class Alloc_audit_scope
+    {
+    public:
+        Alloc_audit_scope()
+            : thread_start(alloc_audit::thread_count()),
+              total_start(alloc_audit::state().total.load(std::memory_order_relaxed))
+        {
+            alloc_audit::state().active.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        ~Alloc_audit_scope() { alloc_audit::state().active.fetch_sub(1, std::memory_order_relaxed); }
+
+        Alloc_audit_scope(const Alloc_audit_scope &) = delete;
+        Alloc_audit_scope &operator=(const Alloc_audit_scope &) = delete;
+
+        uint64_t allocations() const { return alloc_audit::thread_count() - thread_start; }
+        uint64_t all_threads() const
+        {
+            return alloc_audit::state().total.load(std::memory_order_relaxed) - total_start;
+        }
+
+    private:
+        uint64_t thread_start;
+        uint64_t total_start;
+    };
+} // namespace unify_link
+
+#if defined(UNIFY_LINK_ALLOC_AUDIT_IMPLEMENT)
+
+namespace unify_link::alloc_audit
+{
+    inline void *counted_alloc(std::size_t size)
+    {
+        on_allocation(size);
+        if (void *p = std::malloc(size != 0 ? size : 1))
+            return p;
+        throw std::bad_alloc();
+    }
+
+    inline void *counted_aligned_alloc(std::size_t size, std::align_val_t align)
+    {
+        on_allocation(size);
+        const std::size_t a = static_cast<std::size_t>(align);
+#if defined(_WIN32)
+        void *p = _aligned_malloc(size != 0 ? size : 1, a); // MSVC 没有 std::aligned_alloc
+#else
+        void *p = std::aligned_alloc(a, (size + a - 1) / a * a);
+#endif
+        if (p == nullptr)
+            throw std::bad_alloc();
+        return p;
+    }
+
+    // 与 counted_aligned_alloc 配对：_aligned_malloc 的内存必须由 _aligned_free 释放
+    inline void aligned_free(void *p) noexcept
+    {
+#if defined(_WIN32)
+        _aligned_free(p);
+#else
+        std::free(p);
+#endif
+    }
+
+    [[maybe_unused]] static const bool hook_installed = (hooked() = true);
+} // namespace unify_link::alloc_audit
+
+void *operator new(std::size_t size) { return unify_link::alloc_audit::counted_alloc(size); }
+void *operator new[](std::size_t size) { return unify_link::alloc_audit::counted_alloc(size); }
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    try
+    {
+        return unify_link::alloc_audit::counted_alloc(size);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+void *operator new[](std::size_t size, const std::nothrow_t &tag) noexcept { return operator new(size, tag); }
+void *operator new(std::size_t size, std::align_val_t align)
+{
+    return unify_link::alloc_audit::counted_aligned_alloc(size, align);
+}
+void *operator new[](std::size_t size, std::align_val_t align)
+{
+    return unify_link::alloc_audit::counted_aligned_alloc(size, align);
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { unify_link::alloc_audit::aligned_free(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { unify_link::alloc_audit::aligned_free(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept { unify_link::alloc_audit::aligned_free(p); }
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept { unify_link::alloc_audit::aligned_free(p); }
+
+#endif // UNIFY_LINK_ALLOC_AUDIT_IMPLEMENT
+
+#endif // UNIFY_LINK_ALLOC_AUDIT_HPP
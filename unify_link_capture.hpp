@@ -0,0 +1,600 @@
+#ifndef UNIFY_LINK_CAPTURE_HPP
+#define UNIFY_LINK_CAPTURE_HPP
+
+// 链路流量录制 / 回放（主机端，POSIX）：
+//   Capture_writer 把收 / 发的原始字节块与解码出的帧边界连同时间戳追加写入文件；
+//   Capture_reader 以 mmap 只读打开，按记录遍历或按时间定位，replay() 把接收字节按原始节奏或全速喂给链路。
+//
+// 文件格式（小端，全部结构体紧凑排列）：
+//   capture_file_head_t
+//   { capture_chunk_head_t + records... }*        记录按块写入，块是追加与定位的单位
+//   capture_index_entry_t[chunk_count] + capture_index_tail_t   正常关闭时写入的块索引
+// 进程意外退出时没有索引，读取端从文件头起逐块扫描，丢弃不完整的尾块。
+
+#if !defined(__unix__) && !defined(__APPLE__)
+#error "unify_link_capture.hpp needs POSIX file and mmap APIs"
+#endif
+
+#include "unify_link.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <functional>
+#include <mutex>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace unify_link
+{
+    enum class Capture_record_type : uint8_t
+    {
+        RX = 1,    // 接收到的原始字节
+        TX = 2,    // 发出的原始字节
+        FRAME = 3, // 接收端解析出的 CRC 正确帧：数据为 8 字节帧头（载荷在 RX 字节中）
+    };
+
+#pragma pack(push, 1)
+    struct capture_file_head_t
+    {
+        char magic[8];           // "ULCAP\0\0\0"
+        uint16_t version;        // 1
+        uint16_t reserved;
+        uint32_t chunk_size;     // 写入端的块大小上限
+        uint64_t start_unix_ns;  // 录制开始的墙上时间，记录时间戳相对于此刻（单调时钟）
+    };
+
+    struct capture_chunk_head_t
+    {
+        uint32_t magic;    // kChunkMagic
+        uint32_t bytes;    // 块内记录的总字节数（不含本结构体）
+        uint32_t records;  // 记录条数
+        uint64_t first_ns; // 第一条记录的时间戳
+        uint64_t last_ns;  // 最后一条记录的时间戳
+    };
+
+    struct capture_record_head_t
+    {
+        uint64_t time_ns; // 相对录制开始
+        uint16_t length;  // 数据字节数（超过 65535 的字节块拆为多条记录）
+        uint8_t type;     // Capture_record_type
+        uint8_t reserved;
+    };
+
+    struct capture_index_entry_t
+    {
+        uint64_t offset;   // 块头在文件中的偏移
+        uint64_t first_ns; // 该块第一条记录的时间戳
+    };
+
+    struct capture_index_tail_t
+    {
+        uint32_t magic;        // kIndexMagic
+        uint32_t chunk_count;
+        uint64_t index_offset; // 第一条 capture_index_entry_t 的偏移
+    };
+#pragma pack(pop)
+
+    static_assert(sizeof(capture_file_head_t) == 24, "capture_file_head_t must be 24 bytes");
+    static_assert(sizeof(capture_chunk_head_t) == 28, "capture_chunk_head_t must be 28 bytes");
+    static_assert(sizeof(capture_record_head_t) == 12, "capture_record_head_t must be 12 bytes");
+
+    namespace detail
+    {
+        constexpr char kCaptureMagic[8] = {'U', 'L', 'C', 'A', 'P', 0, 0, 0};
+        constexpr uint16_t kCaptureVersion = 1;
+        constexpr uint32_t kChunkMagic = 0x4B434C55; // "ULCK"
+        constexpr uint32_t kIndexMagic = 0x58494C55; // "ULIX"
+    } // namespace detail
+
+    class Capture_writer
+    {
+    public:
+        static constexpr uint32_t kDefaultChunkSize = 64 * 1024;
+
+        Capture_writer() = default;
+        ~Capture_writer() { close(); }
+
+        Capture_writer(const Capture_writer &) = delete;
+        Capture_writer &operator=(const Capture_writer &) = delete;
+
+        // 创建（覆盖）文件；失败时返回 false，last_error() 为 errno
+        bool open(const char *path, uint32_t chunk_size = kDefaultChunkSize)
+        {
+            close();
+            std::lock_guard<std::mutex> lock(mutex);
+            fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+            if (fd < 0)
+                return _fail();
+
+            this->chunk_size = std::max<uint32_t>(chunk_size, 256); // 超过块大小的单条记录独占一个块
+            chunk.reserve(this->chunk_size);
+            index.clear();
+            start = std::chrono::steady_clock::now();
+
+            capture_file_head_t head{};
+            std::memcpy(head.magic, detail::kCaptureMagic, sizeof(head.magic));
+            head.version = detail::kCaptureVersion;
+            head.chunk_size = this->chunk_size;
+            head.start_unix_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                           std::chrono::system_clock::now().time_since_epoch())
+                                                           .count());
+            file_size = 0;
+            return _write(&head, sizeof(head));
+        }
+
+        // 写出当前块与索引并关闭
+        bool close()
+        {
+            detach_frames();
+            std::lock_guard<std::mutex> lock(mutex);
+            if (fd < 0)
+                return true;
+
+            bool ok = _flush_chunk();
+            if (ok && !index.empty())
+            {
+                capture_index_tail_t tail{detail::kIndexMagic, static_cast<uint32_t>(index.size()), file_size};
+                ok = _write(index.data(), index.size() * sizeof(capture_index_entry_t)) && _write(&tail, sizeof(tail));
+            }
+            ::close(fd);
+            fd = -1;
+            return ok;
+        }
+
+        bool is_open() const { return fd >= 0; }
+        int last_error() const { return error; }
+        uint64_t records() const { return record_count; }
+
+        // 线程安全：收 / 发线程与解析线程可同时记录
+        void rx(const uint8_t *data, uint32_t len) { _record_bytes(Capture_record_type::RX, data, len); }
+        void tx(const uint8_t *data, uint32_t len) { _record_bytes(Capture_record_type::TX, data, len); }
+
+        void frame(const unify_link_frame_head_t &head)
+        {
+            _record(Capture_record_type::FRAME, reinterpret_cast<const uint8_t *>(&head), sizeof(head));
+        }
+
+        // 接入链路的原始帧观察（与 Link_monitor_t 等其他观察者并存），记录每个帧边界；close() 时摘除
+        template <typename Link>
+        void attach_frames(Link &link)
+        {
+            detach_frames();
+            tap_node.tap = [this](const unify_link_frame_head_t &head, const uint8_t *, uint16_t) { frame(head); };
+            link.add_frame_tap(tap_node);
+            detach = [&link, this]() { link.remove_frame_tap(tap_node); };
+        }
+
+        void detach_frames()
+        {
+            if (detach)
+                detach();
+            detach = nullptr;
+        }
+
+        // 传输层原始字节观察（Serial_transport_t::set_byte_tap）
+        std::function<void(bool, const uint8_t *, uint32_t)> byte_tap()
+        {
+            return [this](bool is_tx, const uint8_t *data, uint32_t len) { is_tx ? tx(data, len) : rx(data, len); };
+        }
+
+        // 把已缓冲的记录作为一个完整块写入文件（例如定时调用，保证崩溃时至多丢失最近一段）
+        bool flush()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return fd >= 0 && _flush_chunk();
+        }
+
+    private:
+        void _record_bytes(Capture_record_type type, const uint8_t *data, uint32_t len)
+        {
+            while (len != 0)
+            {
+                const uint16_t part = static_cast<uint16_t>(std::min<uint32_t>(len, 0xFFFF));
+                _record(type, data, part);
+                data += part;
+                len -= part;
+            }
+        }
+
+        void _record(Capture_record_type type, const uint8_t *data, uint16_t len)
+        {
+            const uint64_t now = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (fd < 0)
+                return;
+            if (chunk.size() + sizeof(capture_record_head_t) + len > chunk_size && !_flush_chunk())
+                return;
+
+            if (chunk_records == 0)
+                chunk_first = now;
+            chunk_last = now;
+            chunk_records++;
+            record_count++;
+
+            const capture_record_head_t head{now, len, static_cast<uint8_t>(type), 0};
+            const auto *h = reinterpret_cast<const uint8_t *>(&head);
+            chunk.insert(chunk.end(), h, h + sizeof(head));
+            chunk.insert(chunk.end(), data, data + len);
+        }
+
+        bool _flush_chunk()
+        {
+            if (chunk_records == 0)
+                return true;
+
+            const capture_chunk_head_t head{detail::kChunkMagic, static_cast<uint32_t>(chunk.size()), chunk_records,
+                                            chunk_first, chunk_last};
+            index.push_back({file_size, chunk_first});
+
+            iovec iov[2] = {{const_cast<capture_chunk_head_t *>(&head), sizeof(head)}, {chunk.data(), chunk.size()}};
+            size_t total = sizeof(head) + chunk.size();
+            size_t done = 0;
+            while (done < total)
+            {
+                const ssize_t n = ::writev(fd, iov, 2);
+                if (n < 0 && errno == EINTR)
+                    continue;
+                if (n <= 0)
+                    return _fail();
+                done += static_cast<size_t>(n);
+                // 部分写入：推进 iovec
+                size_t skip = static_cast<size_t>(n);
+                for (iovec &v : iov)
+                {
+                    const size_t used = std::min(skip, v.iov_len);
+                    v.iov_base = static_cast<uint8_t *>(v.iov_base) + used;
+                    v.iov_len -= used;
+                    skip -= used;
+                }
+            }
+            file_size += total;
+            chunk.clear();
+            chunk_records = 0;
+            return true;
+        }
+
+        bool _write(const void *data, size_t len)
+        {
+            const auto *p = static_cast<const uint8_t *>(data);
+            while (len != 0)
+            {
+                const ssize_t n = ::write(fd, p, len);
+                if (n < 0 && errno == EINTR)
+                    continue;
+                if (n <= 0)
+                    return _fail();
+                p += n;
+                len -= static_cast<size_t>(n);
+                file_size += static_cast<uint64_t>(n);
+            }
+            return true;
+        }
+
+        bool _fail()
+        {
+            error = errno;
+            return false;
+        }
+
+        std::mutex mutex;
+        int fd = -1;
+        int error = 0;
+        uint32_t chunk_size = kDefaultChunkSize;
+        std::chrono::steady_clock::time_point start{};
+
+        std::vector<uint8_t> chunk;
+        uint32_t chunk_records = 0;
+        uint64_t chunk_first = 0;
+        uint64_t chunk_last = 0;
+        uint64_t file_size = 0;
+        uint64_t record_count = 0;
+        std::vector<capture_index_entry_t> index;
+        std::function<void()> detach;
+        frame_tap_node_t tap_node;
+    };
+
+    class Capture_reader
+    {
+    public:
+        // 指向映射内存的记录视图，reader 关闭前有效
+        struct record_t
+        {
+            Capture_record_type type;
+            uint64_t time_ns;
+            const uint8_t *data;
+            uint16_t length;
+        };
+
+        struct replay_stats_t
+        {
+            uint64_t records = 0;
+            uint64_t rx_bytes = 0;
+            uint64_t tx_bytes = 0;
+            uint64_t captured_frames = 0; // 录制时解析出的帧数，可与回放后的 stats.rx_frames 对比
+            double elapsed_s = 0;
+        };
+
+        Capture_reader() = default;
+        ~Capture_reader() { close(); }
+
+        Capture_reader(const Capture_reader &) = delete;
+        Capture_reader &operator=(const Capture_reader &) = delete;
+
+        // 只读映射文件并建立块表；格式不符时返回 false，last_error() 为 EINVAL
+        bool open(const char *path)
+        {
+            close();
+            const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+                return _fail(errno);
+
+            struct stat st{};
+            if (::fstat(fd, &st) < 0 || st.st_size < static_cast<off_t>(sizeof(capture_file_head_t)))
+            {
+                const int err = errno != 0 ? errno : EINVAL;
+                ::close(fd);
+                return _fail(err);
+            }
+
+            void *map = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+            if (map == MAP_FAILED)
+                return _fail(errno);
+            base = static_cast<const uint8_t *>(map);
+            size = static_cast<size_t>(st.st_size);
+            ::madvise(map, size, MADV_SEQUENTIAL);
+
+            std::memcpy(&head, base, sizeof(head));
+            if (std::memcmp(head.magic, detail::kCaptureMagic, sizeof(head.magic)) != 0 ||
+                head.version != detail::kCaptureVersion)
+            {
+                close();
+                return _fail(EINVAL);
+            }
+
+            if (!_load_index())
+                _scan_chunks();
+            rewind();
+            return true;
+        }
+
+        void close()
+        {
+            if (base != nullptr)
+                ::munmap(const_cast<uint8_t *>(base), size);
+            base = nullptr;
+            size = 0;
+            chunks.clear();
+        }
+
+        bool is_open() const { return base != nullptr; }
+        int last_error() const { return error; }
+        const capture_file_head_t &file_head() const { return head; }
+        size_t chunk_count() const { return chunks.size(); }
+        bool indexed() const { return has_index; } // false：文件未正常关闭，块表由扫描得到
+
+        uint64_t record_count() const
+        {
+            uint64_t n = 0;
+            for (const chunk_t &c : chunks)
+                n += c.records;
+            return n;
+        }
+
+        uint64_t duration_ns() const { return chunks.empty() ? 0 : chunks.back().last_ns - chunks.front().first_ns; }
+
+        void rewind()
+        {
+            chunk_pos = 0;
+            record_pos = 0;
+        }
+
+        // 定位到第一条时间戳 >= time_ns 的记录所在块（按块索引二分，再在块内顺序前进）
+        void seek(uint64_t time_ns)
+        {
+            auto it = std::upper_bound(chunks.begin(), chunks.end(), time_ns,
+                                       [](uint64_t t, const chunk_t &c) { return t < c.first_ns; });
+            chunk_pos = it == chunks.begin() ? 0 : static_cast<size_t>(it - chunks.begin()) - 1;
+            record_pos = 0;
+
+            if (chunk_pos >= chunks.size())
+                return;
+            const chunk_t &c = chunks[chunk_pos];
+            capture_record_head_t rh;
+            while (_record_at(c, record_pos, &rh))
+            {
+                if (rh.time_ns >= time_ns)
+                    return;
+                record_pos += sizeof(rh) + rh.length;
+            }
+            record_pos = c.bytes; // 块尾或损坏的记录：从下一块继续
+        }
+
+        bool next(record_t *out)
+        {
+            while (chunk_pos < chunks.size())
+            {
+                const chunk_t &c = chunks[chunk_pos];
+                capture_record_head_t rh;
+                if (_record_at(c, record_pos, &rh))
+                {
+                    out->type = static_cast<Capture_record_type>(rh.type);
+                    out->time_ns = rh.time_ns;
+                    out->data = base + c.data + record_pos + sizeof(rh);
+                    out->length = rh.length;
+                    record_pos += sizeof(rh) + rh.length;
+                    return true;
+                }
+                chunk_pos++; // 块尾，或记录越出块（损坏 / 非本格式的数据）时放弃该块剩余部分
+                record_pos = 0;
+            }
+            return false;
+        }
+
+        // 从当前位置回放到文件末尾：RX 字节按接收环的空闲空间分段 push，并在每段后 parse_data_task()
+        // speed > 0 时按原始时间间隔 / speed 等待，0 表示全速
+        template <typename Link>
+        replay_stats_t replay(Link &link, double speed = 0.0)
+        {
+            replay_stats_t stats;
+            const auto wall_start = std::chrono::steady_clock::now();
+            bool have_first = false;
+            uint64_t first_ns = 0;
+
+            record_t r;
+            while (next(&r))
+            {
+                stats.records++;
+                if (speed > 0)
+                {
+                    if (!have_first)
+                    {
+                        first_ns = r.time_ns;
+                        have_first = true;
+                    }
+                    const auto offset = std::chrono::nanoseconds(static_cast<int64_t>((r.time_ns - first_ns) / speed));
+                    std::this_thread::sleep_until(wall_start + offset);
+                }
+
+                switch (r.type)
+                {
+                case Capture_record_type::RX:
+                    stats.rx_bytes += r.length;
+                    feed(link, r.data, r.length);
+                    break;
+                case Capture_record_type::TX:
+                    stats.tx_bytes += r.length;
+                    break;
+                case Capture_record_type::FRAME:
+                    stats.captured_frames++;
+                    break;
+                }
+            }
+            link.parse_data_task();
+            stats.elapsed_s =
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+            return stats;
+        }
+
+        // 按接收环空闲空间分段写入并解析，不产生溢出丢弃
+        template <typename Link>
+        static void feed(Link &link, const uint8_t *data, uint32_t len)
+        {
+            while (len != 0)
+            {
+                uint32_t space = link.rec_buff.remain();
+                if (space == 0)
+                {
+                    link.parse_data_task();
+                    space = link.rec_buff.remain();
+                    if (space == 0)
+                        return; // 不可能出现：整帧总能放入接收环
+                }
+                const uint32_t n = link.rev_data_push(data, std::min(len, space));
+                data += n;
+                len -= n;
+                link.parse_data_task();
+            }
+        }
+
+    private:
+        struct chunk_t
+        {
+            size_t data;  // 记录区起始偏移
+            uint32_t bytes;
+            uint32_t records;
+            uint64_t first_ns;
+            uint64_t last_ns;
+        };
+
+        bool _chunk_at(uint64_t offset, chunk_t *out) const
+        {
+            if (offset + sizeof(capture_chunk_head_t) > size)
+                return false;
+            capture_chunk_head_t ch;
+            std::memcpy(&ch, base + offset, sizeof(ch));
+            if (ch.magic != detail::kChunkMagic || offset + sizeof(ch) + ch.bytes > size)
+                return false;
+            *out = {static_cast<size_t>(offset + sizeof(ch)), ch.bytes, ch.records, ch.first_ns, ch.last_ns};
+            return true;
+        }
+
+        // 块内 pos 处的记录头；记录头或数据越出块时返回 false（块本身已由 _chunk_at() 限定在映射范围内）
+        bool _record_at(const chunk_t &c, size_t pos, capture_record_head_t *rh) const
+        {
+            if (pos >= c.bytes || c.bytes - pos < sizeof(*rh))
+                return false;
+            std::memcpy(rh, base + c.data + pos, sizeof(*rh));
+            return rh->length <= c.bytes - pos - sizeof(*rh);
+        }
+
+        bool _load_index()
+        {
+            has_index = false;
+            if (size < sizeof(capture_file_head_t) + sizeof(capture_index_tail_t))
+                return false;
+
+            capture_index_tail_t tail;
+            std::memcpy(&tail, base + size - sizeof(tail), sizeof(tail));
+            if (tail.magic != detail::kIndexMagic ||
+                tail.index_offset + static_cast<uint64_t>(tail.chunk_count) * sizeof(capture_index_entry_t) +
+                        sizeof(tail) != size)
+                return false;
+
+            chunks.clear();
+            chunks.reserve(tail.chunk_count);
+            for (uint32_t i = 0; i < tail.chunk_count; ++i)
+            {
+                capture_index_entry_t entry;
+                std::memcpy(&entry, base + tail.index_offset + i * sizeof(entry), sizeof(entry));
+                chunk_t c;
+                if (!_chunk_at(entry.offset, &c))
+                {
+                    chunks.clear();
+                    return false;
+                }
+                chunks.push_back(c);
+            }
+            has_index = true;
+            return true;
+        }
+
+        void _scan_chunks()
+        {
+            chunks.clear();
+            uint64_t offset = sizeof(capture_file_head_t);
+            chunk_t c;
+            while (_chunk_at(offset, &c))
+            {
+                chunks.push_back(c);
+                offset = c.data + c.bytes;
+            }
+        }
+
+        bool _fail(int err)
+        {
+            error = err;
+            return false;
+        }
+
+        const uint8_t *base = nullptr;
+        size_t size = 0;
+        int error = 0;
+        bool has_index = false;
+        capture_file_head_t head{};
+        std::vector<chunk_t> chunks;
+        size_t chunk_pos = 0;
+        size_t record_pos = 0;
+    };
+} // namespace unify_link
+
+#endif // UNIFY_LINK_CAPTURE_HPP
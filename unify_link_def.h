@@ -4,6 +4,7 @@
 #include <functional>
 #include <stdbool.h>
 #include <stdint.h>
+#include <type_traits>
 
 // 组件ID定义
 #define COMPONENT_ID_SYSTEM 0x00
@@ -14,12 +15,45 @@
 
 // 协议常量定义
 #define FRAME_HEADER 0xA0
+// 帧头 flags（payload_length_and_sign 高 3bit）
+#define FRAME_FLAG_BUNDLE 0x01 // 打包帧：载荷为多条 (data_id, len, payload) 记录
+#define FRAME_FLAG_ACK_REQ 0x02 // 可靠帧：载荷首字节为可靠序号，接收端以累计确认帧应答
+#define FRAME_FLAG_FRAGMENT 0x04 // 分片帧：载荷为 unify_link_fragment_head_t + 分片数据，接收端按偏移原地重组
+// 打包与分片互斥，二者组合表示带时间戳帧：载荷前 4 字节为发送端时延时钟（小端 uint32），之后为普通载荷
+#define FRAME_FLAG_TIMESTAMP (FRAME_FLAG_BUNDLE | FRAME_FLAG_FRAGMENT)
+// 链路层累计确认帧：COMPONENT_ID_SYSTEM / LINK_ACK_DATA_ID，载荷 1 字节 = 期望的下一个可靠序号
+#define LINK_ACK_DATA_ID 0xFF
+// 状态快照（unify_link_mirror.hpp）：COMPONENT_ID_SYSTEM 下的请求、清单与结束帧
+#define SNAPSHOT_REQUEST_DATA_ID 0xFC
+#define SNAPSHOT_MANIFEST_DATA_ID 0xFD
+#define SNAPSHOT_END_DATA_ID 0xFE
 #define MAX_FRAME_DATA_LENGTH 512
 #define MAX_FRAME_LENGTH (MAX_FRAME_DATA_LENGTH + sizeof(unify_link_frame_head_t))
 #define MAX_RECV_BUFF_LENGTH (MAX_FRAME_DATA_LENGTH * 4)
 #define MAX_SEND_BUFF_LENGTH (MAX_FRAME_DATA_LENGTH * 4)
 #ifndef UNIFY_LINK_MAX_HANDLERS
-#define UNIFY_LINK_MAX_HANDLERS 128
+// 每条链路分发表可注册的 (component_id, data_id) 数量（默认值，可按链路用模板参数指定）。
+// 旧版本固定为 128；表满时 register_handle_data() 返回 false，组件的 registered 为 false。
+// 电机 + 编码器 + 升级组件共占 15 项，注册更多 ID 的应用需在包含头文件前调大该值
+#define UNIFY_LINK_MAX_HANDLERS 32
+#endif
+#ifndef UNIFY_LINK_MAX_TX_RULES
+#define UNIFY_LINK_MAX_TX_RULES 16 // 可配置发送优先级 / 最新值替换的 (component_id, data_id) 数量
+#endif
+#ifndef UNIFY_LINK_RELIABLE_WINDOW
+#define UNIFY_LINK_RELIABLE_WINDOW 8 // 同时等待确认的可靠帧数量上限
+#endif
+#ifndef UNIFY_LINK_RELIABLE_STORE
+#define UNIFY_LINK_RELIABLE_STORE 0 // 每条链路保存待确认可靠帧载荷的字节数（不超过 TxSize），0 不支持可靠发送、不占 RAM
+#endif
+#ifndef UNIFY_LINK_STATS_SLOTS
+#define UNIFY_LINK_STATS_SLOTS 0 // 分 (component_id, data_id) 统计的消息数量（收、发各一张表，每个 ID 约 80 字节），0 只保留总计
+#endif
+#ifndef UNIFY_LINK_LATENCY
+#define UNIFY_LINK_LATENCY 0 // 1：启用端到端时延测量（见 unify_link_latency.hpp），0 时相关代码与存储全部不编译
+#endif
+#ifndef UNIFY_LINK_LATENCY_SLOTS
+#define UNIFY_LINK_LATENCY_SLOTS 8 // 记录时延直方图的 (component_id, data_id) 数量（收、发各一张表）
 #endif
 
 namespace unify_link
@@ -63,11 +97,36 @@ namespace unify_link
 
     static_assert(sizeof(unify_link_frame_head_t) == 8, "unify_link_frame_head_t must be 8 bytes");
 
+    // 分片帧载荷头：超过单帧载荷上限的消息按序切分，offset 为本片在整条消息中的位置
+    struct unify_link_fragment_head_t
+    {
+        uint16_t total_length; // 整条消息长度
+        uint16_t offset;       // 本片偏移
+    };
+
+    static_assert(sizeof(unify_link_fragment_head_t) == 4, "unify_link_fragment_head_t must be 4 bytes");
+
     // 回调函数类型定义：处理数据载荷，返回是否成功
     // 参数：数据指针、长度
     // 返回值：true 表示处理成功，false 表示失败
     // 使用 std::function 支持普通函数、lambda、成员函数绑定
     using handle_data_func_t = std::function<bool(const uint8_t *, uint16_t)>;
+
+    // 原始帧观察回调：帧头、完整载荷（打包 / 分片 / 时间戳帧不拆开）、载荷长度
+    using frame_tap_func_t = std::function<void(const unify_link_frame_head_t &, const uint8_t *, uint16_t)>;
+
+    // 可叠加的帧观察者节点（侵入式链表，见 add_frame_tap()），由观察者对象持有
+    struct frame_tap_node_t
+    {
+        frame_tap_func_t tap;
+        frame_tap_node_t *next = nullptr;
+    };
+
+    // 用户提供的单调时钟（单位由使用者决定，例如 HAL_GetTick() 的毫秒），用于打包发送的超时等
+    using clock_fn_t = uint32_t (*)();
+
+    // 统计计数器：64 位平台为 uint64_t，32 位 MCU 上为无锁的 uint32_t（会回绕，按差值使用）
+    using stat_value_t = std::conditional_t<(sizeof(void *) >= 8), uint64_t, uint32_t>;
     struct registered_item_t
     {
         handle_data_func_t callback;
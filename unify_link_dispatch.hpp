@@ -0,0 +1,274 @@
+#ifndef UNIFY_LINK_DISPATCH_HPP
+#define UNIFY_LINK_DISPATCH_HPP
+
+// 按组件并行分发（主机端）：把一个组件的全部处理函数从解析线程移到该组件专属的执行线程。
+//   解析线程：校验长度后把载荷拷入帧池（Frame_pool_t，全部通道共享、预分配）中的一个槽，
+//             把槽号放入该组件的 SPSC 队列，不调用用户代码；队列满或池耗尽时丢弃该帧并计数，解析从不阻塞
+//   执行线程：按到达顺序取出槽号，在槽内原地执行原 dst 拷贝与回调，然后归还槽
+// 因此一个组件的慢回调（例如 Python 的 on_motor_info_updated）只会积压它自己的队列，
+// 其他组件（例如仍在解析线程上处理的 MOTOR_BASIC_ID）与解码本身不受影响；同一组件内的帧保持顺序。
+//
+// 约束：
+//   - offload() 在组件完成注册之后、开始解析之前调用（会改写链路的分发表）
+//   - 被移走组件的 dst 由执行线程写入；对该组件的请求帧（零长度）仍在解析线程按 dst 当前内容应答
+//   - 载荷超过帧槽（MAX_FRAME_DATA_LENGTH）的消息（分片重组）不应移走：其 ID 需要解析线程上的 dst
+//   - PoolSlots >= 通道数 × LaneDepth 时，慢通道占满自己的队列也不会耗尽其他通道可用的槽
+//   - 析构时停止线程、处理完剩余记录并恢复原处理函数
+
+#include "unify_link.hpp"
+#include "unify_link_pool.hpp"
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+namespace unify_link
+{
+    template <typename Link, uint16_t PoolSlots = 256, uint32_t LaneDepth = 32, uint8_t MaxLanes = 8>
+    class Parallel_dispatcher_t
+    {
+
+    public:
+        struct lane_stats_t
+        {
+            uint64_t enqueued = 0;
+            uint64_t dispatched = 0;
+            uint64_t dropped = 0;  // 队列满（执行线程跟不上）或帧池耗尽而丢弃的帧
+            uint64_t failed = 0;   // 原处理函数返回 false
+            uint32_t high_water = 0; // 队列最高排队帧数
+        };
+
+        explicit Parallel_dispatcher_t(Link &link) : link(link) {}
+
+        ~Parallel_dispatcher_t()
+        {
+            stop();
+            restore();
+        }
+
+        Parallel_dispatcher_t(const Parallel_dispatcher_t &) = delete;
+        Parallel_dispatcher_t &operator=(const Parallel_dispatcher_t &) = delete;
+
+        // 把 component_id 下已注册的处理函数移到独立执行线程；未注册任何处理函数、通道已满或已启动时返回 false
+        bool offload(uint8_t component_id)
+        {
+            if (started || lane_count >= MaxLanes || _lane_of(component_id) != nullptr)
+                return false;
+
+            auto lane = std::make_unique<lane_t>();
+            lane->component_id = component_id;
+            uint16_t moved = 0;
+            for (uint16_t data_id = 0; data_id < 256; ++data_id)
+            {
+                registered_item_t *item = link.registered_table.find(component_id, static_cast<uint8_t>(data_id));
+                if (item == nullptr)
+                    continue;
+
+                lane->original[data_id] = *item;
+                lane->moved[data_id] = true;
+                item->dst = nullptr;          // 拷贝移到执行线程
+                item->payload_length = 0xFFFF; // 请求帧与长度检查由 _enqueue() 按原注册项处理
+                item->callback = [this, lane = lane.get(), data_id = static_cast<uint8_t>(data_id)](
+                                     const uint8_t *data, uint16_t len) { return _enqueue(*lane, data_id, data, len); };
+                moved++;
+            }
+            if (moved == 0)
+                return false;
+
+            lanes[lane_count++] = std::move(lane);
+            return true;
+        }
+
+        // 为每个通道启动执行线程
+        bool start()
+        {
+            if (started)
+                return true;
+            running.store(true, std::memory_order_release);
+            for (uint8_t i = 0; i < lane_count; ++i)
+                lanes[i]->thread = std::thread([this, lane = lanes[i].get()] { _executor_loop(*lane); });
+            started = true;
+            return true;
+        }
+
+        // 停止执行线程；已入队的记录在线程退出前全部处理
+        void stop()
+        {
+            if (!started)
+                return;
+            running.store(false, std::memory_order_release);
+            for (uint8_t i = 0; i < lane_count; ++i)
+            {
+                lanes[i]->signal.fetch_add(1, std::memory_order_seq_cst);
+                lanes[i]->signal.notify_one();
+            }
+            for (uint8_t i = 0; i < lane_count; ++i)
+                if (lanes[i]->thread.joinable())
+                    lanes[i]->thread.join();
+            started = false;
+        }
+
+        // 等待所有已入队的记录处理完毕（测试或请求 / 应答同步点）
+        void flush() const
+        {
+            for (uint8_t i = 0; i < lane_count; ++i)
+            {
+                const lane_t &lane = *lanes[i];
+                while (started && lane.dispatched.load(std::memory_order_acquire) < lane.stats_enqueued.get())
+                    std::this_thread::yield();
+            }
+        }
+
+        // 恢复链路上的原处理函数（需已 stop()）
+        void restore()
+        {
+            if (started)
+                return;
+            for (uint8_t i = 0; i < lane_count; ++i)
+            {
+                lane_t &lane = *lanes[i];
+                for (uint16_t data_id = 0; data_id < 256; ++data_id)
+                {
+                    if (!lane.moved[data_id])
+                        continue;
+                    registered_item_t *item = link.registered_table.find(lane.component_id, static_cast<uint8_t>(data_id));
+                    if (item != nullptr)
+                        *item = std::move(lane.original[data_id]);
+                    lane.moved[data_id] = false;
+                }
+            }
+            lane_count = 0;
+        }
+
+        // 任意线程读取
+        bool stats(uint8_t component_id, lane_stats_t *out) const
+        {
+            const lane_t *lane = _lane_of(component_id);
+            if (lane == nullptr)
+                return false;
+            out->enqueued = lane->stats_enqueued.get();
+            out->dispatched = lane->dispatched.load(std::memory_order_relaxed);
+            out->dropped = lane->stats_dropped.get();
+            out->failed = lane->stats_failed.get();
+            out->high_water = lane->high_water.load(std::memory_order_relaxed);
+            return true;
+        }
+
+        bool running_threads() const { return started; }
+        uint8_t lane_total() const { return lane_count; }
+
+        using pool_type = Frame_pool_t<PoolSlots>;
+        const pool_type &frame_pool() const { return pool; }
+
+    private:
+        struct lane_t
+        {
+            uint8_t component_id = 0;
+            std::array<registered_item_t, 256> original{};
+            std::array<bool, 256> moved{};
+
+            Spsc_ring_buffer<uint16_t, LaneDepth> queue; // 帧池槽号
+            std::atomic<uint32_t> signal{0}; // 生产者每次入队后递增，执行线程在其上等待
+
+            stat_counter_t stats_enqueued;   // 解析线程写
+            stat_counter_t stats_dropped;    // 解析线程写
+            std::atomic<uint64_t> dispatched{0}; // 执行线程写（release：flush() 之后可见回调的写入）
+            stat_counter_t stats_failed;     // 执行线程写
+            std::atomic<uint32_t> high_water{0};
+
+            std::thread thread;
+        };
+
+        const lane_t *_lane_of(uint8_t component_id) const
+        {
+            for (uint8_t i = 0; i < lane_count; ++i)
+                if (lanes[i]->component_id == component_id)
+                    return lanes[i].get();
+            return nullptr;
+        }
+
+        // 解析线程
+        bool _enqueue(lane_t &lane, uint8_t data_id, const uint8_t *data, uint16_t len)
+        {
+            const registered_item_t &original = lane.original[data_id];
+            if (len == 0 && original.dst != nullptr)
+                return link.build_send_data(lane.component_id, data_id, static_cast<const uint8_t *>(original.dst),
+                                            original.payload_length) != 0; // 请求帧
+
+            if (original.payload_length != 0xFFFF && original.payload_length != len)
+            {
+                link.stats.on_length_error(lane.component_id, data_id);
+                return false;
+            }
+
+            const auto seg = lane.queue.reserve(1);
+            auto frame = seg.size() != 0 ? pool.acquire_copy(lane.component_id, data_id, data, len)
+                                         : typename pool_type::Frame_ref{};
+            if (!frame)
+            {
+                lane.stats_dropped.add();
+                return true; // 帧本身有效；丢弃单独计数
+            }
+
+            *seg.ptr[0] = frame.detach();
+            lane.queue.commit(1);
+            lane.stats_enqueued.add();
+
+            const uint32_t used = lane.queue.used();
+            if (used > lane.high_water.load(std::memory_order_relaxed))
+                lane.high_water.store(used, std::memory_order_relaxed);
+
+            lane.signal.fetch_add(1, std::memory_order_seq_cst);
+            lane.signal.notify_one();
+            return true;
+        }
+
+        // 执行线程
+        void _executor_loop(lane_t &lane)
+        {
+            while (true)
+            {
+                const uint32_t seen = lane.signal.load(std::memory_order_seq_cst);
+                const bool more = running.load(std::memory_order_acquire);
+                while (_dispatch_one(lane))
+                {
+                }
+                if (!more)
+                    return; // 停止前已取空队列
+                lane.signal.wait(seen, std::memory_order_seq_cst);
+            }
+        }
+
+        bool _dispatch_one(lane_t &lane)
+        {
+            const uint16_t *slot = lane.queue.peek(1);
+            if (slot == nullptr)
+                return false;
+
+            const auto &frame = pool.frame(*slot);
+            const registered_item_t &original = lane.original[frame.data_id];
+            if (original.dst != nullptr)
+                std::memcpy(original.dst, frame.data, frame.length);
+            const bool ok = !original.callback || original.callback(frame.data, frame.length);
+
+            pool.release(*slot);
+            lane.queue.pop_data(1);
+            if (!ok)
+                lane.stats_failed.add();
+            lane.dispatched.store(lane.dispatched.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+            return true;
+        }
+
+        Link &link;
+        pool_type pool;
+        std::array<std::unique_ptr<lane_t>, MaxLanes> lanes{};
+        uint8_t lane_count = 0;
+        std::atomic<bool> running{false};
+        bool started = false;
+    };
+
+    using Parallel_dispatcher = Parallel_dispatcher_t<Unify_link_base>;
+} // namespace unify_link
+
+#endif // UNIFY_LINK_DISPATCH_HPP
@@ -0,0 +1,360 @@
+#ifndef UNIFY_LINK_HUB_HPP
+#define UNIFY_LINK_HUB_HPP
+
+// 多链路集线器（主机端，Linux，CMake: UNIFY_LINK_BUILD_SERIAL）：持有 N 条链路及其传输层，
+// 把它们的 fd 分配到少量工作线程的 epoll 上。每条链路固定由一个工作线程处理（收、发、周期任务都在该线程），
+// 链路内部的 SPSC 环形缓冲区因此保持单生产者/单消费者；工作线程只运行 C++ 代码，不需要 GIL。
+
+#include "unify_link_serial.hpp"
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace unify_link
+{
+    template <typename Link>
+    class Link_hub_t
+    {
+    public:
+        using transport_type = Serial_transport_t<Link>;
+        using task_t = std::function<void(Link &)>;
+
+        // 工作线程每轮结束时发布的快照，其他线程可随时读取
+        struct link_stats_t
+        {
+            uint64_t rx_bytes = 0;
+            uint64_t tx_bytes = 0;
+            uint64_t success_count = 0;
+            uint64_t com_error_count = 0;
+            uint64_t decode_error_count = 0;
+            uint64_t resync_count = 0;
+            bool open = false;
+            int error = 0; // 传输层出错时的 errno，此后该链路不再被轮询
+        };
+
+        // tick_ms：无 I/O 时的最长等待，决定打包超时 / 重传等周期任务的精度
+        explicit Link_hub_t(unsigned worker_count = 1, int tick_ms = 5) : tick_ms(tick_ms)
+        {
+            if (worker_count == 0)
+                worker_count = 1;
+            for (unsigned i = 0; i < worker_count; ++i)
+                workers.emplace_back(std::make_unique<worker_t>());
+        }
+
+        ~Link_hub_t()
+        {
+            stop();
+            for (auto &w : workers)
+            {
+                if (w->epfd >= 0)
+                    ::close(w->epfd);
+                if (w->wake_fd >= 0)
+                    ::close(w->wake_fd);
+            }
+        }
+
+        Link_hub_t(const Link_hub_t &) = delete;
+        Link_hub_t &operator=(const Link_hub_t &) = delete;
+
+        // 添加串口 / 已打开的 fd（socket、pty 等）：仅在 start() 之前调用；返回链路编号，失败返回 -1（见 last_error()）
+        int add_port(const char *path, const typename transport_type::options_t &options = {})
+        {
+            auto entry = std::make_unique<entry_t>();
+            if (running() || !entry->transport.open(path, options, false))
+                return _reject(entry->transport.last_error());
+            return _adopt(std::move(entry));
+        }
+
+        int add_fd(int fd)
+        {
+            auto entry = std::make_unique<entry_t>();
+            if (running() || !entry->transport.attach(fd, false))
+                return _reject(entry->transport.last_error());
+            return _adopt(std::move(entry));
+        }
+
+        size_t size() const { return entries.size(); }
+        unsigned worker_count() const { return static_cast<unsigned>(workers.size()); }
+        int last_error() const { return error; }
+
+        // 链路对象：start() 之后只应在其工作线程内访问（见 post()），组件可在 start() 之前绑定到它
+        Link &link(size_t i) { return entries[i]->link; }
+        transport_type &transport(size_t i) { return entries[i]->transport; }
+        unsigned worker_of(size_t i) const { return entries[i]->worker; }
+
+        bool start()
+        {
+            if (running())
+                return true;
+
+            stopping.store(false, std::memory_order_release);
+            for (auto &w : workers)
+            {
+                if (!_setup_worker(*w))
+                {
+                    stop();
+                    return false;
+                }
+            }
+            for (auto &w : workers)
+                w->thread = std::thread([this, worker = w.get()] { _worker_loop(*worker); });
+            started = true;
+            return true;
+        }
+
+        void stop()
+        {
+            if (!started)
+                return;
+
+            stopping.store(true, std::memory_order_release);
+            for (auto &w : workers)
+                _wake(*w);
+            for (auto &w : workers)
+            {
+                if (w->thread.joinable())
+                    w->thread.join();
+            }
+            started = false;
+        }
+
+        bool running() const { return started; }
+
+        // 线程安全：在链路所属工作线程上执行 task（组件发送、修改配置等），随后尽快发出产生的帧。
+        // 这是其他线程发送的唯一途径：工作线程自身也向 send_buff 写入应答与确认，不能再有第二个生产者
+        void post(size_t i, task_t task)
+        {
+            entry_t *entry = entries[i].get();
+            worker_t &w = *workers[entry->worker];
+            {
+                std::lock_guard<std::mutex> lock(w.post_mutex);
+                w.posted.emplace_back(entry, std::move(task));
+            }
+            _wake(w);
+        }
+
+        link_stats_t stats(size_t i) const
+        {
+            const entry_t &e = *entries[i];
+            link_stats_t s;
+            s.rx_bytes = e.rx_bytes.load(std::memory_order_relaxed);
+            s.tx_bytes = e.tx_bytes.load(std::memory_order_relaxed);
+            s.success_count = e.link.success_count();
+            s.com_error_count = e.link.com_error_count();
+            s.decode_error_count = e.link.decode_error_count();
+            s.resync_count = e.link.resync_count();
+            s.error = e.error.load(std::memory_order_relaxed);
+            s.open = s.error == 0;
+            return s;
+        }
+
+        // 全部链路之和；open 表示所有链路都正常
+        link_stats_t total_stats() const
+        {
+            link_stats_t total;
+            total.open = true;
+            for (size_t i = 0; i < entries.size(); ++i)
+            {
+                const link_stats_t s = stats(i);
+                total.rx_bytes += s.rx_bytes;
+                total.tx_bytes += s.tx_bytes;
+                total.success_count += s.success_count;
+                total.com_error_count += s.com_error_count;
+                total.decode_error_count += s.decode_error_count;
+                total.resync_count += s.resync_count;
+                total.open = total.open && s.open;
+                if (total.error == 0)
+                    total.error = s.error;
+            }
+            return total;
+        }
+
+    private:
+        struct entry_t
+        {
+            Link link;
+            transport_type transport{link}; // 不带自身事件循环，由工作线程的 epoll 驱动
+            unsigned worker = 0;
+            bool watching_out = false;
+            bool failed = false;
+
+            std::atomic<uint64_t> rx_bytes{0};
+            std::atomic<uint64_t> tx_bytes{0};
+            std::atomic<int> error{0};
+        };
+
+        struct worker_t
+        {
+            int epfd = -1;
+            int wake_fd = -1;
+            std::thread thread;
+            std::vector<entry_t *> entries;
+
+            std::mutex post_mutex;
+            std::vector<std::pair<entry_t *, task_t>> posted;
+            std::vector<std::pair<entry_t *, task_t>> running_tasks;
+        };
+
+        int _reject(int err)
+        {
+            error = err != 0 ? err : EBUSY; // start() 之后不能再添加链路
+            return -1;
+        }
+
+        bool _sys_fail()
+        {
+            error = errno;
+            return false;
+        }
+
+        // 按链路数均衡分配：每条链路固定在一个工作线程
+        int _adopt(std::unique_ptr<entry_t> entry)
+        {
+            unsigned target = 0;
+            for (unsigned i = 1; i < workers.size(); ++i)
+            {
+                if (workers[i]->entries.size() < workers[target]->entries.size())
+                    target = i;
+            }
+            entry->worker = target;
+            workers[target]->entries.push_back(entry.get());
+            entries.push_back(std::move(entry));
+            return static_cast<int>(entries.size() - 1);
+        }
+
+        bool _setup_worker(worker_t &w)
+        {
+            if (w.epfd < 0)
+            {
+                w.epfd = ::epoll_create1(EPOLL_CLOEXEC);
+                w.wake_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+                if (w.epfd < 0 || w.wake_fd < 0)
+                    return _sys_fail();
+
+                epoll_event ev{};
+                ev.events = EPOLLIN;
+                ev.data.ptr = nullptr; // 唤醒事件
+                if (::epoll_ctl(w.epfd, EPOLL_CTL_ADD, w.wake_fd, &ev) < 0)
+                    return _sys_fail();
+
+                for (entry_t *e : w.entries)
+                {
+                    epoll_event link_ev{};
+                    link_ev.events = EPOLLIN;
+                    link_ev.data.ptr = e;
+                    if (::epoll_ctl(w.epfd, EPOLL_CTL_ADD, e->transport.native_handle(), &link_ev) < 0)
+                        return _sys_fail();
+                }
+            }
+            return true;
+        }
+
+        static void _wake(worker_t &w)
+        {
+            const uint64_t one = 1;
+            if (w.wake_fd >= 0)
+                (void)!::write(w.wake_fd, &one, sizeof(one));
+        }
+
+        void _fail(worker_t &w, entry_t &e)
+        {
+            ::epoll_ctl(w.epfd, EPOLL_CTL_DEL, e.transport.native_handle(), nullptr);
+            e.failed = true;
+            e.error.store(e.transport.last_error() != 0 ? e.transport.last_error() : EIO, std::memory_order_relaxed);
+        }
+
+        // 周期任务 + 发送，并按是否还有待发数据开关 EPOLLOUT
+        void _flush(worker_t &w, entry_t &e)
+        {
+            if (e.failed)
+                return;
+
+            e.transport.service();
+            if (e.transport.wants_write() && !e.transport.handle_writable())
+                return _fail(w, e);
+
+            const bool want_out = e.transport.wants_write();
+            if (want_out != e.watching_out)
+            {
+                epoll_event ev{};
+                ev.events = want_out ? (EPOLLIN | EPOLLOUT) : EPOLLIN;
+                ev.data.ptr = &e;
+                ::epoll_ctl(w.epfd, EPOLL_CTL_MOD, e.transport.native_handle(), &ev);
+                e.watching_out = want_out;
+            }
+        }
+
+        static void _publish(entry_t &e)
+        {
+            e.rx_bytes.store(e.transport.rx_bytes, std::memory_order_relaxed);
+            e.tx_bytes.store(e.transport.tx_bytes, std::memory_order_relaxed);
+        }
+
+        void _worker_loop(worker_t &w)
+        {
+            constexpr int kMaxEvents = 64;
+            epoll_event events[kMaxEvents];
+
+            while (!stopping.load(std::memory_order_acquire))
+            {
+                {
+                    std::lock_guard<std::mutex> lock(w.post_mutex);
+                    w.running_tasks.swap(w.posted);
+                }
+                for (auto &[entry, task] : w.running_tasks)
+                {
+                    if (!entry->failed)
+                        task(entry->link);
+                }
+                w.running_tasks.clear();
+
+                for (entry_t *e : w.entries)
+                    _flush(w, *e);
+
+                const int n = ::epoll_wait(w.epfd, events, kMaxEvents, tick_ms);
+                for (int i = 0; i < n; ++i)
+                {
+                    entry_t *e = static_cast<entry_t *>(events[i].data.ptr);
+                    if (e == nullptr)
+                    {
+                        uint64_t counter;
+                        (void)!::read(w.wake_fd, &counter, sizeof(counter));
+                        continue;
+                    }
+                    if (e->failed)
+                        continue;
+                    if ((events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) && !e->transport.handle_readable())
+                    {
+                        _fail(w, *e);
+                        continue;
+                    }
+                    if ((events[i].events & EPOLLOUT) && !e->transport.handle_writable())
+                        _fail(w, *e);
+                }
+
+                // 接收处理中产生的应答立即发出
+                for (entry_t *e : w.entries)
+                {
+                    _flush(w, *e);
+                    _publish(*e);
+                }
+            }
+        }
+
+        std::deque<std::unique_ptr<entry_t>> entries;
+        std::vector<std::unique_ptr<worker_t>> workers;
+        std::atomic<bool> stopping{false};
+        bool started = false;
+        int tick_ms;
+        int error = 0;
+    };
+
+    using Link_hub = Link_hub_t<Unify_link_base>;
+} // namespace unify_link
+
+#endif // UNIFY_LINK_HUB_HPP
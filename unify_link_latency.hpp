@@ -0,0 +1,301 @@
+#ifndef UNIFY_LINK_LATENCY_HPP
+#define UNIFY_LINK_LATENCY_HPP
+
+// 端到端时延测量（UNIFY_LINK_LATENCY=1 时由 unify_link.hpp 引入，默认不编译）
+// 时钟由 set_latency_clock() 提供（建议微秒），各阶段：
+//   TX_QUEUE  发送端：帧提交到 send_buff → 被 send_buff_consume() 交给传输层
+//   WIRE      接收端：带时间戳帧的（到达时刻 - 发送端时间戳）减去观测到的最小值，即高于最小单向时延的部分
+//   RX_QUEUE  接收端：帧的最后一个字节进入 rec_buff → 开始分发
+//   HANDLER   接收端：handle_data（含回调）耗时
+
+#include "unify_link_def.h"
+#include "unify_link_slots.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+
+namespace unify_link
+{
+    // HDR 风格对数-线性直方图：每个 2 的幂区间再线性分 8 份，相对误差 ≤ 12.5%，覆盖完整 uint32 范围
+    // 单写者（load + store），任意线程可读取
+    class Latency_histogram
+    {
+    public:
+        static constexpr uint32_t kSubBits = 3;
+        static constexpr uint32_t kSubBuckets = 1u << kSubBits;
+        static constexpr uint32_t kBuckets = (32 - kSubBits + 1) * kSubBuckets;
+
+        static uint32_t bucket_of(uint32_t value)
+        {
+            if (value < kSubBuckets)
+                return value;
+            const uint32_t msb = 31 - static_cast<uint32_t>(std::countl_zero(value));
+            const uint32_t shift = msb - kSubBits;
+            return (shift + 1) * kSubBuckets + ((value >> shift) & (kSubBuckets - 1));
+        }
+
+        // 桶的最小值与最大值（含）
+        static uint32_t bucket_low(uint32_t index)
+        {
+            const uint32_t group = index / kSubBuckets;
+            const uint32_t sub = index % kSubBuckets;
+            return group == 0 ? sub : (kSubBuckets + sub) << (group - 1);
+        }
+
+        static uint32_t bucket_high(uint32_t index)
+        {
+            const uint32_t group = index / kSubBuckets;
+            return group == 0 ? bucket_low(index) : bucket_low(index) + ((1u << (group - 1)) - 1);
+        }
+
+        void record(uint32_t value)
+        {
+            _add(buckets[bucket_of(value)], 1u);
+            _add(samples, 1u);
+            _add(sum, static_cast<stat_value_t>(value));
+            if (samples.load(std::memory_order_relaxed) == 1 || value < min_value.load(std::memory_order_relaxed))
+                min_value.store(value, std::memory_order_relaxed);
+            if (value > max_value.load(std::memory_order_relaxed))
+                max_value.store(value, std::memory_order_relaxed);
+        }
+
+        uint32_t count() const { return samples.load(std::memory_order_relaxed); }
+        uint32_t min() const { return min_value.load(std::memory_order_relaxed); }
+        uint32_t max() const { return max_value.load(std::memory_order_relaxed); }
+        uint32_t bucket(uint32_t index) const { return buckets[index].load(std::memory_order_relaxed); }
+
+        double mean() const
+        {
+            const uint32_t n = count();
+            return n == 0 ? 0.0 : static_cast<double>(sum.load(std::memory_order_relaxed)) / n;
+        }
+
+        // 分位数（0..100），返回所在桶的上界（不超过已记录的最大值）
+        uint32_t percentile(double p) const
+        {
+            const uint32_t n = count();
+            if (n == 0)
+                return 0;
+
+            const double clamped = std::min(std::max(p, 0.0), 100.0);
+            const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(clamped / 100.0 * n + 0.5));
+            uint64_t seen = 0;
+            for (uint32_t i = 0; i < kBuckets; ++i)
+            {
+                seen += bucket(i);
+                if (seen >= rank)
+                    return std::min(bucket_high(i), max());
+            }
+            return max();
+        }
+
+    private:
+        template <typename T>
+        static void _add(std::atomic<T> &counter, T n)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+        }
+
+        std::array<std::atomic<uint32_t>, kBuckets> buckets{};
+        std::atomic<uint32_t> samples{0};
+        std::atomic<stat_value_t> sum{0};
+        std::atomic<uint32_t> min_value{0};
+        std::atomic<uint32_t> max_value{0};
+    };
+
+    enum class Latency_stage : uint8_t
+    {
+        TX_QUEUE = 0,
+        WIRE = 1,
+        RX_QUEUE = 2,
+        HANDLER = 3,
+    };
+
+    // 按 (component_id, data_id) 的直方图表 + 发送 / 接收侧的在途帧时间标记
+    // 发送侧表由 send_buff_consume() 的上下文写入，接收侧表由 parse_data_task() 的上下文写入
+    template <uint16_t Slots, uint8_t TxClasses>
+    class Latency_tracker_t
+    {
+    public:
+        static constexpr uint32_t kMarks = 32; // 每个队列最多跟踪的在途帧 / 接收块，溢出时不采样
+
+        const Latency_histogram *histogram(uint8_t component_id, uint8_t data_id, Latency_stage stage) const
+        {
+            if (stage == Latency_stage::TX_QUEUE)
+            {
+                const tx_slot_t *slot = tx_table.find(component_id, data_id);
+                return slot != nullptr ? &slot->queue : nullptr;
+            }
+            const rx_slot_t *slot = rx_table.find(component_id, data_id);
+            return slot != nullptr ? &slot->stages[static_cast<uint8_t>(stage) - 1] : nullptr;
+        }
+
+        // 本端观测到的最小 (到达时刻 - 对端时间戳) = 时钟偏差 + 最小单向时延；尚无样本时返回 false
+        bool wire_min_delta(int32_t *out) const
+        {
+            if (!wire_min_valid.load(std::memory_order_acquire))
+                return false;
+            *out = wire_min.load(std::memory_order_relaxed);
+            return true;
+        }
+
+        // 双向估计：local_min 为本端 wire_min_delta()，peer_min 为对端上报的同一数值，
+        // 假设两个方向最小时延相同：offset = 本端时钟 - 对端时钟，delay = 最小单向时延
+        static void estimate_clock_offset(int32_t local_min, int32_t peer_min, int32_t *offset, int32_t *delay)
+        {
+            *offset = static_cast<int32_t>((static_cast<int64_t>(local_min) - peer_min) / 2);
+            *delay = static_cast<int32_t>((static_cast<int64_t>(local_min) + peer_min) / 2);
+        }
+
+        // ===== 发送侧 =====
+        // 生产者：帧提交后调用，end_pos 为该队列累计提交字节数
+        void on_tx_commit(uint8_t tx_class, uint32_t end_pos, uint8_t component_id, uint8_t data_id, uint32_t t)
+        {
+            tx_marks[tx_class].push({end_pos, t, component_id, data_id});
+        }
+
+        // 消费者：consumed 为该队列累计消费字节数，整帧离开队列时记录一次排队时延
+        void on_tx_consume(uint8_t tx_class, uint32_t consumed, uint32_t t)
+        {
+            auto &marks = tx_marks[tx_class];
+            tx_mark_t mark;
+            while (marks.front(&mark) && static_cast<int32_t>(consumed - mark.end_pos) >= 0)
+            {
+                if (tx_slot_t *slot = tx_table.insert(mark.component_id, mark.data_id))
+                    slot->queue.record(t - mark.time);
+                marks.pop();
+            }
+        }
+
+        // ===== 接收侧 =====
+        // 生产者（可在中断中）：len 字节进入 rec_buff
+        void on_rx_push(uint32_t len, uint32_t t)
+        {
+            const uint32_t end = rx_pushed.load(std::memory_order_relaxed) + len;
+            rx_pushed.store(end, std::memory_order_relaxed);
+            rx_marks.push({end, t, 0, 0});
+        }
+
+        // 消费者：从 rec_buff 弹出 len 字节（解析、重新同步跳过）
+        void on_rx_consume(uint32_t len) { rx_consumed += len; }
+
+        // 消费者：接收环溢出后整体丢弃，与生产者的累计字节数重新对齐
+        void on_rx_resync()
+        {
+            rx_consumed = rx_pushed.load(std::memory_order_acquire);
+            rx_mark_t mark;
+            while (rx_marks.front(&mark))
+                rx_marks.pop();
+        }
+
+        // 消费者：位于 rec_buff 头部、长度 frame_len 的帧的到达时刻（其最后一个字节所在的接收块）
+        bool rx_arrival(uint32_t frame_len, uint32_t *t)
+        {
+            const uint32_t end = rx_consumed + frame_len;
+            rx_mark_t mark;
+            while (rx_marks.front(&mark))
+            {
+                if (static_cast<int32_t>(mark.end_pos - end) >= 0)
+                {
+                    *t = mark.time;
+                    return true;
+                }
+                rx_marks.pop();
+            }
+            return false;
+        }
+
+        void on_rx_dispatch(uint8_t component_id, uint8_t data_id, uint32_t queued, uint32_t handler)
+        {
+            if (rx_slot_t *slot = rx_table.insert(component_id, data_id))
+            {
+                slot->stages[static_cast<uint8_t>(Latency_stage::RX_QUEUE) - 1].record(queued);
+                slot->stages[static_cast<uint8_t>(Latency_stage::HANDLER) - 1].record(handler);
+            }
+        }
+
+        void on_rx_timestamp(uint8_t component_id, uint8_t data_id, uint32_t arrival, uint32_t sender_time)
+        {
+            const int32_t delta = static_cast<int32_t>(arrival - sender_time);
+            if (!wire_min_valid.load(std::memory_order_relaxed) || delta < wire_min.load(std::memory_order_relaxed))
+            {
+                wire_min.store(delta, std::memory_order_relaxed);
+                wire_min_valid.store(true, std::memory_order_release);
+            }
+            if (rx_slot_t *slot = rx_table.insert(component_id, data_id))
+            {
+                slot->stages[static_cast<uint8_t>(Latency_stage::WIRE) - 1].record(
+                    static_cast<uint32_t>(delta - wire_min.load(std::memory_order_relaxed)));
+            }
+        }
+
+    private:
+        struct tx_mark_t
+        {
+            uint32_t end_pos;
+            uint32_t time;
+            uint8_t component_id;
+            uint8_t data_id;
+        };
+        using rx_mark_t = tx_mark_t;
+
+        // 定长 SPSC 标记队列，满时丢弃新标记（该帧不采样）
+        template <typename T>
+        struct mark_ring_t
+        {
+            std::array<T, kMarks> items{};
+            std::atomic<uint32_t> head{0};
+            std::atomic<uint32_t> tail{0};
+
+            void push(const T &item)
+            {
+                const uint32_t h = head.load(std::memory_order_relaxed);
+                if (h - tail.load(std::memory_order_acquire) >= kMarks)
+                    return;
+                items[h % kMarks] = item;
+                head.store(h + 1, std::memory_order_release);
+            }
+
+            bool front(T *item) const
+            {
+                const uint32_t t = tail.load(std::memory_order_relaxed);
+                if (t == head.load(std::memory_order_acquire))
+                    return false;
+                *item = items[t % kMarks];
+                return true;
+            }
+
+            void pop() { tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+        };
+
+        struct tx_slot_t
+        {
+            std::atomic<uint32_t> tag{0}; // 0 = 空，否则为 key + 1
+            Latency_histogram queue;
+        };
+
+        struct rx_slot_t
+        {
+            std::atomic<uint32_t> tag{0};
+            Latency_histogram stages[3]; // WIRE, RX_QUEUE, HANDLER
+        };
+
+        static_assert(Slots > 0, "UNIFY_LINK_LATENCY_SLOTS must be at least 1");
+
+        detail::id_slot_table<tx_slot_t, Slots> tx_table;
+        detail::id_slot_table<rx_slot_t, Slots> rx_table;
+        std::array<mark_ring_t<tx_mark_t>, TxClasses> tx_marks{};
+        mark_ring_t<rx_mark_t> rx_marks;
+        std::atomic<uint32_t> rx_pushed{0};
+        uint32_t rx_consumed = 0;
+
+        std::atomic<int32_t> wire_min{0};
+        std::atomic<bool> wire_min_valid{false};
+    };
+} // namespace unify_link
+
+#endif // UNIFY_LINK_LATENCY_HPP
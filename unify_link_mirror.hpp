@@ -0,0 +1,561 @@
+#ifndef UNIFY_LINK_MIRROR_HPP
+#define UNIFY_LINK_MIRROR_HPP
+
+// 状态快照与主机镜像：一次请求取回设备端全部状态块（信息、设置、PID 等），重连时只取回变化过的块。
+//
+//   设备端 Snapshot_server_t：登记状态块（对象或按元素发送的数组），收到 SNAPSHOT_REQUEST 后
+//     1. 逐块计算 CRC，内容变化的块代数（generation）加一
+//     2. 发送清单帧 SNAPSHOT_MANIFEST：每块的 ID、元素数、元素长度、代数、CRC，以及本次是否发送
+//     3. 以普通数据帧连续发送主机版本不一致的块（走 build_send_data，开启打包时自动合并），
+//        发送缓冲区放不下时在 poll() 中继续，最后发送 SNAPSHOT_END
+//   主机端 State_mirror_t：请求中携带已知的 (代数, CRC)，数据帧照常由组件处理函数更新组件状态；
+//     收到 SNAPSHOT_END 且期间无 CRC 错误、序号丢失与接收溢出时确认本次取回的块，否则这些块保持失效，下次请求重新取回
+//
+// 代数随内容变化递增，CRC 覆盖设备重启后代数重新计数的情况。两端均不分配堆内存；
+// Snapshot_server_t::poll() 应与 parse_data_task() 在同一上下文调用。
+// 清单、请求与每个元素都必须放进链路的一帧（Link::max_payload_length），默认条目数按此推算，最多 32 条。
+
+#include "unify_link.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <tuple>
+
+namespace unify_link
+{
+#pragma pack(push, 1)
+    // 请求载荷：tag、条目数，之后为主机已知的块版本
+    struct snapshot_known_t
+    {
+        uint8_t component_id;
+        uint8_t data_id;
+        uint16_t generation;
+        uint16_t crc;
+    };
+
+    // 清单载荷：tag、条目数，之后为设备端全部块
+    struct snapshot_manifest_entry_t
+    {
+        uint8_t component_id;
+        uint8_t data_id;
+        uint8_t count;           // 元素数：每个元素一帧
+        uint8_t flags;           // SNAPSHOT_ENTRY_SENT：本次随后发送
+        uint16_t element_length; // 单帧载荷长度
+        uint16_t generation;
+        uint16_t crc; // 全部元素内容的 CRC16
+    };
+
+    // 结束载荷
+    struct snapshot_end_t
+    {
+        uint8_t tag;
+        uint16_t frames; // 清单之后发送的数据帧数
+    };
+#pragma pack(pop)
+
+    static_assert(sizeof(snapshot_known_t) == 6, "snapshot_known_t must be 6 bytes");
+    static_assert(sizeof(snapshot_manifest_entry_t) == 10, "snapshot_manifest_entry_t must be 10 bytes");
+
+    constexpr uint8_t SNAPSHOT_ENTRY_SENT = 0x01;
+
+    // 清单放得进该链路一帧的最大条目数（不超过 32）
+    template <typename Link>
+    constexpr uint8_t snapshot_max_entries =
+        static_cast<uint8_t>(std::min<size_t>(32, (Link::max_payload_length - 2) / sizeof(snapshot_manifest_entry_t)));
+
+    template <typename Link, uint8_t MaxEntries = snapshot_max_entries<Link>>
+    class Snapshot_server_t
+    {
+        static_assert(MaxEntries >= 1, "link payload too small for a snapshot manifest");
+        static_assert(2 + MaxEntries * sizeof(snapshot_manifest_entry_t) <= Link::max_payload_length,
+                      "manifest must fit in one frame");
+
+    public:
+        explicit Snapshot_server_t(Link &link) : link(link)
+        {
+            handlers_registered = link.register_handle_data(
+                COMPONENT_ID_SYSTEM, SNAPSHOT_REQUEST_DATA_ID, nullptr,
+                [this](const uint8_t *data, uint16_t len) { return this->_on_request(data, len); }, 0xFFFF);
+        }
+
+        Snapshot_server_t(const Snapshot_server_t &) = delete;
+        Snapshot_server_t &operator=(const Snapshot_server_t &) = delete;
+
+        // 登记状态块：data 起的 count 个元素，每个元素 element_length 字节、作为一帧 (component_id, data_id) 发送。
+        // 块须在服务端存活期内有效；表满、重复登记或长度超过链路单帧载荷时返回 false
+        bool add(uint8_t component_id, uint8_t data_id, const void *data, uint16_t element_length, uint8_t count = 1)
+        {
+            if (entry_count >= MaxEntries || data == nullptr || count == 0 || element_length == 0 ||
+                element_length > Link::max_payload_length || _find(component_id, data_id) != nullptr)
+                return false;
+
+            entry_t &e = entries[entry_count++];
+            e.component_id = component_id;
+            e.data_id = data_id;
+            e.count = count;
+            e.element_length = element_length;
+            e.data = static_cast<const uint8_t *>(data);
+            e.generation = 1;
+            e.crc = _crc(e);
+            return true;
+        }
+
+        template <typename T>
+        bool add_object(uint8_t component_id, uint8_t data_id, const T &object)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "snapshot blobs are sent as raw bytes");
+            return add(component_id, data_id, &object, sizeof(T), 1);
+        }
+
+        // 数组按元素逐帧发送（例如 motor_info[i]，元素内包含自身编号）
+        template <typename T, size_t N>
+        bool add_array(uint8_t component_id, uint8_t data_id, const T (&array)[N])
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "snapshot blobs are sent as raw bytes");
+            static_assert(N <= 0xFF, "at most 255 elements per entry");
+            return add(component_id, data_id, array, sizeof(T), static_cast<uint8_t>(N));
+        }
+
+        // 登记该组件在分发表中带 dst、定长的全部 ID（即零长度请求帧可以取回的块），返回新增条目数；
+        // Link 为 Unify_link_static 时同样登记该组件 static_routes 中的数据路由
+        uint8_t add_registered(uint8_t component_id)
+        {
+            uint8_t added = _add_static_routes(component_id);
+            for (uint16_t data_id = 0; data_id < 256; ++data_id)
+            {
+                const registered_item_t *item =
+                    link.registered_table.find(component_id, static_cast<uint8_t>(data_id));
+                if (item == nullptr || item->dst == nullptr || item->payload_length == 0xFFFF)
+                    continue;
+                if (add(component_id, static_cast<uint8_t>(data_id), item->dst, item->payload_length))
+                    added++;
+            }
+            return added;
+        }
+
+        // 强制下次请求时发送该块（例如内容按字节未变但语义需要重发）
+        bool touch(uint8_t component_id, uint8_t data_id)
+        {
+            entry_t *e = _find(component_id, data_id);
+            if (e == nullptr)
+                return false;
+            e->generation++;
+            e->crc = _crc(*e);
+            e->forced = true;
+            return true;
+        }
+
+        // 继续发送尚未放入发送缓冲区的部分
+        void poll()
+        {
+            if (phase == Phase::MANIFEST)
+            {
+                if (link.build_send_data(COMPONENT_ID_SYSTEM, SNAPSHOT_MANIFEST_DATA_ID, manifest.data(),
+                                         manifest_len) == 0)
+                    return;
+                phase = Phase::BLOBS;
+            }
+
+            for (; phase == Phase::BLOBS && cursor_entry < entry_count; cursor_entry++, cursor_element = 0)
+            {
+                const entry_t &e = entries[cursor_entry];
+                if (!e.send)
+                    continue;
+                for (; cursor_element < e.count; ++cursor_element)
+                {
+                    const uint8_t *element = e.data + static_cast<uint32_t>(cursor_element) * e.element_length;
+                    if (link.build_send_data(e.component_id, e.data_id, element, e.element_length) == 0)
+                        return; // 发送缓冲区已满，下次 poll() 从这里继续
+                    frames_sent++;
+                }
+            }
+
+            if (phase == Phase::BLOBS)
+            {
+                const snapshot_end_t end{tag, frames_sent};
+                if (link.build_send_data(COMPONENT_ID_SYSTEM, SNAPSHOT_END_DATA_ID,
+                                         reinterpret_cast<const uint8_t *>(&end), sizeof(end)) == 0)
+                    return;
+                link.flush_bundle();
+                phase = Phase::IDLE;
+            }
+        }
+
+        // 请求 ID 已写入链路分发表；为 false 时分发表已满（见 UNIFY_LINK_MAX_HANDLERS），收不到快照请求
+        bool registered() const { return handlers_registered; }
+        bool streaming() const { return phase != Phase::IDLE; }
+        uint8_t size() const { return entry_count; }
+        uint32_t request_count() const { return requests; }
+
+    private:
+        enum class Phase : uint8_t
+        {
+            IDLE,
+            MANIFEST,
+            BLOBS,
+        };
+
+        struct entry_t
+        {
+            uint8_t component_id = 0;
+            uint8_t data_id = 0;
+            uint8_t count = 0;
+            uint16_t element_length = 0;
+            const uint8_t *data = nullptr;
+            uint16_t generation = 0;
+            uint16_t crc = 0;
+            bool send = false;
+            bool forced = false;
+        };
+
+        // 逐元素累计：整块可能超过 crc16_calculation() 的 16 位长度
+        static uint16_t _crc(const entry_t &e)
+        {
+            uint16_t crc = 0xFFFF;
+            for (uint8_t i = 0; i < e.count; ++i)
+                crc = crc16_calculation(e.data + static_cast<uint32_t>(i) * e.element_length, e.element_length, crc);
+            return crc;
+        }
+
+        uint8_t _add_static_routes(uint8_t component_id)
+        {
+            if constexpr (requires { link.components; })
+                return std::apply([&](auto &...components)
+                                  { return static_cast<uint8_t>((_add_component_routes(component_id, components) + ... + 0)); },
+                                  link.components);
+            else
+                return 0;
+        }
+
+        template <typename Component>
+        uint8_t _add_component_routes(uint8_t component_id, Component &component)
+        {
+            if (Component::component_id != component_id)
+                return 0;
+            return _add_routes(component, static_cast<typename Component::static_routes *>(nullptr));
+        }
+
+        template <typename Component, typename... Routes>
+        uint8_t _add_routes(Component &component, std::tuple<Routes...> *)
+        {
+            uint8_t added = 0;
+            ((added = static_cast<uint8_t>(added + _add_route<Routes>(component))), ...);
+            return added;
+        }
+
+        // 只有数据路由（static_data_route）有可取回的成员
+        template <typename Route, typename Component>
+        uint8_t _add_route(Component &component)
+        {
+            if constexpr (requires { Route::member; })
+                return add(Component::component_id, Route::data_id, &(component.*Route::member),
+                           sizeof(typename Route::payload_type))
+                           ? 1
+                           : 0;
+            else
+                return 0;
+        }
+
+        entry_t *_find(uint8_t component_id, uint8_t data_id)
+        {
+            for (uint8_t i = 0; i < entry_count; ++i)
+                if (entries[i].component_id == component_id && entries[i].data_id == data_id)
+                    return &entries[i];
+            return nullptr;
+        }
+
+        bool _on_request(const uint8_t *data, uint16_t len)
+        {
+            if (len < 2 || len != 2 + data[1] * sizeof(snapshot_known_t))
+                return false;
+
+            tag = data[0];
+            const uint8_t known_count = data[1];
+            requests++;
+
+            manifest[0] = tag;
+            manifest[1] = entry_count;
+            manifest_len = 2;
+            for (uint8_t i = 0; i < entry_count; ++i)
+            {
+                entry_t &e = entries[i];
+                const uint16_t crc = _crc(e);
+                if (crc != e.crc)
+                {
+                    e.crc = crc;
+                    e.generation++;
+                }
+
+                e.send = true;
+                for (uint8_t k = 0; k < known_count && !e.forced; ++k)
+                {
+                    snapshot_known_t known;
+                    std::memcpy(&known, data + 2 + k * sizeof(known), sizeof(known));
+                    if (known.component_id == e.component_id && known.data_id == e.data_id)
+                    {
+                        e.send = known.generation != e.generation || known.crc != e.crc;
+                        break;
+                    }
+                }
+                e.forced = false;
+
+                const snapshot_manifest_entry_t out{e.component_id,   e.data_id,    e.count,
+                                                    e.send ? SNAPSHOT_ENTRY_SENT : uint8_t{0},
+                                                    e.element_length, e.generation, e.crc};
+                std::memcpy(manifest.data() + manifest_len, &out, sizeof(out));
+                manifest_len += sizeof(out);
+            }
+
+            // 新请求取代进行中的发送
+            phase = Phase::MANIFEST;
+            cursor_entry = 0;
+            cursor_element = 0;
+            frames_sent = 0;
+            poll();
+            return true;
+        }
+
+        Link &link;
+        bool handlers_registered = false;
+        std::array<entry_t, MaxEntries> entries{};
+        uint8_t entry_count = 0;
+
+        std::array<uint8_t, 2 + MaxEntries * sizeof(snapshot_manifest_entry_t)> manifest{};
+        uint16_t manifest_len = 0;
+        Phase phase = Phase::IDLE;
+        uint8_t tag = 0;
+        uint8_t cursor_entry = 0;
+        uint8_t cursor_element = 0;
+        uint16_t frames_sent = 0;
+        uint32_t requests = 0;
+    };
+
+    template <typename Link, uint8_t MaxEntries = snapshot_max_entries<Link>>
+    class State_mirror_t
+    {
+        static_assert(MaxEntries >= 1, "link payload too small for a snapshot request");
+        static_assert(2 + MaxEntries * sizeof(snapshot_known_t) <= Link::max_payload_length,
+                      "request must fit in one frame");
+
+    public:
+        // 镜像中的一个块：设备端最近一次清单给出的版本，valid 表示主机已持有该版本
+        struct entry_t
+        {
+            uint8_t component_id = 0;
+            uint8_t data_id = 0;
+            uint8_t count = 0;
+            uint16_t element_length = 0;
+            uint16_t generation = 0;
+            uint16_t crc = 0;
+            bool valid = false;
+        };
+
+        struct sync_result_t
+        {
+            uint8_t entries = 0;  // 设备端的块数
+            uint8_t fetched = 0;  // 本次取回的块数
+            uint16_t frames = 0;  // 本次取回的数据帧数
+            bool complete = false; // 期间无接收错误，全部块已是最新
+        };
+
+        explicit State_mirror_t(Link &link) : link(link)
+        {
+            handlers_registered = link.register_handle_data(
+                COMPONENT_ID_SYSTEM, SNAPSHOT_MANIFEST_DATA_ID, nullptr,
+                [this](const uint8_t *data, uint16_t len) { return this->_on_manifest(data, len); }, 0xFFFF);
+            handlers_registered &= link.register_handle_data(
+                COMPONENT_ID_SYSTEM, SNAPSHOT_END_DATA_ID, nullptr,
+                [this](const uint8_t *data, uint16_t len) { return this->_on_end(data, len); },
+                sizeof(snapshot_end_t));
+        }
+
+        State_mirror_t(const State_mirror_t &) = delete;
+        State_mirror_t &operator=(const State_mirror_t &) = delete;
+
+        // 发送快照请求；full 为 true 时不携带已知版本（全部重新取回）。发送缓冲区满时返回 false。
+        // 应答丢失时 busy() 保持为 true，由调用方按超时重新请求
+        bool request(bool full = false)
+        {
+            std::array<uint8_t, 2 + MaxEntries * sizeof(snapshot_known_t)> payload;
+            uint16_t len = 2;
+            uint8_t known = 0;
+            for (uint8_t i = 0; i < entry_count && !full; ++i)
+            {
+                const entry_t &e = entries[i];
+                if (!e.valid)
+                    continue;
+                const snapshot_known_t k{e.component_id, e.data_id, e.generation, e.crc};
+                std::memcpy(payload.data() + len, &k, sizeof(k));
+                len += sizeof(k);
+                known++;
+            }
+            payload[0] = ++tag;
+            payload[1] = known;
+
+            pending_count = 0;
+            awaiting_manifest = false;
+            if (link.build_send_data(COMPONENT_ID_SYSTEM, SNAPSHOT_REQUEST_DATA_ID, payload.data(), len) == 0)
+            {
+                in_flight = false;
+                return false;
+            }
+            in_flight = true;
+            awaiting_manifest = true;
+            return true;
+        }
+
+        // 丢弃全部版本（例如换了一块板子），下次请求取回全部块
+        void invalidate()
+        {
+            for (uint8_t i = 0; i < entry_count; ++i)
+                entries[i].valid = false;
+            is_synced = false;
+        }
+
+        // 清单与结束帧 ID 已写入链路分发表；为 false 时分发表已满（见 UNIFY_LINK_MAX_HANDLERS），同步无法完成
+        bool registered() const { return handlers_registered; }
+        bool busy() const { return in_flight; }
+        bool synced() const { return is_synced; }
+        const sync_result_t &last_result() const { return result; }
+
+        uint8_t size() const { return entry_count; }
+        const entry_t &operator[](uint8_t i) const { return entries[i]; }
+        const entry_t *find(uint8_t component_id, uint8_t data_id) const
+        {
+            for (uint8_t i = 0; i < entry_count; ++i)
+                if (entries[i].component_id == component_id && entries[i].data_id == data_id)
+                    return &entries[i];
+            return nullptr;
+        }
+
+        // 每次收到结束帧时调用（解析上下文）
+        std::function<void(const sync_result_t &)> on_synced;
+
+    private:
+        struct error_marks_t
+        {
+            uint64_t crc_errors = 0;
+            uint64_t seq_lost = 0;
+            uint64_t overflow = 0;
+
+            bool operator==(const error_marks_t &o) const
+            {
+                return crc_errors == o.crc_errors && seq_lost == o.seq_lost && overflow == o.overflow;
+            }
+        };
+
+        error_marks_t _marks() const
+        {
+            const auto totals = link.stats_totals();
+            return {totals.crc_errors, totals.seq_lost, totals.rx_overflow_bytes};
+        }
+
+        bool _on_manifest(const uint8_t *data, uint16_t len)
+        {
+            if (len < 2 || len != 2 + data[1] * sizeof(snapshot_manifest_entry_t) || data[1] > MaxEntries)
+                return false;
+            if (!awaiting_manifest || data[0] != tag)
+                return true; // 过期请求的应答
+
+            pending_count = data[1];
+            for (uint8_t i = 0; i < pending_count; ++i)
+                std::memcpy(&pending[i], data + 2 + i * sizeof(snapshot_manifest_entry_t),
+                            sizeof(snapshot_manifest_entry_t));
+            marks = _marks();
+            awaiting_manifest = false;
+            awaiting_end = true;
+            return true;
+        }
+
+        bool _on_end(const uint8_t *data, uint16_t len)
+        {
+            (void)len;
+            snapshot_end_t end;
+            std::memcpy(&end, data, sizeof(end));
+            if (!awaiting_end || end.tag != tag)
+                return true;
+
+            const bool clean = _marks() == marks;
+            result = {};
+            result.entries = pending_count;
+            result.frames = end.frames;
+            result.complete = clean;
+
+            // 以清单为准重建镜像：未发送的块沿用主机版本，已发送的块在无接收错误时生效
+            std::array<entry_t, MaxEntries> next{};
+            for (uint8_t i = 0; i < pending_count; ++i)
+            {
+                const snapshot_manifest_entry_t &m = pending[i];
+                entry_t &e = next[i];
+                e.component_id = m.component_id;
+                e.data_id = m.data_id;
+                e.count = m.count;
+                e.element_length = m.element_length;
+                e.generation = m.generation;
+                e.crc = m.crc;
+                if (m.flags & SNAPSHOT_ENTRY_SENT)
+                {
+                    e.valid = clean;
+                    result.fetched++;
+                }
+                else
+                {
+                    const entry_t *old = find(m.component_id, m.data_id);
+                    e.valid = old != nullptr && old->valid;
+                }
+                result.complete = result.complete && e.valid;
+            }
+            entries = next;
+            entry_count = pending_count;
+
+            awaiting_end = false;
+            in_flight = false;
+            is_synced = result.complete;
+            if (on_synced)
+                on_synced(result);
+            return true;
+        }
+
+        Link &link;
+        bool handlers_registered = false;
+        std::array<entry_t, MaxEntries> entries{};
+        uint8_t entry_count = 0;
+
+        std::array<snapshot_manifest_entry_t, MaxEntries> pending{};
+        uint8_t pending_count = 0;
+        error_marks_t marks;
+        uint8_t tag = 0;
+        bool awaiting_manifest = false;
+        bool awaiting_end = false;
+        bool in_flight = false;
+        bool is_synced = false;
+        sync_result_t result;
+    };
+
+    using Snapshot_server = Snapshot_server_t<Unify_link_base>;
+    using State_mirror = State_mirror_t<Unify_link_base>;
+
+    // 组件状态块：信息、设置按元素发送，PID 整体发送（motor_info[i].motor_id 等元素编号由设备端填写）
+    template <typename Server, typename Motor>
+    uint8_t add_motor_snapshot(Server &server, Motor &motor)
+    {
+        uint8_t added = 0;
+        added += server.add_array(Motor::component_id, Motor::MOTOR_INFO_ID, motor.motor_info);
+        added += server.add_array(Motor::component_id, Motor::MOTOR_SETTING_ID, motor.motor_settings);
+        added += server.add_object(Motor::component_id, Motor::MOTOR_PID_ID, motor.motor_pid);
+        return added;
+    }
+
+    template <typename Server, typename Encoder>
+    uint8_t add_encoder_snapshot(Server &server, Encoder &encoder)
+    {
+        uint8_t added = 0;
+        added += server.add_object(Encoder::component_id, Encoder::ENCODER_INFO_ID, encoder.encoder_info);
+        added += server.add_object(Encoder::component_id, Encoder::ENCODER_SETTING_ID, encoder.encoder_setting);
+        return added;
+    }
+} // namespace unify_link
+
+#endif // UNIFY_LINK_MIRROR_HPP
@@ -0,0 +1,250 @@
+#ifndef UNIFY_LINK_MONITOR_HPP
+#define UNIFY_LINK_MONITOR_HPP
+
+// 链路监视：挂在 frame_tap 上按 (component_id, data_id) 统计线上帧，并给出滑动窗口内的帧率 / 字节率 / 错误率
+// 写入只发生在解析上下文，快照由一个读者线程（例如 UI 定时器）获取，不加锁、不分配内存
+
+#include "unify_link.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace unify_link
+{
+    // 分桶滑动窗口：每个时间片一个桶，桶记录所属时间片编号，读者只累加窗口内已结束的时间片，
+    // 因此链路空闲时速率自然回落到 0，写者也不需要定时器
+    template <uint8_t Buckets>
+    class Rate_window_t
+    {
+        static_assert(Buckets >= 2, "need at least one completed bucket in the window");
+
+    public:
+        static constexpr uint32_t kNoEpoch = 0xFFFFFFFFu;
+
+        void add(uint32_t epoch, uint32_t bytes)
+        {
+            bucket_t &b = buckets[epoch % Buckets];
+            if (b.epoch.load(std::memory_order_relaxed) != epoch)
+            {
+                b.frames.value.store(0, std::memory_order_relaxed);
+                b.bytes.value.store(0, std::memory_order_relaxed);
+                b.epoch.store(epoch, std::memory_order_release);
+            }
+            b.frames.add();
+            b.bytes.add(bytes);
+        }
+
+        // now_epoch 之前 Buckets - 1 个时间片的总和
+        void sum(uint32_t now_epoch, uint64_t *frames, uint64_t *bytes) const
+        {
+            *frames = 0;
+            *bytes = 0;
+            for (const bucket_t &b : buckets)
+            {
+                const uint32_t epoch = b.epoch.load(std::memory_order_acquire);
+                const uint32_t age = now_epoch - epoch;
+                if (epoch == kNoEpoch || age == 0 || age >= Buckets)
+                    continue;
+                *frames += b.frames.get();
+                *bytes += b.bytes.get();
+            }
+        }
+
+    private:
+        struct bucket_t
+        {
+            std::atomic<uint32_t> epoch{kNoEpoch};
+            stat_counter_t frames;
+            stat_counter_t bytes;
+        };
+
+        std::array<bucket_t, Buckets> buckets{};
+    };
+
+    // Slots：单独统计的 ID 数（线性探测表，满后只计入总计）；Buckets - 1 个时间片组成一个窗口
+    template <typename Link, uint16_t Slots = 32, uint8_t Buckets = 11>
+    class Link_monitor_t
+    {
+    public:
+        using totals_t = typename Link::stats_totals_t;
+
+        // 单个 ID：按线上帧头计（打包帧作为一帧、计入其帧头 ID），字节含帧头
+        struct message_rate_t
+        {
+            uint8_t component_id = 0;
+            uint8_t data_id = 0;
+            uint8_t flags = 0; // 最近一帧的标志位
+            uint64_t frames = 0;
+            uint64_t bytes = 0;
+            float frames_per_sec = 0;
+            float bytes_per_sec = 0;
+        };
+
+        struct snapshot_t
+        {
+            totals_t totals;       // 链路累计计数（Link::stats_totals()）
+            uint32_t window = 0;   // 窗口长度（时钟单位）
+            uint64_t tap_frames = 0; // 监视器看到的帧数
+            float rx_frames_per_sec = 0;
+            float rx_bytes_per_sec = 0;
+            float crc_errors_per_sec = 0;
+            float decode_errors_per_sec = 0;
+            float seq_lost_per_sec = 0;
+        };
+
+        // clock：单调时钟，bucket_span 为一个时间片的时钟单位数；ticks_per_sec 用于换算每秒速率（毫秒时钟为 1000）
+        Link_monitor_t(Link &link, clock_fn_t clock, uint32_t bucket_span = 100, uint32_t ticks_per_sec = 1000)
+            : link(link), clock(clock), bucket_span(bucket_span != 0 ? bucket_span : 1), ticks_per_sec(ticks_per_sec)
+        {
+            tap_node.tap = [this](const unify_link_frame_head_t &head, const uint8_t *, uint16_t len)
+            { on_frame(head, len); };
+            link.add_frame_tap(tap_node);
+        }
+
+        // 只摘除自己的节点，其他观察者（包括之后接入的）不受影响
+        ~Link_monitor_t() { link.remove_frame_tap(tap_node); }
+
+        Link_monitor_t(const Link_monitor_t &) = delete;
+        Link_monitor_t &operator=(const Link_monitor_t &) = delete;
+
+        // 解析上下文（frame_tap）
+        void on_frame(const unify_link_frame_head_t &head, uint16_t payload_len)
+        {
+            const uint32_t epoch = _epoch();
+            const uint32_t bytes = sizeof(unify_link_frame_head_t) + payload_len;
+            total.add(epoch, bytes);
+            tap_frames.add();
+
+            slot_t *slot = table.insert(head.component_id, head.data_id);
+            if (slot == nullptr)
+                return;
+            slot->window.add(epoch, bytes);
+            slot->frames.add();
+            slot->bytes.add(bytes);
+            slot->flags.store(head.flags(), std::memory_order_relaxed);
+        }
+
+        // 读者线程：保存每个时间片的错误计数样本以计算窗口内错误率，因此只应由一个线程调用
+        void snapshot(snapshot_t *out)
+        {
+            const uint32_t now = _epoch();
+            out->totals = link.stats_totals();
+            out->window = window_span();
+            out->tap_frames = tap_frames.get();
+
+            uint64_t frames = 0;
+            uint64_t bytes = 0;
+            total.sum(now, &frames, &bytes);
+            out->rx_frames_per_sec = _per_sec(frames);
+            out->rx_bytes_per_sec = _per_sec(bytes);
+
+            error_sample_t &latest = error_samples[now % Buckets];
+            if (latest.epoch != now)
+                latest = {now, out->totals.crc_errors, out->totals.decode_errors, out->totals.seq_lost};
+
+            // 窗口内最早的样本作为基准；样本不足一个时间片时错误率为 0
+            const error_sample_t *base = nullptr;
+            for (const error_sample_t &sample : error_samples)
+            {
+                const uint32_t age = now - sample.epoch;
+                if (sample.epoch != Rate_window_t<Buckets>::kNoEpoch && age != 0 && age < Buckets &&
+                    (base == nullptr || age > now - base->epoch))
+                    base = &sample;
+            }
+            if (base == nullptr)
+            {
+                out->crc_errors_per_sec = out->decode_errors_per_sec = out->seq_lost_per_sec = 0;
+                return;
+            }
+            const uint32_t span = (now - base->epoch) * bucket_span;
+            out->crc_errors_per_sec = _rate(out->totals.crc_errors - base->crc_errors, span);
+            out->decode_errors_per_sec = _rate(out->totals.decode_errors - base->decode_errors, span);
+            out->seq_lost_per_sec = _rate(out->totals.seq_lost - base->seq_lost, span);
+        }
+
+        // 全部已出现 ID，最多写入 max 条，返回写入条数；任意线程
+        uint16_t messages(message_rate_t *out, uint16_t max) const
+        {
+            const uint32_t now = _epoch();
+            uint16_t count = 0;
+            for (const slot_t &slot : table)
+            {
+                const uint32_t tag = slot.tag.load(std::memory_order_acquire);
+                if (tag == 0 || count >= max)
+                    continue;
+                _fill(slot, tag, now, &out[count++]);
+            }
+            return count;
+        }
+
+        // 单个 ID；从未出现过时返回 false
+        bool message(uint8_t component_id, uint8_t data_id, message_rate_t *out) const
+        {
+            const slot_t *slot = table.find(component_id, data_id);
+            if (slot == nullptr)
+                return false;
+            _fill(*slot, slot->tag.load(std::memory_order_acquire), _epoch(), out);
+            return true;
+        }
+
+        uint32_t window_span() const { return (Buckets - 1) * bucket_span; }
+        static constexpr uint16_t capacity() { return Slots; }
+
+    private:
+        struct slot_t
+        {
+            std::atomic<uint32_t> tag{0}; // 0 = 空，否则为 key + 1
+            std::atomic<uint8_t> flags{0};
+            stat_counter_t frames;
+            stat_counter_t bytes;
+            Rate_window_t<Buckets> window;
+        };
+
+        struct error_sample_t
+        {
+            uint32_t epoch = Rate_window_t<Buckets>::kNoEpoch;
+            uint64_t crc_errors = 0;
+            uint64_t decode_errors = 0;
+            uint64_t seq_lost = 0;
+        };
+
+        uint32_t _epoch() const { return clock != nullptr ? clock() / bucket_span : 0; }
+
+        float _rate(uint64_t count, uint32_t span) const
+        {
+            return span == 0 ? 0.0f : static_cast<float>(static_cast<double>(count) * ticks_per_sec / span);
+        }
+
+        float _per_sec(uint64_t count) const { return _rate(count, window_span()); }
+
+        void _fill(const slot_t &slot, uint32_t tag, uint32_t now, message_rate_t *out) const
+        {
+            uint64_t frames = 0;
+            uint64_t bytes = 0;
+            slot.window.sum(now, &frames, &bytes);
+            out->component_id = decltype(table)::component_of(tag);
+            out->data_id = decltype(table)::data_of(tag);
+            out->flags = slot.flags.load(std::memory_order_relaxed);
+            out->frames = slot.frames.get();
+            out->bytes = slot.bytes.get();
+            out->frames_per_sec = _per_sec(frames);
+            out->bytes_per_sec = _per_sec(bytes);
+        }
+
+        Link &link;
+        frame_tap_node_t tap_node;
+        clock_fn_t clock;
+        const uint32_t bucket_span;
+        const uint32_t ticks_per_sec;
+
+        Rate_window_t<Buckets> total;
+        stat_counter_t tap_frames;
+        detail::id_slot_table<slot_t, Slots> table;
+        std::array<error_sample_t, Buckets> error_samples{};
+    };
+
+    using Link_monitor = Link_monitor_t<Unify_link_base>;
+} // namespace unify_link
+
+#endif // UNIFY_LINK_MONITOR_HPP
@@ -0,0 +1,177 @@
+#ifndef UNIFY_LINK_POOL_HPP
+#define UNIFY_LINK_POOL_HPP
+
+// 定长帧池：Slots 个 SlotBytes 字节的帧槽一次性预分配（对象内数组，可放入静态区），运行中取用 / 归还不访问堆。
+//   - acquire()/release() 为无锁的带标签空闲栈（Treiber），任意线程、任意数量的生产者与消费者均可使用
+//   - 池耗尽时 acquire() 返回空引用并计数，调用方丢弃该帧，不阻塞、不回退到堆
+//   - Frame_ref 为只可移动的持有者，析构时自动归还
+// 排队中、分发中的帧（例如 Parallel_dispatcher_t 的执行通道）都从这里取得缓冲区，因此内存占用与延迟都有上界。
+
+#include "unify_link_def.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+namespace unify_link
+{
+    template <uint16_t Slots, uint16_t SlotBytes = MAX_FRAME_DATA_LENGTH>
+    class Frame_pool_t
+    {
+        static_assert(Slots > 0 && Slots < 0xFFFF, "Slots must be in [1, 65534]");
+        static_assert(SlotBytes > 0, "SlotBytes must be positive");
+
+    public:
+        static constexpr uint16_t kNone = 0xFFFF;
+
+        // 帧槽：元数据 + 载荷
+        struct frame_t
+        {
+            uint8_t component_id = 0;
+            uint8_t data_id = 0;
+            uint16_t length = 0;
+            alignas(8) uint8_t data[SlotBytes];
+        };
+
+        class Frame_ref
+        {
+        public:
+            Frame_ref() = default;
+            Frame_ref(Frame_ref &&other) noexcept : pool(other.pool), slot(other.slot) { other.pool = nullptr; }
+            Frame_ref &operator=(Frame_ref &&other) noexcept
+            {
+                if (this != &other)
+                {
+                    reset();
+                    pool = other.pool;
+                    slot = other.slot;
+                    other.pool = nullptr;
+                }
+                return *this;
+            }
+            Frame_ref(const Frame_ref &) = delete;
+            Frame_ref &operator=(const Frame_ref &) = delete;
+            ~Frame_ref() { reset(); }
+
+            explicit operator bool() const { return pool != nullptr; }
+            frame_t *operator->() const { return &pool->frames[slot]; }
+            frame_t &operator*() const { return pool->frames[slot]; }
+            uint16_t index() const { return slot; }
+
+            // 放弃所有权并返回槽号（例如放入按槽号排队的 SPSC 队列），之后由 Frame_pool_t::release(index) 归还
+            uint16_t detach()
+            {
+                pool = nullptr;
+                return slot;
+            }
+
+            void reset()
+            {
+                if (pool != nullptr)
+                    pool->release(slot);
+                pool = nullptr;
+            }
+
+        private:
+            friend class Frame_pool_t;
+            Frame_ref(Frame_pool_t *pool, uint16_t slot) : pool(pool), slot(slot) {}
+
+            Frame_pool_t *pool = nullptr;
+            uint16_t slot = 0;
+        };
+
+        Frame_pool_t()
+        {
+            for (uint16_t i = 0; i < Slots; ++i)
+                next[i].store(static_cast<uint16_t>(i + 1 < Slots ? i + 1 : kNone), std::memory_order_relaxed);
+            head.store(_pack(0, 0), std::memory_order_relaxed);
+        }
+
+        Frame_pool_t(const Frame_pool_t &) = delete;
+        Frame_pool_t &operator=(const Frame_pool_t &) = delete;
+
+        // 取一个槽并写入元数据；len 超过 SlotBytes 或池已耗尽时返回空引用
+        Frame_ref acquire(uint8_t component_id, uint8_t data_id, uint16_t len)
+        {
+            const uint16_t slot = len <= SlotBytes ? acquire_index() : kNone;
+            if (slot == kNone)
+            {
+                exhausted_count.fetch_add(1, std::memory_order_relaxed);
+                return {};
+            }
+            frame_t &frame = frames[slot];
+            frame.component_id = component_id;
+            frame.data_id = data_id;
+            frame.length = len;
+            return Frame_ref(this, slot);
+        }
+
+        // 取一个槽并拷入载荷
+        Frame_ref acquire_copy(uint8_t component_id, uint8_t data_id, const uint8_t *data, uint16_t len)
+        {
+            Frame_ref ref = acquire(component_id, data_id, len);
+            if (ref && len != 0)
+                std::memcpy(ref->data, data, len);
+            return ref;
+        }
+
+        // 按槽号访问（与 Frame_ref::detach() 配合）；空闲栈为空时返回 kNone
+        uint16_t acquire_index()
+        {
+            uint64_t top = head.load(std::memory_order_acquire);
+            while (true)
+            {
+                const uint16_t slot = _index(top);
+                if (slot == kNone)
+                    return kNone;
+                const uint64_t replacement = _pack(next[slot].load(std::memory_order_relaxed), _tag(top) + 1);
+                if (head.compare_exchange_weak(top, replacement, std::memory_order_acq_rel, std::memory_order_acquire))
+                    break;
+            }
+
+            const uint32_t used = in_use_count.fetch_add(1, std::memory_order_relaxed) + 1;
+            uint32_t peak = high_water_mark.load(std::memory_order_relaxed);
+            while (used > peak && !high_water_mark.compare_exchange_weak(peak, used, std::memory_order_relaxed))
+            {
+            }
+            return _index(top);
+        }
+
+        void release(uint16_t slot)
+        {
+            uint64_t top = head.load(std::memory_order_relaxed);
+            do
+            {
+                next[slot].store(_index(top), std::memory_order_relaxed);
+            } while (!head.compare_exchange_weak(top, _pack(slot, _tag(top) + 1), std::memory_order_release,
+                                                 std::memory_order_relaxed));
+            in_use_count.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        frame_t &frame(uint16_t slot) { return frames[slot]; }
+        const frame_t &frame(uint16_t slot) const { return frames[slot]; }
+
+        // 统计：任意线程读取
+        uint32_t in_use() const { return in_use_count.load(std::memory_order_relaxed); }
+        uint32_t high_water() const { return high_water_mark.load(std::memory_order_relaxed); }
+        uint64_t exhausted() const { return exhausted_count.load(std::memory_order_relaxed); }
+        static constexpr uint16_t capacity() { return Slots; }
+        static constexpr uint16_t slot_bytes() { return SlotBytes; }
+
+    private:
+        // 栈顶 = 槽号（低 16 位）+ 修改标签（高 32 位），标签随每次出入栈递增以避免 ABA
+        static uint64_t _pack(uint16_t slot, uint32_t tag) { return (static_cast<uint64_t>(tag) << 32) | slot; }
+        static uint16_t _index(uint64_t top) { return static_cast<uint16_t>(top); }
+        static uint32_t _tag(uint64_t top) { return static_cast<uint32_t>(top >> 32); }
+
+        frame_t frames[Slots];
+        std::atomic<uint16_t> next[Slots];
+        std::atomic<uint64_t> head{0};
+        std::atomic<uint32_t> in_use_count{0};
+        std::atomic<uint32_t> high_water_mark{0};
+        std::atomic<uint64_t> exhausted_count{0};
+    };
+} // namespace unify_link
+
+#endif // UNIFY_LINK_POOL_HPP
@@ -0,0 +1,454 @@
+#ifndef UNIFY_LINK_SERIAL_HPP
+#define UNIFY_LINK_SERIAL_HPP
+
+// Linux 串口传输层（主机端可选模块，CMake: UNIFY_LINK_BUILD_SERIAL）：
+// 原始模式 termios + epoll 事件循环；read 直接写入 rec_buff 的空闲区间，writev 直接取 send_buff 的待发区间，
+// 全程没有中间缓冲区。嵌入式构建不要包含本文件。
+
+#if !defined(__linux__)
+#error "unify_link_serial.hpp is only available on Linux"
+#endif
+
+#include "unify_link.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <fcntl.h>
+#include <functional>
+#include <linux/serial.h>
+#include <mutex>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <sys/uio.h>
+#include <termios.h>
+#include <unistd.h>
+#include <vector>
+
+namespace unify_link
+{
+    namespace detail
+    {
+        // 内核 struct termios2（asm/termbits.h 与 <termios.h> 不能同时包含，这里按通用布局自行声明）
+        struct termios2_t
+        {
+            tcflag_t c_iflag;
+            tcflag_t c_oflag;
+            tcflag_t c_cflag;
+            tcflag_t c_lflag;
+            cc_t c_line;
+            cc_t c_cc[19];
+            speed_t c_ispeed;
+            speed_t c_ospeed;
+        };
+
+        constexpr tcflag_t kBaudOther = 0010000; // BOTHER：c_ispeed/c_ospeed 为任意波特率
+
+        inline speed_t standard_baud(uint32_t baud)
+        {
+            switch (baud)
+            {
+            case 9600: return B9600;
+            case 19200: return B19200;
+            case 38400: return B38400;
+            case 57600: return B57600;
+            case 115200: return B115200;
+            case 230400: return B230400;
+            case 460800: return B460800;
+            case 500000: return B500000;
+            case 576000: return B576000;
+            case 921600: return B921600;
+            case 1000000: return B1000000;
+            case 1152000: return B1152000;
+            case 1500000: return B1500000;
+            case 2000000: return B2000000;
+            case 2500000: return B2500000;
+            case 3000000: return B3000000;
+            case 3500000: return B3500000;
+            case 4000000: return B4000000;
+            default: return B0;
+            }
+        }
+    } // namespace detail
+
+    // 原始字节观察回调：is_tx、数据、长度；在传输层线程调用，数据仅在回调期间有效（见 Capture_writer::byte_tap()）
+    using byte_tap_func_t = std::function<void(bool, const uint8_t *, uint32_t)>;
+
+    template <typename Link>
+    class Serial_transport_t
+    {
+    public:
+        using task_t = std::function<void(Link &)>;
+
+        struct options_t
+        {
+            uint32_t baud_rate = 115200; // 非标准波特率经 termios2/BOTHER 设置
+            bool low_latency = true;     // ASYNC_LOW_LATENCY：关闭驱动的接收批量延迟（驱动不支持时忽略）
+            bool hw_flow_control = false;
+            // 非阻塞 + epoll 下 read 总是立即返回已到达的全部字节；VMIN/VTIME 仅在 fd 被切回阻塞模式时生效
+            uint8_t vmin = 0;
+            uint8_t vtime = 0;
+        };
+
+        explicit Serial_transport_t(Link &link) : link(link) {}
+        ~Serial_transport_t() { close(); }
+
+        Serial_transport_t(const Serial_transport_t &) = delete;
+        Serial_transport_t &operator=(const Serial_transport_t &) = delete;
+
+        // 打开并配置 tty；失败时返回 false，last_error() 为 errno。event_loop 见 attach()
+        bool open(const char *path, const options_t &options = {}, bool event_loop = true)
+        {
+            close();
+            const int tty = ::open(path, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+            if (tty < 0)
+                return _fail();
+
+            if (!_configure(tty, options))
+            {
+                const int err = errno;
+                ::close(tty);
+                errno = err;
+                return _fail();
+            }
+            return attach(tty, event_loop);
+        }
+
+        // 接管已打开的 fd（socket、pty 等，不做 termios 配置），关闭时（含失败）一并关闭。
+        // event_loop = false 时不创建 epoll / eventfd：由外部事件循环（如 Link_hub_t）按 native_handle() 驱动，
+        // poll_once() / run() 不可用，wake() 为空操作
+        bool attach(int io_fd, bool event_loop = true)
+        {
+            close();
+            const int flags = ::fcntl(io_fd, F_GETFL);
+            if (flags < 0 || ::fcntl(io_fd, F_SETFL, flags | O_NONBLOCK) < 0)
+            {
+                _fail();
+                ::close(io_fd);
+                return false;
+            }
+
+            fd = io_fd;
+            watching_out = false;
+            if (!event_loop)
+                return true;
+
+            epfd = ::epoll_create1(EPOLL_CLOEXEC);
+            wake_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (epfd < 0 || wake_fd < 0)
+            {
+                _fail();
+                close();
+                return false;
+            }
+
+            epoll_event ev{};
+            ev.events = EPOLLIN;
+            ev.data.fd = fd;
+            epoll_event wake_ev{};
+            wake_ev.events = EPOLLIN;
+            wake_ev.data.fd = wake_fd;
+            if (::epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev) < 0 || ::epoll_ctl(epfd, EPOLL_CTL_ADD, wake_fd, &wake_ev) < 0)
+            {
+                _fail();
+                close();
+                return false;
+            }
+            return true;
+        }
+
+        void close()
+        {
+            for (int *p : {&wake_fd, &epfd, &fd})
+            {
+                if (*p >= 0)
+                    ::close(*p);
+                *p = -1;
+            }
+        }
+
+        bool is_open() const { return fd >= 0; }
+        bool has_event_loop() const { return epfd >= 0; }
+        int native_handle() const { return fd; }
+        int last_error() const { return error; }
+        bool low_latency_enabled() const { return low_latency; }
+
+        // === 事件处理（也可由外部事件循环按 native_handle() 的就绪事件直接调用） ===
+
+        // 读到 EAGAIN 为止：每次 readv 直接写入 rec_buff 的空闲区间（最多两段），随后解析；对端关闭或出错时返回 false
+        bool handle_readable()
+        {
+            while (true)
+            {
+                uint32_t space = link.rec_buff.remain();
+                if (space == 0)
+                {
+                    link.parse_data_task();
+                    space = link.rec_buff.remain();
+                    if (space == 0)
+                    {
+                        rx_full_count++; // 接收缓冲区被不完整的帧占满，留在内核缓冲区中下次再读
+                        return true;
+                    }
+                }
+
+                const auto seg = link.rec_buff.reserve(space);
+                iovec iov[2] = {{seg.ptr[0], seg.len[0]}, {seg.ptr[1], seg.len[1]}};
+                const ssize_t n = ::readv(fd, iov, seg.len[1] != 0 ? 2 : 1);
+                read_calls++;
+                if (n > 0)
+                {
+                    if (byte_tap)
+                    {
+                        const uint32_t first = std::min<uint32_t>(static_cast<uint32_t>(n), seg.len[0]);
+                        byte_tap(false, seg.ptr[0], first);
+                        if (static_cast<uint32_t>(n) > first)
+                            byte_tap(false, seg.ptr[1], static_cast<uint32_t>(n) - first);
+                    }
+                    link.rev_data_mark(static_cast<uint32_t>(n));
+                    link.rec_buff.commit(static_cast<uint32_t>(n));
+                    rx_bytes += static_cast<uint64_t>(n);
+                    link.parse_data_task();
+                    if (static_cast<uint32_t>(n) < space)
+                        return true; // 内核缓冲区已读空
+                    continue;
+                }
+                if (n == 0)
+                    return _fail(EPIPE); // 对端关闭
+                if (errno == EINTR)
+                    continue;
+                if (errno == EAGAIN || errno == EWOULDBLOCK)
+                    return true;
+                return _fail();
+            }
+        }
+
+        // writev 直接发送 send_buff_peek() 的区间，只消费实际写出的字节；出错时返回 false
+        bool handle_writable()
+        {
+            while (true)
+            {
+                const auto seg = link.send_buff_peek();
+                if (seg.size() == 0)
+                    return true;
+
+                iovec iov[2] = {{const_cast<uint8_t *>(seg.ptr[0]), seg.len[0]},
+                                {const_cast<uint8_t *>(seg.ptr[1]), seg.len[1]}};
+                const ssize_t n = ::writev(fd, iov, seg.len[1] != 0 ? 2 : 1);
+                write_calls++;
+                if (n > 0)
+                {
+                    if (byte_tap)
+                    {
+                        const uint32_t first = std::min<uint32_t>(static_cast<uint32_t>(n), seg.len[0]);
+                        byte_tap(true, seg.ptr[0], first);
+                        if (static_cast<uint32_t>(n) > first)
+                            byte_tap(true, seg.ptr[1], static_cast<uint32_t>(n) - first);
+                    }
+                    link.send_buff_consume(static_cast<uint32_t>(n));
+                    tx_bytes += static_cast<uint64_t>(n);
+                    link.fragment_poll(); // 腾出空间后补充后续分片
+                    continue;
+                }
+                if (n < 0 && errno == EINTR)
+                    continue;
+                if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+                    return true; // 内核发送缓冲区已满，等待 EPOLLOUT
+                return _fail();
+            }
+        }
+
+        bool wants_write() const { return link.send_buff_used() != 0; }
+
+        // 链路的周期任务：打包超时、分片续写、可靠帧重传
+        void service()
+        {
+            link.bundle_poll();
+            link.fragment_poll();
+            link.reliable_poll();
+        }
+
+        // 事件循环的一次迭代：最多等待 timeout_ms，处理读写与唤醒；返回 false 表示传输层出错（见 last_error()）
+        bool poll_once(int timeout_ms)
+        {
+            if (!is_open())
+                return false;
+            if (!has_event_loop())
+                return _fail(EINVAL);
+
+            _run_posted();
+            service();
+            if (wants_write() && !handle_writable())
+                return false;
+            if (!_watch_out(wants_write()))
+                return false;
+
+            epoll_event events[2];
+            const int n = ::epoll_wait(epfd, events, 2, timeout_ms);
+            if (n < 0)
+                return errno == EINTR ? true : _fail();
+
+            for (int i = 0; i < n; ++i)
+            {
+                if (events[i].data.fd == wake_fd)
+                {
+                    uint64_t counter;
+                    (void)!::read(wake_fd, &counter, sizeof(counter));
+                    continue;
+                }
+                if ((events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) && !handle_readable())
+                    return false;
+                if ((events[i].events & EPOLLOUT) && !handle_writable())
+                    return false;
+            }
+
+            // 唤醒期间投递的任务以及接收处理中产生的应答等立即发出，不再等一轮 epoll
+            _run_posted();
+            service();
+            return !wants_write() || handle_writable();
+        }
+
+        // 在当前线程运行事件循环直到 stop 置位（由其他线程调用 wake() 立即打断等待）
+        bool run(const std::atomic<bool> &stop, int tick_ms = 10)
+        {
+            while (!stop.load(std::memory_order_acquire))
+            {
+                if (!poll_once(tick_ms))
+                    return false;
+            }
+            return true;
+        }
+
+        // 线程安全：在事件循环线程上执行 task（组件发送、修改配置等），随后尽快发出产生的帧。
+        // 事件循环自身也向 send_buff 写入（应答、确认、打包 / 分片 / 重传），其他线程不得直接发送
+        void post(task_t task)
+        {
+            {
+                std::lock_guard<std::mutex> lock(post_mutex);
+                posted.push_back(std::move(task));
+            }
+            wake();
+        }
+
+        // 线程安全：打断正在 epoll_wait 的事件循环（例如让 run() 及时看到 stop）
+        void wake()
+        {
+            const uint64_t one = 1;
+            if (wake_fd >= 0)
+                (void)!::write(wake_fd, &one, sizeof(one));
+        }
+
+        // 记录实际读入 / 写出的字节（例如录制）；应在事件循环启动前设置
+        void set_byte_tap(byte_tap_func_t tap) { byte_tap = std::move(tap); }
+
+        Link &link;
+
+        uint64_t rx_bytes = 0;
+        uint64_t tx_bytes = 0;
+        uint64_t read_calls = 0;
+        uint64_t write_calls = 0;
+        uint64_t rx_full_count = 0;
+
+    private:
+        bool _configure(int tty, const options_t &options)
+        {
+            termios tio{};
+            if (::tcgetattr(tty, &tio) < 0)
+                return false;
+
+            ::cfmakeraw(&tio);
+            tio.c_cflag |= CLOCAL | CREAD;
+            tio.c_cflag &= ~(CSTOPB | PARENB);
+            if (options.hw_flow_control)
+                tio.c_cflag |= CRTSCTS;
+            else
+                tio.c_cflag &= ~CRTSCTS;
+            tio.c_iflag &= ~(IXON | IXOFF | IXANY);
+            tio.c_cc[VMIN] = options.vmin;
+            tio.c_cc[VTIME] = options.vtime;
+
+            const speed_t speed = detail::standard_baud(options.baud_rate);
+            if (speed != B0)
+            {
+                ::cfsetispeed(&tio, speed);
+                ::cfsetospeed(&tio, speed);
+            }
+            if (::tcsetattr(tty, TCSANOW, &tio) < 0)
+                return false;
+
+            if (speed == B0)
+            {
+                // 非标准波特率
+                detail::termios2_t tio2{};
+                if (::ioctl(tty, _IOR('T', 0x2A, detail::termios2_t), &tio2) < 0)
+                    return false;
+                tio2.c_cflag = (tio2.c_cflag & ~static_cast<tcflag_t>(CBAUD)) | detail::kBaudOther;
+                tio2.c_ispeed = options.baud_rate;
+                tio2.c_ospeed = options.baud_rate;
+                if (::ioctl(tty, _IOW('T', 0x2B, detail::termios2_t), &tio2) < 0)
+                    return false;
+            }
+
+            low_latency = false;
+            if (options.low_latency)
+            {
+                serial_struct serial{};
+                if (::ioctl(tty, TIOCGSERIAL, &serial) == 0)
+                {
+                    serial.flags |= ASYNC_LOW_LATENCY;
+                    low_latency = ::ioctl(tty, TIOCSSERIAL, &serial) == 0;
+                }
+            }
+
+            ::tcflush(tty, TCIOFLUSH);
+            return true;
+        }
+
+        bool _watch_out(bool enable)
+        {
+            if (enable == watching_out)
+                return true;
+
+            epoll_event ev{};
+            ev.events = enable ? (EPOLLIN | EPOLLOUT) : EPOLLIN;
+            ev.data.fd = fd;
+            if (::epoll_ctl(epfd, EPOLL_CTL_MOD, fd, &ev) < 0)
+                return _fail();
+            watching_out = enable;
+            return true;
+        }
+
+        void _run_posted()
+        {
+            {
+                std::lock_guard<std::mutex> lock(post_mutex);
+                running_tasks.swap(posted);
+            }
+            for (auto &task : running_tasks)
+                task(link);
+            running_tasks.clear();
+        }
+
+        bool _fail(int err = 0)
+        {
+            error = err != 0 ? err : errno;
+            return false;
+        }
+
+        int fd = -1;
+        int epfd = -1;
+        int wake_fd = -1;
+        int error = 0;
+        bool watching_out = false;
+        bool low_latency = false;
+        byte_tap_func_t byte_tap;
+
+        std::mutex post_mutex;
+        std::vector<task_t> posted;
+        std::vector<task_t> running_tasks;
+    };
+
+    using Serial_transport = Serial_transport_t<Unify_link_base>;
+} // namespace unify_link
+
+#endif // UNIFY_LINK_SERIAL_HPP
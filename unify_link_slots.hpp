@@ -0,0 +1,85 @@
+#ifndef UNIFY_LINK_SLOTS_HPP
+#define UNIFY_LINK_SLOTS_HPP
+
+// 按 (component_id, data_id) 定位的定长槽位表，供统计（Link_stats_t）、时延（Latency_recorder_t）与监视（Link_monitor_t）共用。
+//   - 线性探测，起点 (component_id * 31 + data_id) % N；槽位的 tag 为 key + 1（0 为空），写入后不再改变
+//   - 新槽位以 CAS 发布 tag，多个写者可同时占用空槽；读者以 acquire 读到 tag 后即可见槽位内容
+//   - 表满时 insert() 返回 nullptr，调用方只计入总计
+
+#include "unify_link_def.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+namespace unify_link
+{
+    namespace detail
+    {
+        // Slot 需含 std::atomic<uint32_t> tag 成员，其余字段由调用方定义
+        template <typename Slot, uint16_t N>
+        struct id_slot_table
+        {
+            std::array<Slot, N> slots{};
+
+            static constexpr uint32_t tag_of(uint8_t component_id, uint8_t data_id)
+            {
+                return ((static_cast<uint32_t>(component_id) << 8) | data_id) + 1;
+            }
+            static constexpr uint8_t component_of(uint32_t tag) { return static_cast<uint8_t>((tag - 1) >> 8); }
+            static constexpr uint8_t data_of(uint32_t tag) { return static_cast<uint8_t>(tag - 1); }
+
+            Slot *find(uint8_t component_id, uint8_t data_id) { return _probe(*this, component_id, data_id, false); }
+            const Slot *find(uint8_t component_id, uint8_t data_id) const
+            {
+                return _probe(*this, component_id, data_id, false);
+            }
+            // 查找，不存在时占用一个空槽
+            Slot *insert(uint8_t component_id, uint8_t data_id) { return _probe(*this, component_id, data_id, true); }
+
+            auto begin() { return slots.begin(); }
+            auto end() { return slots.end(); }
+            auto begin() const { return slots.begin(); }
+            auto end() const { return slots.end(); }
+
+        private:
+            template <typename Self>
+            static auto _probe(Self &self, uint8_t component_id, uint8_t data_id, bool insert)
+                -> decltype(&self.slots[0])
+            {
+                if constexpr (N == 0)
+                {
+                    return nullptr;
+                }
+                else
+                {
+                    const uint32_t tag = tag_of(component_id, data_id);
+                    uint32_t i = (component_id * 31u + data_id) % N;
+                    for (uint16_t n = 0; n < N; ++n, i = (i + 1) % N)
+                    {
+                        auto &slot = self.slots[i];
+                        const uint32_t current = slot.tag.load(std::memory_order_acquire);
+                        if (current == tag)
+                            return &slot;
+                        if (current != 0)
+                            continue;
+                        if (!insert)
+                            return nullptr;
+                        if constexpr (!std::is_const_v<Self>)
+                        {
+                            uint32_t expected = 0;
+                            if (slot.tag.compare_exchange_strong(expected, tag, std::memory_order_acq_rel) ||
+                                expected == tag)
+                                return &slot;
+                            // 被其他写者以别的 ID 占用，继续探测
+                        }
+                    }
+                    return nullptr;
+                }
+            }
+        };
+    } // namespace detail
+} // namespace unify_link
+
+#endif // UNIFY_LINK_SLOTS_HPP
@@ -0,0 +1,229 @@
+#ifndef UNIFY_LINK_STATIC_HPP
+#define UNIFY_LINK_STATIC_HPP
+
+#include "unify_link.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+
+namespace unify_link
+{
+    // 编译期注册路径：组件通过 static_routes 声明 (data_id → 成员/回调) 映射，
+    // Unify_link_static 在编译期展开为比较链（等价 switch），memcpy 长度与回调均可被内联。
+    // 不使用 std::function、不分配堆内存，可用于 -fno-rtti / 无堆的固件工程。
+
+    // 组件的编译期注册构造参数：组件以此构造时不向运行时分发表注册
+    template <typename Link>
+    struct static_registration_t
+    {
+        Link &link_base;
+    };
+
+    namespace detail
+    {
+        template <typename T>
+        struct member_pointer_traits;
+
+        template <typename C, typename M>
+        struct member_pointer_traits<M C::*>
+        {
+            using class_type = C;
+            using member_type = M;
+        };
+
+        template <auto Callback>
+        constexpr bool has_callback = !std::is_same_v<decltype(Callback), std::nullptr_t>;
+
+        // 载荷长度上限取决于链路的 MaxPayload，由 Unify_link_static 在展开路由时检查
+        template <typename Payload>
+        constexpr bool is_valid_payload = std::is_trivially_copyable_v<Payload>;
+
+        template <typename... Ts>
+        constexpr bool ids_unique(const Ts... ids)
+        {
+            if constexpr (sizeof...(Ts) < 2)
+            {
+                return true;
+            }
+            else
+            {
+                const uint8_t list[] = {static_cast<uint8_t>(ids)...};
+                for (size_t i = 0; i < sizeof...(Ts); ++i)
+                {
+                    for (size_t j = i + 1; j < sizeof...(Ts); ++j)
+                    {
+                        if (list[i] == list[j])
+                            return false;
+                    }
+                }
+                return true;
+            }
+        }
+
+        template <typename Component>
+        using registration_for = static_registration_t<typename Component::link_type>;
+
+        template <typename First, typename... Rest>
+        struct first_of
+        {
+            using type = First;
+        };
+    } // namespace detail
+
+    // 数据路由：载荷复制到 Member，再调用可选的成员回调 bool (C::*)(const uint8_t *, uint16_t)
+    // 长度为 0 的请求帧回传 Member 的当前值（与 register_handle_data 中 dst 的语义一致）
+    template <uint8_t DataId, auto Member, auto Callback = nullptr>
+    struct static_data_route
+    {
+        using component_type = typename detail::member_pointer_traits<decltype(Member)>::class_type;
+        using payload_type = typename detail::member_pointer_traits<decltype(Member)>::member_type;
+
+        static_assert(detail::is_valid_payload<payload_type>,
+                      "payload must be trivially copyable");
+
+        static constexpr uint8_t data_id = DataId;
+        static constexpr auto member = Member; // 供 Snapshot_server_t::add_registered() 枚举可取回的块
+
+        template <typename Link>
+        static bool handle(Link &link, component_type &component, const uint8_t *data, uint16_t len)
+        {
+            payload_type &dst = component.*Member;
+
+            // 请求帧 返回请求数据
+            if (len == 0)
+            {
+                return link.build_send_data(component_type::component_id, DataId,
+                                            reinterpret_cast<const uint8_t *>(&dst), sizeof(payload_type)) != 0;
+            }
+
+            if (len != sizeof(payload_type))
+                return false;
+
+            std::memcpy(&dst, data, sizeof(payload_type));
+
+            if constexpr (detail::has_callback<Callback>)
+                return (component.*Callback)(data, len);
+            return true;
+        }
+    };
+
+    // 回调路由：无目标成员，只校验长度 sizeof(Payload) 后调用成员回调
+    template <uint8_t DataId, typename Payload, auto Callback>
+    struct static_callback_route
+    {
+        using component_type = typename detail::member_pointer_traits<decltype(Callback)>::class_type;
+        using payload_type = Payload;
+
+        static_assert(detail::is_valid_payload<payload_type>,
+                      "payload must be trivially copyable");
+
+        static constexpr uint8_t data_id = DataId;
+
+        template <typename Link>
+        static bool handle(Link &, component_type &component, const uint8_t *data, uint16_t len)
+        {
+            if (len != sizeof(payload_type))
+                return false;
+
+            return (component.*Callback)(data, len);
+        }
+    };
+
+    // 变长路由：载荷长度不超过 sizeof(MaxPayload) 即交给成员回调，由回调自行解析（如增量编码帧）
+    template <uint8_t DataId, typename MaxPayload, auto Callback>
+    struct static_variable_route
+    {
+        using component_type = typename detail::member_pointer_traits<decltype(Callback)>::class_type;
+        using payload_type = MaxPayload;
+
+        static constexpr uint8_t data_id = DataId;
+
+        template <typename Link>
+        static bool handle(Link &, component_type &component, const uint8_t *data, uint16_t len)
+        {
+            if (len > sizeof(payload_type))
+                return false;
+
+            return (component.*Callback)(data, len);
+        }
+    };
+
+    // 持有全部组件的链路：组件在内部构造，所有 (component_id, data_id) 在编译期分发；
+    // 未命中的帧仍可落入运行时分发表（register_handle_data 依然可用）。
+    // 链路尺寸取自组件的 link_type（如 Motor_link_basic_t<Unify_link_t<...>>），全部组件须一致。
+    template <typename... Components>
+    class Unify_link_static : public detail::first_of<Components...>::type::link_type
+    {
+        static_assert(sizeof...(Components) > 0, "Unify_link_static needs at least one component");
+        static_assert(detail::ids_unique(Components::component_id...), "duplicate component_id");
+
+    public:
+        using link_type = typename detail::first_of<Components...>::type::link_type;
+
+        static_assert((std::is_same_v<typename Components::link_type, link_type> && ...),
+                      "all components must be bound to the same link type");
+
+        std::tuple<Components...> components;
+
+        Unify_link_static() : components(detail::registration_for<Components>{*this}...)
+        {
+            this->static_dispatch = &Unify_link_static::dispatch;
+        }
+
+        // 组件持有本对象的引用，禁止拷贝/移动
+        Unify_link_static(const Unify_link_static &) = delete;
+        Unify_link_static &operator=(const Unify_link_static &) = delete;
+
+        template <typename Component>
+        Component &get()
+        {
+            return std::get<Component>(components);
+        }
+
+        template <typename Component>
+        const Component &get() const
+        {
+            return std::get<Component>(components);
+        }
+
+    private:
+        static int dispatch(link_type &base, uint8_t component_id, uint8_t data_id, const uint8_t *data,
+                            uint16_t len)
+        {
+            auto &self = static_cast<Unify_link_static &>(base);
+            int result = -1;
+            (void)((Components::component_id == component_id &&
+                    (result = self.template dispatch_component<Components>(data_id, data, len), true)) ||
+                   ...);
+            return result;
+        }
+
+        template <typename Component>
+        int dispatch_component(uint8_t data_id, const uint8_t *data, uint16_t len)
+        {
+            return dispatch_routes(std::get<Component>(components), data_id, data, len,
+                                   static_cast<typename Component::static_routes *>(nullptr));
+        }
+
+        template <typename Component, typename... Routes>
+        int dispatch_routes(Component &component, uint8_t data_id, const uint8_t *data, uint16_t len,
+                            std::tuple<Routes...> *)
+        {
+            static_assert(detail::ids_unique(Routes::data_id...), "duplicate data_id in static_routes");
+            static_assert((std::is_same_v<typename Routes::component_type, Component> && ...),
+                          "static_routes must point at members of the owning component");
+            static_assert(((sizeof(typename Routes::payload_type) <= link_type::max_payload_length) && ...),
+                          "static route payload exceeds the link's MaxPayload");
+
+            int result = -1;
+            (void)((Routes::data_id == data_id &&
+                    (result = Routes::handle(static_cast<link_type &>(*this), component, data, len) ? 1 : 0, true)) ||
+                   ...);
+            return result;
+        }
+    };
+} // namespace unify_link
+
+#endif // UNIFY_LINK_STATIC_HPP